@@ -25,17 +25,68 @@ BEGIN_NAMESPACE_SATPG
 AtpgMgr::AtpgMgr() :
   mTimer(TM_SIZE, TM_MISC)
 {
+  mSaFsim2 = nullptr;
+  mSaFsim3 = nullptr;
   mSaFaultMgr = nullptr;
+  mTdFsim2 = nullptr;
+  mTdFsim3 = nullptr;
   mTdFaultMgr = nullptr;
 }
 
 // @brief デストラクタ
 AtpgMgr::~AtpgMgr()
 {
+  delete_fsim();
   delete mSaFaultMgr;
   delete mTdFaultMgr;
 }
 
+// @brief 縮退故障用の2値の故障シミュレータを取り出す．
+//
+// 故障シミュレータは最初に取り出された時に作られる．
+Fsim&
+AtpgMgr::_sa_fsim2()
+{
+  if ( mSaFsim2 == nullptr ) {
+    mSaFsim2 = new Fsim;
+    mSaFsim2->init_fsim2(_fsim_topology(), FaultType::StuckAt);
+  }
+  return *mSaFsim2;
+}
+
+// @brief 縮退故障用の3値の故障シミュレータを返す．
+Fsim&
+AtpgMgr::_sa_fsim3()
+{
+  if ( mSaFsim3 == nullptr ) {
+    mSaFsim3 = new Fsim;
+    mSaFsim3->init_fsim3(_fsim_topology(), FaultType::StuckAt);
+  }
+  return *mSaFsim3;
+}
+
+// @brief 遷移故障用の2値の故障シミュレータを取り出す．
+Fsim&
+AtpgMgr::_td_fsim2()
+{
+  if ( mTdFsim2 == nullptr ) {
+    mTdFsim2 = new Fsim;
+    mTdFsim2->init_fsim2(_fsim_topology(), FaultType::TransitionDelay);
+  }
+  return *mTdFsim2;
+}
+
+// @brief 遷移故障用の3値の故障シミュレータを返す．
+Fsim&
+AtpgMgr::_td_fsim3()
+{
+  if ( mTdFsim3 == nullptr ) {
+    mTdFsim3 = new Fsim;
+    mTdFsim3->init_fsim3(_fsim_topology(), FaultType::TransitionDelay);
+  }
+  return *mTdFsim3;
+}
+
 // @brief ファイル読み込みに関わる時間を得る．
 USTime
 AtpgMgr::read_time() const
@@ -81,12 +132,41 @@ AtpgMgr::after_set_network()
   mSaTvList.clear();
   mTdTvList.clear();
 
-  mSaFsim2.init_fsim2(_network(), FaultType::StuckAt);
-  mSaFsim3.init_fsim3(_network(), FaultType::StuckAt);
+  // 故障シミュレータは使われる時に新しいネットワークで作り直す．
+  delete_fsim();
+
   mSaFaultMgr = new FaultStatusMgr(_network());
-  mTdFsim2.init_fsim2(_network(), FaultType::TransitionDelay);
-  mTdFsim3.init_fsim3(_network(), FaultType::TransitionDelay);
   mTdFaultMgr = new FaultStatusMgr(_network());
 }
 
+// @brief 故障シミュレータ用の回路構造を取り出す．
+//
+// 最初に取り出された時に作られる．
+const std::shared_ptr<const SimTopology>&
+AtpgMgr::_fsim_topology()
+{
+  if ( !mFsimTopology ) {
+    mFsimTopology = Fsim::make_topology(_network());
+  }
+  return mFsimTopology;
+}
+
+// @brief 故障シミュレータを全て削除する．
+void
+AtpgMgr::delete_fsim()
+{
+  delete mSaFsim2;
+  delete mSaFsim3;
+  delete mTdFsim2;
+  delete mTdFsim3;
+
+  mSaFsim2 = nullptr;
+  mSaFsim3 = nullptr;
+  mTdFsim2 = nullptr;
+  mTdFsim3 = nullptr;
+
+  // 回路構造は故障シミュレータを削除した後で手放す．
+  mFsimTopology.reset();
+}
+
 END_NAMESPACE_SATPG
@@ -44,6 +44,11 @@ enum {
 //////////////////////////////////////////////////////////////////////
 /// @class AtpgMgr AtpgMgr.h "AtpgMgr.h"
 /// @brief ATPG に共通のデータを保持しておくためのクラス
+///
+/// 故障シミュレータは最初に使われる時に作られるので，
+/// 使われない種類の分の領域は確保されない．<br>
+/// 4種類の故障シミュレータは同じネットワークから作られるので
+/// SimNode のグラフ，FFR の表，故障の配列は一つだけ作って共有する．
 //////////////////////////////////////////////////////////////////////
 class AtpgMgr
 {
@@ -66,6 +71,8 @@ public:
   _network();
 
   /// @brief 縮退故障用の2値の故障シミュレータを取り出す．
+  ///
+  /// 故障シミュレータは最初に取り出された時に作られる．
   Fsim&
   _sa_fsim2();
 
@@ -149,6 +156,16 @@ private:
   // 下請け関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 故障シミュレータ用の回路構造を取り出す．
+  ///
+  /// 最初に取り出された時に作られる．
+  const std::shared_ptr<const SimTopology>&
+  _fsim_topology();
+
+  /// @brief 故障シミュレータを全て削除する．
+  void
+  delete_fsim();
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -158,11 +175,14 @@ private:
   // 対象のネットワーク
   TpgNetwork mNetwork;
 
+  // 故障シミュレータの間で共有する回路構造
+  std::shared_ptr<const SimTopology> mFsimTopology;
+
   // 縮退故障用の2値の故障シミュレータ
-  Fsim mSaFsim2;
+  Fsim* mSaFsim2;
 
   // 縮退故障用の3値の故障シミュレータ
-  Fsim mSaFsim3;
+  Fsim* mSaFsim3;
 
   // 縮退故障用の故障マネージャ
   FaultStatusMgr* mSaFaultMgr;
@@ -171,10 +191,10 @@ private:
   vector<TestVector> mSaTvList;
 
   // 遷移故障用の2値の故障シミュレータ
-  Fsim mTdFsim2;
+  Fsim* mTdFsim2;
 
   // 遷移故障用の3値の故障シミュレータ
-  Fsim mTdFsim3;
+  Fsim* mTdFsim3;
 
   // 遷移故障用の故障マネージャ
   FaultStatusMgr* mTdFaultMgr;
@@ -203,22 +223,6 @@ AtpgMgr::_network()
   return mNetwork;
 }
 
-// @brief 縮退故障用の2値の故障シミュレータを取り出す．
-inline
-Fsim&
-AtpgMgr::_sa_fsim2()
-{
-  return mSaFsim2;
-}
-
-// @brief 縮退故障用の3値の故障シミュレータを返す．
-inline
-Fsim&
-AtpgMgr::_sa_fsim3()
-{
-  return mSaFsim3;
-}
-
 // @brief 縮退故障用の故障マネージャを取り出す．
 inline
 FaultStatusMgr&
@@ -235,22 +239,6 @@ AtpgMgr::_sa_tv_list()
   return mSaTvList;
 }
 
-// @brief 遷移故障用の2値の故障シミュレータを取り出す．
-inline
-Fsim&
-AtpgMgr::_td_fsim2()
-{
-  return mTdFsim2;
-}
-
-// @brief 遷移故障用の3値の故障シミュレータを返す．
-inline
-Fsim&
-AtpgMgr::_td_fsim3()
-{
-  return mTdFsim3;
-}
-
 // @brief 遷移故障用の故障マネージャを取り出す．
 inline
 FaultStatusMgr&
@@ -72,7 +72,6 @@ RandWsaCmd::cmd_proc(TclObjVector& objv)
   int dff_num = _network().dff_num();
   InputVector iv(input_num);
   DffVector dv(dff_num);
-  InputVector av(input_num);
   Fsim& fsim = _td_fsim2();
 
   double total_wsa = 0.0;
@@ -97,12 +96,14 @@ RandWsaCmd::cmd_proc(TclObjVector& objv)
   }
   else {
     // BS モード
-    for ( int i = 0; i < count; ++ i ) {
-      iv.set_from_random(rg);
-      dv.set_from_random(rg);
-      av.set_from_random(rg);
-      fsim.set_state(iv, dv);
-      int wsa1 = fsim.calc_wsa(av, weighted);
+    // 各パタンは独立なのでまとめてビット並列に計算する．
+    vector<TestVector> tv_list(count, TestVector(input_num, dff_num, FaultType::TransitionDelay));
+    for ( auto& tv: tv_list ) {
+      tv.set_from_random(rg);
+    }
+    vector<int> wsa_list;
+    fsim.calc_wsa(tv_list, weighted, wsa_list);
+    for ( auto wsa1: wsa_list ) {
       total_wsa += wsa1;
     }
   }
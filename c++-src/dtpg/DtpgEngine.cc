@@ -53,18 +53,15 @@ DtpgEngine::DtpgEngine(const TpgNetwork& network,
   mNetwork(network),
   mFaultType(fault_type),
   mRoot(root),
-  mMarkArray(mNetwork.node_num(), 0U),
-  mHvarMap(network.node_num()),
-  mGvarMap(network.node_num()),
-  mFvarMap(network.node_num()),
-  mDvarMap(network.node_num()),
   mJustifier(just_type, network),
   mTimerEnable(true)
 {
-  mTfoList.reserve(network.node_num());
-  mTfiList.reserve(network.node_num());
-  mTfi2List.reserve(network.node_num());
-  mOutputList.reserve(network.ppo_num());
+  // 変数は root の TFI/TFO のノードにしか割り当てないので
+  // ネットワーク全体の大きさの配列は用いない．
+  mHvarMap.init_sparse();
+  mGvarMap.init_sparse();
+  mFvarMap.init_sparse();
+  mDvarMap.init_sparse();
 }
 
 // @brief デストラクタ
@@ -0,0 +1,382 @@
+
+/// @file DtpgInc.cc
+/// @brief DtpgInc の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DtpgInc.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "TpgDff.h"
+#include "GateEnc.h"
+#include "NodeValList.h"
+#include "TestVector.h"
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "ym/StopWatch.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+extern
+NodeValList
+extract(const TpgNode* root,
+	const VidMap& gvar_map,
+	const VidMap& fvar_map,
+	const vector<SatBool3>& model);
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] fault_type 故障の種類
+// @param[in] just_type Justifier の種類を表す文字列
+// @param[in] solver_type SATソルバの実装タイプ
+DtpgInc::DtpgInc(const TpgNetwork& network,
+		 FaultType fault_type,
+		 const string& just_type,
+		 const SatSolverType& solver_type) :
+  mSolver(solver_type),
+  mNetwork(network),
+  mFaultType(fault_type),
+  mRoot(nullptr),
+  mConeNum(0),
+  mTfoMark(network.node_num(), false),
+  mHvarMap(network.node_num()),
+  mGvarMap(network.node_num()),
+  mFvarMap(network.node_num()),
+  mDvarMap(network.node_num()),
+  mJustifier(just_type, network)
+{
+  mTfoList.reserve(network.node_num());
+  mOutputList.reserve(network.ppo_num());
+
+  make_good_cnf();
+}
+
+// @brief デストラクタ
+DtpgInc::~DtpgInc()
+{
+}
+
+// @brief テスト生成を行なう．
+// @param[in] fault 対象の故障
+// @return 結果を返す．
+DtpgResult
+DtpgInc::gen_pattern(const TpgFault* fault)
+{
+  const TpgNode* ffr_root = fault->tpg_onode()->ffr_root();
+  if ( ffr_root != mRoot ) {
+    make_cone(ffr_root);
+  }
+
+  // FFR 内の故障伝搬条件を ffr_cond に入れる．
+  NodeValList ffr_cond = ffr_propagate_condition(fault, mFaultType);
+
+  // 活性化リテラルと ffr_cond の内容を assumptions に追加する．
+  vector<SatLiteral> assumptions;
+  assumptions.reserve(ffr_cond.size() + 1);
+  assumptions.push_back(mActLit);
+  conv_to_assumptions(ffr_cond, assumptions);
+
+  SatBool3 sat_res = solve(assumptions);
+  if ( sat_res == SatBool3::True ) {
+    NodeValList suf_cond = extract(mRoot, mGvarMap, mFvarMap, mSatModel);
+    suf_cond.merge(ffr_cond);
+    TestVector testvect = backtrace(suf_cond);
+    return DtpgResult(testvect);
+  }
+  else if ( sat_res == SatBool3::False ) {
+    return DtpgResult::make_untestable();
+  }
+  else { // sat_res == SatBool3::X
+    return DtpgResult::make_undetected();
+  }
+}
+
+// @brief ネットワーク全体の正常回路の CNF を作る．
+void
+DtpgInc::make_good_cnf()
+{
+  cnf_begin();
+
+  // 変数を割り当てる．
+  // コーンが作られるまでは fvar は gvar と同じ
+  for ( auto node: mNetwork.node_list() ) {
+    SatVarId gvar = mSolver.new_variable();
+    mSolver.freeze_literal(SatLiteral(gvar));
+    mGvarMap.set_vid(node, gvar);
+    mFvarMap.set_vid(node, gvar);
+  }
+  if ( mFaultType == FaultType::TransitionDelay ) {
+    for ( auto node: mNetwork.node_list() ) {
+      SatVarId hvar = mSolver.new_variable();
+      mSolver.freeze_literal(SatLiteral(hvar));
+      mHvarMap.set_vid(node, hvar);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // 正常回路の CNF を生成
+  //////////////////////////////////////////////////////////////////////
+  GateEnc gval_enc(mSolver, mGvarMap);
+  for ( auto node: mNetwork.node_list() ) {
+    gval_enc.make_cnf(node);
+  }
+
+  if ( mFaultType == FaultType::TransitionDelay ) {
+    for ( auto& dff: mNetwork.dff_list() ) {
+      // DFF の入力の1時刻前の値と出力の値が等しい．
+      SatLiteral olit(mGvarMap(dff.output()));
+      SatLiteral ilit(mHvarMap(dff.input()));
+      mSolver.add_eq_rel(olit, ilit);
+    }
+
+    GateEnc hval_enc(mSolver, mHvarMap);
+    for ( auto node: mNetwork.node_list() ) {
+      hval_enc.make_cnf(node);
+    }
+  }
+
+  cnf_end();
+}
+
+// @brief root の TFO の故障回路の CNF を作る．
+// @param[in] root FFR の根のノード
+//
+// 直前のコーンは無効化される．
+void
+DtpgInc::make_cone(const TpgNode* root)
+{
+  cnf_begin();
+
+  if ( mRoot != nullptr ) {
+    // 直前のコーンを無効化する．
+    // コーンの節は全て ~mActLit を含むのでこの単位節で充足され，
+    // SAT ソルバの簡単化で取り除かれる．
+    mSolver.add_clause(~mActLit);
+    for ( auto node: mTfoList ) {
+      mTfoMark[node->id()] = false;
+      mFvarMap.set_vid(node, mGvarMap(node));
+    }
+    mTfoList.clear();
+    mOutputList.clear();
+  }
+
+  mRoot = root;
+
+  // root の TFO を mTfoList に入れる．
+  mTfoMark[root->id()] = true;
+  mTfoList.push_back(root);
+  for ( int rpos = 0; rpos < static_cast<int>(mTfoList.size()); ++ rpos ) {
+    const TpgNode* node = mTfoList[rpos];
+    if ( node->is_ppo() ) {
+      mOutputList.push_back(node);
+    }
+    for ( auto onode: node->fanout_list() ) {
+      if ( !mTfoMark[onode->id()] ) {
+	mTfoMark[onode->id()] = true;
+	mTfoList.push_back(onode);
+      }
+    }
+  }
+
+  // 活性化リテラル
+  // 仮定として使い続けるのでこれだけは凍結しておく．
+  SatVarId avar = mSolver.new_variable();
+  mSolver.freeze_literal(SatLiteral(avar));
+  mActLit = SatLiteral(avar);
+
+  // TFO の部分に変数を割り当てる．
+  // fvar と dvar はこのコーンの節からしか参照されないので凍結しない．
+  // 無効化したあとは SAT ソルバが消去してよい．
+  for ( auto node: mTfoList ) {
+    SatVarId fvar = mSolver.new_variable();
+    SatVarId dvar = mSolver.new_variable();
+
+    mFvarMap.set_vid(node, fvar);
+    mDvarMap.set_vid(node, dvar);
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障回路の CNF を生成
+  // 全ての節は活性化リテラルが 1 の時のみ有効となる．
+  //////////////////////////////////////////////////////////////////////
+  GateEnc fval_enc(mSolver, mFvarMap, mActLit);
+  for ( auto node: mTfoList ) {
+    if ( node != mRoot ) {
+      fval_enc.make_cnf(node);
+    }
+    make_dchain_cnf(node);
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障の検出条件
+  //////////////////////////////////////////////////////////////////////
+  {
+    vector<SatLiteral> odiff;
+    odiff.reserve(mOutputList.size());
+    for ( auto node: mOutputList ) {
+      SatLiteral dlit(mDvarMap(node));
+      odiff.push_back(dlit);
+    }
+    add_cone_clause(odiff);
+
+    if ( !mRoot->is_ppo() ) {
+      // mRoot の dlit が1でなければならない．
+      SatLiteral dlit0(mDvarMap(mRoot));
+      add_cone_clause({dlit0});
+    }
+  }
+
+  ++ mConeNum;
+
+  cnf_end();
+}
+
+// @brief 故障伝搬条件を表すCNF式を生成する．
+// @param[in] node 対象のノード
+void
+DtpgInc::make_dchain_cnf(const TpgNode* node)
+{
+  SatLiteral glit(mGvarMap(node));
+  SatLiteral flit(mFvarMap(node));
+  SatLiteral dlit(mDvarMap(node));
+
+  // dlit -> XOR(glit, flit) を追加する．
+  // 要するに正常回路と故障回路で異なっているとき dlit が 1 となる．
+  add_cone_clause({~glit, ~flit, ~dlit});
+  add_cone_clause({ glit,  flit, ~dlit});
+
+  if ( node->is_ppo() ) {
+    add_cone_clause({~glit,  flit,  dlit});
+    add_cone_clause({ glit, ~flit,  dlit});
+  }
+  else {
+    // dlit -> ファンアウト先のノードの dlit の一つが 1
+    int nfo = node->fanout_num();
+    if ( nfo == 1 ) {
+      SatLiteral odlit(mDvarMap(node->fanout_list()[0]));
+      add_cone_clause({~dlit, odlit});
+    }
+    else {
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(nfo + 2);
+      for ( auto onode: node->fanout_list() ) {
+	tmp_lits.push_back(SatLiteral(mDvarMap(onode)));
+      }
+      tmp_lits.push_back(~dlit);
+      add_cone_clause(tmp_lits);
+
+      const TpgNode* imm_dom = node->imm_dom();
+      if ( imm_dom != nullptr ) {
+	SatLiteral odlit(mDvarMap(imm_dom));
+	add_cone_clause({~dlit, odlit});
+      }
+    }
+  }
+}
+
+// @brief 現在のコーンの節を追加する．
+// @param[in] lits 節のリテラルのリスト
+//
+// 活性化リテラルの否定を加えて追加する．
+void
+DtpgInc::add_cone_clause(vector<SatLiteral> lits)
+{
+  lits.push_back(~mActLit);
+  mSolver.add_clause(lits);
+}
+
+// @brief 値割り当てをリテラルのリストに変換する．
+// @param[in] assign_list 値の割り当てリスト
+// @param[out] assumptions 変換したリテラルを追加するリスト
+void
+DtpgInc::conv_to_assumptions(const NodeValList& assign_list,
+			     vector<SatLiteral>& assumptions)
+{
+  for ( auto nv: assign_list ) {
+    const TpgNode* node = nv.node();
+    bool inv = !nv.val(); // 0 の時が inv = true
+    SatVarId vid = (nv.time() == 0) ? mHvarMap(node) : mGvarMap(node);
+    assumptions.push_back(SatLiteral(vid, inv));
+  }
+}
+
+// @brief 一つの SAT問題を解く．
+// @param[in] assumptions 値の決まっている変数のリスト
+// @return 結果を返す．
+SatBool3
+DtpgInc::solve(const vector<SatLiteral>& assumptions)
+{
+  StopWatch timer;
+  timer.start();
+
+  SatBool3 ans = mSolver.solve(assumptions, mSatModel);
+
+  timer.stop();
+  USTime time = timer.time();
+
+  SatStats sat_stats;
+  mSolver.get_stats(sat_stats);
+
+  if ( ans == SatBool3::True ) {
+    // パタンが求まった．
+    mStats.update_det(sat_stats, time);
+  }
+  else if ( ans == SatBool3::False ) {
+    // 検出不能と判定された．
+    mStats.update_red(sat_stats, time);
+  }
+  else {
+    // ans == SatBool3::X つまりアボート
+    mStats.update_abort(sat_stats, time);
+  }
+
+  return ans;
+}
+
+// @brief バックトレースを行う．
+// @param[in] suf_cond 十分条件の割り当て
+// @return テストパタンを返す．
+TestVector
+DtpgInc::backtrace(const NodeValList& suf_cond)
+{
+  StopWatch timer;
+  timer.start();
+
+  TestVector testvect;
+  if ( mFaultType == FaultType::TransitionDelay ) {
+    testvect = mJustifier(suf_cond, mHvarMap, mGvarMap, mSatModel);
+  }
+  else {
+    testvect = mJustifier(suf_cond, mGvarMap, mSatModel);
+  }
+
+  timer.stop();
+  mStats.mBackTraceTime += timer.time();
+
+  return testvect;
+}
+
+// @brief CNF 作成を開始する．
+void
+DtpgInc::cnf_begin()
+{
+  mTimer.reset();
+  mTimer.start();
+}
+
+// @brief CNF 作成を終了する．
+void
+DtpgInc::cnf_end()
+{
+  mTimer.stop();
+  mStats.mCnfGenTime += mTimer.time();
+  ++ mStats.mCnfGenCount;
+}
+
+END_NAMESPACE_SATPG
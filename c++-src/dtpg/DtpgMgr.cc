@@ -0,0 +1,291 @@
+
+/// @file DtpgMgr.cc
+/// @brief DtpgMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "DtpgMgr.h"
+#include "DtpgFFR.h"
+#include "DtpgMFFC.h"
+#include "DtpgResult.h"
+#include "FaultStatusMgr.h"
+#include "TpgFFR.h"
+#include "TpgMFFC.h"
+#include "TpgFault.h"
+#include "ym/Range.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_SATPG
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// テスト生成の結果
+//////////////////////////////////////////////////////////////////////
+struct DtpgItem
+{
+  // 故障
+  const TpgFault* mFault;
+
+  // 結果 (Detected か Untestable)
+  FaultStatus mStatus;
+
+  // テストベクタ
+  // mStatus == Detected の時のみ意味を持つ．
+  TestVector mTestVector;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// テスト生成の結果を故障シミュレーション用のスレッドに渡すキュー
+//
+// 複数のスレッドから put() してよいが get_all() を呼ぶのは
+// 一つのスレッドに限られる．
+//////////////////////////////////////////////////////////////////////
+class DtpgQueue
+{
+public:
+
+  // コンストラクタ
+  DtpgQueue() :
+    mClosed(false)
+  {
+  }
+
+  // 結果を追加する．
+  void
+  put(const TpgFault* fault,
+      FaultStatus status,
+      const TestVector& testvect)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mItemList.push_back(DtpgItem{fault, status, testvect});
+    }
+    mCond.notify_one();
+  }
+
+  // これ以上 put() されないことを知らせる．
+  void
+  close()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mClosed = true;
+    }
+    mCond.notify_one();
+  }
+
+  // 要素が追加されるまで待って，溜まっている要素を全て取り出す．
+  // close() 後に要素がなくなったら false を返す．
+  bool
+  get_all(vector<DtpgItem>& item_list)
+  {
+    item_list.clear();
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCond.wait(lock, [this]{ return !mItemList.empty() || mClosed; });
+    item_list.swap(mItemList);
+    return !item_list.empty();
+  }
+
+
+private:
+
+  // 排他制御用のミューテックス
+  std::mutex mMutex;
+
+  // 待ち合わせ用の条件変数
+  std::condition_variable mCond;
+
+  // 要素のリスト
+  vector<DtpgItem> mItemList;
+
+  // close() が呼ばれたことを表すフラグ
+  bool mClosed;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス DtpgMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] fault_type 故障の種類
+// @param[in] just_type Justifier の種類を表す文字列
+// @param[in] solver_type SATソルバの実装タイプ
+DtpgMgr::DtpgMgr(const TpgNetwork& network,
+		 FaultType fault_type,
+		 const string& just_type,
+		 const SatSolverType& solver_type) :
+  mNetwork(network),
+  mFaultType(fault_type),
+  mJustType(just_type),
+  mSolverType(solver_type),
+  mThreadNum(1),
+  mUntestNum(0),
+  mAbortNum(0)
+{
+  mFsim.init_fsim3(network, fault_type);
+}
+
+// @brief デストラクタ
+DtpgMgr::~DtpgMgr()
+{
+}
+
+// @brief テスト生成を行うスレッド数を設定する．
+// @param[in] num スレッド数
+//
+// num が 0 以下の場合にはハードウェアのスレッド数を用いる．
+void
+DtpgMgr::set_thread_num(int num)
+{
+  if ( num <= 0 ) {
+    num = std::thread::hardware_concurrency();
+    if ( num == 0 ) {
+      num = 1;
+    }
+  }
+  mThreadNum = num;
+}
+
+// @brief FFR 単位でテスト生成を行う．
+// @param[in] fmgr 故障の状態を保持するオブジェクト
+// @param[in] drop 故障シミュレーションによる故障ドロップを行う時 true
+void
+DtpgMgr::ffr_mode(FaultStatusMgr& fmgr,
+		  bool drop)
+{
+  _run<DtpgFFR>(mNetwork.ffr_list(), fmgr, drop);
+}
+
+// @brief MFFC 単位でテスト生成を行う．
+// @param[in] fmgr 故障の状態を保持するオブジェクト
+// @param[in] drop 故障シミュレーションによる故障ドロップを行う時 true
+void
+DtpgMgr::mffc_mode(FaultStatusMgr& fmgr,
+		   bool drop)
+{
+  _run<DtpgMFFC>(mNetwork.mffc_list(), fmgr, drop);
+}
+
+// @brief テスト生成を行う．
+// @param[in] unit_list 仕事の単位(FFR or MFFC)のリスト
+// @param[in] fmgr 故障の状態を保持するオブジェクト
+// @param[in] drop 故障ドロップを行う時 true
+template<class DtpgT,
+	 class UnitT>
+void
+DtpgMgr::_run(const Array<const UnitT>& unit_list,
+	      FaultStatusMgr& fmgr,
+	      bool drop)
+{
+  mFaultList.clear();
+  mTvList.clear();
+  mUntestNum = 0;
+  mStats.clear();
+
+  mFsim.set_skip_all();
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( fmgr.get(f) == FaultStatus::Undetected ) {
+      mFsim.clear_skip(f);
+    }
+  }
+
+  DtpgQueue queue;
+  std::atomic<int> next_unit(0);
+  std::atomic<int> running_num(mThreadNum);
+  std::atomic<int> abort_num(0);
+  vector<DtpgStats> stats_array(mThreadNum);
+
+  // テスト生成を行うスレッド
+  // 仕事の単位を一つずつ取り出して処理する．
+  auto worker = [&](int thread_id) {
+    auto& stats = stats_array[thread_id];
+    int unit_num = unit_list.size();
+    for ( ; ; ) {
+      int pos = next_unit.fetch_add(1);
+      if ( pos >= unit_num ) {
+	break;
+      }
+      auto& unit = unit_list[pos];
+      DtpgT dtpg(mNetwork, mFaultType, unit, mJustType, mSolverType);
+      for ( auto fault: unit.fault_list() ) {
+	if ( fmgr.get(fault) != FaultStatus::Undetected ) {
+	  // 処理済みか故障ドロップされた．
+	  continue;
+	}
+	DtpgResult result = dtpg.gen_pattern(fault);
+	auto status = result.status();
+	if ( status == FaultStatus::Undetected ) {
+	  ++ abort_num;
+	}
+	else if ( fmgr.set_if_undetected(fault, status) ) {
+	  queue.put(fault, status, result.testvector());
+	}
+      }
+      stats.merge(dtpg.stats());
+    }
+    // 最後に終わったスレッドがキューを閉じる．
+    if ( -- running_num == 0 ) {
+      queue.close();
+    }
+  };
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(mThreadNum);
+  for ( auto i: Range(mThreadNum) ) {
+    thread_list.push_back(std::thread(worker, i));
+  }
+
+  // 結果の記録と故障シミュレーションはこのスレッドで行う．
+  // mFsim, mFaultList, mTvList, mUntestNum はこのスレッドしか触らない．
+  auto sink = [&](const TpgFault* f, int pos) {
+    if ( fmgr.set_if_undetected(f, FaultStatus::Detected) ) {
+      mFaultList.push_back(f);
+      mFsim.set_skip(f);
+    }
+  };
+  vector<DtpgItem> item_list;
+  vector<TestVector> tv_list;
+  while ( queue.get_all(item_list) ) {
+    tv_list.clear();
+    for ( auto& item: item_list ) {
+      mFsim.set_skip(item.mFault);
+      if ( item.mStatus == FaultStatus::Detected ) {
+	mFaultList.push_back(item.mFault);
+	mTvList.push_back(item.mTestVector);
+	tv_list.push_back(item.mTestVector);
+      }
+      else {
+	++ mUntestNum;
+      }
+    }
+    if ( drop && !tv_list.empty() ) {
+      mFsim.grade(tv_list, sink);
+    }
+  }
+
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  mAbortNum = abort_num;
+  for ( auto& stats: stats_array ) {
+    mStats.merge(stats);
+  }
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,328 @@
+
+/// @file DtpgSeq.cc
+/// @brief DtpgSeq の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "DtpgSeq.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "TpgDff.h"
+#include "GateEnc.h"
+#include "FaultyGateEnc.h"
+#include "NodeValList.h"
+#include "InputVector.h"
+#include "DffVector.h"
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "ym/StopWatch.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+// クラス DtpgSeq
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] fault 対象の故障
+// @param[in] just_type Justifier の種類を表す文字列
+// @param[in] solver_type SATソルバの実装タイプ
+DtpgSeq::DtpgSeq(const TpgNetwork& network,
+		 const TpgFault* fault,
+		 const string& just_type,
+		 const SatSolverType& solver_type) :
+  mSolver(solver_type),
+  mNetwork(network),
+  mFault(fault),
+  mCheckedNum(0),
+  mMarkArray(network.node_num(), false),
+  mJustifier(just_type, network)
+{
+}
+
+// @brief デストラクタ
+DtpgSeq::~DtpgSeq()
+{
+}
+
+// @brief テスト系列の生成を行なう．
+// @param[in] max_frame 時間展開数の上限
+// @param[out] init_state FFの初期値
+// @param[out] input_list 時刻ごとの外部入力の値のリスト
+// @retval SatBool3::True テスト系列が求まった．
+// @retval SatBool3::False max_frame 時刻以内では検出できない．
+// @retval SatBool3::X アボートした．
+SatBool3
+DtpgSeq::dtpg(int max_frame,
+	      DffVector& init_state,
+	      vector<InputVector>& input_list)
+{
+  for ( ; ; ) {
+    if ( mCheckedNum == frame_num() ) {
+      if ( frame_num() >= max_frame ) {
+	break;
+      }
+      add_frame();
+    }
+
+    // 最後の時刻で故障が検出される条件を調べる．
+    // それより前の時刻では検出されないことがわかっている．
+    int time = mCheckedNum;
+    vector<SatLiteral> assumptions(1, mDetLitList[time]);
+    SatBool3 ans = solve(assumptions);
+    if ( ans == SatBool3::True ) {
+      backtrace(time, init_state, input_list);
+      return ans;
+    }
+    if ( ans == SatBool3::X ) {
+      // アボートした時刻は次の呼び出しでもう一度調べる．
+      return ans;
+    }
+
+    // この時刻では検出できないので以降の問題では否定しておく．
+    mSolver.add_clause(~mDetLitList[time]);
+    ++ mCheckedNum;
+  }
+
+  return SatBool3::False;
+}
+
+// @brief 時間フレームを一つ追加する．
+void
+DtpgSeq::add_frame()
+{
+  StopWatch timer;
+  timer.start();
+
+  int time = frame_num();
+  mGvarMapList.push_back(VidMap());
+  mGvarMapList[time].init_sparse();
+  mFvarMapList.push_back(VidMap());
+  mTfoListArray.push_back(vector<const TpgNode*>());
+
+  vector<const TpgNode*>& tfo_list = mTfoListArray[time];
+  make_tfo_list(time, tfo_list);
+
+  VidMap& fvar_map = mFvarMapList[time];
+  fvar_map.init_sparse(tfo_list.size());
+
+  // TFO の部分に故障値の変数を割り当てる．
+  const TpgNode* fnode = mFault->tpg_onode();
+  for ( auto node: tfo_list ) {
+    make_good_cnf(node, time);
+
+    if ( node != fnode && node->is_dff_output() ) {
+      // 1時刻前の DFF の入力の故障値をそのまま用いる．
+      const TpgNode* inode = node->dff()->input();
+      SatVarId fvar = mFvarMapList[time - 1](inode);
+      ASSERT_COND( fvar != kSatVarIdIllegal );
+      fvar_map.set_vid(node, fvar);
+    }
+    else {
+      SatVarId fvar = mSolver.new_variable();
+      mSolver.freeze_literal(SatLiteral(fvar));
+      fvar_map.set_vid(node, fvar);
+    }
+  }
+
+  // TFO に含まれないファンインの故障値は正常値と等しい．
+  const VidMap& gvar_map = mGvarMapList[time];
+  for ( auto node: tfo_list ) {
+    for ( auto inode: node->fanin_list() ) {
+      if ( fvar_map(inode) == kSatVarIdIllegal ) {
+	fvar_map.set_vid(inode, gvar_map(inode));
+      }
+    }
+  }
+
+  // 故障回路の CNF を作る．
+  GateEnc fval_enc(mSolver, fvar_map);
+  for ( auto node: tfo_list ) {
+    if ( node == fnode ) {
+      FaultyGateEnc ffval_enc(mSolver, fvar_map, mFault);
+      ffval_enc.make_cnf();
+    }
+    else if ( !node->is_dff_output() ) {
+      fval_enc.make_cnf(node);
+    }
+  }
+
+  // この時刻の外部出力で故障が検出される条件を作る．
+  vector<SatLiteral> tmp_lits;
+  for ( auto node: tfo_list ) {
+    if ( node->is_primary_output() ) {
+      SatLiteral glit(gvar_map(node));
+      SatLiteral flit(fvar_map(node));
+      SatLiteral dlit(mSolver.new_variable());
+
+      // dlit -> XOR(glit, flit) を追加する．
+      mSolver.add_clause(~glit, ~flit, ~dlit);
+      mSolver.add_clause( glit,  flit, ~dlit);
+
+      tmp_lits.push_back(dlit);
+    }
+  }
+  // 故障の影響が外部出力に届かない時刻では det_lit は常に 0 になる．
+  // det_lit は dtpg() で仮定として用いるので凍結しておく．
+  SatLiteral det_lit(mSolver.new_variable());
+  mSolver.freeze_literal(det_lit);
+  tmp_lits.push_back(~det_lit);
+  mSolver.add_clause(tmp_lits);
+  mDetLitList.push_back(det_lit);
+
+  timer.stop();
+  mStats.mCnfGenTime += timer.time();
+  ++ mStats.mCnfGenCount;
+}
+
+// @brief 正常回路の CNF を作る．
+// @param[in] node 対象のノード
+// @param[in] time 時刻
+void
+DtpgSeq::make_good_cnf(const TpgNode* node,
+		       int time)
+{
+  VidMap& gvar_map = mGvarMapList[time];
+  if ( gvar_map(node) != kSatVarIdIllegal ) {
+    return;
+  }
+
+  if ( time > 0 && node->is_dff_output() ) {
+    // DFF の出力の値は1時刻前の DFF の入力の値と等しい．
+    const TpgNode* inode = node->dff()->input();
+    make_good_cnf(inode, time - 1);
+    gvar_map.set_vid(node, mGvarMapList[time - 1](inode));
+    return;
+  }
+
+  SatVarId var = mSolver.new_variable();
+  mSolver.freeze_literal(SatLiteral(var));
+  gvar_map.set_vid(node, var);
+
+  for ( auto inode: node->fanin_list() ) {
+    make_good_cnf(inode, time);
+  }
+
+  GateEnc gval_enc(mSolver, gvar_map);
+  gval_enc.make_cnf(node);
+}
+
+// @brief 故障の影響が及ぶ可能性のあるノードのリストを作る．
+// @param[in] time 時刻
+// @param[out] tfo_list 結果を格納するリスト
+void
+DtpgSeq::make_tfo_list(int time,
+		       vector<const TpgNode*>& tfo_list)
+{
+  tfo_list.clear();
+
+  const TpgNode* fnode = mFault->tpg_onode();
+  tfo_list.push_back(fnode);
+  mMarkArray[fnode->id()] = true;
+
+  if ( time > 0 ) {
+    // 1時刻前に故障の影響が及んでいた DFF の出力を加える．
+    for ( auto node: mTfoListArray[time - 1] ) {
+      if ( node->is_dff_input() ) {
+	const TpgNode* onode = node->dff()->output();
+	if ( !mMarkArray[onode->id()] ) {
+	  mMarkArray[onode->id()] = true;
+	  tfo_list.push_back(onode);
+	}
+      }
+    }
+  }
+
+  for ( int rpos = 0; rpos < static_cast<int>(tfo_list.size()); ++ rpos ) {
+    const TpgNode* node = tfo_list[rpos];
+    for ( auto onode: node->fanout_list() ) {
+      if ( !mMarkArray[onode->id()] ) {
+	mMarkArray[onode->id()] = true;
+	tfo_list.push_back(onode);
+      }
+    }
+  }
+
+  for ( auto node: tfo_list ) {
+    mMarkArray[node->id()] = false;
+  }
+}
+
+// @brief 一つの SAT問題を解く．
+// @param[in] assumptions 値の決まっている変数のリスト
+// @return 結果を返す．
+SatBool3
+DtpgSeq::solve(const vector<SatLiteral>& assumptions)
+{
+  StopWatch timer;
+  timer.start();
+
+  SatBool3 ans = mSolver.solve(assumptions, mSatModel);
+
+  timer.stop();
+  USTime time = timer.time();
+
+  SatStats sat_stats;
+  mSolver.get_stats(sat_stats);
+
+  if ( ans == SatBool3::True ) {
+    // パタンが求まった．
+    mStats.update_det(sat_stats, time);
+  }
+  else if ( ans == SatBool3::False ) {
+    // この時刻までは検出不能と判定された．
+    mStats.update_red(sat_stats, time);
+  }
+  else {
+    // ans == SatBool3::X つまりアボート
+    mStats.update_abort(sat_stats, time);
+  }
+
+  return ans;
+}
+
+// @brief 直前の solve() の結果からテスト系列を作る．
+// @param[in] det_time 故障を検出した時刻
+// @param[out] init_state FFの初期値
+// @param[out] input_list 時刻ごとの外部入力の値のリスト
+//
+// 各時刻で故障の影響が及ぶ可能性のあるノードとそのファンインの
+// 正常値を正当化する．これらの値が決まれば故障値も全て決まるので
+// 故障の影響は det_time の外部出力まで伝搬する．
+void
+DtpgSeq::backtrace(int det_time,
+		   DffVector& init_state,
+		   vector<InputVector>& input_list)
+{
+  // dtpg() は最後に追加した時刻でしか検出条件を調べない．
+  ASSERT_COND( det_time == frame_num() - 1 );
+
+  StopWatch timer;
+  timer.start();
+
+  vector<NodeValList> assign_array(frame_num());
+  for ( auto time: Range(frame_num()) ) {
+    NodeValList& assign_list = assign_array[time];
+    for ( auto node: mTfoListArray[time] ) {
+      assign_list.add(node, 0, gval(node, time) == Val3::_1);
+      for ( auto inode: node->fanin_list() ) {
+	assign_list.add(inode, 0, gval(inode, time) == Val3::_1);
+      }
+    }
+  }
+
+  mJustifier(assign_array, mGvarMapList, mSatModel, init_state, input_list);
+
+  timer.stop();
+  mStats.mBackTraceTime += timer.time();
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,355 @@
+
+/// @file CfsEngine.cc
+/// @brief CfsEngine の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "CfsEngine.h"
+#include "SimEval.h"
+#include "TpgFault.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+BEGIN_NONAMESPACE
+
+// val の bit 番目のビットの値を Val3 で返す．
+inline
+Val3
+get_val3(const FSIM_VALTYPE& val,
+	 int bit)
+{
+#if FSIM_VAL2
+  return get_bit(val, bit) ? Val3::_1 : Val3::_0;
+#elif FSIM_VAL3
+  if ( get_bit(val.val0(), bit) ) {
+    return Val3::_0;
+  }
+  if ( get_bit(val.val1(), bit) ) {
+    return Val3::_1;
+  }
+  return Val3::_X;
+#endif
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス CfsEngine
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CfsEngine::CfsEngine() :
+  mFaultArray(nullptr),
+  mGvalArray(nullptr),
+  mActList(nullptr)
+{
+}
+
+// @brief デストラクタ
+CfsEngine::~CfsEngine()
+{
+}
+
+// @brief 初期化を行う．
+// @param[in] max_level 最大レベル
+// @param[in] node_array 全てのノードの配列
+// @param[in] fault_array 全ての故障の配列
+// @param[in] fault_num 故障数
+// @param[in] gval_array ノード番号をキーにした正常値の配列
+void
+CfsEngine::init(int max_level,
+		const vector<const SimNode*>& node_array,
+		const SimFault* fault_array,
+		int fault_num,
+		const FSIM_VALTYPE* gval_array)
+{
+  mFaultArray = fault_array;
+  mGvalArray = gval_array;
+
+  int nn = node_array.size();
+  int max_ni = 0;
+  for ( auto node: node_array ) {
+    if ( max_ni < node->fanin_num() ) {
+      max_ni = node->fanin_num();
+    }
+  }
+
+  mEntryArray.clear();
+  mBeginArray.clear();
+  mBeginArray.resize(nn, 0);
+  mEndArray.clear();
+  mEndArray.resize(nn, 0);
+  mActBeginArray.clear();
+  mActBeginArray.resize(nn, 0);
+  mActEndArray.clear();
+  mActEndArray.resize(nn, 0);
+  mNodeList.clear();
+  mQueue.clear();
+  mQueue.resize(max_level + 1);
+  mQueueFlag.clear();
+  mQueueFlag.resize(nn, false);
+  mDetFlag.clear();
+  mDetFlag.resize(fault_num, false);
+  mHeadArray.resize(max_ni);
+  mTailArray.resize(max_ni);
+  mMask0.resize(max_ni);
+  mMask1.resize(max_ni);
+#if FSIM_VAL3
+  mMaskX.resize(max_ni);
+#endif
+  mValArray.resize(nn);
+}
+
+// @brief 故障シミュレーションを行う．
+// @param[in] act_list 活性化された故障のリスト
+// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+//
+// act_list は fault_array 上の位置の昇順に並んでいなければならない．
+void
+CfsEngine::simulate(const vector<const SimFault*>& act_list,
+		    vector<const SimFault*>& det_list)
+{
+  det_list.clear();
+  mEntryArray.clear();
+
+  // 故障のあるノードをキューに積む．
+  // 同じノードの故障は act_list 上で連続している．
+  mActList = &act_list;
+  int na = act_list.size();
+  for ( auto pos: Range(na) ) {
+    auto node = act_list[pos]->mNode;
+    auto id = node->id();
+    if ( mActBeginArray[id] == mActEndArray[id] ) {
+      mActBeginArray[id] = pos;
+    }
+    mActEndArray[id] = pos + 1;
+    put(node);
+  }
+
+  // レベルの小さい順に故障リストを計算する．
+  // eval() の中で積まれるのはより大きいレベルのノードだけなので
+  // 処理中のキューが変更されることはない．
+  for ( auto& queue: mQueue ) {
+    for ( auto node: queue ) {
+      mQueueFlag[node->id()] = false;
+      eval(node, det_list);
+    }
+    queue.clear();
+  }
+
+  // 後始末
+  for ( auto node: mNodeList ) {
+    mBeginArray[node->id()] = 0;
+    mEndArray[node->id()] = 0;
+  }
+  mNodeList.clear();
+  for ( auto ff: act_list ) {
+    auto id = ff->mNode->id();
+    mActBeginArray[id] = 0;
+    mActEndArray[id] = 0;
+  }
+  for ( auto ff: det_list ) {
+    mDetFlag[ff->mId] = false;
+  }
+  mActList = nullptr;
+}
+
+// @brief ノードの故障リストを計算する．
+// @param[in] node 対象のノード
+// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+void
+CfsEngine::eval(const SimNode* node,
+		vector<const SimFault*>& det_list)
+{
+  auto id = node->id();
+  auto ni = node->fanin_num();
+  for ( auto i: Range(ni) ) {
+    auto iid = node->fanin_id(i);
+    mHeadArray[i] = mBeginArray[iid];
+    mTailArray[i] = mEndArray[iid];
+  }
+
+  int begin = mEntryArray.size();
+  auto act_pos = mActBeginArray[id];
+  auto act_end = mActEndArray[id];
+  clear_mask(ni);
+  int bit = 0;
+  for ( ; ; ) {
+    // ファンインの故障リストの先頭のうち最小の故障位置を求める．
+    int fpos = -1;
+    for ( auto i: Range(ni) ) {
+      if ( mHeadArray[i] < mTailArray[i] ) {
+	auto pos = mEntryArray[mHeadArray[i]].mFaultPos;
+	if ( fpos == -1 || fpos > pos ) {
+	  fpos = pos;
+	}
+      }
+    }
+
+    if ( fpos != -1 ) {
+      // ファンインから伝搬してきた故障
+      for ( auto i: Range(ni) ) {
+	auto& head = mHeadArray[i];
+	if ( head < mTailArray[i] && mEntryArray[head].mFaultPos == fpos ) {
+	  set_mask(i, bit, mEntryArray[head].mVal);
+	  ++ head;
+	}
+      }
+      mBitFault[bit] = fpos;
+      mBitStem[bit] = false;
+      mBitIpos[bit] = -1;
+    }
+    else if ( act_pos < act_end ) {
+      // このノードの故障
+      // 故障はトポロジカル順に並んでいるのでファンインから
+      // 伝搬してきた故障よりも必ず後ろになる．
+      auto ff = (*mActList)[act_pos];
+      ++ act_pos;
+      mBitFault[bit] = ff->mId;
+      if ( ff->mOrigF->is_branch_fault() ) {
+	// 入力の故障は eval_batch() で可観測性から計算する．
+	// 同じノードが複数の入力につながっている場合があるので
+	// ノード番号をキーにした値の配列では表せない．
+	mBitStem[bit] = false;
+	mBitIpos[bit] = ff->mIpos;
+      }
+      else {
+	// 出力の故障は計算する必要がない．
+	mBitStem[bit] = true;
+	mBitIpos[bit] = -1;
+      }
+    }
+    else {
+      break;
+    }
+
+    ++ bit;
+    if ( bit == FSIM_PV_BITLEN ) {
+      eval_batch(node, bit, det_list);
+      clear_mask(ni);
+      bit = 0;
+    }
+  }
+  if ( bit > 0 ) {
+    eval_batch(node, bit, det_list);
+  }
+
+  int end = mEntryArray.size();
+  mBeginArray[id] = begin;
+  mEndArray[id] = end;
+  if ( end > begin ) {
+    mNodeList.push_back(node);
+    auto nfo = node->fanout_num();
+    if ( nfo == 1 ) {
+      put(node->fanout_top());
+    }
+    else {
+      for ( auto i: Range(nfo) ) {
+	put(node->fanout(i));
+      }
+    }
+  }
+}
+
+// @brief ビットに割り当てた故障の値をまとめて計算する．
+// @param[in] node 対象のノード
+// @param[in] bit_num 割り当てたビット数
+// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+void
+CfsEngine::eval_batch(const SimNode* node,
+		      int bit_num,
+		      vector<const SimFault*>& det_list)
+{
+  bool need_calc = false;
+  for ( auto bit: Range(bit_num) ) {
+    if ( !mBitStem[bit] && mBitIpos[bit] == -1 ) {
+      need_calc = true;
+      break;
+    }
+  }
+
+  auto oval = mGvalArray[node->id()];
+  if ( need_calc ) {
+    // ファンインの値は正常値のうちマスクのビットだけ故障値に置き換える．
+    auto ni = node->fanin_num();
+    for ( auto i: Range(ni) ) {
+      auto iid = node->fanin_id(i);
+#if FSIM_VAL2
+      auto ival = (mGvalArray[iid] & ~mMask0[i]) | mMask1[i];
+#elif FSIM_VAL3
+      auto ival = mGvalArray[iid];
+      ival.set_with_mask(FSIM_VALTYPE(mMask0[i], mMask1[i]), mMask0[i] | mMask1[i] | mMaskX[i]);
+#endif
+      mValArray[iid] = ival;
+    }
+    oval = calc_val(node, mValArray.data());
+  }
+
+  auto gval = get_val3(mGvalArray[node->id()], 0);
+  for ( auto bit: Range(bit_num) ) {
+    Val3 fval;
+    if ( mBitStem[bit] ) {
+      fval = ~gval;
+    }
+    else if ( mBitIpos[bit] != -1 ) {
+      // 故障のある入力だけが反転した時の出力値
+      // 正常値は全てのビットが同じなので 0 ビット目を見ればよい．
+      auto obs = calc_gobs(node, mBitIpos[bit], mGvalArray);
+      fval = get_bit(obs, 0) ? ~gval : gval;
+    }
+    else {
+      fval = get_val3(oval, bit);
+    }
+    if ( fval == gval ) {
+      continue;
+    }
+    auto fpos = mBitFault[bit];
+    mEntryArray.push_back(Entry{fpos, fval});
+    if ( node->is_output() && gval != Val3::_X && fval != Val3::_X && !mDetFlag[fpos] ) {
+      mDetFlag[fpos] = true;
+      det_list.push_back(&mFaultArray[fpos]);
+    }
+  }
+}
+
+// @brief ファンインのマスクをクリアする．
+// @param[in] ni ファンイン数
+void
+CfsEngine::clear_mask(int ni)
+{
+  for ( auto i: Range(ni) ) {
+    mMask0[i] = FSIM_PV_ALL0;
+    mMask1[i] = FSIM_PV_ALL0;
+#if FSIM_VAL3
+    mMaskX[i] = FSIM_PV_ALL0;
+#endif
+  }
+}
+
+// @brief ファンインのマスクに故障値をセットする．
+// @param[in] ipos ファンイン番号
+// @param[in] bit ビット位置
+// @param[in] val 故障値
+void
+CfsEngine::set_mask(int ipos,
+		    int bit,
+		    Val3 val)
+{
+  switch ( val ) {
+  case Val3::_0: set_bit(mMask0[ipos], bit); break;
+  case Val3::_1: set_bit(mMask1[ipos], bit); break;
+  case Val3::_X:
+#if FSIM_VAL3
+    set_bit(mMaskX[ipos], bit);
+#endif
+    break;
+  }
+}
+
+END_NAMESPACE_SATPG_FSIM
@@ -0,0 +1,239 @@
+#ifndef FSIM_CFSENGINE_H
+#define FSIM_CFSENGINE_H
+
+/// @file CfsEngine.h
+/// @brief CfsEngine のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include "SimNode.h"
+#include "SimFault.h"
+#include "PackedVal.h"
+#include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
+#include "Val3.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+/// @class CfsEngine CfsEngine.h "CfsEngine.h"
+/// @brief 並行故障シミュレーション(concurrent fault simulation)を行うクラス
+///
+/// 1つのパタンに対して，各ノードごとに正常値と異なる値を持つ故障と
+/// その値のリスト(故障リスト)を作り，ファンインの故障リストから
+/// ファンアウトの故障リストをレベル順に計算する．
+/// FFR の根ごとにイベントを伝搬させる sppfp と異なり，同じ経路を
+/// 通る故障はまとめて一度に処理されるので，生き残っている故障が
+/// 少ない時に無駄な計算が少ない．<br>
+/// 1つのノードの評価では故障リストの和集合の故障を FSIM_PV_BITLEN 個ずつ
+/// ビットに割り当てて calc_val() でまとめて計算する．
+/// ただし，このノードの入力の故障はファンイン番号ごとに
+/// calc_gobs() で計算する．<br>
+/// 正常値は全てのビットが同じ値で init() で渡された配列に
+/// 計算済みであるものとする．
+//////////////////////////////////////////////////////////////////////
+class CfsEngine
+{
+public:
+
+  /// @brief コンストラクタ
+  CfsEngine();
+
+  /// @brief コピーコンストラクタは禁止
+  CfsEngine(const CfsEngine& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  CfsEngine&
+  operator=(const CfsEngine& src) = delete;
+
+  /// @brief デストラクタ
+  ~CfsEngine();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化を行う．
+  /// @param[in] max_level 最大レベル
+  /// @param[in] node_array 全てのノードの配列
+  /// @param[in] fault_array 全ての故障の配列
+  /// @param[in] fault_num 故障数
+  /// @param[in] gval_array ノード番号をキーにした正常値の配列
+  ///
+  /// 故障リストは fault_array 上の位置の順に並べられる．
+  /// fault_array の故障はノードのトポロジカル順に並んでいなければならない．
+  void
+  init(int max_level,
+       const vector<const SimNode*>& node_array,
+       const SimFault* fault_array,
+       int fault_num,
+       const FSIM_VALTYPE* gval_array);
+
+  /// @brief 故障シミュレーションを行う．
+  /// @param[in] act_list 活性化された故障のリスト
+  /// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+  ///
+  /// act_list は fault_array 上の位置の昇順に並んでいなければならない．
+  void
+  simulate(const vector<const SimFault*>& act_list,
+	   vector<const SimFault*>& det_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 故障リストの要素
+  struct Entry
+  {
+    // 故障の位置
+    int mFaultPos;
+
+    // 故障値
+    Val3 mVal;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief キューに積む．
+  /// @param[in] node 対象のノード
+  void
+  put(const SimNode* node);
+
+  /// @brief ノードの故障リストを計算する．
+  /// @param[in] node 対象のノード
+  /// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+  void
+  eval(const SimNode* node,
+       vector<const SimFault*>& det_list);
+
+  /// @brief ビットに割り当てた故障の値をまとめて計算する．
+  /// @param[in] node 対象のノード
+  /// @param[in] bit_num 割り当てたビット数
+  /// @param[out] det_list 外部出力まで伝搬した故障を格納するリスト
+  void
+  eval_batch(const SimNode* node,
+	     int bit_num,
+	     vector<const SimFault*>& det_list);
+
+  /// @brief ファンインのマスクをクリアする．
+  /// @param[in] ni ファンイン数
+  void
+  clear_mask(int ni);
+
+  /// @brief ファンインのマスクに故障値をセットする．
+  /// @param[in] ipos ファンイン番号
+  /// @param[in] bit ビット位置
+  /// @param[in] val 故障値
+  void
+  set_mask(int ipos,
+	   int bit,
+	   Val3 val);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 故障の配列
+  const SimFault* mFaultArray;
+
+  // ノード番号をキーにした正常値の配列
+  // 故障シミュレータが持っているものを借りている．
+  const FSIM_VALTYPE* mGvalArray;
+
+  // 全ての故障リストの要素を納める配列
+  vector<Entry> mEntryArray;
+
+  // ノード番号をキーにして故障リストの先頭位置を納める配列
+  vector<int> mBeginArray;
+
+  // ノード番号をキーにして故障リストの末尾位置を納める配列
+  vector<int> mEndArray;
+
+  // ノード番号をキーにして活性化された故障の act_list 上の範囲を納める配列
+  vector<int> mActBeginArray;
+  vector<int> mActEndArray;
+
+  // 処理中の act_list
+  const vector<const SimFault*>* mActList;
+
+  // 故障リストを持つノードのリスト
+  vector<const SimNode*> mNodeList;
+
+  // レベルごとのキュー
+  vector<vector<const SimNode*> > mQueue;
+
+  // ノード番号をキーにしてキューに入っている時 true となる配列
+  vector<bool> mQueueFlag;
+
+  // 故障の位置をキーにして検出済みの時 true となる配列
+  vector<bool> mDetFlag;
+
+  // ファンインごとの故障リストの処理中の位置
+  vector<int> mHeadArray;
+
+  // ファンインごとの故障リストの末尾の位置
+  vector<int> mTailArray;
+
+  // ビットに割り当てた故障の位置
+  int mBitFault[FSIM_PV_BITLEN];
+
+  // ビットに割り当てた故障が出力の故障の時 true
+  bool mBitStem[FSIM_PV_BITLEN];
+
+  // ビットに割り当てた故障が入力の故障の時のファンイン番号
+  // それ以外の時は -1
+  int mBitIpos[FSIM_PV_BITLEN];
+
+  // ファンインごとの故障値が0のビットのマスク
+  vector<FSIM_PVTYPE> mMask0;
+
+  // ファンインごとの故障値が1のビットのマスク
+  vector<FSIM_PVTYPE> mMask1;
+
+#if FSIM_VAL3
+  // ファンインごとの故障値がXのビットのマスク
+  vector<FSIM_PVTYPE> mMaskX;
+#endif
+
+  // ノード番号をキーにして calc_val() に渡す故障値の配列
+  vector<FSIM_VALTYPE> mValArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief キューに積む．
+// @param[in] node 対象のノード
+inline
+void
+CfsEngine::put(const SimNode* node)
+{
+  auto id = node->id();
+  if ( !mQueueFlag[id] ) {
+    mQueueFlag[id] = true;
+    mQueue[node->level()].push_back(node);
+  }
+}
+
+END_NAMESPACE_SATPG_FSIM
+
+#endif // FSIM_CFSENGINE_H
@@ -8,12 +8,30 @@
 
 
 #include "EventQ.h"
-#include "SimNode.h"
-#include "GateType.h"
+#include "SimEval.h"
 
 
 BEGIN_NAMESPACE_SATPG_FSIM
 
+BEGIN_NONAMESPACE
+
+// old_val のうち mask で1の立っているビットだけ new_val に置き換える．
+inline
+FSIM_VALTYPE
+merge_val(FSIM_VALTYPE old_val,
+	  FSIM_VALTYPE new_val,
+	  FSIM_PVTYPE mask)
+{
+#if FSIM_VAL2
+  return (old_val & ~mask) | (new_val & mask);
+#elif FSIM_VAL3
+  old_val.set_with_mask(new_val, mask);
+  return old_val;
+#endif
+}
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // 故障シミュレーション用のイベントキューを表すクラス
 //////////////////////////////////////////////////////////////////////
@@ -24,6 +42,10 @@ EventQ::EventQ() :
   mArray(nullptr),
   mNum(0),
   mClearArraySize(0),
+  mValArray(nullptr),
+  mLinkArray(nullptr),
+  mQueueFlagArray(nullptr),
+  mFlipFlagArray(nullptr),
   mClearArray(nullptr),
   mClearPos(0),
   mFlipMaskArray(nullptr),
@@ -35,6 +57,9 @@ EventQ::EventQ() :
 EventQ::~EventQ()
 {
   delete [] mArray;
+  delete [] mLinkArray;
+  delete [] mQueueFlagArray;
+  delete [] mFlipFlagArray;
   delete [] mClearArray;
   delete [] mFlipMaskArray;
 }
@@ -42,22 +67,35 @@ EventQ::~EventQ()
 // @brief 初期化を行う．
 // @param[in] max_level 最大レベル
 // @param[in] node_num ノード数
+// @param[in] val_array ノード番号をキーにした値の配列
 void
 EventQ::init(int max_level,
-	     int node_num)
+	     int node_num,
+	     FSIM_VALTYPE* val_array)
 {
   if ( max_level >= mArraySize ) {
     delete [] mArray;
     mArraySize = max_level + 1;
-    mArray = new SimNode*[mArraySize];
+    mArray = new const SimNode*[mArraySize];
   }
   if ( node_num > mClearArraySize ) {
+    delete [] mLinkArray;
+    delete [] mQueueFlagArray;
+    delete [] mFlipFlagArray;
     delete [] mClearArray;
     delete [] mFlipMaskArray;
     mClearArraySize = node_num;
+    mLinkArray = new const SimNode*[mClearArraySize];
+    mQueueFlagArray = new bool[mClearArraySize];
+    mFlipFlagArray = new bool[mClearArraySize];
     mClearArray = new RestoreInfo[mClearArraySize];
-    mFlipMaskArray = new PackedVal[mClearArraySize];
+    mFlipMaskArray = new FSIM_PVTYPE[mClearArraySize];
+  }
+  for ( auto i: Range(0, mClearArraySize) ) {
+    mQueueFlagArray[i] = false;
+    mFlipFlagArray[i] = false;
   }
+  mValArray = val_array;
 
   mCurLevel = 0;
   for ( auto i: Range(0, mArraySize) ) {
@@ -70,17 +108,17 @@ EventQ::init(int max_level,
 // @param[in] node 対象のノード
 // @param[in] valmask 反転マスク
 void
-EventQ::put_trigger(SimNode* node,
-		    PackedVal valmask,
+EventQ::put_trigger(const SimNode* node,
+		    FSIM_PVTYPE valmask,
 		    bool immediate)
 {
-  if ( immediate || node->gate_type() == GateType::Input ) {
+  if ( immediate || node->op() == SimOp::Input ) {
     // 入力の場合，他のイベントの干渉は受けないので
     // 今計算してしまう．
     // もしくは ppsfp のようにイベントが単独であると
     // わかっている場合も即座に計算してしまう．
-    auto old_val = node->val();
-    node->set_val(old_val ^ valmask);
+    auto old_val = mValArray[node->id()];
+    mValArray[node->id()] = old_val ^ valmask;
     add_to_clear_list(node, old_val);
     put_fanouts(node);
   }
@@ -99,11 +137,11 @@ EventQ::put_trigger(SimNode* node,
 // target が nullptr でない時にはイベントが target まで到達したら
 // シミュレーションを終える．
 // target が nullptr の時には出力ノードまでイベントを伝える．
-PackedVal
-EventQ::simulate(SimNode* target)
+FSIM_PVTYPE
+EventQ::simulate(const SimNode* target)
 {
   // どこかの外部出力で検出されたことを表すビット
-  auto obs = kPvAll0;
+  auto obs = FSIM_PV_ALL0;
   for ( ; ; ) {
     auto node = get();
     // イベントが残っていなければ終わる．
@@ -111,14 +149,14 @@ EventQ::simulate(SimNode* target)
 
     // すでに検出済みのビットはマスクしておく
     // これは無駄なイベントの発生を抑える．
-    auto old_val = node->val();
-    node->calc_val(~obs);
-    auto new_val = node->val();
-    if ( node->has_flip_mask() ) {
-      auto flip_mask = mFlipMaskArray[node->id()];
+    auto id = node->id();
+    auto old_val = mValArray[id];
+    auto new_val = merge_val(old_val, calc_val(node, mValArray), ~obs);
+    if ( mFlipFlagArray[id] ) {
+      auto flip_mask = mFlipMaskArray[id];
       new_val ^= flip_mask;
-      node->set_val(new_val);
     }
+    mValArray[id] = new_val;
     if ( new_val != old_val ) {
       add_to_clear_list(node, old_val);
       if ( node->is_output() || node == target ) {
@@ -134,14 +172,13 @@ EventQ::simulate(SimNode* target)
   // 今の故障シミュレーションで値の変わったノードを元にもどしておく
   for ( auto i: Range(0, mClearPos) ) {
     auto& rinfo = mClearArray[i];
-    auto node = rinfo.mNode;
-    node->set_val(rinfo.mVal);
+    mValArray[rinfo.mId] = rinfo.mVal;
   }
   mClearPos = 0;
 
   for ( auto i: Range(0, mMaskPos) ) {
     auto node = mMaskList[i];
-    node->clear_flip();
+    mFlipFlagArray[node->id()] = false;
   }
   mMaskPos = 0;
 
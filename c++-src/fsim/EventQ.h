@@ -11,6 +11,10 @@
 
 #include "fsim_nsdef.h"
 #include "SimNode.h"
+#include "PackedVal.h"
+#include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
 #include "ym/Range.h"
 
 
@@ -22,7 +26,11 @@ BEGIN_NAMESPACE_SATPG_FSIM
 ///
 /// キューに詰まれる要素は SimNode で，各々のノードはレベルを持つ．
 /// このキューではレベルの小さい順に処理してゆく．同じレベルのノード
-/// 間の順序は任意でよい．
+/// 間の順序は任意でよい．<br>
+/// SimNode は複数の故障シミュレータで共有されるので，キューのリンクや
+/// 反転マスクの印はノード番号をキーにした自身の配列に持つ．
+/// 値は init() で渡された故障シミュレータの値の配列を直接書き換え，
+/// simulate() の最後に元に戻す．
 //////////////////////////////////////////////////////////////////////
 class EventQ
 {
@@ -43,17 +51,19 @@ public:
   /// @brief 初期化を行う．
   /// @param[in] max_level 最大レベル
   /// @param[in] node_num ノード数
+  /// @param[in] val_array ノード番号をキーにした値の配列
   void
   init(int max_level,
-       int node_num);
+       int node_num,
+       FSIM_VALTYPE* val_array);
 
   /// @brief 初期イベントを追加する．
   /// @param[in] node 対象のノード
   /// @param[in] valmask 反転マスク
   /// @param[in] immediate 反転マスクをすぐに適用する時に true にする．
   void
-  put_trigger(SimNode* node,
-	      PackedVal valmask,
+  put_trigger(const SimNode* node,
+	      FSIM_PVTYPE valmask,
 	      bool immediate);
 
   /// @brief イベントドリブンシミュレーションを行う．
@@ -63,8 +73,8 @@ public:
   /// target が nullptr でない時にはイベントが target まで到達したら
   /// シミュレーションを終える．
   /// target が nullptr の時には出力ノードまでイベントを伝える．
-  PackedVal
-  simulate(SimNode* target = nullptr);
+  FSIM_PVTYPE
+  simulate(const SimNode* target = nullptr);
 
 
 private:
@@ -75,31 +85,31 @@ private:
   /// @brief ファンアウトのノードをキューに積む．
   /// @param[in] node 対象のノード
   void
-  put_fanouts(SimNode* node);
+  put_fanouts(const SimNode* node);
 
   /// @brief キューに積む
   /// @param[in] node 対象のノード
   void
-  put(SimNode* node);
+  put(const SimNode* node);
 
   /// @brief キューから取り出す．
   /// @retval nullptr キューが空だった．
-  SimNode*
+  const SimNode*
   get();
 
   /// @brief clear リストに追加する．
   /// @param[in] node 対象のノード
   /// @param[in] old_val 元の値
   void
-  add_to_clear_list(SimNode* node,
+  add_to_clear_list(const SimNode* node,
 		    FSIM_VALTYPE old_val);
 
   /// @brief 反転フラグをセットする．
   /// @param[in] node 対象のノード
   /// @param[in] flip_mask 反転マスク
   void
-  set_flip_mask(SimNode* node,
-		PackedVal flip_mask);
+  set_flip_mask(const SimNode* node,
+		FSIM_PVTYPE flip_mask);
 
 
 private:
@@ -110,8 +120,8 @@ private:
   // 値を元に戻すための構造体
   struct RestoreInfo
   {
-    // ノード
-    SimNode* mNode;
+    // ノード番号
+    int mId;
 
     // 元の値
     FSIM_VALTYPE mVal;
@@ -127,7 +137,7 @@ private:
   int mArraySize;
 
   // キューの先頭ノードの配列
-  SimNode** mArray;
+  const SimNode** mArray;
 
   // 現在のレベル．
   int mCurLevel;
@@ -138,6 +148,22 @@ private:
   // mCearArray のサイズ
   int mClearArraySize;
 
+  // ノード番号をキーにした値の配列
+  // 故障シミュレータが持っているものを借りている．
+  FSIM_VALTYPE* mValArray;
+
+  // ノード番号をキーにしてキューの次の要素を納める配列
+  // サイズは mClearArraySize と同じ
+  const SimNode** mLinkArray;
+
+  // ノード番号をキーにしてキューに入っているかどうかを表す配列
+  // サイズは mClearArraySize と同じ
+  bool* mQueueFlagArray;
+
+  // ノード番号をキーにして反転マスクを持っているかどうかを表す配列
+  // サイズは mClearArraySize と同じ
+  bool* mFlipFlagArray;
+
   // clear 用の情報の配列
   RestoreInfo* mClearArray;
 
@@ -146,11 +172,11 @@ private:
 
   // 反転マスクの配列
   // サイズは mClearArraySize と同じ
-  PackedVal* mFlipMaskArray;
+  FSIM_PVTYPE* mFlipMaskArray;
 
   // 反転マスクをセットしたノードのリスト
-  // 仕様上 kPvBitLen が最大
-  SimNode* mMaskList[kPvBitLen];
+  // 仕様上 FSIM_PV_BITLEN が最大
+  const SimNode* mMaskList[FSIM_PV_BITLEN];
 
   // mMaskList の最後の要素位置
   int mMaskPos;
@@ -166,7 +192,7 @@ private:
 // @param[in] node 対象のノード
 inline
 void
-EventQ::put_fanouts(SimNode* node)
+EventQ::put_fanouts(const SimNode* node)
 {
   auto no = node->fanout_num();
   if ( no == 1 ) {
@@ -182,13 +208,14 @@ EventQ::put_fanouts(SimNode* node)
 // @brief キューに積む
 inline
 void
-EventQ::put(SimNode* node)
+EventQ::put(const SimNode* node)
 {
-  if ( !node->in_queue() ) {
-    node->set_queue();
+  auto id = node->id();
+  if ( !mQueueFlagArray[id] ) {
+    mQueueFlagArray[id] = true;
     auto level = node->level();
     auto& w = mArray[level];
-    node->mLink = w;
+    mLinkArray[id] = w;
     w = node;
     if ( mNum == 0 || mCurLevel > level ) {
       mCurLevel = level;
@@ -200,7 +227,7 @@ EventQ::put(SimNode* node)
 // @brief キューから取り出す．
 // @retval nullptr キューが空だった．
 inline
-SimNode*
+const SimNode*
 EventQ::get()
 {
   if ( mNum > 0 ) {
@@ -209,8 +236,9 @@ EventQ::get()
       auto& w = mArray[mCurLevel];
       auto node = w;
       if ( node != nullptr ) {
-	node->clear_queue();
-	w = node->mLink;
+	auto id = node->id();
+	mQueueFlagArray[id] = false;
+	w = mLinkArray[id];
 	-- mNum;
 	return node;
       }
@@ -224,11 +252,11 @@ EventQ::get()
 // @param[in] old_val 元の値
 inline
 void
-EventQ::add_to_clear_list(SimNode* node,
+EventQ::add_to_clear_list(const SimNode* node,
 			  FSIM_VALTYPE old_val)
 {
   auto& rinfo = mClearArray[mClearPos];
-  rinfo.mNode = node;
+  rinfo.mId = node->id();
   rinfo.mVal = old_val;
   ++ mClearPos;
 }
@@ -238,10 +266,10 @@ EventQ::add_to_clear_list(SimNode* node,
 // @param[in] flip_mask 反転マスク
 inline
 void
-EventQ::set_flip_mask(SimNode* node,
-		      PackedVal flip_mask)
+EventQ::set_flip_mask(const SimNode* node,
+		      FSIM_PVTYPE flip_mask)
 {
-  node->set_flip();
+  mFlipFlagArray[node->id()] = true;
   mFlipMaskArray[node->id()] = flip_mask;
   mMaskList[mMaskPos] = node;
   ++ mMaskPos;
@@ -9,25 +9,32 @@
 
 #include "Fsim.h"
 #include "FsimImpl.h"
+#include "SimTopology.h"
 #include "TestVector.h"
+#include "TpgFault.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
 
 namespace nsFsimSa2 {
-  std::unique_ptr<FsimImpl> new_Fsim(const TpgNetwork& network);
+  std::unique_ptr<FsimImpl> new_Fsim(const std::shared_ptr<const SimTopology>& topology,
+				     bool compiled_gval);
 }
 
 namespace nsFsimSa3 {
-  std::unique_ptr<FsimImpl> new_Fsim(const TpgNetwork& network);
+  std::unique_ptr<FsimImpl> new_Fsim(const std::shared_ptr<const SimTopology>& topology,
+				     bool compiled_gval);
 }
 
 namespace nsFsimTd2 {
-  std::unique_ptr<FsimImpl> new_Fsim(const TpgNetwork& network);
+  std::unique_ptr<FsimImpl> new_Fsim(const std::shared_ptr<const SimTopology>& topology,
+				     bool compiled_gval);
 }
 
 namespace nsFsimTd3 {
-  std::unique_ptr<FsimImpl> new_Fsim(const TpgNetwork& network);
+  std::unique_ptr<FsimImpl> new_Fsim(const std::shared_ptr<const SimTopology>& topology,
+				     bool compiled_gval);
 }
 
 
@@ -38,7 +45,9 @@ namespace nsFsimTd3 {
 // @brief 空のコンストラクタ
 //
 // 内容は不定
-Fsim::Fsim()
+Fsim::Fsim() :
+  mThreadNum(1),
+  mConcurrent(false)
 {
 }
 
@@ -50,33 +59,77 @@ Fsim::~Fsim()
 // @brief 2値の故障シミュレータとして初期化する．
 // @param[in] network ネットワーク
 // @param[in] fault_type 故障の型
+// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
 void
 Fsim::init_fsim2(const TpgNetwork& network,
-		 FaultType fault_type)
+		 FaultType fault_type,
+		 bool compiled_gval)
+{
+  init_fsim2(make_topology(network), fault_type, compiled_gval);
+}
+
+// @brief 3値の故障シミュレータとして初期化する．
+// @param[in] network ネットワーク
+// @param[in] fault_type 故障の型
+// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+void
+Fsim::init_fsim3(const TpgNetwork& network,
+		 FaultType fault_type,
+		 bool compiled_gval)
+{
+  init_fsim3(make_topology(network), fault_type, compiled_gval);
+}
+
+// @brief 故障シミュレータ用の回路構造を作る．
+// @param[in] network ネットワーク
+std::shared_ptr<const SimTopology>
+Fsim::make_topology(const TpgNetwork& network)
+{
+  return std::make_shared<const SimTopology>(network);
+}
+
+// @brief 共有された回路構造を用いて2値の故障シミュレータとして初期化する．
+// @param[in] topology make_topology() で作った回路構造
+// @param[in] fault_type 故障の型
+// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+void
+Fsim::init_fsim2(const std::shared_ptr<const SimTopology>& topology,
+		 FaultType fault_type,
+		 bool compiled_gval)
 {
   if ( fault_type == FaultType::StuckAt ) {
-    mImpl = nsFsimSa2::new_Fsim(network);
+    mImpl = nsFsimSa2::new_Fsim(topology, compiled_gval);
+    mImpl->set_thread_num(mThreadNum);
+    mImpl->set_concurrent(mConcurrent);
   }
   else if ( fault_type == FaultType::TransitionDelay ) {
-    mImpl = nsFsimTd2::new_Fsim(network);
+    mImpl = nsFsimTd2::new_Fsim(topology, compiled_gval);
+    mImpl->set_thread_num(mThreadNum);
+    mImpl->set_concurrent(mConcurrent);
   }
   else {
     ASSERT_NOT_REACHED;
   }
 }
 
-// @brief 3値の故障シミュレータとして初期化する．
-// @param[in] network ネットワーク
+// @brief 共有された回路構造を用いて3値の故障シミュレータとして初期化する．
+// @param[in] topology make_topology() で作った回路構造
 // @param[in] fault_type 故障の型
+// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
 void
-Fsim::init_fsim3(const TpgNetwork& network,
-		 FaultType fault_type)
+Fsim::init_fsim3(const std::shared_ptr<const SimTopology>& topology,
+		 FaultType fault_type,
+		 bool compiled_gval)
 {
   if ( fault_type == FaultType::StuckAt ) {
-    mImpl = nsFsimSa3::new_Fsim(network);
+    mImpl = nsFsimSa3::new_Fsim(topology, compiled_gval);
+    mImpl->set_thread_num(mThreadNum);
+    mImpl->set_concurrent(mConcurrent);
   }
   else if ( fault_type == FaultType::TransitionDelay ) {
-    mImpl = nsFsimTd3::new_Fsim(network);
+    mImpl = nsFsimTd3::new_Fsim(topology, compiled_gval);
+    mImpl->set_thread_num(mThreadNum);
+    mImpl->set_concurrent(mConcurrent);
   }
   else {
     ASSERT_NOT_REACHED;
@@ -147,6 +200,100 @@ Fsim::clear_skip(const vector<const TpgFault*>& fault_list)
   }
 }
 
+// @brief ppsfp で用いるスレッド数を設定する．
+// @param[in] num スレッド数 ( num >= 1 )
+void
+Fsim::set_thread_num(int num)
+{
+  ASSERT_COND( num >= 1 );
+
+  mThreadNum = num;
+  if ( mImpl ) {
+    mImpl->set_thread_num(num);
+  }
+}
+
+// @brief ppsfp で用いるスレッド数を返す．
+int
+Fsim::thread_num() const
+{
+  return mThreadNum;
+}
+
+// @brief sppfp を並行故障シミュレーションで行うかどうかを設定する．
+// @param[in] flag true の時並行故障シミュレーションを用いる．
+void
+Fsim::set_concurrent(bool flag)
+{
+  mConcurrent = flag;
+  if ( mImpl ) {
+    mImpl->set_concurrent(flag);
+  }
+}
+
+// @brief sppfp を並行故障シミュレーションで行う時 true を返す．
+bool
+Fsim::concurrent() const
+{
+  return mConcurrent;
+}
+
+// @brief 全ての故障の目標検出回数を設定する．
+// @param[in] target 目標検出回数
+void
+Fsim::set_det_target(int target)
+{
+  if ( mImpl ) {
+    mImpl->set_det_target(target);
+  }
+}
+
+// @brief 故障の目標検出回数を設定する．
+// @param[in] f 対象の故障
+// @param[in] target 目標検出回数
+void
+Fsim::set_det_target(const TpgFault* f,
+		     int target)
+{
+  if ( mImpl ) {
+    mImpl->set_det_target(f, target);
+  }
+}
+
+// @brief 全ての故障の検出回数を0にする．
+void
+Fsim::clear_det_count()
+{
+  if ( mImpl ) {
+    mImpl->clear_det_count();
+  }
+}
+
+// @brief 故障の検出回数を返す．
+// @param[in] f 対象の故障
+int
+Fsim::det_count(const TpgFault* f)
+{
+  if ( mImpl ) {
+    return mImpl->det_count(f);
+  }
+  else {
+    return 0;
+  }
+}
+
+// @brief 検出回数のヒストグラムを返す．
+vector<int>
+Fsim::det_count_histogram()
+{
+  if ( mImpl ) {
+    return mImpl->det_count_histogram();
+  }
+  else {
+    return vector<int>();
+  }
+}
+
 // @brief SPSFP故障シミュレーションを行う．
 // @param[in] tv テストベクタ
 // @param[in] f 対象の故障
@@ -229,11 +376,89 @@ Fsim::ppsfp()
   }
 }
 
+// @brief 複数のパタンで故障シミュレーションを行い結果を sink に送る．
+// @param[in] tv_list テストベクタのリスト
+// @param[in] sink 故障とそれを検出したパタン番号を受け取る関数
+// @param[in] ndet 故障をドロップするまでの検出回数
+// @return sink に送った (故障, パタン番号) の組の数を返す．
+int
+Fsim::grade(const vector<TestVector>& tv_list,
+	    const std::function<void(const TpgFault*, int)>& sink,
+	    int ndet)
+{
+  if ( !mImpl ) {
+    return 0;
+  }
+
+  // 検出回数は det_count() と同じカウンタを用いる．
+  // 目標検出回数に達した故障には _fault_sweep() でスキップマークがつく．
+  // 呼び出し側のスキップマークと目標検出回数は最後に元に戻す．
+  mImpl->save_fault_state();
+  mImpl->set_det_target(ndet);
+  mImpl->clear_det_count();
+
+  int bitlen = mImpl->pv_bitlen();
+  int tv_num = tv_list.size();
+  int n_pair = 0;
+  for ( int tv_base = 0; tv_base < tv_num; tv_base += bitlen ) {
+    int num = std::min(bitlen, tv_num - tv_base);
+    mImpl->clear_patterns();
+    for ( auto i: Range(num) ) {
+      mImpl->set_pattern(i, tv_list[tv_base + i]);
+    }
+    int nd = mImpl->ppsfp();
+    for ( auto i: Range(nd) ) {
+      auto f = mImpl->det_fault(i);
+      // このブロックで sink に送ってよい検出回数を求める．
+      // det_count() にはこのブロックの分がすでに加算されている．
+      int rest = -1;
+      if ( ndet > 0 ) {
+	int block_count = 0;
+	for ( int base = 0; base < num; base += kPvBitLen ) {
+	  block_count += count_ones(mImpl->det_fault_pat(i, base / kPvBitLen));
+	}
+	rest = std::max(0, ndet - (mImpl->det_count(f) - block_count));
+      }
+      for ( int base = 0; base < num && rest != 0; base += kPvBitLen ) {
+	auto dbits = mImpl->det_fault_pat(i, base / kPvBitLen);
+	for ( ; dbits != kPvAll0 && rest != 0; dbits &= (dbits - 1) ) {
+	  // 最下位の1のビット位置
+	  int bit = count_ones((dbits & ~(dbits - 1)) - 1);
+	  sink(f, tv_base + base + bit);
+	  ++ n_pair;
+	  if ( rest > 0 ) {
+	    -- rest;
+	  }
+	}
+      }
+    }
+  }
+  mImpl->clear_patterns();
+  mImpl->restore_fault_state();
+
+  return n_pair;
+}
+
+// @brief 複数のパタンで故障シミュレーションを行い結果をリストに追加する．
+// @param[in] tv_list テストベクタのリスト
+// @param[out] det_list 故障とそれを検出したパタン番号の組を追加するリスト
+// @param[in] ndet 故障をドロップするまでの検出回数
+// @return det_list に追加した要素数を返す．
+int
+Fsim::grade(const vector<TestVector>& tv_list,
+	    vector<pair<const TpgFault*, int>>& det_list,
+	    int ndet)
+{
+  return grade(tv_list,
+	       [&det_list](const TpgFault* f, int pat_id) {
+		 det_list.push_back(make_pair(f, pat_id));
+	       },
+	       ndet);
+}
+
 // @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
 // @param[in] tv テストベクタ
 //
-// - 外部入力以外は無視する．
-// - 時刻1の割り当ても無視する
 // weightedの意味は以下の通り
 // - false: ゲートの出力の遷移回数の和
 // - true : ゲートの出力の遷移回数に(ファンアウト数＋１)を掛けたものの和
@@ -249,6 +474,24 @@ Fsim::calc_wsa(const TestVector& tv,
   }
 }
 
+// @brief 複数のテストベクタの遷移回数をまとめて数える．
+// @param[in] tv_list テストベクタのリスト
+// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+// @param[out] wsa_list tv_list の各要素の遷移回数を納めるリスト
+void
+Fsim::calc_wsa(const vector<TestVector>& tv_list,
+	       bool weighted,
+	       vector<int>& wsa_list)
+{
+  if ( mImpl ) {
+    mImpl->calc_wsa(tv_list, weighted, wsa_list);
+  }
+  else {
+    wsa_list.clear();
+    wsa_list.resize(tv_list.size(), 0);
+  }
+}
+
 // @brief 状態を設定する．
 // @param[in] i_vect 外部入力のビットベクタ
 // @param[in] f_vect FFの値のビットベクタ
@@ -287,6 +530,34 @@ Fsim::calc_wsa(const InputVector& i_vect,
   }
 }
 
+// @brief 順序回路の故障シミュレーションを行う．
+// @param[in] init_state FFの初期値のビットベクタ
+// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+// @return 検出された故障数を返す．
+int
+Fsim::seqsim(const DffVector& init_state,
+	     const vector<InputVector>& input_list)
+{
+  if ( mImpl ) {
+    return mImpl->seqsim(init_state, input_list);
+  }
+  else {
+    return 0;
+  }
+}
+
+// @brief ppsfp で同時に扱えるパタン数を返す．
+int
+Fsim::pv_bitlen() const
+{
+  if ( mImpl ) {
+    return mImpl->pv_bitlen();
+  }
+  else {
+    return kPvBitLen;
+  }
+}
+
 // @brief ppsfp 用のパタンバッファをクリアする．
 void
 Fsim::clear_patterns()
@@ -297,7 +568,7 @@ Fsim::clear_patterns()
 }
 
 // @brief ppsfp 用のパタンを設定する．
-// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
 // @param[in] tv テストベクタ
 void
 Fsim::set_pattern(int pos,
@@ -309,7 +580,7 @@ Fsim::set_pattern(int pos,
 }
 
 // @brief 設定した ppsfp 用のパタンを読み出す．
-// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
 TestVector
 Fsim::get_pattern(int pos)
 {
@@ -360,11 +631,13 @@ Fsim::det_fault_list()
 
 // @brief 直前の ppsfp で検出された故障の検出ビットパタンを返す．
 // @param[in] pos 位置番号 ( 0 <= pos < det_fault_num() )
+// @param[in] wpos ワード位置 ( 0 <= wpos < pv_bitlen() / kPvBitLen )
 PackedVal
-Fsim::det_fault_pat(int pos)
+Fsim::det_fault_pat(int pos,
+		    int wpos)
 {
   if ( mImpl ) {
-    return mImpl->det_fault_pat(pos);
+    return mImpl->det_fault_pat(pos, wpos);
   }
   else {
     return 0UL;
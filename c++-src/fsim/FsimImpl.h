@@ -71,6 +71,89 @@ public:
   void
   clear_skip(const vector<const TpgFault*>& fault_list);
 
+  /// @brief ppsfp で用いるスレッド数を設定する．
+  /// @param[in] num スレッド数 ( num >= 1 )
+  virtual
+  void
+  set_thread_num(int num) = 0;
+
+  /// @brief ppsfp で用いるスレッド数を返す．
+  virtual
+  int
+  thread_num() const = 0;
+
+  /// @brief sppfp を並行故障シミュレーションで行うかどうかを設定する．
+  /// @param[in] flag true の時並行故障シミュレーションを用いる．
+  virtual
+  void
+  set_concurrent(bool flag) = 0;
+
+  /// @brief sppfp を並行故障シミュレーションで行う時 true を返す．
+  virtual
+  bool
+  concurrent() const = 0;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // N検出用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全ての故障の目標検出回数を設定する．
+  /// @param[in] target 目標検出回数
+  ///
+  /// 検出回数が target に達した故障には自動的にスキップマークがつけられる．
+  /// target = 0 の場合は自動的にスキップマークをつけない．
+  virtual
+  void
+  set_det_target(int target) = 0;
+
+  /// @brief 故障の目標検出回数を設定する．
+  /// @param[in] f 対象の故障
+  /// @param[in] target 目標検出回数
+  virtual
+  void
+  set_det_target(const TpgFault* f,
+		 int target) = 0;
+
+  /// @brief 全ての故障の検出回数を0にする．
+  virtual
+  void
+  clear_det_count() = 0;
+
+  /// @brief 故障の検出回数を返す．
+  /// @param[in] f 対象の故障
+  ///
+  /// sppfp() では1回，ppsfp() では検出したパタン数だけ加算される．
+  virtual
+  int
+  det_count(const TpgFault* f) = 0;
+
+  /// @brief 検出回数のヒストグラムを返す．
+  ///
+  /// 返り値の k 番目の要素は検出回数が k の故障数となる．
+  /// スキップマークのついている故障も含む．
+  virtual
+  vector<int>
+  det_count_histogram() = 0;
+
+  /// @brief 全ての故障のスキップマークと目標検出回数を退避する．
+  ///
+  /// 退避できるのは1組だけで，再度呼ぶと上書きされる．
+  /// 退避している間に set_skip() などで明示的に変更したスキップマークは
+  /// 退避した内容にも反映される．目標検出回数に達してついた
+  /// スキップマークは反映されない．
+  virtual
+  void
+  save_fault_state() = 0;
+
+  /// @brief save_fault_state() で退避したスキップマークと目標検出回数を戻す．
+  ///
+  /// 検出回数は戻さない．
+  virtual
+  void
+  restore_fault_state() = 0;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -133,8 +216,6 @@ public:
   /// @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
   /// @param[in] tv テストベクタ
   ///
-  /// - 外部入力以外は無視する．
-  /// - 時刻1の割り当ても無視する
   /// weightedの意味は以下の通り
   /// - false: ゲートの出力の遷移回数の和
   /// - true : ゲートの出力の遷移回数に(ファンアウト数＋１)を掛けたものの和
@@ -143,6 +224,16 @@ public:
   calc_wsa(const TestVector& tv,
 	   bool weighted) = 0;
 
+  /// @brief 複数のテストベクタの遷移回数をまとめて数える．
+  /// @param[in] tv_list テストベクタのリスト
+  /// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+  /// @param[out] wsa_list tv_list の各要素の遷移回数を納めるリスト
+  virtual
+  void
+  calc_wsa(const vector<TestVector>& tv_list,
+	   bool weighted,
+	   vector<int>& wsa_list) = 0;
+
   /// @brief 状態を設定する．
   /// @param[in] i_vect 外部入力のビットベクタ
   /// @param[in] f_vect FFの値のビットベクタ
@@ -166,19 +257,35 @@ public:
   calc_wsa(const InputVector& i_vect,
 	   bool weighted) = 0;
 
+  /// @brief 順序回路の故障シミュレーションを行う．
+  /// @param[in] init_state FFの初期値のビットベクタ
+  /// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+  /// @return 検出された故障数を返す．
+  virtual
+  int
+  seqsim(const DffVector& init_state,
+	 const vector<InputVector>& input_list) = 0;
+
 
 public:
   //////////////////////////////////////////////////////////////////////
   // ppsfp のテストパタンを設定する関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ppsfp で同時に扱えるパタン数を返す．
+  ///
+  /// kPvBitLen の倍数となる．
+  virtual
+  int
+  pv_bitlen() const = 0;
+
   /// @brief ppsfp 用のパタンバッファをクリアする．
   virtual
   void
   clear_patterns() = 0;
 
   /// @brief ppsfp 用のパタンを設定する．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
   /// @param[in] tv テストベクタ
   virtual
   void
@@ -186,7 +293,7 @@ public:
 	      const TestVector& tv) = 0;
 
   /// @brief 設定した ppsfp 用のパタンを読み出す．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
   virtual
   TestVector
   get_pattern(int pos) = 0;
@@ -215,11 +322,15 @@ public:
 
   /// @brief 直前の ppsfp で検出された故障の検出ビットパタンを返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < det_fault_num() )
+  /// @param[in] wpos ワード位置 ( 0 <= wpos < pv_bitlen() / kPvBitLen )
   virtual
   PackedVal
-  det_fault_pat(int pos) = 0;
+  det_fault_pat(int pos,
+		int wpos) = 0;
 
   /// @brief 直前の ppsfp で検出された故障に対する検出パタンのリストを返す．
+  ///
+  /// 1つの故障につき pv_bitlen() / kPvBitLen ワードずつ並んでいる．
   virtual
   Array<PackedVal>
   det_fault_pat_list() = 0;
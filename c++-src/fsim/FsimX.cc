@@ -23,17 +23,19 @@
 
 #include "SimNode.h"
 #include "SimFFR.h"
+#include "SimEval.h"
 #include "InputVals.h"
 
-#include "ym/HashSet.h"
 #include "ym/Range.h"
-#include "ym/StopWatch.h"
 
 
 BEGIN_NAMESPACE_SATPG_FSIM
 
 BEGIN_NONAMESPACE
 
+// _ppsfp_mt() で一度にスレッドに割り当てる FFR 数
+const int kFFRChunkSize = 64;
+
 // Val3 を PackedVal/PackedVal3 に変換する．
 inline
 FSIM_VALTYPE
@@ -41,12 +43,12 @@ val3_to_packedval(Val3 val)
 {
 #if FSIM_VAL2
   // kValX は kVal0 とみなす．
-  return (val == Val3::_1) ? kPvAll1 : kPvAll0;
+  return (val == Val3::_1) ? FSIM_PV_ALL1 : FSIM_PV_ALL0;
 #elif FSIM_VAL3
   switch ( val ) {
-  case Val3::_X: return PackedVal3(kPvAll0, kPvAll0);
-  case Val3::_0: return PackedVal3(kPvAll1, kPvAll0);
-  case Val3::_1: return PackedVal3(kPvAll0, kPvAll1);
+  case Val3::_X: return FSIM_VALTYPE(FSIM_PV_ALL0, FSIM_PV_ALL0);
+  case Val3::_0: return FSIM_VALTYPE(FSIM_PV_ALL1, FSIM_PV_ALL0);
+  case Val3::_1: return FSIM_VALTYPE(FSIM_PV_ALL0, FSIM_PV_ALL1);
   }
 #endif
 }
@@ -58,12 +60,12 @@ Val3
 packedval_to_val3(FSIM_VALTYPE pval)
 {
 #if FSIM_VAL2
-  return (pval & 1UL) ? Val3::_1 : Val3::_0;
+  return get_bit(pval, 0) ? Val3::_1 : Val3::_0;
 #elif FSIM_VAL3
-  if ( pval.val0() & 1UL) {
+  if ( get_bit(pval.val0(), 0) ) {
     return Val3::_0;
   }
-  else if ( pval.val1() & 1UL ) {
+  else if ( get_bit(pval.val1(), 0) ) {
     return Val3::_1;
   }
   else {
@@ -72,223 +74,177 @@ packedval_to_val3(FSIM_VALTYPE pval)
 #endif
 }
 
-END_NONAMESPACE
-
-std::unique_ptr<FsimImpl>
-new_Fsim(const TpgNetwork& network)
+// val のうち mask0 のビットを 0 に，mask1 のビットを 1 にする．
+inline
+FSIM_VALTYPE
+inject_val(FSIM_VALTYPE val,
+	   FSIM_PVTYPE mask0,
+	   FSIM_PVTYPE mask1)
 {
-  return static_cast<std::unique_ptr<FsimImpl>>(new FSIM_CLASSNAME(network));
+#if FSIM_VAL2
+  return (val & ~(mask0 | mask1)) | mask1;
+#elif FSIM_VAL3
+  val.set_with_mask(FSIM_VALTYPE(mask0, mask1), mask0 | mask1);
+  return val;
+#endif
 }
 
+// seqsim で故障を注入する箇所を表す構造体
+struct SeqInject
+{
+  // 対象のノード
+  const SimNode* mNode;
 
-//////////////////////////////////////////////////////////////////////
-// FsimX
-//////////////////////////////////////////////////////////////////////
+  // 入力の故障の場合の入力位置
+  // 出力の故障の場合は -1
+  int mIpos;
 
-// @brief コンストラクタ
-// @param[in] network ネットワーク
-FSIM_CLASSNAME::FSIM_CLASSNAME(const TpgNetwork& network)
-{
-  mPatMap = kPvAll0;
-  mPPIArray = nullptr;
-  mPPOArray = nullptr;
-  mPrevValArray = nullptr;
-  mFFRArray = nullptr;
-  mFFRMap = nullptr;
-  mSimFaults = nullptr;
-  mFaultArray = nullptr;
-  mDetFaultArray = nullptr;
-  mDetPatArray = nullptr;
+  // 0 に固定するビットのマスク
+  FSIM_PVTYPE mMask0;
 
-  set_network(network);
-}
+  // 1 に固定するビットのマスク
+  FSIM_PVTYPE mMask1;
+};
 
-// @brief デストラクタ
-FSIM_CLASSNAME::~FSIM_CLASSNAME()
+// 2つの値の間で遷移したビットに1を立てたビットベクタを返す．
+// FSIM_VAL3 の場合，どちらかが X のビットは遷移していないとみなす．
+inline
+FSIM_PVTYPE
+toggle_bits(FSIM_VALTYPE val1,
+	    FSIM_VALTYPE val2)
 {
-  clear();
+#if FSIM_VAL2
+  return val1 ^ val2;
+#elif FSIM_VAL3
+  return (val1.val0() & val2.val1()) | (val1.val1() & val2.val0());
+#endif
 }
 
-// @brief ネットワークをセットする関数
-// @param[in] network ネットワーク
-void
-FSIM_CLASSNAME::set_network(const TpgNetwork& network)
-{
-  mInputNum = network.input_num();
-  mOutputNum = network.output_num();
-  mDffNum = network.dff_num();
-
-  auto nn = network.node_num();
-  auto ni = network.ppi_num();
-  auto no = network.ppo_num();
-
-  ASSERT_COND( ni == mInputNum + mDffNum );
-  ASSERT_COND( no == mOutputNum + mDffNum );
-
-  // 対応付けを行うマップの初期化
-  vector<SimNode*> simmap(nn);
-
-  mPPIArray = new SimNode*[ni];
-  mPPOArray = new SimNode*[no];
-  mPrevValArray = new FSIM_VALTYPE[nn];
-
-  auto nf = 0;
-  for ( auto tpgnode: network.node_list() ) {
-    nf += network.node_rep_fault_num(tpgnode->id());
-
-    SimNode* node = nullptr;
-
-    if ( tpgnode->is_ppi() ) {
-      // 外部入力に対応する SimNode の生成
-      node = make_input();
-      mPPIArray[tpgnode->input_id()] = node;
-    }
-    else if ( tpgnode->is_ppo() ) {
-      // 外部出力に対応する SimNode の生成
-      auto inode = simmap[tpgnode->fanin(0)->id()];
-      // 実際にはバッファタイプのノードに出力の印をつけるだけ．
-      node = make_gate(GateType::Buff, vector<SimNode*>(1, inode));
-      node->set_output();
-      mPPOArray[tpgnode->output_id()] = node;
-    }
-    else if ( tpgnode->is_dff_clock() ||
-	      tpgnode->is_dff_clear() ||
-	      tpgnode->is_dff_preset() ) {
-      // DFFの制御端子に対応する SimNode の生成
-      auto inode = simmap[tpgnode->fanin(0)->id()];
-      // 実際にはバッファタイプのノードに出力の印をつけるだけ．
-      node = make_gate(GateType::Buff, vector<SimNode*>(1, inode));
-      node->set_output();
-    }
-    else if ( tpgnode->is_logic() ) {
-      // 論理ノードに対する SimNode の作成
-      auto ni = tpgnode->fanin_num();
-
-      // ファンインに対応する SimNode を探す．
-      vector<SimNode*> inputs;
-      inputs.reserve(ni);
-      for ( auto itpgnode: tpgnode->fanin_list() ) {
-	auto inode = simmap[itpgnode->id()];
-	ASSERT_COND( inode != nullptr);
-
-	inputs.push_back(inode);
+// ビットごとのカウンタをビットスライス形式で表す構造体
+//
+// mPlanes[i] の各ビットがそのビット位置のカウンタの 2^i の桁を表す．
+// 全ビット分の加算を桁数回のビット演算で行うことができる．
+struct BitSliceCounter
+{
+  // mask のビット位置のカウンタに w を足す．
+  void
+  add(FSIM_PVTYPE mask,
+      int w)
+  {
+    for ( int i = 0; w > 0; ++ i, w >>= 1 ) {
+      if ( (w & 1) == 0 ) {
+	continue;
+      }
+      // i 桁目から繰り上がりを伝搬させる．
+      auto carry = mask;
+      for ( int j = i; carry != FSIM_PV_ALL0; ++ j ) {
+	// w の下位桁が 0 の場合は i が現在の桁数を超えていることがある．
+	while ( j >= static_cast<int>(mPlanes.size()) ) {
+	  mPlanes.push_back(FSIM_PV_ALL0);
+	}
+	auto tmp = mPlanes[j] & carry;
+	mPlanes[j] ^= carry;
+	carry = tmp;
       }
-
-      // 出力の論理を表す SimNode を作る．
-      auto type = tpgnode->gate_type();
-      node = make_gate(type, inputs);
     }
-    // 対応表に登録しておく．
-    simmap[tpgnode->id()] = node;
   }
 
-  // 各ノードのファンアウトリストの設定
-  auto node_num = mNodeArray.size();
+  // bit 番目のカウンタの値を返す．
+  int
+  count(int bit) const
   {
-    vector<vector<SimNode*> > fanout_lists(node_num);
-    vector<int> ipos(node_num);
-    for ( auto node: mNodeArray ) {
-      auto ni = node->fanin_num();
-      for ( auto i: Range(0, ni) ) {
-	auto inode = node->fanin(i);
-	fanout_lists[inode->id()].push_back(node);
-	ipos[inode->id()] = i;
+    int c = 0;
+    for ( auto i: Range(mPlanes.size()) ) {
+      if ( get_bit(mPlanes[i], bit) ) {
+	c += (1 << i);
       }
     }
-    for ( auto i: Range(node_num) ) {
-      auto node = mNodeArray[i];
-      node->set_fanout_list(fanout_lists[i], ipos[i]);
-    }
+    return c;
   }
 
-  // FFR の設定
-  auto ffr_num = 0;
-  for ( auto node: mNodeArray ) {
-    if ( node->is_output() || node->fanout_num() != 1 ) {
-      ++ ffr_num;
-    }
+  // 各桁のビットベクタ
+  vector<FSIM_PVTYPE> mPlanes;
+};
+
+END_NONAMESPACE
+
+std::unique_ptr<FsimImpl>
+new_Fsim(const std::shared_ptr<const SimTopology>& topology,
+	 bool compiled_gval)
+{
+  return static_cast<std::unique_ptr<FsimImpl>>(new FSIM_CLASSNAME(topology, compiled_gval));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// FsimX
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] topology 回路構造
+// @param[in] compiled_gval 正常値計算に GvalProg を用いる時 true にする．
+FSIM_CLASSNAME::FSIM_CLASSNAME(const std::shared_ptr<const SimTopology>& topology,
+			       bool compiled_gval) :
+  mTopology(topology),
+  mNodeArray(topology->node_list()),
+  mCompiledGval(compiled_gval)
+{
+  mPatMap = FSIM_PV_ALL0;
+  mPatFirstBit = FSIM_PV_BITLEN;
+  mThreadNum = 1;
+  mLocalEventQArray = nullptr;
+  mConcurrent = false;
+
+  auto nn = mNodeArray.size();
+  mValArray = new FSIM_VALTYPE[nn]();
+  mPrevValArray = new FSIM_VALTYPE[nn]();
+  mObsArray = new FSIM_PVTYPE[nn];
+  mFFRObsArray = new FSIM_PVTYPE[mTopology->ffr_num()];
+
+  // 全ての故障のスキップマークはクリアされている．
+  mFaultNum = mTopology->fault_num();
+  mFaultStateArray = new FaultState[mFaultNum];
+  for ( auto i: Range(mFaultNum) ) {
+    auto& state = mFaultStateArray[i];
+    state.mObsMask = FSIM_PV_ALL0;
+    state.mDetCount = 0;
+    state.mDetTarget = 0;
+    state.mSkip = false;
   }
+  mDetFaultArray = new const TpgFault*[mFaultNum];
+  mDetPatArray = new PackedVal[mFaultNum * FSIM_PV_WORDS];
+  mDetNum = 0;
 
-  mFFRNum = ffr_num;
-  mFFRArray = new SimFFR[ffr_num];
-  mFFRMap = new SimFFR*[mNodeArray.size()];
-  ffr_num = 0;
-  for ( int i = node_num; -- i >= 0; ) {
-    auto node = mNodeArray[i];
-    if ( node->is_output() || node->fanout_num() != 1 ) {
-      auto ffr = &mFFRArray[ffr_num];
-      node->set_ffr_root();
-      mFFRMap[node->id()] = ffr;
-      ffr->set_root(node);
-      ++ ffr_num;
-    }
-    else {
-      auto fo_node = node->fanout_top();
-      auto ffr = mFFRMap[fo_node->id()];
-      mFFRMap[node->id()] = ffr;
-    }
-  }
-
-  // 最大レベルを求め，イベントキューを初期化する．
-  auto max_level = 0;
-  for ( auto inode: Array<SimNode*>(mPPOArray, 0, no) ) {
-    if ( max_level < inode->level() ) {
-      max_level = inode->level();
-    }
-  }
-  mEventQ.init(max_level, mNodeArray.size());
-
-
-  //////////////////////////////////////////////////////////////////////
-  // 故障リストの設定
-  //////////////////////////////////////////////////////////////////////
-
-  // 同時に各 SimFFR 内の故障リストも再構築する．
-  mFaultNum = nf;
-  mSimFaults = new SimFault[nf];
-  mFaultArray = new SimFault*[network.max_fault_id()];
-  mDetFaultArray = new const TpgFault*[nf];
-  mDetPatArray = new PackedVal[nf];
-  auto fid = 0;
-  for ( auto tpgnode: network.node_list() ) {
-    auto simnode = simmap[tpgnode->id()];
-    auto ffr = mFFRMap[simnode->id()];
-    auto nf1 = network.node_rep_fault_num(tpgnode->id());
-    for ( auto j: Range(0, nf1) ) {
-      auto fault = network.node_rep_fault(tpgnode->id(), j);
-      SimNode* isimnode = nullptr;
-      int ipos = 0;
-      if ( fault->is_branch_fault() ) {
-	ipos = fault->tpg_pos();
-	auto inode = tpgnode->fanin(ipos);
-	isimnode = simmap[inode->id()];
-      }
-      else {
-	isimnode = simnode;
-      }
-      mSimFaults[fid].set(fault, simnode, ipos, isimnode);
-      auto ff = &mSimFaults[fid];
-      mFaultArray[fault->id()] = ff;
-      ff->mSkip = false;
-      ffr->add_fault(ff);
-      ++ fid;
-    }
+  // イベントキューを初期化する．
+  mEventQ.init(mTopology->max_level(), nn, mValArray);
+
+  // 正常値計算用の命令列を作る．
+  if ( mCompiledGval ) {
+    mGvalProg.compile(mTopology->logic_list());
   }
 }
 
-// @brief FFR のリストを返す．
-Array<SimFFR>
-FSIM_CLASSNAME::_ffr_list() const
+// @brief デストラクタ
+FSIM_CLASSNAME::~FSIM_CLASSNAME()
 {
-  return Array<SimFFR>(mFFRArray, 0, mFFRNum);
+  mWorkerPool.stop();
+  delete [] mLocalEventQArray;
+
+  delete [] mValArray;
+  delete [] mPrevValArray;
+  delete [] mObsArray;
+  delete [] mFFRObsArray;
+  delete [] mFaultStateArray;
+  delete [] mDetFaultArray;
+  delete [] mDetPatArray;
 }
 
 // @brief 全ての故障にスキップマークをつける．
 void
 FSIM_CLASSNAME::set_skip_all()
 {
-  for ( auto& sim_fault: Array<SimFault>(mSimFaults, 0, mFaultNum) ) {
-    sim_fault.mSkip = true;
+  for ( auto i: Range(mFaultNum) ) {
+    _set_skip(i, true);
   }
 }
 
@@ -297,15 +253,15 @@ FSIM_CLASSNAME::set_skip_all()
 void
 FSIM_CLASSNAME::set_skip(const TpgFault* f)
 {
-  mFaultArray[f->id()]->mSkip = true;
+  _set_skip(mTopology->sim_fault(f)->mId, true);
 }
 
 // @brief 全ての故障のスキップマークを消す．
 void
 FSIM_CLASSNAME::clear_skip_all()
 {
-  for ( auto& sim_fault: Array<SimFault>(mSimFaults, 0, mFaultNum) ) {
-    sim_fault.mSkip = false;
+  for ( auto i: Range(mFaultNum) ) {
+    _set_skip(i, false);
   }
 }
 
@@ -314,7 +270,124 @@ FSIM_CLASSNAME::clear_skip_all()
 void
 FSIM_CLASSNAME::clear_skip(const TpgFault* f)
 {
-  mFaultArray[f->id()]->mSkip = false;
+  _set_skip(mTopology->sim_fault(f)->mId, false);
+}
+
+// @brief 全ての故障の目標検出回数を設定する．
+// @param[in] target 目標検出回数
+void
+FSIM_CLASSNAME::set_det_target(int target)
+{
+  ASSERT_COND( target >= 0 );
+
+  for ( auto i: Range(mFaultNum) ) {
+    mFaultStateArray[i].mDetTarget = target;
+  }
+}
+
+// @brief 故障の目標検出回数を設定する．
+// @param[in] f 対象の故障
+// @param[in] target 目標検出回数
+void
+FSIM_CLASSNAME::set_det_target(const TpgFault* f,
+			       int target)
+{
+  ASSERT_COND( target >= 0 );
+
+  mFaultStateArray[mTopology->sim_fault(f)->mId].mDetTarget = target;
+}
+
+// @brief 全ての故障の検出回数を0にする．
+void
+FSIM_CLASSNAME::clear_det_count()
+{
+  for ( auto i: Range(mFaultNum) ) {
+    mFaultStateArray[i].mDetCount = 0;
+  }
+}
+
+// @brief 故障の検出回数を返す．
+// @param[in] f 対象の故障
+int
+FSIM_CLASSNAME::det_count(const TpgFault* f)
+{
+  return mFaultStateArray[mTopology->sim_fault(f)->mId].mDetCount;
+}
+
+// @brief 検出回数のヒストグラムを返す．
+vector<int>
+FSIM_CLASSNAME::det_count_histogram()
+{
+  vector<int> hist;
+  for ( auto i: Range(mFaultNum) ) {
+    int count = mFaultStateArray[i].mDetCount;
+    if ( static_cast<int>(hist.size()) <= count ) {
+      hist.resize(count + 1, 0);
+    }
+    ++ hist[count];
+  }
+  return hist;
+}
+
+// @brief 全ての故障のスキップマークと目標検出回数を退避する．
+void
+FSIM_CLASSNAME::save_fault_state()
+{
+  mSavedStateArray.resize(mFaultNum);
+  for ( auto i: Range(mFaultNum) ) {
+    auto& state = mFaultStateArray[i];
+    mSavedStateArray[i] = make_pair(state.mSkip, state.mDetTarget);
+  }
+}
+
+// @brief save_fault_state() で退避したスキップマークと目標検出回数を戻す．
+void
+FSIM_CLASSNAME::restore_fault_state()
+{
+  ASSERT_COND( static_cast<int>(mSavedStateArray.size()) == mFaultNum );
+
+  for ( auto i: Range(mFaultNum) ) {
+    auto& state = mFaultStateArray[i];
+    state.mSkip = mSavedStateArray[i].first;
+    state.mDetTarget = mSavedStateArray[i].second;
+  }
+  mSavedStateArray.clear();
+}
+
+// @brief ppsfp で用いるスレッド数を設定する．
+// @param[in] num スレッド数 ( num >= 1 )
+void
+FSIM_CLASSNAME::set_thread_num(int num)
+{
+  ASSERT_COND( num >= 1 );
+
+  if ( num == mThreadNum ) {
+    return;
+  }
+
+  mWorkerPool.stop();
+  delete [] mLocalEventQArray;
+  mLocalEventQArray = nullptr;
+  mThreadNum = num;
+  if ( num > 1 ) {
+    mLocalEventQArray = new LocalEventQ[num];
+    for ( auto i: Range(num) ) {
+      mLocalEventQArray[i].init(mTopology->max_level(), mNodeArray.size(), mValArray);
+    }
+    mWorkerPool.start(num);
+  }
+}
+
+// @brief sppfp を並行故障シミュレーションで行うかどうかを設定する．
+// @param[in] flag true の時並行故障シミュレーションを用いる．
+void
+FSIM_CLASSNAME::set_concurrent(bool flag)
+{
+  if ( flag && !mConcurrent ) {
+    mCfsEngine.init(mTopology->max_level(), mNodeArray,
+		    mTopology->fault_array(), mFaultNum, mValArray);
+  }
+  mConcurrent = flag;
 }
 
 // @brief SPSFP故障シミュレーションを行う．
@@ -367,6 +440,9 @@ FSIM_CLASSNAME::sppfp(const TestVector& tv)
   _calc_gval(iv);
 
   // 故障伝搬を行う．
+  if ( mConcurrent ) {
+    return _sppfp_cfs();
+  }
   return _sppfp();
 }
 
@@ -384,6 +460,9 @@ FSIM_CLASSNAME::sppfp(const NodeValList& assign_list)
   _calc_gval(iv);
 
   // 故障伝搬を行う．
+  if ( mConcurrent ) {
+    return _sppfp_cfs();
+  }
   return _sppfp();
 }
 
@@ -395,7 +474,7 @@ FSIM_CLASSNAME::sppfp(const NodeValList& assign_list)
 int
 FSIM_CLASSNAME::ppsfp()
 {
-  if ( mPatMap == kPvAll0 ) {
+  if ( mPatMap == FSIM_PV_ALL0 ) {
     // パタンが一つも設定されていない．
     mDetNum = 0;
     return 0;
@@ -414,21 +493,21 @@ FSIM_CLASSNAME::ppsfp()
 void
 FSIM_CLASSNAME::clear_patterns()
 {
-  mPatMap = kPvAll0;
-  mPatFirstBit = kPvBitLen;
+  mPatMap = FSIM_PV_ALL0;
+  mPatFirstBit = FSIM_PV_BITLEN;
 }
 
 // @brief ppsfp 用のパタンを設定する．
-// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+// @param[in] pos 位置番号 ( 0 <= pos < FSIM_PV_BITLEN )
 // @param[in] tv テストベクタ
 void
 FSIM_CLASSNAME::set_pattern(int pos,
 			    const TestVector& tv)
 {
-  ASSERT_COND( pos >= 0 && pos < kPvBitLen );
+  ASSERT_COND( pos >= 0 && pos < FSIM_PV_BITLEN );
 
   mPatBuff[pos] = tv;
-  mPatMap |= (1ULL << pos);
+  set_bit(mPatMap, pos);
 
   if ( mPatFirstBit > pos ) {
     mPatFirstBit = pos;
@@ -436,12 +515,12 @@ FSIM_CLASSNAME::set_pattern(int pos,
 }
 
 // @brief 設定した ppsfp 用のパタンを読み出す．
-// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+// @param[in] pos 位置番号 ( 0 <= pos < FSIM_PV_BITLEN )
 TestVector
 FSIM_CLASSNAME::get_pattern(int pos)
 {
-  ASSERT_COND( pos >= 0 && pos < kPvBitLen );
-  ASSERT_COND ( mPatMap & (1ULL << pos) );
+  ASSERT_COND( pos >= 0 && pos < FSIM_PV_BITLEN );
+  ASSERT_COND ( get_bit(mPatMap, pos) );
 
   return mPatBuff[pos];
 }
@@ -453,13 +532,13 @@ FSIM_CLASSNAME::get_pattern(int pos)
 bool
 FSIM_CLASSNAME::_spsfp(const TpgFault* f)
 {
-  auto ff = mFaultArray[f->id()];
+  auto ff = mTopology->sim_fault(f);
 
   // FFR の根までの伝搬条件を求める．
   auto obs = _fault_prop(ff);
 
   // obs が 0 ならその後のシミュレーションを行う必要はない．
-  if ( obs == kPvAll0 ) {
+  if ( obs == FSIM_PV_ALL0 ) {
     return false;
   }
 
@@ -467,9 +546,9 @@ FSIM_CLASSNAME::_spsfp(const TpgFault* f)
   auto root = ff->mNode->ffr_root();
 
   // root からの故障伝搬シミュレーションを行う．
-  obs = _prop_sim(root, kPvAll1);
+  obs = _prop_sim(root, FSIM_PV_ALL1);
 
-  return (obs != kPvAll0);
+  return (obs != FSIM_PV_ALL0);
 }
 
 // @brief SPPFP故障シミュレーションの本体
@@ -477,17 +556,18 @@ FSIM_CLASSNAME::_spsfp(const TpgFault* f)
 int
 FSIM_CLASSNAME::_sppfp()
 {
-  const SimFFR* ffr_buff[kPvBitLen];
+  const SimFFR* ffr_buff[FSIM_PV_BITLEN];
 
   mDetNum = 0;
   auto bitpos = 0;
   // FFR ごとに処理を行う．
-  for ( auto& ffr: _ffr_list() ) {
+  for ( auto i: Range(mTopology->ffr_num()) ) {
+    auto& ffr = mTopology->ffr(i);
     // FFR 内の故障伝搬を行う．
-    // 結果は SimFault.mObsMask に保存される．
+    // 結果は FaultState::mObsMask に保存される．
     // FFR 内の全ての obs マスクを ffr_req に入れる．
-    auto ffr_req = _foreach_faults(ffr.fault_list());
-    if ( ffr_req == kPvAll0 ) {
+    auto ffr_req = _foreach_faults(ffr);
+    if ( ffr_req == FSIM_PV_ALL0 ) {
       // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
       continue;
     }
@@ -499,12 +579,13 @@ FSIM_CLASSNAME::_sppfp()
     }
     else {
       // キューに積んでおく
-      PackedVal bitmask = 1ULL << bitpos;
+      auto bitmask = FSIM_PV_ALL0;
+      set_bit(bitmask, bitpos);
       mEventQ.put_trigger(root, bitmask, false);
       ffr_buff[bitpos] = &ffr;
       ++ bitpos;
 
-      if ( bitpos == kPvBitLen ) {
+      if ( bitpos == FSIM_PV_BITLEN ) {
 	_do_simulation(ffr_buff, bitpos);
 	bitpos = 0;
       }
@@ -517,6 +598,40 @@ FSIM_CLASSNAME::_sppfp()
   return mDetNum;
 }
 
+// @brief 並行故障シミュレーションによる SPPFP故障シミュレーションの本体
+// @return 検出された故障数を返す．
+//
+// 正常値は全てのビットが同じ値になっている．
+int
+FSIM_CLASSNAME::_sppfp_cfs()
+{
+  // 活性化された故障を集める．
+  // SimTopology の故障の配列の順に並ぶので CfsEngine の要求を満たしている．
+  mCfsActList.clear();
+  auto fault_array = mTopology->fault_array();
+  for ( auto i: Range(mFaultNum) ) {
+    if ( mFaultStateArray[i].mSkip ) {
+      continue;
+    }
+    auto sim_fault = &fault_array[i];
+    auto act = _fault_act(sim_fault);
+    if ( get_bit(act, 0) ) {
+      mCfsActList.push_back(sim_fault);
+    }
+  }
+
+  mCfsEngine.simulate(mCfsActList, mCfsDetList);
+
+  mDetNum = 0;
+  for ( auto ff: mCfsDetList ) {
+    mDetFaultArray[mDetNum] = ff->mOrigF;
+    ++ mDetNum;
+    _add_det_count(ff, 1);
+  }
+
+  return mDetNum;
+}
+
 // @brief 複数のパタンで故障シミュレーションを行う．
 // @return 検出された故障数を返す．
 //
@@ -525,17 +640,22 @@ FSIM_CLASSNAME::_sppfp()
 int
 FSIM_CLASSNAME::_ppsfp()
 {
+  if ( mThreadNum > 1 ) {
+    return _ppsfp_mt();
+  }
+
   // FFR ごとに処理を行う．
   mDetNum = 0;
-  for ( auto& ffr: _ffr_list() ) {
+  for ( auto i: Range(mTopology->ffr_num()) ) {
+    auto& ffr = mTopology->ffr(i);
     auto& fault_list = ffr.fault_list();
     // FFR 内の故障伝搬を行う．
-    // 結果は SimFault::mObsMask に保存される．
+    // 結果は FaultState::mObsMask に保存される．
     // FFR 内の全ての obs マスクを ffr_req に入れる．
-    auto ffr_req = _foreach_faults(fault_list) & mPatMap;
+    auto ffr_req = _foreach_faults(ffr) & mPatMap;
 
     // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
-    if ( ffr_req == kPvAll0 ) {
+    if ( ffr_req == FSIM_PV_ALL0 ) {
       continue;
     }
 
@@ -548,6 +668,73 @@ FSIM_CLASSNAME::_ppsfp()
   return mDetNum;
 }
 
+// @brief 複数のスレッドを用いた PPSFP故障シミュレーションの本体
+// @return 検出された故障数を返す．
+//
+// 正常値は _calc_gval() で計算済みのものを全スレッドで共有する．
+// 故障値は各スレッドの LocalEventQ が保持する．
+// スレッドは set_thread_num() で生成したものを使い回す．
+int
+FSIM_CLASSNAME::_ppsfp_mt()
+{
+  // 各スレッドは FFR 番号の小さい順に kFFRChunkSize 個ずつ取り出して
+  // 処理を行い，結果を mFFRObsArray に書き込む．
+  std::atomic<int> next_pos(0);
+  mWorkerPool.run([this, &next_pos](int tid) {
+      _ppsfp_worker(tid, next_pos);
+    });
+
+  // 結果を FFR の順にまとめる．
+  // 故障の順序は _ppsfp() と同一になる．
+  mDetNum = 0;
+  for ( auto i: Range(mTopology->ffr_num()) ) {
+    auto obs = mFFRObsArray[i];
+    if ( obs != FSIM_PV_ALL0 ) {
+      _fault_sweep(mTopology->ffr(i).fault_list(), obs);
+    }
+  }
+
+  return mDetNum;
+}
+
+// @brief _ppsfp_mt() のスレッドごとの処理
+// @param[in] tid スレッド番号
+// @param[in] next_pos 次に処理する FFR 番号
+void
+FSIM_CLASSNAME::_ppsfp_worker(int tid,
+			      std::atomic<int>& next_pos)
+{
+  // 正常値は mValArray から必要な分だけ読み出す．
+  auto& eventq = mLocalEventQArray[tid];
+  eventq.update_gval();
+
+  int ffr_num = mTopology->ffr_num();
+  for ( ; ; ) {
+    int start = next_pos.fetch_add(kFFRChunkSize);
+    if ( start >= ffr_num ) {
+      break;
+    }
+    int end = std::min(start + kFFRChunkSize, ffr_num);
+    for ( auto i: Range(start, end) ) {
+      auto& ffr = mTopology->ffr(i);
+      // FFR 内の故障伝搬を行う．
+      // FFR 内のノードと故障は一つのスレッドしか扱わないので
+      // mObsArray と FaultState::mObsMask に書き込んでもよい．
+      auto ffr_req = _foreach_faults(ffr) & mPatMap;
+      if ( ffr_req == FSIM_PV_ALL0 ) {
+	mFFRObsArray[i] = FSIM_PV_ALL0;
+      }
+      else if ( ffr.root()->is_output() ) {
+	// 外部出力の場合は無条件で伝搬している．
+	mFFRObsArray[i] = FSIM_PV_ALL1;
+      }
+      else {
+	mFFRObsArray[i] = eventq.simulate(ffr.root(), ffr_req);
+      }
+    }
+  }
+}
+
 // @brief 状態を設定する．
 // @param[in] i_vect 外部入力のビットベクタ
 // @param[in] f_vect FFの値のビットベクタ
@@ -555,36 +742,22 @@ void
 FSIM_CLASSNAME::set_state(const InputVector& i_vect,
 			  const DffVector& f_vect)
 {
-  int i = 0;
-  for ( auto simnode: input_list() ) {
+  auto ni = mTopology->input_num();
+  for ( auto i: Range(ni) ) {
     auto val3 = i_vect.val(i);
-    simnode->set_val(val3_to_packedval(val3));
-    ++ i;
+    set_ppi_val(i, val3_to_packedval(val3));
   }
 
-  i = 0;
-  for ( auto simnode: dff_output_list() ) {
+  for ( auto i: Range(mTopology->dff_num()) ) {
     auto val3 = f_vect.val(i);
-    simnode->set_val(val3_to_packedval(val3));
-    ++ i;
+    set_ppi_val(i + ni, val3_to_packedval(val3));
   }
 
   // 各信号線の値を計算する．
   _calc_val();
 
   // 1時刻シフトする．
-
-  // mPrevValArray に値をコピーする．
-  for ( auto node: mNodeArray ) {
-    mPrevValArray[node->id()] = node->val();
-  }
-
-  // DFF の出力の値を入力にコピーする．
-  for ( auto i: Range(mDffNum) ) {
-    auto onode = mPPOArray[i + mOutputNum];
-    auto inode = mPPIArray[i + mInputNum];
-    inode->set_val(onode->val());
-  }
+  _shift_time();
 }
 
 // @brief 状態を取得する．
@@ -594,18 +767,15 @@ void
 FSIM_CLASSNAME::get_state(InputVector& i_vect,
 			  DffVector& f_vect)
 {
-  int i = 0;
-  for ( auto simnode: input_list() ) {
-    auto val = packedval_to_val3(simnode->val());
+  auto ni = mTopology->input_num();
+  for ( auto i: Range(ni) ) {
+    auto val = packedval_to_val3(_ppi_val(i));
     i_vect.set_val(i, val);
-    ++ i;
   }
 
-  i = 0;
-  for ( auto simnode: dff_output_list() ) {
-    auto val = packedval_to_val3(simnode->val());
+  for ( auto i: Range(mTopology->dff_num()) ) {
+    auto val = packedval_to_val3(_ppi_val(i + ni));
     f_vect.set_val(i, val);
-    ++ i;
   }
 }
 
@@ -615,11 +785,7 @@ int
 FSIM_CLASSNAME::calc_wsa(const InputVector& i_vect,
 			 bool weighted)
 {
-  int i = 0;
-  for ( auto simnode: input_list() ) {
-    auto val3 = i_vect.val(i);
-    simnode->set_val(val3_to_packedval(val3));
-  }
+  _seq_set_inputs(i_vect);
 
   // 各信号線の値を計算する．
   _calc_val();
@@ -631,18 +797,7 @@ FSIM_CLASSNAME::calc_wsa(const InputVector& i_vect,
   }
 
   // 1時刻シフトする．
-
-  // mPrevValArray に値をコピーする．
-  for ( auto node: mNodeArray ) {
-    mPrevValArray[node->id()] = node->val();
-  }
-
-  // DFF の出力の値を入力にコピーする．
-  for ( auto i: Range(mDffNum) ) {
-    auto onode = mPPOArray[i + mOutputNum];
-    auto inode = mPPIArray[i + mInputNum];
-    inode->set_val(onode->val());
-  }
+  _shift_time();
 
   return wsa;
 }
@@ -650,8 +805,6 @@ FSIM_CLASSNAME::calc_wsa(const InputVector& i_vect,
 // @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
 // @param[in] tv テストベクタ
 //
-// - 外部入力以外は無視する．
-// - 時刻1の割り当ても無視する
 // weightedの意味は以下の通り
 // - false: ゲートの出力の遷移回数の和
 // - true : ゲートの出力の遷移回数に(ファンアウト数＋１)を掛けたものの和
@@ -659,22 +812,265 @@ int
 FSIM_CLASSNAME::calc_wsa(const TestVector& tv,
 			 bool weighted)
 {
-#if 0
-  set_state(tv.input_vector(), tv.dff_vector());
-  return calc_wsa(tv.aux_input_vector(), weighted);
+  vector<TestVector> tv_list(1, tv);
+  vector<int> wsa_list;
+  calc_wsa(tv_list, weighted, wsa_list);
+  return wsa_list[0];
+}
+
+// @brief 複数のテストベクタの遷移回数をまとめて数える．
+// @param[in] tv_list テストベクタのリスト
+// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+// @param[out] wsa_list tv_list の各要素の遷移回数を納めるリスト
+void
+FSIM_CLASSNAME::calc_wsa(const vector<TestVector>& tv_list,
+			 bool weighted,
+			 vector<int>& wsa_list)
+{
+  int n = tv_list.size();
+  wsa_list.clear();
+  wsa_list.resize(n, 0);
+
+  // FSIM_PV_BITLEN 個ずつビットに割り当てて処理する．
+  for ( int base = 0; base < n; base += FSIM_PV_BITLEN ) {
+    int num = n - base;
+    if ( num > FSIM_PV_BITLEN ) {
+      num = FSIM_PV_BITLEN;
+    }
+    FSIM_PVTYPE pat_map = FSIM_PV_ALL0;
+    for ( auto i: Range(num) ) {
+      set_bit(pat_map, i);
+    }
+    Tv2InputVals iv(pat_map, &tv_list[base]);
+    _calc_wsa(iv, weighted, num, &wsa_list[base]);
+  }
+}
+
+// @brief 順序回路の故障シミュレーションを行う．
+// @param[in] init_state FFの初期値のビットベクタ
+// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+// @return 検出された故障数を返す．
+int
+FSIM_CLASSNAME::seqsim(const DffVector& init_state,
+		       const vector<InputVector>& input_list)
+{
+  mDetNum = 0;
+
+#if FSIM_SA
+  // 正常回路のシミュレーションを行って各時刻の外部出力の値を記録する．
+  int nframe = input_list.size();
+  auto no = mTopology->output_num();
+  auto ni = mTopology->input_num();
+  vector<FSIM_VALTYPE> good_array(nframe * no);
+  for ( auto i: Range(mTopology->dff_num()) ) {
+    set_ppi_val(i + ni, val3_to_packedval(init_state.val(i)));
+  }
+  for ( auto t: Range(nframe) ) {
+    if ( t > 0 ) {
+      // 1時刻シフトする．
+      _copy_dff_vals();
+    }
+    _seq_set_inputs(input_list[t]);
+    _calc_val();
+    for ( auto i: Range(no) ) {
+      good_array[t * no + i] = _ppo_val(i);
+    }
+  }
+
+  // 対象の故障を FSIM_PV_BITLEN 個ずつビットに割り当てて処理する．
+  vector<const SimFault*> fault_list;
+  fault_list.reserve(mFaultNum);
+  auto fault_array = mTopology->fault_array();
+  for ( auto i: Range(mFaultNum) ) {
+    if ( !mFaultStateArray[i].mSkip ) {
+      fault_list.push_back(&fault_array[i]);
+    }
+  }
+  int nf = fault_list.size();
+  for ( int base = 0; base < nf; base += FSIM_PV_BITLEN ) {
+    int num = std::min(FSIM_PV_BITLEN, nf - base);
+    _seqsim_faults(init_state, input_list, good_array, &fault_list[base], num);
+  }
 #else
-#warning "TestVector を用いたバージョン未完成"
-  return 0;
+  // 遷移故障の順序回路シミュレーションはサポートしない．
+  ASSERT_NOT_REACHED;
+#endif
+
+  return mDetNum;
+}
+
+// @brief 順序回路の状態と外部入力を設定する．
+// @param[in] i_vect 外部入力のビットベクタ
+void
+FSIM_CLASSNAME::_seq_set_inputs(const InputVector& i_vect)
+{
+  for ( auto i: Range(mTopology->input_num()) ) {
+    set_ppi_val(i, val3_to_packedval(i_vect.val(i)));
+  }
+}
+
+// @brief 複数の故障を注入して順序回路の故障シミュレーションを行う．
+// @param[in] init_state FFの初期値のビットベクタ
+// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+// @param[in] good_array 各時刻の外部出力の正常値を納めた配列
+// @param[in] fault_list 故障のリスト
+// @param[in] fault_num 故障数 ( <= FSIM_PV_BITLEN )
+void
+FSIM_CLASSNAME::_seqsim_faults(const DffVector& init_state,
+			       const vector<InputVector>& input_list,
+			       const vector<FSIM_VALTYPE>& good_array,
+			       const SimFault* const* fault_list,
+			       int fault_num)
+{
+  // 故障を注入する箇所のリストを作る．
+  // ノードの順(=トポロジカル順)に並べておく．
+  vector<SeqInject> inject_list;
+  inject_list.reserve(fault_num);
+  auto rest_mask = FSIM_PV_ALL0;
+  for ( auto bit: Range(fault_num) ) {
+    auto ff = fault_list[bit];
+    auto bitmask = FSIM_PV_ALL0;
+    set_bit(bitmask, bit);
+    rest_mask |= bitmask;
+    int ipos = ff->mOrigF->is_branch_fault() ? ff->mIpos : -1;
+    auto mask0 = ( ff->mOrigF->val() == 0 ) ? bitmask : FSIM_PV_ALL0;
+    auto mask1 = ( ff->mOrigF->val() == 1 ) ? bitmask : FSIM_PV_ALL0;
+    inject_list.push_back(SeqInject{ff->mNode, ipos, mask0, mask1});
+  }
+  std::stable_sort(inject_list.begin(), inject_list.end(),
+		   [](const SeqInject& a, const SeqInject& b) {
+		     return a.mNode->id() < b.mNode->id();
+		   });
+
+  // 入力の故障を注入する際に元の値を退避しておくリスト
+  vector<pair<int, FSIM_VALTYPE> > save_list;
+
+  auto no = mTopology->output_num();
+  auto ni = mTopology->input_num();
+  for ( auto i: Range(mTopology->dff_num()) ) {
+    set_ppi_val(i + ni, val3_to_packedval(init_state.val(i)));
+  }
+  int nframe = input_list.size();
+  for ( auto t: Range(nframe) ) {
+    if ( t > 0 ) {
+      // 故障回路の状態をビットごとに引き継ぐ．
+      _copy_dff_vals();
+    }
+    _seq_set_inputs(input_list[t]);
+
+    // トポロジカル順に値を計算しつつ故障を注入する．
+    int rpos = 0;
+    int nr = inject_list.size();
+    for ( auto node: mNodeArray ) {
+      int rend = rpos;
+      while ( rend < nr && inject_list[rend].mNode == node ) {
+	++ rend;
+      }
+      auto id = node->id();
+      if ( node->fanin_num() > 0 ) {
+	// 入力の故障はファンインの値を一時的に書き換えて計算する．
+	for ( auto r: Range(rpos, rend) ) {
+	  auto& inject = inject_list[r];
+	  if ( inject.mIpos >= 0 ) {
+	    auto iid = node->fanin_id(inject.mIpos);
+	    auto val = mValArray[iid];
+	    save_list.push_back(make_pair(iid, val));
+	    mValArray[iid] = inject_val(val, inject.mMask0, inject.mMask1);
+	  }
+	}
+	mValArray[id] = calc_val(node, mValArray);
+	// 同じノードを複数回書き換えている可能性があるので逆順に戻す．
+	for ( int i = save_list.size(); -- i >= 0; ) {
+	  mValArray[save_list[i].first] = save_list[i].second;
+	}
+	save_list.clear();
+      }
+      // 出力の故障
+      for ( auto r: Range(rpos, rend) ) {
+	auto& inject = inject_list[r];
+	if ( inject.mIpos < 0 ) {
+	  mValArray[id] = inject_val(mValArray[id], inject.mMask0, inject.mMask1);
+	}
+      }
+      rpos = rend;
+    }
+
+    // 外部出力で正常値と異なるビットの故障を検出済みとする．
+    auto dbits = FSIM_PV_ALL0;
+    for ( auto i: Range(no) ) {
+      dbits |= diff(good_array[t * no + i], _ppo_val(i));
+    }
+    dbits &= rest_mask;
+    if ( dbits != FSIM_PV_ALL0 ) {
+      for ( auto bit: Range(fault_num) ) {
+	if ( get_bit(dbits, bit) ) {
+	  auto ff = fault_list[bit];
+	  mDetFaultArray[mDetNum] = ff->mOrigF;
+	  ++ mDetNum;
+	  _add_det_count(ff, 1);
+	}
+      }
+      rest_mask &= ~dbits;
+      if ( rest_mask == FSIM_PV_ALL0 ) {
+	// 全ての故障が検出された．
+	break;
+      }
+    }
+  }
+}
+
+// @brief 1時刻目と2時刻目の間の遷移回数をビットごとに数える．
+// @param[in] input_vals 入力値
+// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+// @param[in] num 有効なビット数
+// @param[out] wsa_array 各ビットの遷移回数を納める配列
+void
+FSIM_CLASSNAME::_calc_wsa(const InputVals& input_vals,
+			  bool weighted,
+			  int num,
+			  int* wsa_array)
+{
+  // 2時刻分の正常値を計算する．
+  // 1時刻目の値は mPrevValArray に入る．
+#if FSIM_SA
+  // 縮退故障用の場合は2時刻目も外部入力の値は変わらない．
+  input_vals.set_val(*this);
+  _calc_val();
+
+  _shift_time();
+  _calc_val();
+#elif FSIM_TD
+  _calc_gval(input_vals);
 #endif
+
+  // 遷移したビットを重みごとにカウンタに足し込む．
+  BitSliceCounter counter;
+  for ( auto node: mNodeArray ) {
+    auto diff = toggle_bits(mPrevValArray[node->id()], mValArray[node->id()]);
+    if ( diff == FSIM_PV_ALL0 ) {
+      continue;
+    }
+    int w = 1;
+    if ( weighted ) {
+      w += node->fanout_num();
+    }
+    counter.add(diff, w);
+  }
+
+  for ( auto bit: Range(num) ) {
+    wsa_array[bit] = counter.count(bit);
+  }
 }
 
 // @brief ノードの出力の(重み付き)信号遷移回数を求める．
 int
-FSIM_CLASSNAME::_calc_wsa(SimNode* node,
+FSIM_CLASSNAME::_calc_wsa(const SimNode* node,
 			  bool weighted)
 {
+  // ビット並列版と同じく X との間の変化は遷移とみなさない．
   int wsa = 0;
-  if ( mPrevValArray[node->id()] != node->val() ) {
+  auto id = node->id();
+  if ( toggle_bits(mPrevValArray[id], mValArray[id]) != FSIM_PV_ALL0 ) {
     wsa = 1;
     if ( weighted ) {
       wsa += node->fanout_num();
@@ -710,18 +1106,7 @@ FSIM_CLASSNAME::_calc_gval(const InputVals& input_vals)
   _calc_val();
 
   // 1時刻シフトする．
-
-  // mPrevValArray に値をコピーする．
-  for ( auto node: mNodeArray ) {
-    mPrevValArray[node->id()] = node->val();
-  }
-
-  // DFF の出力の値を入力にコピーする．
-  for ( auto i: Range(mDffNum) ) {
-    auto onode = mPPOArray[i + mOutputNum];
-    auto inode = mPPIArray[i + mInputNum];
-    inode->set_val(onode->val());
-  }
+  _shift_time();
 
   // 2時刻目の入力を設定する．
   input_vals.set_val2(*this);
@@ -737,32 +1122,95 @@ FSIM_CLASSNAME::_calc_gval(const InputVals& input_vals)
 void
 FSIM_CLASSNAME::_calc_val()
 {
-  for ( auto node: mLogicArray ) {
-    node->calc_val();
+  if ( mCompiledGval ) {
+    mGvalProg.eval(mValArray);
+  }
+  else {
+    for ( auto node: mTopology->logic_list() ) {
+      mValArray[node->id()] = calc_val(node, mValArray);
+    }
+  }
+}
+
+// @brief 1時刻シフトする．
+void
+FSIM_CLASSNAME::_shift_time()
+{
+  // mPrevValArray に値をコピーする．
+  for ( auto i: Range(mNodeArray.size()) ) {
+    mPrevValArray[i] = mValArray[i];
+  }
+
+  // DFF の出力の値を入力にコピーする．
+  _copy_dff_vals();
+}
+
+// @brief DFF の出力に DFF の入力の値をコピーする．
+void
+FSIM_CLASSNAME::_copy_dff_vals()
+{
+  auto ni = mTopology->input_num();
+  auto no = mTopology->output_num();
+  for ( auto i: Range(mTopology->dff_num()) ) {
+    set_ppi_val(i + ni, _ppo_val(i + no));
   }
 }
 
 // @brief 個々の故障に FaultProp を適用する．
-// @param[in] fault_list 故障のリスト
+// @param[in] ffr 対象の FFR
 // @return 全ての故障の伝搬結果のORを返す．
-PackedVal
-FSIM_CLASSNAME::_foreach_faults(const vector<SimFault*>& fault_list)
+//
+// FFR 内の各ノードから根までの可観測性は _calc_ffr_obs() で
+// 一度だけ求めておき，個々の故障ではそれを参照する．
+FSIM_PVTYPE
+FSIM_CLASSNAME::_foreach_faults(const SimFFR& ffr)
 {
-  auto ffr_req = kPvAll0;
-  for ( auto ff: fault_list ) {
-    if ( ff->mSkip ) {
+  auto ffr_req = FSIM_PV_ALL0;
+  bool obs_done = false;
+  for ( auto ff: ffr.fault_list() ) {
+    auto& state = mFaultStateArray[ff->mId];
+    if ( state.mSkip ) {
       continue;
     }
 
-    auto obs = _fault_prop(ff);
+    if ( !obs_done ) {
+      // 全ての故障がスキップされている場合には計算しない．
+      _calc_ffr_obs(ffr);
+      obs_done = true;
+    }
 
-    ff->mObsMask = obs;
+    auto lobs = mObsArray[ff->mNode->id()];
+    if ( ff->mOrigF->is_branch_fault() ) {
+      // 入力の故障
+      lobs &= calc_gobs(ff->mNode, ff->mIpos, mValArray);
+    }
+    auto obs = _fault_act(ff) & lobs;
+
+    state.mObsMask = obs;
     ffr_req |= obs;
   }
 
   return ffr_req;
 }
 
+// @brief FFR 内の各ノードから根までの可観測性を求める．
+// @param[in] ffr 対象の FFR
+//
+// 結果は mObsArray の FFR 内のノードの位置に格納される．
+void
+FSIM_CLASSNAME::_calc_ffr_obs(const SimFFR& ffr)
+{
+  // 根から順に処理するのでファンアウト先の値は計算済みとなる．
+  mObsArray[ffr.root()->id()] = FSIM_PV_ALL1;
+  auto n = ffr.node_num();
+  for ( auto pos: Range(1, n) ) {
+    auto node = ffr.node(pos);
+    auto onode = node->fanout_top();
+    auto ipos = node->fanout_ipos();
+    mObsArray[node->id()] = mObsArray[onode->id()] & calc_gobs(onode, ipos, mValArray);
+  }
+}
+
 // @brief シミュレーションを行って sppfp 用の _fault_sweep() を呼ぶ出す．
 // @param[in] ffr_buf FFR を入れた配列
 // @param[in] ffr_num FFR 数
@@ -771,9 +1219,8 @@ FSIM_CLASSNAME::_do_simulation(const SimFFR* ffr_buff[],
 			       int ffr_num)
 {
   auto obs = mEventQ.simulate();
-  PackedVal mask = 1ULL;
-  for ( auto i = 0; i < ffr_num; ++ i, mask <<= 1 ) {
-    if ( obs & mask ) {
+  for ( auto i = 0; i < ffr_num; ++ i ) {
+    if ( get_bit(obs, i) ) {
       _fault_sweep(ffr_buff[i]->fault_list());
     }
   }
@@ -782,15 +1229,17 @@ FSIM_CLASSNAME::_do_simulation(const SimFFR* ffr_buff[],
 // @brief 故障をスキャンして結果をセットする(sppfp用)
 // @param[in] fault_list 故障のリスト
 void
-FSIM_CLASSNAME::_fault_sweep(const vector<SimFault*>& fault_list)
+FSIM_CLASSNAME::_fault_sweep(const vector<const SimFault*>& fault_list)
 {
   for ( auto ff: fault_list ) {
-    if ( ff->mSkip || ff->mObsMask == kPvAll0 ) {
+    auto& state = mFaultStateArray[ff->mId];
+    if ( state.mSkip || state.mObsMask == FSIM_PV_ALL0 ) {
       continue;
     }
     auto f = ff->mOrigF;
     mDetFaultArray[mDetNum] = f;
     ++ mDetNum;
+    _add_det_count(ff, 1);
   }
 }
 
@@ -798,68 +1247,27 @@ FSIM_CLASSNAME::_fault_sweep(const vector<SimFault*>& fault_list)
 // @param[in] fault_list 故障のリスト
 // @param[in] pat 検出パタン
 void
-FSIM_CLASSNAME::_fault_sweep(const vector<SimFault*>& fault_list,
-			     PackedVal mask)
+FSIM_CLASSNAME::_fault_sweep(const vector<const SimFault*>& fault_list,
+			     FSIM_PVTYPE mask)
 {
   for ( auto ff: fault_list ) {
-    if ( ff->mSkip ) {
+    auto& state = mFaultStateArray[ff->mId];
+    if ( state.mSkip ) {
       continue;
     }
-    auto pat = ff->mObsMask & mask;
-    if ( pat != kPvAll0 ) {
+    auto pat = state.mObsMask & mask;
+    if ( pat != FSIM_PV_ALL0 ) {
       auto f = ff->mOrigF;
       mDetFaultArray[mDetNum] = f;
-      mDetPatArray[mDetNum] = pat & mPatMap;
+      pat &= mPatMap;
+      auto dst = &mDetPatArray[mDetNum * FSIM_PV_WORDS];
+      for ( auto wpos: Range(FSIM_PV_WORDS) ) {
+	dst[wpos] = get_word(pat, wpos);
+      }
       ++ mDetNum;
+      _add_det_count(ff, count_ones(pat));
     }
   }
 }
 
-// @brief 現在保持している SimNode のネットワークを破棄する．
-void
-FSIM_CLASSNAME::clear()
-{
-  // mNodeArray が全てのノードを持っている
-  for ( auto node: mNodeArray ) {
-    delete node;
-  }
-  mNodeArray.clear();
-
-  delete [] mPPIArray;
-  delete [] mPPOArray;
-  delete [] mPrevValArray;
-
-  mLogicArray.clear();
-
-  delete [] mFFRArray;
-  delete [] mFFRMap;
-
-  delete [] mSimFaults;
-  delete [] mFaultArray;
-  delete [] mDetFaultArray;
-  delete [] mDetPatArray;
-}
-
-// @brief 外部入力ノードを作る．
-SimNode*
-FSIM_CLASSNAME::make_input()
-{
-  auto id = mNodeArray.size();
-  auto node = SimNode::new_input(id);
-  mNodeArray.push_back(node);
-  return node;
-}
-
-// @brief 単純な logic ノードを作る．
-SimNode*
-FSIM_CLASSNAME::make_gate(GateType type,
-			  const vector<SimNode*>& inputs)
-{
-  auto id = mNodeArray.size();
-  auto node = SimNode::new_gate(id, type, inputs);
-  mNodeArray.push_back(node);
-  mLogicArray.push_back(node);
-  return node;
-}
-
 END_NAMESPACE_SATPG_FSIM
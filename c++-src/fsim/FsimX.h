@@ -14,24 +14,35 @@
 #include "fsim_nsdef.h"
 #include "PackedVal.h"
 #include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
 #include "EventQ.h"
-#include "SimFault.h"
+#include "LocalEventQ.h"
+#include "SimEval.h"
+#include "WorkerPool.h"
+#include "GvalProg.h"
+#include "CfsEngine.h"
+#include "SimTopology.h"
 #include "TpgNode.h"
 #include "TpgFault.h"
 #include "TestVector.h"
+#include <atomic>
+#include <memory>
 
 
 BEGIN_NAMESPACE_SATPG_FSIM
 
-class SimFFR;
-class SimNode;
 class InputVals;
 
 //////////////////////////////////////////////////////////////////////
 /// @class FSIM_CLASSNAME FsimX.h "FsimX.h"
 /// @brief 故障シミュレーションを行うモジュール
 ///
-/// 実際のクラス名は FsimSa2, FsimSa3, FsimTd2, FsimTd3 である．
+/// 実際のクラス名は FsimSa2, FsimSa3, FsimTd2, FsimTd3 である．<br>
+/// 回路構造(SimNode，FFR，故障)は不変な SimTopology として
+/// 同じネットワークに対する他のインスタンスと共有する．
+/// インスタンスごとにはノード番号をキーにした値の配列と，
+/// SimFault::mId をキーにした故障の状態の配列だけを持つ．
 //////////////////////////////////////////////////////////////////////
 class FSIM_CLASSNAME :
   public FsimImpl
@@ -39,8 +50,10 @@ class FSIM_CLASSNAME :
 public:
 
   /// @brief コンストラクタ
-  /// @param[in] network ネットワーク
-  FSIM_CLASSNAME (const TpgNetwork& network);
+  /// @param[in] topology 回路構造
+  /// @param[in] compiled_gval 正常値計算に GvalProg を用いる時 true にする．
+  FSIM_CLASSNAME (const std::shared_ptr<const SimTopology>& topology,
+		  bool compiled_gval);
 
   /// @brief デストラクタ
   virtual
@@ -74,6 +87,82 @@ public:
   void
   clear_skip(const TpgFault* f);
 
+  /// @brief ppsfp で用いるスレッド数を設定する．
+  /// @param[in] num スレッド数 ( num >= 1 )
+  virtual
+  void
+  set_thread_num(int num);
+
+  /// @brief ppsfp で用いるスレッド数を返す．
+  virtual
+  int
+  thread_num() const;
+
+  /// @brief sppfp を並行故障シミュレーションで行うかどうかを設定する．
+  /// @param[in] flag true の時並行故障シミュレーションを用いる．
+  virtual
+  void
+  set_concurrent(bool flag);
+
+  /// @brief sppfp を並行故障シミュレーションで行う時 true を返す．
+  virtual
+  bool
+  concurrent() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // N検出用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全ての故障の目標検出回数を設定する．
+  /// @param[in] target 目標検出回数
+  ///
+  /// 検出回数が target に達した故障には自動的にスキップマークがつけられる．
+  /// target = 0 の場合は自動的にスキップマークをつけない．
+  virtual
+  void
+  set_det_target(int target);
+
+  /// @brief 故障の目標検出回数を設定する．
+  /// @param[in] f 対象の故障
+  /// @param[in] target 目標検出回数
+  virtual
+  void
+  set_det_target(const TpgFault* f,
+		 int target);
+
+  /// @brief 全ての故障の検出回数を0にする．
+  virtual
+  void
+  clear_det_count();
+
+  /// @brief 故障の検出回数を返す．
+  /// @param[in] f 対象の故障
+  ///
+  /// sppfp() では1回，ppsfp() では検出したパタン数だけ加算される．
+  virtual
+  int
+  det_count(const TpgFault* f);
+
+  /// @brief 検出回数のヒストグラムを返す．
+  ///
+  /// 返り値の k 番目の要素は検出回数が k の故障数となる．
+  /// スキップマークのついている故障も含む．
+  virtual
+  vector<int>
+  det_count_histogram();
+
+  /// @brief 全ての故障のスキップマークと目標検出回数を退避する．
+  virtual
+  void
+  save_fault_state();
+
+  /// @brief save_fault_state() で退避したスキップマークと目標検出回数を戻す．
+  virtual
+  void
+  restore_fault_state();
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -136,8 +225,6 @@ public:
   /// @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
   /// @param[in] tv テストベクタ
   ///
-  /// - 外部入力以外は無視する．
-  /// - 時刻1の割り当ても無視する
   /// weightedの意味は以下の通り
   /// - false: ゲートの出力の遷移回数の和
   /// - true : ゲートの出力の遷移回数に(ファンアウト数＋１)を掛けたものの和
@@ -146,6 +233,16 @@ public:
   calc_wsa(const TestVector& tv,
 	   bool weighted);
 
+  /// @brief 複数のテストベクタの遷移回数をまとめて数える．
+  /// @param[in] tv_list テストベクタのリスト
+  /// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+  /// @param[out] wsa_list tv_list の各要素の遷移回数を納めるリスト
+  virtual
+  void
+  calc_wsa(const vector<TestVector>& tv_list,
+	   bool weighted,
+	   vector<int>& wsa_list);
+
   /// @brief 状態を設定する．
   /// @param[in] i_vect 外部入力のビットベクタ
   /// @param[in] f_vect FFの値のビットベクタ
@@ -169,19 +266,33 @@ public:
   calc_wsa(const InputVector& i_vect,
 	   bool weighted);
 
+  /// @brief 順序回路の故障シミュレーションを行う．
+  /// @param[in] init_state FFの初期値のビットベクタ
+  /// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+  /// @return 検出された故障数を返す．
+  virtual
+  int
+  seqsim(const DffVector& init_state,
+	 const vector<InputVector>& input_list);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
   // ppsfp のテストパタンを設定する関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ppsfp で同時に扱えるパタン数を返す．
+  virtual
+  int
+  pv_bitlen() const;
+
   /// @brief ppsfp 用のパタンバッファをクリアする．
   virtual
   void
   clear_patterns();
 
   /// @brief ppsfp 用のパタンを設定する．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < FSIM_PV_BITLEN )
   /// @param[in] tv テストベクタ
   virtual
   void
@@ -189,7 +300,7 @@ public:
 	      const TestVector& tv);
 
   /// @brief 設定した ppsfp 用のパタンを読み出す．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < FSIM_PV_BITLEN )
   virtual
   TestVector
   get_pattern(int pos);
@@ -218,11 +329,15 @@ public:
 
   /// @brief 直前の ppsfp で検出された故障に対する検出パタンを返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < det_fault_num() )
+  /// @param[in] wpos ワード位置 ( 0 <= wpos < pv_bitlen() / kPvBitLen )
   virtual
   PackedVal
-  det_fault_pat(int pos);
+  det_fault_pat(int pos,
+		int wpos);
 
   /// @brief 直前の ppsfp で検出された故障に対する検出パタンのリストを返す．
+  ///
+  /// 1つの故障につき pv_bitlen() / kPvBitLen ワードずつ並んでいる．
   virtual
   Array<PackedVal>
   det_fault_pat_list();
@@ -242,22 +357,12 @@ public:
   int
   ppi_num() const;
 
-  /// @brief PPI のノードを返す．
+  /// @brief PPI の値を設定する．
   /// @param[in] id PPI番号 ( 0 <= id < ppi_num() )
-  SimNode*
-  ppi(int id) const;
-
-  /// @brief 外部入力ノードのリストを返す．
-  Array<SimNode*>
-  input_list() const;
-
-  /// @brief DFFの出力ノードのリストを返す．
-  Array<SimNode*>
-  dff_output_list() const;
-
-  /// @brief PPI のノードのリストを返す．
-  Array<SimNode*>
-  ppi_list() const;
+  /// @param[in] val 値
+  void
+  set_ppi_val(int id,
+	      FSIM_VALTYPE val);
 
 
 private:
@@ -265,16 +370,35 @@ private:
   // 内部で用いられる下請け関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief ネットワークをセットする．
-  /// @param[in] network ネットワーク
+  /// @brief PPI の値を返す．
+  /// @param[in] id PPI番号 ( 0 <= id < ppi_num() )
+  FSIM_VALTYPE
+  _ppi_val(int id) const;
+
+  /// @brief PPO の値を返す．
+  /// @param[in] id PPO番号 ( 0 <= id < ppo_num() )
+  FSIM_VALTYPE
+  _ppo_val(int id) const;
+
+  /// @brief 故障のスキップマークを設定する．
+  /// @param[in] id SimFault::mId
+  /// @param[in] flag スキップマーク
   ///
-  /// 全ての故障のスキップマークはクリアされる．
+  /// 退避した状態がある場合はそちらにも反映する．
   void
-  set_network(const TpgNetwork& network);
+  _set_skip(int id,
+	    bool flag);
 
-  /// @brief FFR のリストを返す．
-  Array<SimFFR>
-  _ffr_list() const;
+  /// @brief 1時刻シフトする．
+  ///
+  /// 現在の値を mPrevValArray にコピーし，
+  /// DFF の出力に DFF の入力の値をコピーする．
+  void
+  _shift_time();
+
+  /// @brief DFF の出力に DFF の入力の値をコピーする．
+  void
+  _copy_dff_vals();
 
   /// @brief SPSFP故障シミュレーションの本体
   /// @param[in] f 対象の故障
@@ -288,6 +412,11 @@ private:
   int
   _sppfp();
 
+  /// @brief 並行故障シミュレーションによる SPPFP故障シミュレーションの本体
+  /// @return 検出された故障数を返す．
+  int
+  _sppfp_cfs();
+
   /// @brief PPSFP故障シミュレーションの本体
   /// @return 検出された故障数を返す．
   ///
@@ -296,6 +425,21 @@ private:
   int
   _ppsfp();
 
+  /// @brief 複数のスレッドを用いた PPSFP故障シミュレーションの本体
+  /// @return 検出された故障数を返す．
+  ///
+  /// FFR をスレッドに振り分けて故障伝搬シミュレーションを行う．
+  /// 結果は _ppsfp() と同じ順序で det_fault() に格納される．
+  int
+  _ppsfp_mt();
+
+  /// @brief _ppsfp_mt() のスレッドごとの処理
+  /// @param[in] tid スレッド番号
+  /// @param[in] next_pos 次に処理する FFR 番号
+  void
+  _ppsfp_worker(int tid,
+		std::atomic<int>& next_pos);
+
   /// @brief 正常値の計算を行う．
   /// @param[in] input_vals 入力値
   void
@@ -307,9 +451,44 @@ private:
   void
   _calc_val();
 
+  /// @brief 順序回路の状態と外部入力を設定する．
+  /// @param[in] i_vect 外部入力のビットベクタ
+  ///
+  /// FF の出力には直前の時刻の FF の入力の値をコピーする．
+  void
+  _seq_set_inputs(const InputVector& i_vect);
+
+  /// @brief 複数の故障を注入して順序回路の故障シミュレーションを行う．
+  /// @param[in] init_state FFの初期値のビットベクタ
+  /// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+  /// @param[in] good_array 各時刻の外部出力の正常値を納めた配列
+  /// @param[in] fault_list 故障のリスト
+  /// @param[in] fault_num 故障数 ( <= FSIM_PV_BITLEN )
+  ///
+  /// fault_list[i] は i 番目のビットに割り当てられる．
+  void
+  _seqsim_faults(const DffVector& init_state,
+		 const vector<InputVector>& input_list,
+		 const vector<FSIM_VALTYPE>& good_array,
+		 const SimFault* const* fault_list,
+		 int fault_num);
+
+  /// @brief 1時刻目と2時刻目の間の遷移回数をビットごとに数える．
+  /// @param[in] input_vals 入力値
+  /// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+  /// @param[in] num 有効なビット数
+  /// @param[out] wsa_array 各ビットの遷移回数を納める配列
+  ///
+  /// set_state() で設定した状態は失われる．
+  void
+  _calc_wsa(const InputVals& input_vals,
+	    bool weighted,
+	    int num,
+	    int* wsa_array);
+
   /// @brief ノードの出力の(重み付き)信号遷移回数を求める．
   int
-  _calc_wsa(SimNode* node,
+  _calc_wsa(const SimNode* node,
 	    bool weighted);
 
   /// @brief FFR の根から故障伝搬シミュレーションを行う．
@@ -318,35 +497,49 @@ private:
   /// @return 伝搬したビットに1を立てたビットベクタ
   ///
   /// obs_mask が0のビットのイベントはマスクされる．
-  PackedVal
-  _prop_sim(SimNode* root,
-	    PackedVal obs_mask);
+  FSIM_PVTYPE
+  _prop_sim(const SimNode* root,
+	    FSIM_PVTYPE obs_mask);
 
   /// @brief FFR内の伝搬条件を求める．
   /// @param[in] fault 対象の故障
-  PackedVal
-  _ffr_prop(SimFault* fault);
+  FSIM_PVTYPE
+  _ffr_prop(const SimFault* fault);
 
   /// @brief FFR内の故障シミュレーションを行う．
   /// @param[in] fault 対象の故障
-  PackedVal
-  _fault_prop(SimFault* fault);
+  FSIM_PVTYPE
+  _fault_prop(const SimFault* fault);
 
   /// @brief 個々の故障の故障伝搬条件を計算する．
-  /// @param[in] fault_list 故障のリスト
+  /// @param[in] ffr 対象の FFR
   /// @return 全ての故障の伝搬結果のORを返す．
-  PackedVal
-  _foreach_faults(const vector<SimFault*>& fault_list);
+  FSIM_PVTYPE
+  _foreach_faults(const SimFFR& ffr);
+
+  /// @brief FFR 内の各ノードから根までの可観測性を求める．
+  /// @param[in] ffr 対象の FFR
+  ///
+  /// 結果は mObsArray の FFR 内のノードの位置に格納される．
+  void
+  _calc_ffr_obs(const SimFFR& ffr);
 
   /// @brief 故障の活性化条件を求める．
   /// @param[in] fault 対象の故障
-  PackedVal
-  _fault_cond(SimFault* fault);
+  ///
+  /// 遷移故障の場合は1時刻前の条件も含む．
+  FSIM_PVTYPE
+  _fault_act(const SimFault* fault);
+
+  /// @brief 故障の活性化条件を求める．
+  /// @param[in] fault 対象の故障
+  FSIM_PVTYPE
+  _fault_cond(const SimFault* fault);
 
   /// @brief 故障の活性化条件を求める．(遷移故障用)
   /// @param[in] fault 対象の故障
-  PackedVal
-  _fault_prev_cond(SimFault* fault);
+  FSIM_PVTYPE
+  _fault_prev_cond(const SimFault* fault);
 
   /// @brief シミュレーションを行って sppfp 用の _fault_sweep() を呼ぶ出す．
   /// @param[in] ffr_buf FFR を入れた配列
@@ -358,34 +551,46 @@ private:
   /// @brief 故障をスキャンして結果をセットする(sppfp用)
   /// @param[in] fault_list 故障のリスト
   void
-  _fault_sweep(const vector<SimFault*>& fault_list);
+  _fault_sweep(const vector<const SimFault*>& fault_list);
+
+  /// @brief 検出回数を加算する．
+  /// @param[in] ff 対象の故障
+  /// @param[in] num 加算する回数
+  ///
+  /// 目標検出回数に達したらスキップマークをつける．
+  void
+  _add_det_count(const SimFault* ff,
+		 int num);
 
   /// @brief 故障をスキャンして結果をセットする(ppsfp用)
   /// @param[in] fault_list 故障のリスト
   /// @param[in] pat 検出パタン
   void
-  _fault_sweep(const vector<SimFault*>& fault_list,
-	       PackedVal pat);
+  _fault_sweep(const vector<const SimFault*>& fault_list,
+	       FSIM_PVTYPE pat);
 
 
 private:
   //////////////////////////////////////////////////////////////////////
-  // SimNode / SimFault の設定に関する関数
+  // 内部で用いられるデータ構造
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 現在保持している SimNode のネットワークを破棄する．
-  /// 内部で clear_faults() を呼ぶ．
-  void
-  clear();
+  // 故障ごとの状態
+  // SimTopology の故障は共有されるのでインスタンスごとに持つ．
+  struct FaultState
+  {
+    // 直前の故障シミュレーションで FFR の根まで伝搬したビット
+    FSIM_PVTYPE mObsMask;
 
-  /// @brief 外部入力ノードを作る．
-  SimNode*
-  make_input();
+    // 検出回数
+    int mDetCount;
 
-  /// @brief logic ノードを作る．
-  SimNode*
-  make_gate(GateType type,
-	    const vector<SimNode*>& inputs);
+    // 目標検出回数
+    int mDetTarget;
+
+    // スキップフラグ
+    bool mSkip;
+  };
 
 
 private:
@@ -393,72 +598,89 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 外部入力数
-  int mInputNum;
-
-  // 外部出力数
-  int mOutputNum;
-
-  // DFF数
-  int mDffNum;
+  // 回路構造
+  std::shared_ptr<const SimTopology> mTopology;
 
-  // 全ての SimNode を納めた配列
-  vector<SimNode*> mNodeArray;
+  // 全ての SimNode のリスト
+  // mTopology->node_list() と同じ
+  const vector<const SimNode*>& mNodeArray;
 
-  // PPIに対応する SimNode を納めた配列
-  // サイズは mInputNum + mDffNum
-  SimNode** mPPIArray;
+  // ノード番号をキーにして値を納める配列
+  // サイズは mNodeArray.size()
+  FSIM_VALTYPE* mValArray;
 
-  // PPOに対応する SimNode を納めた配列
-  // サイズは mOutputNum + mDffNum
-  SimNode** mPPOArray;
+  // 正常値計算に mGvalProg を用いる時 true にするフラグ
+  bool mCompiledGval;
 
-  // 入力からのトポロジカル順に並べた logic ノードの配列
-  vector<SimNode*> mLogicArray;
+  // 正常値計算用の命令列
+  GvalProg mGvalProg;
 
   // ブロードサイド方式用の１時刻前の値を保持する配列
   // サイズは mNodeArray.size()
   FSIM_VALTYPE* mPrevValArray;
 
-  // FFR 数
-  int mFFRNum;
-
-  // FFR を納めた配列
-  // サイズは mFFRNum
-  SimFFR* mFFRArray;
+  // ノード番号をキーにして FFR の根までの可観測性を納める配列
+  // サイズは mNodeArray.size()
+  FSIM_PVTYPE* mObsArray;
 
-  // SimNode->id() をキーにして所属する FFR を納めた配列
-  SimFFR** mFFRMap;
+  // FFR ごとの伝搬結果を納めた配列(_ppsfp_mt()用)
+  // サイズは mTopology->ffr_num()
+  FSIM_PVTYPE* mFFRObsArray;
 
   // パタンの設定状況を表すビットベクタ
-  PackedVal mPatMap;
+  FSIM_PVTYPE mPatMap;
 
   // mPatMap の最初の1のビット位置
-  // 全て０の場合には kPvBitLen が入る．
+  // 全て０の場合には FSIM_PV_BITLEN が入る．
   int mPatFirstBit;
 
   // パタンバッファ
-  TestVector mPatBuff[kPvBitLen];
+  TestVector mPatBuff[FSIM_PV_BITLEN];
 
   // イベントキュー
   EventQ mEventQ;
 
+  // ppsfp で用いるスレッド数
+  int mThreadNum;
+
+  // スレッドごとのイベントキューの配列
+  // サイズは mThreadNum ( mThreadNum == 1 の時は nullptr )
+  LocalEventQ* mLocalEventQArray;
+
+  // _ppsfp_mt() で用いる常駐スレッド
+  // mThreadNum == 1 の時はスレッドを持たない．
+  WorkerPool mWorkerPool;
+
+  // sppfp を並行故障シミュレーションで行う時 true にするフラグ
+  bool mConcurrent;
+
+  // 並行故障シミュレーションを行うオブジェクト
+  CfsEngine mCfsEngine;
+
+  // 並行故障シミュレーション用の活性化された故障のリスト
+  vector<const SimFault*> mCfsActList;
+
+  // 並行故障シミュレーション用の検出された故障のリスト
+  vector<const SimFault*> mCfsDetList;
+
   // 故障数
   int mFaultNum;
 
-  // 故障シミュレーション用の故障の配列
+  // SimFault::mId をキーにして故障の状態を納める配列
   // サイズは mFaultNum
-  SimFault* mSimFaults;
+  FaultState* mFaultStateArray;
 
-  // TpgFault::id() をキーとして SimFault を格納する配列
-  SimFault** mFaultArray;
+  // save_fault_state() で退避した (スキップマーク, 目標検出回数) の配列
+  // 空でなければサイズは mFaultNum
+  vector<pair<bool, int>> mSavedStateArray;
 
   // 検出された故障を格納する配列
   // サイズは常に mFaultNum
   const TpgFault** mDetFaultArray;
 
   // 故障を検出するビットパタンを格納する配列
-  // サイズは常に mFaultNum
+  // 1つの故障につき FSIM_PV_WORDS 個のワードを用いる．
+  // サイズは常に mFaultNum * FSIM_PV_WORDS
   PackedVal* mDetPatArray;
 
   // 検出された故障数
@@ -476,7 +698,7 @@ inline
 int
 FSIM_CLASSNAME::input_num() const
 {
-  return mInputNum;
+  return mTopology->input_num();
 }
 
 // @brief PPI数を返す．
@@ -484,42 +706,74 @@ inline
 int
 FSIM_CLASSNAME::ppi_num() const
 {
-  return mInputNum + mDffNum;
+  return mTopology->ppi_num();
 }
 
-// @brief PPI のノードを返す．
+// @brief PPI の値を設定する．
 // @param[in] id PPI番号 ( 0 <= id < ppi_num() )
+// @param[in] val 値
 inline
-SimNode*
-FSIM_CLASSNAME::ppi(int id) const
+void
+FSIM_CLASSNAME::set_ppi_val(int id,
+			    FSIM_VALTYPE val)
 {
-  ASSERT_COND( id >= 0 && id < ppi_num() );
+  mValArray[mTopology->ppi(id)->id()] = val;
+}
+
+// @brief PPI の値を返す．
+// @param[in] id PPI番号 ( 0 <= id < ppi_num() )
+inline
+FSIM_VALTYPE
+FSIM_CLASSNAME::_ppi_val(int id) const
+{
+  return mValArray[mTopology->ppi(id)->id()];
+}
 
-  return mPPIArray[id];
+// @brief PPO の値を返す．
+// @param[in] id PPO番号 ( 0 <= id < ppo_num() )
+inline
+FSIM_VALTYPE
+FSIM_CLASSNAME::_ppo_val(int id) const
+{
+  return mValArray[mTopology->ppo(id)->id()];
 }
 
-// @brief 外部入力ノードのリストを返す．
+// @brief 故障のスキップマークを設定する．
+// @param[in] id SimFault::mId
+// @param[in] flag スキップマーク
 inline
-Array<SimNode*>
-FSIM_CLASSNAME::input_list() const
+void
+FSIM_CLASSNAME::_set_skip(int id,
+			  bool flag)
 {
-  return Array<SimNode*>(mPPIArray, 0, input_num());
+  mFaultStateArray[id].mSkip = flag;
+  if ( !mSavedStateArray.empty() ) {
+    mSavedStateArray[id].first = flag;
+  }
 }
 
-// @brief DFFの出力ノードのリストを返す．
+// @brief ppsfp で用いるスレッド数を返す．
 inline
-Array<SimNode*>
-FSIM_CLASSNAME::dff_output_list() const
+int
+FSIM_CLASSNAME::thread_num() const
 {
-  return Array<SimNode*>(mPPIArray, input_num(), ppi_num());
+  return mThreadNum;
 }
 
-// @brief PPI のノードのリストを返す．
+// @brief sppfp を並行故障シミュレーションで行う時 true を返す．
 inline
-Array<SimNode*>
-FSIM_CLASSNAME::ppi_list() const
+bool
+FSIM_CLASSNAME::concurrent() const
 {
-  return Array<SimNode*>(mPPIArray, 0, ppi_num());
+  return mConcurrent;
+}
+
+// @brief ppsfp で同時に扱えるパタン数を返す．
+inline
+int
+FSIM_CLASSNAME::pv_bitlen() const
+{
+  return FSIM_PV_BITLEN;
 }
 
 // @brief 直前の sppfp/ppsfp で検出された故障数を返す．
@@ -551,27 +805,46 @@ FSIM_CLASSNAME::det_fault_list()
 
 // @brief 直前の ppsfp で検出された故障の検出ビットパタンを返す．
 // @param[in] pos 位置番号 ( 0 <= pos < det_fault_num() )
+// @param[in] wpos ワード位置 ( 0 <= wpos < pv_bitlen() / kPvBitLen )
 inline
 PackedVal
-FSIM_CLASSNAME::det_fault_pat(int pos)
+FSIM_CLASSNAME::det_fault_pat(int pos,
+			      int wpos)
 {
   ASSERT_COND( pos >= 0 && pos < det_fault_num() );
+  ASSERT_COND( wpos >= 0 && wpos < FSIM_PV_WORDS );
 
-  return mDetPatArray[pos];
+  return mDetPatArray[pos * FSIM_PV_WORDS + wpos];
 }
 
+// @brief 直前の ppsfp で検出された故障に対する検出パタンのリストを返す．
 inline
 Array<PackedVal>
 FSIM_CLASSNAME::det_fault_pat_list()
 {
-  return Array<PackedVal>(mDetPatArray, 0, mDetNum);
+  return Array<PackedVal>(mDetPatArray, 0, mDetNum * FSIM_PV_WORDS);
+}
+
+// @brief 検出回数を加算する．
+// @param[in] ff 対象の故障
+// @param[in] num 加算する回数
+inline
+void
+FSIM_CLASSNAME::_add_det_count(const SimFault* ff,
+			       int num)
+{
+  auto& state = mFaultStateArray[ff->mId];
+  state.mDetCount += num;
+  if ( state.mDetTarget > 0 && state.mDetCount >= state.mDetTarget ) {
+    state.mSkip = true;
+  }
 }
 
 BEGIN_NONAMESPACE
 
 // 故障の活性化条件を返す．
 inline
-PackedVal
+FSIM_PVTYPE
 _fault_diff(const TpgFault* f,
 	    FSIM_VALTYPE val)
 {
@@ -584,7 +857,7 @@ _fault_diff(const TpgFault* f,
 
 // 遷移故障の初期化条件を返す．
 inline
-PackedVal
+FSIM_PVTYPE
 _fault_eq(const TpgFault* f,
 	  FSIM_VALTYPE val)
 {
@@ -600,40 +873,53 @@ END_NONAMESPACE
 // @brief FFR内の故障シミュレーションを行う．
 // @param[in] fault 対象の故障
 inline
-PackedVal
-FSIM_CLASSNAME::_fault_prop(SimFault* fault)
+FSIM_PVTYPE
+FSIM_CLASSNAME::_fault_prop(const SimFault* fault)
 {
   // 故障の活性化条件を求める．
-  auto cval = _fault_cond(fault);
+  auto cval = _fault_act(fault);
 
   // FFR 内の故障伝搬を行う．
   auto lobs = _ffr_prop(fault);
 
-#if FSIM_SA
   return cval & lobs;
+}
+
+// @brief 故障の活性化条件を求める．
+// @param[in] fault 対象の故障
+//
+// 遷移故障の場合は1時刻前の条件も含む．
+inline
+FSIM_PVTYPE
+FSIM_CLASSNAME::_fault_act(const SimFault* fault)
+{
+  auto cval = _fault_cond(fault);
+
+#if FSIM_SA
+  return cval;
 #elif FSIM_TD
   // 1時刻前の条件を求める．
   auto pval = _fault_prev_cond(fault);
 
-  return lobs & cval & pval;
+  return cval & pval;
 #else
-  return 0UL;
+  return FSIM_PV_ALL0;
 #endif
 }
 
 // @brief FFR内の伝搬条件を求める．
 // @param[in] fault 対象の故障
 inline
-PackedVal
-FSIM_CLASSNAME::_ffr_prop(SimFault* fault)
+FSIM_PVTYPE
+FSIM_CLASSNAME::_ffr_prop(const SimFault* fault)
 {
-  auto lobs = kPvAll1;
+  auto lobs = FSIM_PV_ALL1;
 
   auto f_node = fault->mNode;
   for ( auto node = f_node; !node->is_ffr_root(); ) {
     auto onode = node->fanout_top();
     auto pos = node->fanout_ipos();
-    lobs &= onode->_calc_gobs(pos);
+    lobs &= calc_gobs(onode, pos, mValArray);
     node = onode;
   }
 
@@ -641,7 +927,7 @@ FSIM_CLASSNAME::_ffr_prop(SimFault* fault)
   if ( f->is_branch_fault() ) {
     // 入力の故障
     auto ipos = fault->mIpos;
-    lobs &= f_node->_calc_gobs(ipos);
+    lobs &= calc_gobs(f_node, ipos, mValArray);
   }
 
   return lobs;
@@ -650,11 +936,11 @@ FSIM_CLASSNAME::_ffr_prop(SimFault* fault)
 // @brief 故障の活性化条件を求める．(縮退故障用)
 // @param[in] fault 対象の故障
 inline
-PackedVal
-FSIM_CLASSNAME::_fault_cond(SimFault* fault)
+FSIM_PVTYPE
+FSIM_CLASSNAME::_fault_cond(const SimFault* fault)
 {
   // 故障の入力側のノードの値
-  auto ival = fault->mInode->val();
+  auto ival = mValArray[fault->mInode->id()];
 
   // それが故障値と異なっていることが条件
   auto valdiff = _fault_diff(fault->mOrigF, ival);
@@ -665,8 +951,8 @@ FSIM_CLASSNAME::_fault_cond(SimFault* fault)
 // @brief 故障の活性化条件を求める．(遷移故障用)
 // @param[in] fault 対象の故障
 inline
-PackedVal
-FSIM_CLASSNAME::_fault_prev_cond(SimFault* fault)
+FSIM_PVTYPE
+FSIM_CLASSNAME::_fault_prev_cond(const SimFault* fault)
 {
   // １時刻前の値が故障値と同じである必要がある．
   auto pval = mPrevValArray[fault->mInode->id()];
@@ -682,13 +968,13 @@ FSIM_CLASSNAME::_fault_prev_cond(SimFault* fault)
 //
 // obs_mask が0のビットのイベントはマスクされる．
 inline
-PackedVal
-FSIM_CLASSNAME::_prop_sim(SimNode* root,
-			  PackedVal obs_mask)
+FSIM_PVTYPE
+FSIM_CLASSNAME::_prop_sim(const SimNode* root,
+			  FSIM_PVTYPE obs_mask)
 {
   if ( root->is_output() ) {
     // 外部出力の場合は無条件で伝搬している．
-    return kPvAll1;
+    return FSIM_PV_ALL1;
   }
 
   // それ以外はイベントドリヴンシミュレーションを行う．
@@ -0,0 +1,79 @@
+
+/// @file GvalProg.cc
+/// @brief GvalProg の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "GvalProg.h"
+#include "SimEval.h"
+#include "ym/Range.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+// クラス GvalProg
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+GvalProg::GvalProg()
+{
+}
+
+// @brief デストラクタ
+GvalProg::~GvalProg()
+{
+}
+
+// @brief 命令列を作る．
+// @param[in] logic_list 論理ノードのリスト(トポロジカル順)
+void
+GvalProg::compile(const vector<const SimNode*>& logic_list)
+{
+  // レベル順に並べる．
+  // 同じレベルのノードはもとの順序を保つ．
+  vector<const SimNode*> node_list(logic_list);
+  std::stable_sort(node_list.begin(), node_list.end(),
+		   [](const SimNode* a, const SimNode* b) {
+		     return a->level() < b->level();
+		   });
+
+  auto n = node_list.size();
+  mOpArray.clear();
+  mOpArray.reserve(n);
+  mOutArray.clear();
+  mOutArray.reserve(n);
+  mFaninPosArray.clear();
+  mFaninPosArray.reserve(n + 1);
+  mFaninArray.clear();
+  for ( auto node: node_list ) {
+    auto ni = node->fanin_num();
+    mOpArray.push_back(node->op());
+    mOutArray.push_back(node->id());
+    mFaninPosArray.push_back(mFaninArray.size());
+    for ( auto i: Range(ni) ) {
+      mFaninArray.push_back(node->fanin_id(i));
+    }
+  }
+  mFaninPosArray.push_back(mFaninArray.size());
+}
+
+// @brief 正常値の計算を行う．
+// @param[in] val_array ノード番号をキーにした値の配列
+void
+GvalProg::eval(FSIM_VALTYPE* val_array) const
+{
+  auto fanin = mFaninArray.data();
+  auto n = mOpArray.size();
+  for ( auto i: Range(n) ) {
+    auto pos = mFaninPosArray[i];
+    auto end = mFaninPosArray[i + 1];
+    val_array[mOutArray[i]] = calc_op(mOpArray[i], &fanin[pos], end - pos, val_array);
+  }
+}
+
+END_NAMESPACE_SATPG_FSIM
@@ -0,0 +1,91 @@
+#ifndef FSIM_GVALPROG_H
+#define FSIM_GVALPROG_H
+
+/// @file GvalProg.h
+/// @brief GvalProg のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include "SimNode.h"
+#include "PackedVal.h"
+#include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+/// @class GvalProg GvalProg.h "GvalProg.h"
+/// @brief 正常値計算用にコンパイルされた命令列
+///
+/// SimNode のネットワークをレベル順に並べた命令列に変換したもの．
+/// 各命令は(命令コード，出力番号，ファンイン番号の並び)からなり，
+/// それぞれ別々の配列に連続して格納される．
+/// 値は故障シミュレータが持つノード番号をキーにした配列を直接読み書き
+/// するので，計算中に SimNode のポインタの参照は行わない．
+//////////////////////////////////////////////////////////////////////
+class GvalProg
+{
+public:
+
+  /// @brief コンストラクタ
+  GvalProg();
+
+  /// @brief コピーコンストラクタは禁止
+  GvalProg(const GvalProg& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  GvalProg&
+  operator=(const GvalProg& src) = delete;
+
+  /// @brief デストラクタ
+  ~GvalProg();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 命令列を作る．
+  /// @param[in] logic_list 論理ノードのリスト(トポロジカル順)
+  void
+  compile(const vector<const SimNode*>& logic_list);
+
+  /// @brief 正常値の計算を行う．
+  /// @param[in] val_array ノード番号をキーにした値の配列
+  ///
+  /// PPI の値は val_array に設定されているものとする．
+  /// 結果も val_array に書き込まれる．
+  void
+  eval(FSIM_VALTYPE* val_array) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 命令コードの配列
+  vector<SimOp> mOpArray;
+
+  // 出力のノード番号の配列
+  vector<int> mOutArray;
+
+  // 各命令のファンインの開始位置の配列
+  // サイズは命令数 + 1
+  vector<int> mFaninPosArray;
+
+  // ファンインのノード番号の配列
+  vector<int> mFaninArray;
+
+};
+
+END_NAMESPACE_SATPG_FSIM
+
+#endif // FSIM_GVALPROG_H
@@ -12,6 +12,7 @@
 #include "TestVector.h"
 #include "NodeValList.h"
 #include "TpgNode.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG_FSIM
@@ -25,10 +26,10 @@ init_val()
 {
 #if FSIM_VAL2
   // デフォルトで 0 にする．
-  return kPvAll0;
+  return FSIM_PV_ALL0;
 #elif FSIM_VAL3
   // デフォルトで X にする．
-  return PackedVal3(kPvAll0, kPvAll0);
+  return FSIM_VALTYPE(FSIM_PV_ALL0, FSIM_PV_ALL0);
 #endif
 }
 
@@ -38,9 +39,9 @@ FSIM_VALTYPE
 int_to_packedval(int val)
 {
 #if FSIM_VAL2
-  return val ? kPvAll1 : kPvAll0;
+  return val ? FSIM_PV_ALL1 : FSIM_PV_ALL0;
 #elif FSIM_VAL3
-  return val ? PackedVal3(kPvAll1) : PackedVal3(kPvAll0);
+  return val ? FSIM_VALTYPE(FSIM_PV_ALL1) : FSIM_VALTYPE(FSIM_PV_ALL0);
 #endif
 }
 
@@ -51,28 +52,30 @@ val3_to_packedval(Val3 val)
 {
 #if FSIM_VAL2
   // Val3::_X は Val3::_0 とみなす．
-  return (val == Val3::_1) ? kPvAll1 : kPvAll0;
+  return (val == Val3::_1) ? FSIM_PV_ALL1 : FSIM_PV_ALL0;
 #elif FSIM_VAL3
   switch ( val ) {
-  case Val3::_X: return PackedVal3(kPvAll0, kPvAll0);
-  case Val3::_0: return PackedVal3(kPvAll1, kPvAll0);
-  case Val3::_1: return PackedVal3(kPvAll0, kPvAll1);
+  case Val3::_X: return FSIM_VALTYPE(FSIM_PV_ALL0, FSIM_PV_ALL0);
+  case Val3::_0: return FSIM_VALTYPE(FSIM_PV_ALL1, FSIM_PV_ALL0);
+  case Val3::_1: return FSIM_VALTYPE(FSIM_PV_ALL0, FSIM_PV_ALL1);
   }
 #endif
 }
 
-// bit のビットに値を設定する．
+// pos 番目のビットに値を設定する．
 inline
 void
 bit_set(FSIM_VALTYPE& val,
 	Val3 ival,
-	PackedVal bit)
+	int pos)
 {
 #if FSIM_VAL2
   if ( ival == Val3::_1 ) {
-    val |= bit;
+    set_bit(val, pos);
   }
 #elif FSIM_VAL3
+  auto bit = FSIM_PV_ALL0;
+  set_bit(bit, pos);
   FSIM_VALTYPE val1 = val3_to_packedval(ival);
   val.set_with_mask(val1, bit);
 #endif
@@ -102,11 +105,9 @@ TvInputVals::~TvInputVals()
 void
 TvInputVals::set_val(FSIM_CLASSNAME& fsim) const
 {
-  int iid = 0;
-  for ( auto simnode: fsim.ppi_list() ) {
+  for ( auto iid: Range(fsim.ppi_num()) ) {
     Val3 val3 = mTestVector.ppi_val(iid);
-    simnode->set_val(val3_to_packedval(val3));
-    ++ iid;
+    fsim.set_ppi_val(iid, val3_to_packedval(val3));
   }
 }
 
@@ -115,11 +116,9 @@ TvInputVals::set_val(FSIM_CLASSNAME& fsim) const
 void
 TvInputVals::set_val1(FSIM_CLASSNAME& fsim) const
 {
-  int iid = 0;
-  for ( auto simnode: fsim.ppi_list() ) {
+  for ( auto iid: Range(fsim.ppi_num()) ) {
     Val3 val3 = mTestVector.ppi_val(iid);
-    simnode->set_val(val3_to_packedval(val3));
-    ++ iid;
+    fsim.set_ppi_val(iid, val3_to_packedval(val3));
   }
 }
 
@@ -128,11 +127,9 @@ TvInputVals::set_val1(FSIM_CLASSNAME& fsim) const
 void
 TvInputVals::set_val2(FSIM_CLASSNAME& fsim) const
 {
-  int iid = 0;
-  for ( auto simnode: fsim.input_list() ) {
+  for ( auto iid: Range(fsim.input_num()) ) {
     Val3 val3 = mTestVector.aux_input_val(iid);
-    simnode->set_val(val3_to_packedval(val3));
-    ++ iid;
+    fsim.set_ppi_val(iid, val3_to_packedval(val3));
   }
 }
 
@@ -143,19 +140,20 @@ TvInputVals::set_val2(FSIM_CLASSNAME& fsim) const
 
 // @brief コンストラクタ
 // @param[in] pat_map パタンのセットされているビットに1を立てたビットマップ
-// @param[in] pat_array パタンの配列(サイズは kPvBitLen の固定長)
-Tv2InputVals::Tv2InputVals(PackedVal pat_map,
-			   TestVector pat_array[]) :
-  mPatMap(pat_map)
+// @param[in] pat_array パタンの配列(サイズは FSIM_PV_BITLEN の固定長)
+//
+// pat_array の内容はコピーせずに参照する．
+Tv2InputVals::Tv2InputVals(FSIM_PVTYPE pat_map,
+			   const TestVector pat_array[]) :
+  mPatMap(pat_map),
+  mPatArray(pat_array)
 {
   // パタンのセットされている最初のビット位置を求めておく．
-  mPatFirstBit = kPvBitLen;
-  for ( int i = 0; i < kPvBitLen; ++ i ) {
-    if ( mPatMap & (1ULL << i) ) {
-      mPatArray[i] = pat_array[i];
-      if ( mPatFirstBit > i ) {
-	mPatFirstBit = i;
-      }
+  mPatFirstBit = FSIM_PV_BITLEN;
+  for ( int i = 0; i < FSIM_PV_BITLEN; ++ i ) {
+    if ( get_bit(mPatMap, i) ) {
+      mPatFirstBit = i;
+      break;
     }
   }
 }
@@ -171,17 +169,14 @@ void
 Tv2InputVals::set_val(FSIM_CLASSNAME& fsim) const
 {
   // 設定されていないビットはどこか他の設定されているビットをコピーする．
-  int iid = 0;
-  for ( auto simnode: fsim.ppi_list() ) {
+  for ( auto iid: Range(fsim.ppi_num()) ) {
     FSIM_VALTYPE val = init_val();
-    PackedVal bit = 1ULL;
-    for ( int i = 0; i < kPvBitLen; ++ i, bit <<= 1 ) {
-      int pos = (mPatMap & bit) ? i : mPatFirstBit;
+    for ( int i = 0; i < FSIM_PV_BITLEN; ++ i ) {
+      int pos = get_bit(mPatMap, i) ? i : mPatFirstBit;
       Val3 ival = mPatArray[pos].ppi_val(iid);
-      bit_set(val, ival, bit);
+      bit_set(val, ival, i);
     }
-    simnode->set_val(val);
-    ++ iid;
+    fsim.set_ppi_val(iid, val);
   }
 }
 
@@ -191,17 +186,14 @@ void
 Tv2InputVals::set_val1(FSIM_CLASSNAME& fsim) const
 {
   // 設定されていないビットはどこか他の設定されているビットをコピーする．
-  int iid = 0;
-  for ( auto simnode: fsim.ppi_list() ) {
+  for ( auto iid: Range(fsim.ppi_num()) ) {
     FSIM_VALTYPE val = init_val();
-    PackedVal bit = 1ULL;
-    for ( int i = 0; i < kPvBitLen; ++ i, bit <<= 1 ) {
-      int pos = (mPatMap & bit) ? i : mPatFirstBit;
+    for ( int i = 0; i < FSIM_PV_BITLEN; ++ i ) {
+      int pos = get_bit(mPatMap, i) ? i : mPatFirstBit;
       Val3 ival = mPatArray[pos].ppi_val(iid);
-      bit_set(val, ival, bit);
+      bit_set(val, ival, i);
     }
-    simnode->set_val(val);
-    ++ iid;
+    fsim.set_ppi_val(iid, val);
   }
 }
 
@@ -211,17 +203,14 @@ void
 Tv2InputVals::set_val2(FSIM_CLASSNAME& fsim) const
 {
   // 設定されていないビットはどこか他の設定されているビットをコピーする．
-  int iid = 0;
-  for ( auto simnode: fsim.input_list() ) {
+  for ( auto iid: Range(fsim.input_num()) ) {
     FSIM_VALTYPE val = init_val();
-    PackedVal bit = 1ULL;
-    for ( int i = 0; i < kPvBitLen; ++ i, bit <<= 1 ) {
-      int pos = (mPatMap & bit) ? i : mPatFirstBit;
+    for ( int i = 0; i < FSIM_PV_BITLEN; ++ i ) {
+      int pos = get_bit(mPatMap, i) ? i : mPatFirstBit;
       Val3 ival = mPatArray[pos].aux_input_val(iid);
-      bit_set(val, ival, bit);
+      bit_set(val, ival, i);
     }
-    simnode->set_val(val);
-    ++ iid;
+    fsim.set_ppi_val(iid, val);
   }
 }
 
@@ -248,15 +237,14 @@ void
 NvlInputVals::set_val(FSIM_CLASSNAME& fsim) const
 {
   FSIM_VALTYPE val0 = init_val();
-  for ( auto simnode: fsim.ppi_list() ) {
-    simnode->set_val(val0);
+  for ( auto iid: Range(fsim.ppi_num()) ) {
+    fsim.set_ppi_val(iid, val0);
   }
 
   for ( auto nv: mAssignList ) {
     ASSERT_COND( nv.time() == 1 );
     int iid = nv.node()->input_id();
-    SimNode* simnode = fsim.ppi(iid);
-    simnode->set_val(int_to_packedval(nv.val()));
+    fsim.set_ppi_val(iid, int_to_packedval(nv.val()));
   }
 }
 
@@ -266,15 +254,14 @@ void
 NvlInputVals::set_val1(FSIM_CLASSNAME& fsim) const
 {
   FSIM_VALTYPE val0 = init_val();
-  for ( auto simnode: fsim.ppi_list() ) {
-    simnode->set_val(val0);
+  for ( auto iid: Range(fsim.ppi_num()) ) {
+    fsim.set_ppi_val(iid, val0);
   }
 
   for ( auto nv: mAssignList ) {
     if ( nv.time() == 0 ) {
       int iid = nv.node()->input_id();
-      SimNode* simnode = fsim.ppi(iid);
-      simnode->set_val(int_to_packedval(nv.val()));
+      fsim.set_ppi_val(iid, int_to_packedval(nv.val()));
     }
   }
 }
@@ -285,15 +272,14 @@ void
 NvlInputVals::set_val2(FSIM_CLASSNAME& fsim) const
 {
   FSIM_VALTYPE val0 = init_val();
-  for ( auto simnode: fsim.input_list() ) {
-    simnode->set_val(val0);
+  for ( auto iid: Range(fsim.input_num()) ) {
+    fsim.set_ppi_val(iid, val0);
   }
 
   for ( auto nv: mAssignList ) {
     if ( nv.time() == 1 ) {
       int iid = nv.node()->input_id();
-      SimNode* simnode = fsim.ppi(iid);
-      simnode->set_val(int_to_packedval(nv.val()));
+      fsim.set_ppi_val(iid, int_to_packedval(nv.val()));
     }
   }
 }
@@ -138,9 +138,9 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] pat_map パタンのセットされているビットに1を立てたビットマップ
-  /// @param[in] pat_array パタンの配列(サイズは kPvBitLen の固定長)
-  Tv2InputVals(PackedVal pat_map,
-	       TestVector pat_array[]);
+  /// @param[in] pat_array パタンの配列(サイズは FSIM_PV_BITLEN の固定長)
+  Tv2InputVals(FSIM_PVTYPE pat_map,
+	       const TestVector pat_array[]);
 
   /// @brief デストラクタ
   virtual
@@ -183,14 +183,16 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // セットされているパタンを表すビットマップ
-  PackedVal mPatMap;
+  FSIM_PVTYPE mPatMap;
 
   // mPatMap の最初の1のビット位置
-  // 全て０の場合には kPvBitLen が入る．
+  // 全て０の場合には FSIM_PV_BITLEN が入る．
   int mPatFirstBit;
 
   // テストベクタの配列
-  TestVector mPatArray[kPvBitLen];
+  // FSIM_PV_BITLEN が大きいとコピーのコストが無視できないので
+  // FsimX の持つパタンバッファを直接参照する．
+  const TestVector* mPatArray;
 
 };
 
@@ -0,0 +1,174 @@
+
+/// @file LocalEventQ.cc
+/// @brief LocalEventQ の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LocalEventQ.h"
+#include "SimEval.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+BEGIN_NONAMESPACE
+
+// mask が1のビットだけ new_val を，それ以外は old_val を選ぶ．
+inline
+FSIM_VALTYPE
+merge_val(FSIM_VALTYPE old_val,
+	  FSIM_VALTYPE new_val,
+	  FSIM_PVTYPE mask)
+{
+#if FSIM_VAL2
+  return (old_val & ~mask) | (new_val & mask);
+#elif FSIM_VAL3
+  old_val.set_with_mask(new_val, mask);
+  return old_val;
+#endif
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// スレッドごとに用いるイベントキュー
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LocalEventQ::LocalEventQ() :
+  mArraySize(0),
+  mArray(nullptr),
+  mCurLevel(0),
+  mNum(0),
+  mNodeNum(0),
+  mLinkArray(nullptr),
+  mQueueFlagArray(nullptr),
+  mGvalArray(nullptr),
+  mValArray(nullptr),
+  mStampArray(nullptr),
+  mCurStamp(1),
+  mClearArray(nullptr),
+  mClearPos(0)
+{
+}
+
+// @brief デストラクタ
+LocalEventQ::~LocalEventQ()
+{
+  delete [] mArray;
+  delete [] mLinkArray;
+  delete [] mQueueFlagArray;
+  delete [] mValArray;
+  delete [] mStampArray;
+  delete [] mClearArray;
+}
+
+// @brief 初期化を行う．
+// @param[in] max_level 最大レベル
+// @param[in] node_num ノード数
+// @param[in] gval_array ノード番号をキーにした正常値の配列
+void
+LocalEventQ::init(int max_level,
+		  int node_num,
+		  const FSIM_VALTYPE* gval_array)
+{
+  if ( max_level >= mArraySize ) {
+    delete [] mArray;
+    mArraySize = max_level + 1;
+    mArray = new const SimNode*[mArraySize];
+  }
+  if ( node_num > mNodeNum ) {
+    delete [] mLinkArray;
+    delete [] mQueueFlagArray;
+    delete [] mValArray;
+    delete [] mStampArray;
+    delete [] mClearArray;
+    mNodeNum = node_num;
+    mLinkArray = new const SimNode*[mNodeNum];
+    mQueueFlagArray = new bool[mNodeNum];
+    mValArray = new FSIM_VALTYPE[mNodeNum];
+    mStampArray = new unsigned int[mNodeNum];
+    mClearArray = new RestoreInfo[mNodeNum];
+  }
+
+  mCurLevel = 0;
+  for ( auto i: Range(0, mArraySize) ) {
+    mArray[i] = nullptr;
+  }
+  for ( auto i: Range(0, mNodeNum) ) {
+    mQueueFlagArray[i] = false;
+    mStampArray[i] = 0;
+  }
+  mGvalArray = gval_array;
+  mCurStamp = 1;
+  mNum = 0;
+  mClearPos = 0;
+}
+
+// @brief 正常値が更新されたことを知らせる．
+void
+LocalEventQ::update_gval()
+{
+  ++ mCurStamp;
+  if ( mCurStamp == 0 ) {
+    // 一周したらスタンプを全てクリアする．
+    for ( auto i: Range(0, mNodeNum) ) {
+      mStampArray[i] = 0;
+    }
+    mCurStamp = 1;
+  }
+}
+
+// @brief root から故障伝搬シミュレーションを行う．
+// @param[in] root FFR の根のノード
+// @param[in] valmask 反転マスク
+// @return 出力における変化ビットを返す．
+FSIM_PVTYPE
+LocalEventQ::simulate(const SimNode* root,
+		      FSIM_PVTYPE valmask)
+{
+  // 初期イベントは一つだけなので即座に適用する．
+  auto root_id = root->id();
+  sync_gval(root_id);
+  set_val(root_id, mValArray[root_id] ^ valmask);
+  put_fanouts(root);
+
+  // どこかの外部出力で検出されたことを表すビット
+  auto obs = FSIM_PV_ALL0;
+  for ( ; ; ) {
+    auto node = get();
+    // イベントが残っていなければ終わる．
+    if ( node == nullptr ) break;
+
+    // すでに検出済みのビットはマスクしておく
+    // これは無駄なイベントの発生を抑える．
+    auto id = node->id();
+    sync_fanins(node);
+    auto old_val = mValArray[id];
+    auto new_val = merge_val(old_val, calc_val(node, mValArray), ~obs);
+    if ( new_val != old_val ) {
+      set_val(id, new_val);
+      if ( node->is_output() ) {
+	auto dbits = diff(new_val, old_val);
+	obs |= dbits;
+      }
+      else {
+	put_fanouts(node);
+      }
+    }
+  }
+
+  // 値の変わったノードを正常値にもどしておく
+  for ( auto i: Range(0, mClearPos) ) {
+    auto& rinfo = mClearArray[i];
+    mValArray[rinfo.mId] = rinfo.mVal;
+  }
+  mClearPos = 0;
+
+  return obs;
+}
+
+END_NAMESPACE_SATPG_FSIM
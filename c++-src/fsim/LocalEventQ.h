@@ -0,0 +1,292 @@
+#ifndef FSIM_LOCALEVENTQ_H
+#define FSIM_LOCALEVENTQ_H
+
+/// @file LocalEventQ.h
+/// @brief LocalEventQ のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include "SimNode.h"
+#include "PackedVal.h"
+#include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+/// @class LocalEventQ LocalEventQ.h "LocalEventQ.h"
+/// @brief スレッドごとに用いる故障シミュレーション用のイベントキュー
+///
+/// EventQ と異なり故障値を故障シミュレータの値の配列ではなく
+/// 自身の配列に持つ．正常値の配列は読み出すだけなので，
+/// 複数の LocalEventQ を別々のスレッドで同時に動かすことができる．<br>
+/// 正常値は全体をコピーせず，イベントの通過するノードとそのファンインの
+/// 分だけを必要になった時点で正常値の配列から取り込む．<br>
+/// ppsfp 専用なので初期イベントは一つだけで，即座に適用される．
+//////////////////////////////////////////////////////////////////////
+class LocalEventQ
+{
+public:
+
+  /// @brief コンストラクタ
+  LocalEventQ();
+
+  /// @brief コピーコンストラクタは禁止
+  LocalEventQ(const LocalEventQ& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  LocalEventQ&
+  operator=(const LocalEventQ& src) = delete;
+
+  /// @brief デストラクタ
+  ~LocalEventQ();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化を行う．
+  /// @param[in] max_level 最大レベル
+  /// @param[in] node_num ノード数
+  /// @param[in] gval_array ノード番号をキーにした正常値の配列
+  void
+  init(int max_level,
+       int node_num,
+       const FSIM_VALTYPE* gval_array);
+
+  /// @brief 正常値が更新されたことを知らせる．
+  ///
+  /// 正常値を計算し直したあと，simulate() を呼ぶ前に呼ぶ必要がある．
+  /// 取り込み済みの正常値を無効にするだけなので定数時間で終わる．
+  void
+  update_gval();
+
+  /// @brief root から故障伝搬シミュレーションを行う．
+  /// @param[in] root FFR の根のノード
+  /// @param[in] valmask 反転マスク
+  /// @return 出力における変化ビットを返す．
+  FSIM_PVTYPE
+  simulate(const SimNode* root,
+	   FSIM_PVTYPE valmask);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ファンアウトのノードをキューに積む．
+  /// @param[in] node 対象のノード
+  void
+  put_fanouts(const SimNode* node);
+
+  /// @brief キューに積む
+  /// @param[in] node 対象のノード
+  void
+  put(const SimNode* node);
+
+  /// @brief キューから取り出す．
+  /// @retval nullptr キューが空だった．
+  const SimNode*
+  get();
+
+  /// @brief ノードの正常値を必要なら取り込む．
+  /// @param[in] id ノード番号
+  void
+  sync_gval(int id);
+
+  /// @brief ノードとそのファンインの正常値を必要なら取り込む．
+  /// @param[in] node 対象のノード
+  void
+  sync_fanins(const SimNode* node);
+
+  /// @brief ノードの値を変更し，clear リストに追加する．
+  /// @param[in] id ノード番号
+  /// @param[in] new_val 新しい値
+  void
+  set_val(int id,
+	  FSIM_VALTYPE new_val);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 値を元に戻すための構造体
+  struct RestoreInfo
+  {
+    // ノード番号
+    int mId;
+
+    // 元の値
+    FSIM_VALTYPE mVal;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // mArray のサイズ
+  int mArraySize;
+
+  // キューの先頭ノードの配列
+  const SimNode** mArray;
+
+  // 現在のレベル．
+  int mCurLevel;
+
+  // キューに入っているノード数
+  int mNum;
+
+  // 以下の配列のサイズ
+  int mNodeNum;
+
+  // ノード番号をキーにしてキューの次の要素を納める配列
+  const SimNode** mLinkArray;
+
+  // ノード番号をキーにしてキューに入っているかどうかを表す配列
+  bool* mQueueFlagArray;
+
+  // ノード番号をキーにした正常値の配列
+  // 故障シミュレータが持っているものを借りている．
+  const FSIM_VALTYPE* mGvalArray;
+
+  // ノード番号をキーにして値を納める配列
+  // mStampArray の値が mCurStamp と等しい要素のみ有効で，
+  // シミュレーションの前後では正常値と一致している．
+  FSIM_VALTYPE* mValArray;
+
+  // ノード番号をキーにして mValArray に正常値を取り込んだ時の
+  // mCurStamp の値を納める配列
+  unsigned int* mStampArray;
+
+  // 現在の正常値を表すスタンプ
+  unsigned int mCurStamp;
+
+  // clear 用の情報の配列
+  RestoreInfo* mClearArray;
+
+  // mCelarArray の最後の要素位置
+  int mClearPos;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ファンアウトのノードをキューに積む．
+// @param[in] node 対象のノード
+inline
+void
+LocalEventQ::put_fanouts(const SimNode* node)
+{
+  auto no = node->fanout_num();
+  if ( no == 1 ) {
+    put(node->fanout_top());
+  }
+  else {
+    for ( auto i: Range(0, no) ) {
+      put(node->fanout(i));
+    }
+  }
+}
+
+// @brief キューに積む
+inline
+void
+LocalEventQ::put(const SimNode* node)
+{
+  auto id = node->id();
+  if ( !mQueueFlagArray[id] ) {
+    mQueueFlagArray[id] = true;
+    auto level = node->level();
+    auto& w = mArray[level];
+    mLinkArray[id] = w;
+    w = node;
+    if ( mNum == 0 || mCurLevel > level ) {
+      mCurLevel = level;
+    }
+    ++ mNum;
+  }
+}
+
+// @brief キューから取り出す．
+// @retval nullptr キューが空だった．
+inline
+const SimNode*
+LocalEventQ::get()
+{
+  if ( mNum > 0 ) {
+    // mNum が正しければ mCurLevel がオーバーフローすることはない．
+    for ( ; ; ++ mCurLevel ) {
+      auto& w = mArray[mCurLevel];
+      auto node = w;
+      if ( node != nullptr ) {
+	auto id = node->id();
+	mQueueFlagArray[id] = false;
+	w = mLinkArray[id];
+	-- mNum;
+	return node;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// @brief ノードの正常値を必要なら取り込む．
+// @param[in] id ノード番号
+inline
+void
+LocalEventQ::sync_gval(int id)
+{
+  if ( mStampArray[id] != mCurStamp ) {
+    mStampArray[id] = mCurStamp;
+    mValArray[id] = mGvalArray[id];
+  }
+}
+
+// @brief ノードとそのファンインの正常値を必要なら取り込む．
+// @param[in] node 対象のノード
+inline
+void
+LocalEventQ::sync_fanins(const SimNode* node)
+{
+  sync_gval(node->id());
+  auto ni = node->fanin_num();
+  for ( auto i: Range(0, ni) ) {
+    sync_gval(node->fanin_id(i));
+  }
+}
+
+// @brief ノードの値を変更し，clear リストに追加する．
+// @param[in] id ノード番号
+// @param[in] new_val 新しい値
+inline
+void
+LocalEventQ::set_val(int id,
+		     FSIM_VALTYPE new_val)
+{
+  auto& rinfo = mClearArray[mClearPos];
+  rinfo.mId = id;
+  rinfo.mVal = mValArray[id];
+  ++ mClearPos;
+  mValArray[id] = new_val;
+}
+
+END_NAMESPACE_SATPG_FSIM
+
+#endif // FSIM_LOCALEVENTQ_H
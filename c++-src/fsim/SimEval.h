@@ -0,0 +1,178 @@
+#ifndef FSIM_SIMEVAL_H
+#define FSIM_SIMEVAL_H
+
+/// @file SimEval.h
+/// @brief SimNode の値の計算を行う関数群
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include "SimNode.h"
+#include "PackedVal.h"
+#include "PackedVal3.h"
+#include "PackedValW.h"
+#include "PackedVal3W.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+// SimNode は値を持たないので，値はノード番号をキーにした配列で受け取る．
+// 故障シミュレータの種類ごとに値の型が異なるのでここで定義する．
+//////////////////////////////////////////////////////////////////////
+
+/// @brief 演算コードに従って出力値を計算する．
+/// @param[in] op 演算コード
+/// @param[in] f ファンインのノード番号の配列
+/// @param[in] ni ファンイン数
+/// @param[in] val ノード番号をキーにした値の配列
+///
+/// op が SimOp::Input の場合は呼んではいけない．
+inline
+FSIM_VALTYPE
+calc_op(SimOp op,
+	const int* f,
+	int ni,
+	const FSIM_VALTYPE* val)
+{
+  switch ( op ) {
+  case SimOp::Buff:  return  val[f[0]];
+  case SimOp::Not:   return ~val[f[0]];
+
+  case SimOp::And2:  return  (val[f[0]] & val[f[1]]);
+  case SimOp::And3:  return  (val[f[0]] & val[f[1]] & val[f[2]]);
+  case SimOp::And4:  return  (val[f[0]] & val[f[1]] & val[f[2]] & val[f[3]]);
+  case SimOp::Nand2: return ~(val[f[0]] & val[f[1]]);
+  case SimOp::Nand3: return ~(val[f[0]] & val[f[1]] & val[f[2]]);
+  case SimOp::Nand4: return ~(val[f[0]] & val[f[1]] & val[f[2]] & val[f[3]]);
+
+  case SimOp::Or2:   return  (val[f[0]] | val[f[1]]);
+  case SimOp::Or3:   return  (val[f[0]] | val[f[1]] | val[f[2]]);
+  case SimOp::Or4:   return  (val[f[0]] | val[f[1]] | val[f[2]] | val[f[3]]);
+  case SimOp::Nor2:  return ~(val[f[0]] | val[f[1]]);
+  case SimOp::Nor3:  return ~(val[f[0]] | val[f[1]] | val[f[2]]);
+  case SimOp::Nor4:  return ~(val[f[0]] | val[f[1]] | val[f[2]] | val[f[3]]);
+
+  case SimOp::Xor2:  return  (val[f[0]] ^ val[f[1]]);
+  case SimOp::Xnor2: return ~(val[f[0]] ^ val[f[1]]);
+
+  case SimOp::AndN:
+  case SimOp::NandN:
+    {
+      auto tmp = val[f[0]];
+      for ( int i = 1; i < ni; ++ i ) {
+	tmp &= val[f[i]];
+      }
+      return ( op == SimOp::AndN ) ? tmp : ~tmp;
+    }
+
+  case SimOp::OrN:
+  case SimOp::NorN:
+    {
+      auto tmp = val[f[0]];
+      for ( int i = 1; i < ni; ++ i ) {
+	tmp |= val[f[i]];
+      }
+      return ( op == SimOp::OrN ) ? tmp : ~tmp;
+    }
+
+  case SimOp::XorN:
+  case SimOp::XnorN:
+    {
+      auto tmp = val[f[0]];
+      for ( int i = 1; i < ni; ++ i ) {
+	tmp ^= val[f[i]];
+      }
+      return ( op == SimOp::XorN ) ? tmp : ~tmp;
+    }
+
+  case SimOp::Input:
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return val[f[0]];
+}
+
+/// @brief ノードの出力値を計算する．
+/// @param[in] node 対象のノード(入力ノードであってはならない)
+/// @param[in] val_array ノード番号をキーにした値の配列
+inline
+FSIM_VALTYPE
+calc_val(const SimNode* node,
+	 const FSIM_VALTYPE* val_array)
+{
+  return calc_op(node->op(), node->fanin_id_array(), node->fanin_num(), val_array);
+}
+
+/// @brief ゲートの入力から出力までの可観測性を計算する．
+/// @param[in] node 対象のノード(入力ノードであってはならない)
+/// @param[in] ipos 入力位置
+/// @param[in] val_array ノード番号をキーにした値の配列
+///
+/// AND/NAND は ipos 以外の入力が 1，OR/NOR は 0 の時に観測可能となる．
+/// XOR/XNOR は 2値なら常に，3値なら ipos 以外の入力が X でない時に
+/// 観測可能となる．
+inline
+FSIM_PVTYPE
+calc_gobs(const SimNode* node,
+	  int ipos,
+	  const FSIM_VALTYPE* val_array)
+{
+  auto ni = node->fanin_num();
+  auto f = node->fanin_id_array();
+  auto obs = FSIM_PV_ALL1;
+  switch ( node->op() ) {
+  case SimOp::Buff:
+  case SimOp::Not:
+    break;
+
+  case SimOp::And2: case SimOp::And3: case SimOp::And4: case SimOp::AndN:
+  case SimOp::Nand2: case SimOp::Nand3: case SimOp::Nand4: case SimOp::NandN:
+    for ( int i = 0; i < ni; ++ i ) {
+      if ( i != ipos ) {
+#if FSIM_VAL2
+	obs &= val_array[f[i]];
+#elif FSIM_VAL3
+	obs &= val_array[f[i]].val1();
+#endif
+      }
+    }
+    break;
+
+  case SimOp::Or2: case SimOp::Or3: case SimOp::Or4: case SimOp::OrN:
+  case SimOp::Nor2: case SimOp::Nor3: case SimOp::Nor4: case SimOp::NorN:
+    for ( int i = 0; i < ni; ++ i ) {
+      if ( i != ipos ) {
+#if FSIM_VAL2
+	obs &= ~val_array[f[i]];
+#elif FSIM_VAL3
+	obs &= val_array[f[i]].val0();
+#endif
+      }
+    }
+    break;
+
+  case SimOp::Xor2: case SimOp::XorN:
+  case SimOp::Xnor2: case SimOp::XnorN:
+#if FSIM_VAL3
+    for ( int i = 0; i < ni; ++ i ) {
+      if ( i != ipos ) {
+	obs &= val_array[f[i]].val01();
+      }
+    }
+#endif
+    break;
+
+  case SimOp::Input:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+  return obs;
+}
+
+END_NAMESPACE_SATPG_FSIM
+
+#endif // FSIM_SIMEVAL_H
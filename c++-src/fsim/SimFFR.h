@@ -5,14 +5,14 @@
 /// @brief SimFFR のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2016 Yusuke Matsunaga
+/// Copyright (C) 2016, 2018 Yusuke Matsunaga
 /// All rights reserved.
 
 
-#include "fsim_nsdef.h"
+#include "satpg.h"
 
 
-BEGIN_NAMESPACE_SATPG_FSIM
+BEGIN_NAMESPACE_SATPG
 
 class SimFault;
 class SimNode;
@@ -20,6 +20,9 @@ class SimNode;
 //////////////////////////////////////////////////////////////////////
 /// @class SimFFR SimFFR.h "SimFFR.h"
 /// @brief Fanout-Free-Region を表すクラス
+///
+/// 構造に関する情報だけを持つ．FFR 内の可観測性を計算する作業領域は
+/// 故障シミュレータごとにノード番号をキーにした配列で持つ．
 //////////////////////////////////////////////////////////////////////
 class SimFFR
 {
@@ -43,20 +46,39 @@ public:
 
   /// @brief 根のノードをセットする．
   void
-  set_root(SimNode* root);
+  set_root(const SimNode* root);
 
   /// @brief 根のノードを得る．
-  SimNode*
+  const SimNode*
   root() const;
 
   /// @brief このFFRの故障リストに故障を追加する．
   void
-  add_fault(SimFault* f);
+  add_fault(const SimFault* f);
 
   /// @brief このFFRに属する故障リストを得る．
-  const vector<SimFault*>&
+  const vector<const SimFault*>&
   fault_list() const;
 
+  /// @brief このFFRにノードを追加する．
+  /// @param[in] node 対象のノード
+  ///
+  /// 最初に根のノードを追加し，以降はファンアウト先のノードが
+  /// 追加された後で追加しなければならない．
+  void
+  add_node(const SimNode* node);
+
+  /// @brief このFFRに属するノード数を得る．
+  int
+  node_num() const;
+
+  /// @brief このFFRに属するノードを得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < node_num() )
+  ///
+  /// 0 番目は根のノードとなる．
+  const SimNode*
+  node(int pos) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -64,10 +86,14 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   // 根のノード
-  SimNode* mRoot;
+  const SimNode* mRoot;
 
   // この FFR に属する故障のリスト
-  vector<SimFault*> mFaultList;
+  vector<const SimFault*> mFaultList;
+
+  // この FFR に属するノードのリスト
+  // 根から出力側が先になるように並んでいる．
+  vector<const SimNode*> mNodeList;
 
 };
 
@@ -78,7 +104,8 @@ private:
 
 // @brief コンストラクタ
 inline
-SimFFR::SimFFR()
+SimFFR::SimFFR() :
+  mRoot(nullptr)
 {
 }
 
@@ -91,14 +118,14 @@ SimFFR::~SimFFR()
 // @brief 根のノードをセットする．
 inline
 void
-SimFFR::set_root(SimNode* root)
+SimFFR::set_root(const SimNode* root)
 {
   mRoot = root;
 }
 
 // @brief 根のノードを得る．
 inline
-SimNode*
+const SimNode*
 SimFFR::root() const
 {
   return mRoot;
@@ -107,19 +134,47 @@ SimFFR::root() const
 // @brief このFFRの故障リストに故障を追加する．
 inline
 void
-SimFFR::add_fault(SimFault* f)
+SimFFR::add_fault(const SimFault* f)
 {
   mFaultList.push_back(f);
 }
 
 // @brief このFFRに属する故障リストを得る．
 inline
-const vector<SimFault*>&
+const vector<const SimFault*>&
 SimFFR::fault_list() const
 {
   return mFaultList;
 }
 
-END_NAMESPACE_SATPG_FSIM
+// @brief このFFRにノードを追加する．
+// @param[in] node 対象のノード
+inline
+void
+SimFFR::add_node(const SimNode* node)
+{
+  mNodeList.push_back(node);
+}
+
+// @brief このFFRに属するノード数を得る．
+inline
+int
+SimFFR::node_num() const
+{
+  return mNodeList.size();
+}
+
+// @brief このFFRに属するノードを得る．
+// @param[in] pos 位置番号 ( 0 <= pos < node_num() )
+inline
+const SimNode*
+SimFFR::node(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < node_num() );
+
+  return mNodeList[pos];
+}
+
+END_NAMESPACE_SATPG
 
 #endif // SIMFFR_H
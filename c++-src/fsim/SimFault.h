@@ -8,16 +8,20 @@
 /// Copyright (C) 2016, 2018 Yusuke Matsunaga
 /// All rights reserved.
 
-#include "fsim_nsdef.h"
+#include "satpg.h"
 
 
-BEGIN_NAMESPACE_SATPG_FSIM
+BEGIN_NAMESPACE_SATPG
 
 class SimNode;
 
 //////////////////////////////////////////////////////////////////////
 /// @class SimFault SimFault.h "SimFault.h"
 /// @brief 故障シミュレーション用の故障関係のデータ構造
+///
+/// 構造に関する情報だけを持ち，SimTopology を共有する全ての
+/// 故障シミュレータから参照される．スキップマークや検出回数などの
+/// 状態は故障シミュレータごとに mId をキーにした配列で持つ．
 //////////////////////////////////////////////////////////////////////
 class SimFault
 {
@@ -40,22 +44,24 @@ public:
 public:
 
   /// @brief 内容を設定する便利関数
+  /// @param[in] id 通し番号
   /// @param[in] f オリジナルの故障
   /// @param[in] node 対応する SimNode
   /// @param[in] ipos 入力番号
   /// @param[in] inode 入力に対応する SimNode
   /// @note ipos と inode は f が入力の故障の時のみ意味を持つ．
   void
-  set(const TpgFault* f,
-      SimNode* node,
+  set(int id,
+      const TpgFault* f,
+      const SimNode* node,
       int ipos,
-      SimNode* inode)
+      const SimNode* inode)
   {
+    mId = id;
     mOrigF = f;
     mNode = node;
     mIpos = ipos;
     mInode = inode;
-    mSkip = true;
   }
 
 
@@ -64,26 +70,23 @@ public:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // SimTopology の故障の配列上の位置
+  int mId;
+
   // 元の故障
   const TpgFault* mOrigF;
 
   // 故障のあるゲート
-  SimNode* mNode;
+  const SimNode* mNode;
 
   // 入力の故障の場合の入力位置
   int mIpos;
 
   // 入力の故障の場合の入力のゲート
-  SimNode* mInode;
-
-  // 現在計算中のローカルな故障伝搬マスク
-  PackedVal mObsMask;
-
-  // スキップフラグ
-  bool mSkip;
+  const SimNode* mInode;
 
 };
 
-END_NAMESPACE_SATPG_FSIM
+END_NAMESPACE_SATPG
 
 #endif // SIMFAULT_H
@@ -1,4 +1,4 @@
-﻿
+
 /// @file SimNode.cc
 /// @brief SimNode の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
@@ -8,150 +8,220 @@
 
 
 #include "SimNode.h"
-#include "SnInput.h"
-#include "SnBuff.h"
-#include "SnAnd.h"
-#include "SnOr.h"
-#include "SnXor.h"
-#include "GateType.h"
+#include "SimNodeArena.h"
 #include "ym/Range.h"
+#include <new>
 
 
-BEGIN_NAMESPACE_SATPG_FSIM
+BEGIN_NAMESPACE_SATPG
 
 //////////////////////////////////////////////////////////////////////
 // 故障シミュレーション用のノードを表すクラス
 //////////////////////////////////////////////////////////////////////
 
-// コンストラクタ
-SimNode::SimNode(int id) :
+// @brief コンストラクタ
+// @param[in] id ノード番号
+// @param[in] op 演算コード
+// @param[in] inputs ファンインのノードのリスト
+SimNode::SimNode(int id,
+		 SimOp op,
+		 const vector<SimNode*>& inputs) :
   mId(id),
+  mOp(op),
   mFanoutNum(0),
-  mFanoutTop(nullptr),
-  mLevel(0)
+  mFanoutTop(0),
+  mLevel(0),
+  mFaninNum(inputs.size())
 {
-}
-
-// デストラクタ
-SimNode::~SimNode()
-{
-  if ( fanout_num() > 1 ) {
-    auto fanouts = reinterpret_cast<SimNode**>(mFanoutTop);
-    delete [] fanouts;
+  // レベルはファンインの最大値 + 1
+  int max_level = -1;
+  for ( auto i: Range(mFaninNum) ) {
+    auto input = inputs[i];
+    mFanins[i] = input->id();
+    if ( max_level < input->level() ) {
+      max_level = input->level();
+    }
   }
+  mLevel = max_level + 1;
 }
 
 // @brief 入力ノードを生成するクラスメソッド
+// @param[in] arena 領域を確保するアリーナ
+// @param[in] id ノード番号
 SimNode*
-SimNode::new_input(int id)
+SimNode::new_input(SimNodeArena& arena,
+		   int id)
 {
-  return new SnInput(id);
+  void* p = arena.alloc(node_size(0));
+  return new (p) SimNode(id, SimOp::Input, vector<SimNode*>());
 }
 
 // @brief ゲートを生成するクラスメソッド
+// @param[in] arena 領域を確保するアリーナ
+// @param[in] id ノード番号
+// @param[in] type ゲートの種類
+// @param[in] inputs ファンインのノードのリスト
 SimNode*
-SimNode::new_gate(int id,
+SimNode::new_gate(SimNodeArena& arena,
+		  int id,
 		  GateType type,
 		  const vector<SimNode*>& inputs)
 {
-  SimNode* node = nullptr;
-  auto ni = inputs.size();
+  int ni = inputs.size();
+  auto op = opcode(type, ni);
+  void* p = arena.alloc(node_size(ni));
+  return new (p) SimNode(id, op, inputs);
+}
+
+// @brief ノードの生成に必要な領域のサイズを返す．
+// @param[in] ni ファンイン数
+//
+// 入力ノードの場合は ni = 0 とする．
+SizeType
+SimNode::node_size(int ni)
+{
+  // mFanins の1要素分はクラスの中に含まれている．
+  if ( ni < 1 ) {
+    ni = 1;
+  }
+  return sizeof(SimNode) + sizeof(int) * (ni - 1);
+}
+
+// @brief ゲートの種類とファンイン数から演算コードを求める．
+// @param[in] type ゲートの種類
+// @param[in] ni ファンイン数
+SimOp
+SimNode::opcode(GateType type,
+		int ni)
+{
   switch ( type ) {
+  case GateType::Input:
+    ASSERT_COND( ni == 0 );
+    return SimOp::Input;
+
   case GateType::Buff:
     ASSERT_COND( ni == 1 );
-
-    node = new SnBuff(id, inputs);
-    break;
+    return SimOp::Buff;
 
   case GateType::Not:
     ASSERT_COND( ni == 1 );
-
-    node = new SnNot(id, inputs);
-    break;
+    return SimOp::Not;
 
   case GateType::And:
     switch ( ni ) {
-    case 2:  node = new SnAnd2(id, inputs); break;
-    case 3:  node = new SnAnd3(id, inputs); break;
-    case 4:  node = new SnAnd4(id, inputs); break;
-    default: node = new SnAnd(id, inputs);  break;
+    case 2:  return SimOp::And2;
+    case 3:  return SimOp::And3;
+    case 4:  return SimOp::And4;
+    default: return SimOp::AndN;
     }
-    break;
 
   case GateType::Nand:
     switch ( ni ) {
-    case 2:  node = new SnNand2(id, inputs); break;
-    case 3:  node = new SnNand3(id, inputs); break;
-    case 4:  node = new SnNand4(id, inputs); break;
-    default: node = new SnNand(id, inputs);  break;
+    case 2:  return SimOp::Nand2;
+    case 3:  return SimOp::Nand3;
+    case 4:  return SimOp::Nand4;
+    default: return SimOp::NandN;
     }
-    break;
 
   case GateType::Or:
     switch ( ni ) {
-    case 2:  node = new SnOr2(id, inputs); break;
-    case 3:  node = new SnOr3(id, inputs); break;
-    case 4:  node = new SnOr4(id, inputs); break;
-    default: node = new SnOr(id, inputs);  break;
+    case 2:  return SimOp::Or2;
+    case 3:  return SimOp::Or3;
+    case 4:  return SimOp::Or4;
+    default: return SimOp::OrN;
     }
-    break;
 
   case GateType::Nor:
     switch ( ni ) {
-    case 2:  node = new SnNor2(id, inputs); break;
-    case 3:  node = new SnNor3(id, inputs); break;
-    case 4:  node = new SnNor4(id, inputs); break;
-    default: node = new SnNor(id, inputs);  break;
+    case 2:  return SimOp::Nor2;
+    case 3:  return SimOp::Nor3;
+    case 4:  return SimOp::Nor4;
+    default: return SimOp::NorN;
     }
-    break;
 
   case GateType::Xor:
-    switch ( ni ) {
-    case 2:  node = new SnXor2(id, inputs); break;
-    default: node = new SnXor(id, inputs);  break;
-    }
-    break;
+    return ( ni == 2 ) ? SimOp::Xor2 : SimOp::XorN;
 
   case GateType::Xnor:
-    switch ( ni ) {
-    case 2:  node = new SnXnor2(id, inputs); break;
-    default: node = new SnXnor(id, inputs);  break;
-    }
-    break;
+    return ( ni == 2 ) ? SimOp::Xnor2 : SimOp::XnorN;
 
   default:
-    ASSERT_NOT_REACHED;
+    break;
+  }
+  ASSERT_NOT_REACHED;
+  return SimOp::Buff;
+}
+
+// @brief ゲートタイプを返す．
+GateType
+SimNode::gate_type() const
+{
+  switch ( mOp ) {
+  case SimOp::Input: return GateType::Input;
+  case SimOp::Buff:  return GateType::Buff;
+  case SimOp::Not:   return GateType::Not;
+  case SimOp::And2:
+  case SimOp::And3:
+  case SimOp::And4:
+  case SimOp::AndN:  return GateType::And;
+  case SimOp::Nand2:
+  case SimOp::Nand3:
+  case SimOp::Nand4:
+  case SimOp::NandN: return GateType::Nand;
+  case SimOp::Or2:
+  case SimOp::Or3:
+  case SimOp::Or4:
+  case SimOp::OrN:   return GateType::Or;
+  case SimOp::Nor2:
+  case SimOp::Nor3:
+  case SimOp::Nor4:
+  case SimOp::NorN:  return GateType::Nor;
+  case SimOp::Xor2:
+  case SimOp::XorN:  return GateType::Xor;
+  case SimOp::Xnor2:
+  case SimOp::XnorN: return GateType::Xnor;
   }
-  return node;
+  ASSERT_NOT_REACHED;
+  return GateType::Buff;
 }
 
-// @brief レベルを設定する．
+// @brief 内容をダンプする．
 void
-SimNode::set_level(int level)
+SimNode::dump(ostream& s) const
 {
-  mLevel = level;
+  s << gate_type();
+  if ( mFaninNum > 0 ) {
+    s << "(" << mFanins[0];
+    for ( auto i: Range(1, mFaninNum) ) {
+      s << ", " << mFanins[i];
+    }
+    s << ")";
+  }
+  s << endl;
 }
 
 // @brief ファンアウトリストを作成する．
 void
-SimNode::set_fanout_list(const vector<SimNode*>& fo_list,
+SimNode::set_fanout_list(SimNodeArena& arena,
+			 const vector<SimNode*>& fo_list,
 			 int ipos)
 {
   auto nfo = fo_list.size();
   if ( nfo > 0 ) {
     if ( nfo == 1 ) {
-      mFanoutTop = fo_list[0];
+      mFanoutTop = _ptr_offset(fo_list[0]);
     }
     else {
-      SimNode** fanouts = new SimNode*[nfo];
+      // 配列の位置も要素も自分自身からの相対位置で表す．
+      auto fanouts = reinterpret_cast<int*>(arena.alloc(sizeof(int) * nfo));
       for ( auto i: Range(0, nfo) ) {
-	fanouts[i] = fo_list[i];
+	fanouts[i] = _ptr_offset(fo_list[i]);
       }
-      mFanoutTop = reinterpret_cast<SimNode*>(fanouts);
+      mFanoutTop = _ptr_offset(fanouts);
     }
   }
 
   mFanoutNum |= (nfo << 16) | (ipos << 4);
 }
 
-END_NAMESPACE_SATPG_FSIM
+END_NAMESPACE_SATPG
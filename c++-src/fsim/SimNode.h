@@ -5,36 +5,69 @@
 /// @brief SimNode のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2017 Yusuke Matsunaga
+/// Copyright (C) 2017, 2018 Yusuke Matsunaga
 /// All rights reserved.
 
-#include "fsim_nsdef.h"
-#include "TpgNode.h"
-#include "PackedVal.h"
-#include "PackedVal3.h"
+#include "satpg.h"
+#include "GateType.h"
 
 
-BEGIN_NAMESPACE_SATPG_FSIM
+BEGIN_NAMESPACE_SATPG
+
+class SimNodeArena;
+
+//////////////////////////////////////////////////////////////////////
+/// @brief SimNode の演算コード
+///
+/// ゲートの種類とファンイン数の組み合わせを表す．
+/// 2〜4入力の AND/NAND/OR/NOR と 2入力の XOR/XNOR は
+/// 入力数ごとに別のコードにしてループを避ける．
+//////////////////////////////////////////////////////////////////////
+enum class SimOp : ymuint8 {
+  Input,
+  Buff,
+  Not,
+  And2,  And3,  And4,  AndN,
+  Nand2, Nand3, Nand4, NandN,
+  Or2,   Or3,   Or4,   OrN,
+  Nor2,  Nor3,  Nor4,  NorN,
+  Xor2,  XorN,
+  Xnor2, XnorN
+};
+
 
 //////////////////////////////////////////////////////////////////////
 /// @class SimNode SimNode.h "SimNode.h"
 /// @brief 故障シミュレーション用のノード
 ///
-/// 出力値の計算はゲートの種類によって異なるので仮想関数にしている．<br>
-/// 注意が必要なのがファンアウトの情報．最初のファンアウトだけ個別のポインタで
-/// 持ち，２番目以降のファンアウトは配列で保持する．これは多くのノードが
-/// 一つしかファンアウトを持たず，その場合に配列を使うとメモリ参照が余分に発生する
-/// ため．
+/// 構造(演算コード，ファンイン，ファンアウト，レベル，FFR の根の印)
+/// だけを持ち，値やイベントキューの状態は持たない．
+/// 値は故障シミュレータごとにノード番号をキーにした配列で持つので，
+/// 一度作ったノードは 2値/3値，縮退故障/遷移故障の全ての故障シミュレータ
+/// で共有できる．<br>
+/// 注意が必要なのがファンアウトの情報．最初のファンアウトだけ個別の
+/// 相対位置で持ち，２番目以降のファンアウトは配列で保持する．これは多くの
+/// ノードが一つしかファンアウトを持たず，その場合に配列を使うとメモリ参照が
+/// 余分に発生するため．<br>
+/// SimNode は SimNodeArena 上にトポロジカル順に確保される．ファンアウトは
+/// ポインタではなく自分自身からの 32 ビットの相対位置で持つので，同じ
+/// SimNodeArena 上のノード同士でしかリンクは張れない．
+/// SimNodeArena 上の領域は全て alignof(SimNode) の倍数の位置にあるので
+/// 相対位置はバイト数を alignof(SimNode) で割った値で表す．<br>
+/// ファンインは値の配列を引くためのノード番号で持ち，
+/// オブジェクトの直後に置かれる．
 //////////////////////////////////////////////////////////////////////
 class SimNode
 {
-  friend class EventQ;
-
-protected:
+private:
 
   /// @brief コンストラクタ
   /// @param[in] id ノード番号
-  SimNode(int id);
+  /// @param[in] op 演算コード
+  /// @param[in] inputs ファンインのノードのリスト
+  SimNode(int id,
+	  SimOp op,
+	  const vector<SimNode*>& inputs);
 
 
 public:
@@ -47,8 +80,7 @@ public:
   operator=(const SimNode& src) = delete;
 
   /// @brief デストラクタ
-  virtual
-  ~SimNode();
+  ~SimNode() = default;
 
 
 public:
@@ -57,21 +89,41 @@ public:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 入力ノードを生成するクラスメソッド
+  /// @param[in] arena 領域を確保するアリーナ
   /// @param[in] id ノード番号
   static
   SimNode*
-  new_input(int id);
+  new_input(SimNodeArena& arena,
+	    int id);
 
   /// @brief 論理ノードを生成するクラスメソッド
+  /// @param[in] arena 領域を確保するアリーナ
   /// @param[in] id ノード番号
   /// @param[in] type ゲートの種類
   /// @param[in] inputs ファンインのノードのリスト
   static
   SimNode*
-  new_gate(int id,
+  new_gate(SimNodeArena& arena,
+	   int id,
 	   GateType type,
 	   const vector<SimNode*>& inputs);
 
+  /// @brief ノードの生成に必要な領域のサイズを返す．
+  /// @param[in] ni ファンイン数
+  ///
+  /// 入力ノードの場合は ni = 0 とする．
+  static
+  SizeType
+  node_size(int ni);
+
+  /// @brief ゲートの種類とファンイン数から演算コードを求める．
+  /// @param[in] type ゲートの種類
+  /// @param[in] ni ファンイン数
+  static
+  SimOp
+  opcode(GateType type,
+	 int ni);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -82,27 +134,37 @@ public:
   int
   id() const;
 
+  /// @brief 演算コードを返す．
+  SimOp
+  op() const;
+
   /// @brief ゲートタイプを返す．
-  virtual
   GateType
-  gate_type() const = 0;
+  gate_type() const;
 
   /// @brief ファンイン数を得る．
-  virtual
   int
-  fanin_num() const = 0;
+  fanin_num() const;
 
-  /// @brief pos 番めのファンインを得る．
-  virtual
-  SimNode*
-  fanin(int pos) const = 0;
+  /// @brief pos 番めのファンインのノード番号を得る．
+  /// @param[in] pos 位置番号 ( 0 <= pos < fanin_num() )
+  int
+  fanin_id(int pos) const;
+
+  /// @brief ファンインのノード番号の配列を得る．
+  ///
+  /// サイズは fanin_num()
+  const int*
+  fanin_id_array() const;
 
   /// @brief ファンアウト数を得る．
   int
   fanout_num() const;
 
   /// @brief ファンアウトの先頭のノードを得る．
-  SimNode*
+  ///
+  /// ただし fanout_num() == 0 の時は使えない．
+  const SimNode*
   fanout_top() const;
 
   /// @brief 最初のファンアウト先の入力位置を得る．
@@ -113,7 +175,7 @@ public:
   /// @param[in] pos 位置番号 ( 0 <= pos < fanout_num() )
   ///
   /// ただし fanout_num() == 1 の時は使えない．
-  SimNode*
+  const SimNode*
   fanout(int pos) const;
 
   /// @brief FFR の根のノードの時 true を返す．
@@ -121,8 +183,8 @@ public:
   is_ffr_root() const;
 
   /// @brief FFR の根のノードを返す．
-  SimNode*
-  ffr_root();
+  const SimNode*
+  ffr_root() const;
 
   /// @brief レベルを得る．
   int
@@ -133,14 +195,14 @@ public:
   is_output() const;
 
   /// @brief 内容をダンプする．
-  virtual
   void
-  dump(ostream& s) const = 0;
+  dump(ostream& s) const;
 
 
 public:
   //////////////////////////////////////////////////////////////////////
   // 構造に関する情報の設定用関数
+  // SimTopology の構築中にのみ用いる．
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 出力マークをつける．
@@ -148,8 +210,12 @@ public:
   set_output();
 
   /// @brief ファンアウトリストを作成する．
+  /// @param[in] arena ファンアウトの配列を確保するアリーナ
+  /// @param[in] fo_list ファンアウトのノードのリスト
+  /// @param[in] ipos 最初のファンアウト先の入力位置
   void
-  set_fanout_list(const vector<SimNode*>& fo_list,
+  set_fanout_list(SimNodeArena& arena,
+		  const vector<SimNode*>& fo_list,
 		  int ipos);
 
   /// @brief FFR の根の印をつける．
@@ -157,94 +223,25 @@ public:
   set_ffr_root();
 
 
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 故障シミュレーションに関する情報の取得/設定
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値を得る．
-  FSIM_VALTYPE
-  val() const;
-
-  /// @brief 出力値のセットを行う．
-  /// @param[in] val 値
-  void
-  set_val(FSIM_VALTYPE val);
-
-  /// @brief 出力値のセットを行う(マスク付き)．
-  /// @param[in] val 値
-  /// @param[in] mask マスク
-  void
-  set_val(FSIM_VALTYPE val,
-	  PackedVal mask);
-
-  /// @brief 出力値を計算する．
-  void
-  calc_val();
-
-  /// @brief 出力値を計算する(マスク付き)．
-  /// @param[in] mask マスク
-  ///
-  /// mask で1の立っているビットだけ更新する．
-  void
-  calc_val(PackedVal mask);
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 故障シミュレーション用の仮想関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値の計算を行う．
-  /// @return 計算結果を返す．
-  virtual
-  FSIM_VALTYPE
-  _calc_val() = 0;
-
-  /// @brief ゲートの入力から出力までの可観測性を計算する．
-  virtual
-  PackedVal
-  _calc_gobs(int ipos) = 0;
-
-
-protected:
-  //////////////////////////////////////////////////////////////////////
-  // 派生クラスで用いられる関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief レベルを設定する．
-  void
-  set_level(int level);
-
-
 private:
   //////////////////////////////////////////////////////////////////////
-  // EventQ 用の関数
+  // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief キューに積まれていたら true を返す．
-  bool
-  in_queue() const;
-
-  /// @brief キューフラグをセットする．
-  void
-  set_queue();
-
-  /// @brief キューフラグをクリアする．
-  void
-  clear_queue();
-
-  /// @brief 反転マスクを持っていたら true を返す．
-  bool
-  has_flip_mask() const;
+  /// @brief 領域の自分自身からの相対位置を求める．
+  /// @param[in] ptr 対象の領域(SimNodeArena 上になければならない)
+  int
+  _ptr_offset(const void* ptr) const;
 
-  /// @brief 反転フラグをセットする．
-  void
-  set_flip();
+  /// @brief 相対位置から領域を求める．
+  /// @param[in] offset _ptr_offset() で求めた相対位置
+  const char*
+  _offset_ptr(int offset) const;
 
-  /// @brief 反転フラグをクリアする．
-  void
-  clear_flip();
+  /// @brief 相対位置からノードを求める．
+  /// @param[in] offset _ptr_offset() で求めた相対位置
+  const SimNode*
+  _offset_node(int offset) const;
 
 
 private:
@@ -255,27 +252,30 @@ private:
   // ID 番号
   int mId;
 
+  // 演算コード
+  SimOp mOp;
+
   // ファンアウトリストの要素数
   // その他以下の情報もパックして持つ．
   // - 0      : 出力のマーク
   // - 1      : FFRの根のマーク
-  // - 2      : EventQ に入っているかどうかを示すマーク
-  // - 3      : 反転フラグ
   // - 4 - 15 : 最初のファンアウトの入力位置(FFR内のノードのみ意味を持つ)
   // - 16 -   : ファンアウト数
   unsigned int mFanoutNum;
 
-  // ファンアウトの先頭のノード
-  SimNode* mFanoutTop;
+  // ファンアウトの先頭のノードの相対位置
+  // ファンアウト数が2以上の時はファンアウトの配列の相対位置
+  int mFanoutTop;
 
   // レベル
   int mLevel;
 
-  // イベントキューの次の要素
-  SimNode* mLink;
+  // ファンイン数
+  int mFaninNum;
 
-  // 出力値
-  FSIM_VALTYPE mVal;
+  // ファンインのノード番号の配列
+  // 実際には mFaninNum 個の要素を持つ．
+  int mFanins[1];
 
 };
 
@@ -292,6 +292,41 @@ SimNode::id() const
   return mId;
 }
 
+// @brief 演算コードを返す．
+inline
+SimOp
+SimNode::op() const
+{
+  return mOp;
+}
+
+// @brief ファンイン数を得る．
+inline
+int
+SimNode::fanin_num() const
+{
+  return mFaninNum;
+}
+
+// @brief pos 番めのファンインのノード番号を得る．
+// @param[in] pos 位置番号 ( 0 <= pos < fanin_num() )
+inline
+int
+SimNode::fanin_id(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < mFaninNum );
+
+  return mFanins[pos];
+}
+
+// @brief ファンインのノード番号の配列を得る．
+inline
+const int*
+SimNode::fanin_id_array() const
+{
+  return mFanins;
+}
+
 // @brief ファンアウト数を得る．
 inline
 int
@@ -302,19 +337,20 @@ SimNode::fanout_num() const
 
 // @brief ファンアウトの先頭のノードを得る．
 inline
-SimNode*
+const SimNode*
 SimNode::fanout_top() const
 {
-  return mFanoutTop;
+  return _offset_node(mFanoutTop);
 }
 
 // @brief pos 番目のファンアウトを得る．
 inline
-SimNode*
+const SimNode*
 SimNode::fanout(int pos) const
 {
-  SimNode** fanouts = reinterpret_cast<SimNode**>(mFanoutTop);
-  return fanouts[pos];
+  // ファンアウトの配列の要素も自分自身からの相対位置
+  auto fanouts = reinterpret_cast<const int*>(_offset_ptr(mFanoutTop));
+  return _offset_node(fanouts[pos]);
 }
 
 // @brief 最初のファンアウト先の入力位置を得る．
@@ -335,10 +371,10 @@ SimNode::is_ffr_root() const
 
 // @brief FFR の根のノードを返す．
 inline
-SimNode*
-SimNode::ffr_root()
+const SimNode*
+SimNode::ffr_root() const
 {
-  SimNode* root = this;
+  const SimNode* root = this;
   while ( !root->is_ffr_root() ) {
     root = root->fanout_top();
   }
@@ -378,106 +414,37 @@ SimNode::set_ffr_root()
   mFanoutNum |= 2U;
 }
 
-// @brief 出力値を得る．
-inline
-FSIM_VALTYPE
-SimNode::val() const
-{
-  return mVal;
-}
-
-// @brief 出力値のセットを行う．
-// @param[in] val 値
+// @brief 領域の自分自身からの相対位置を求める．
+// @param[in] ptr 対象の領域(SimNodeArena 上になければならない)
 inline
-void
-SimNode::set_val(FSIM_VALTYPE val)
-{
-  mVal = val;
-}
-
-// @brief 出力値のセットを行う(マスク付き)．
-// @param[in] val 値
-// @param[in] mask マスク
-inline
-void
-SimNode::set_val(FSIM_VALTYPE val,
-		 PackedVal mask)
-{
-#if FSIM_VAL2
-  mVal &= ~mask;
-  mVal |= (val & mask);
-#elif FSIM_VAL3
-  mVal.set_with_mask(val, mask);
-#endif
-}
-
-// @brief 出力値を計算する．
-inline
-void
-SimNode::calc_val()
-{
-  set_val(_calc_val());
-}
-
-// @brief 出力値を計算する(マスク付き)．
-// @param[in] mask マスク
-//
-// mask で1の立っているビットだけ更新する．
-inline
-void
-SimNode::calc_val(PackedVal mask)
-{
-  set_val(_calc_val(), mask);
-}
-
-// @brief キューに積まれていたら true を返す．
-inline
-bool
-SimNode::in_queue() const
-{
-  return static_cast<bool>((mFanoutNum >> 2) & 1U);
-}
-
-// @brief キューフラグをセットする．
-inline
-void
-SimNode::set_queue()
-{
-  mFanoutNum |= 1U << 2;
-}
-
-// @brief キューフラグをクリアする．
-inline
-void
-SimNode::clear_queue()
-{
-  mFanoutNum &= ~(1U << 2);
-}
-
-// @brief 反転マスクを持っていたら true を返す．
-inline
-bool
-SimNode::has_flip_mask() const
+int
+SimNode::_ptr_offset(const void* ptr) const
 {
-  return static_cast<bool>((mFanoutNum >> 3) & 1U);
+  const std::ptrdiff_t unit = alignof(SimNode);
+  auto diff = reinterpret_cast<const char*>(ptr) - reinterpret_cast<const char*>(this);
+  ASSERT_COND( diff % unit == 0 );
+  return static_cast<int>(diff / unit);
 }
 
-// @brief 反転フラグをセットする．
+// @brief 相対位置から領域を求める．
+// @param[in] offset _ptr_offset() で求めた相対位置
 inline
-void
-SimNode::set_flip()
+const char*
+SimNode::_offset_ptr(int offset) const
 {
-  mFanoutNum |= 1U << 3;
+  const std::ptrdiff_t unit = alignof(SimNode);
+  return reinterpret_cast<const char*>(this) + offset * unit;
 }
 
-// @brief 反転フラグをクリアする．
+// @brief 相対位置からノードを求める．
+// @param[in] offset _ptr_offset() で求めた相対位置
 inline
-void
-SimNode::clear_flip()
+const SimNode*
+SimNode::_offset_node(int offset) const
 {
-  mFanoutNum &= ~(1U << 3);
+  return reinterpret_cast<const SimNode*>(_offset_ptr(offset));
 }
 
-END_NAMESPACE_SATPG_FSIM
+END_NAMESPACE_SATPG
 
 #endif // FSIM_SIMNODE_H
@@ -0,0 +1,71 @@
+
+/// @file SimNodeArena.cc
+/// @brief SimNodeArena の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SimNodeArena.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+// クラス SimNodeArena
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SimNodeArena::SimNodeArena() :
+  mChunk(nullptr),
+  mTop(nullptr),
+  mSize(0),
+  mUsed(0)
+{
+}
+
+// @brief デストラクタ
+SimNodeArena::~SimNodeArena()
+{
+  clear();
+}
+
+// @brief 領域を確保する．
+// @param[in] size 領域のサイズ(バイト数)
+//
+// 以前の領域は破棄される．
+bool
+SimNodeArena::init(SizeType size)
+{
+  clear();
+
+  // 相対位置で表せない大きさは扱えない．
+  if ( round_up(size) > max_size() ) {
+    return false;
+  }
+
+  // new char[] の領域は SimNode のアラインメントに
+  // 揃っているとは限らないので余分に確保して先頭をずらす．
+  const SizeType align = alignof(SimNode);
+  mSize = round_up(size);
+  mChunk = new char[mSize + align];
+  auto addr = reinterpret_cast<ympuint>(mChunk);
+  mTop = mChunk + (align - addr % align) % align;
+  mUsed = 0;
+
+  return true;
+}
+
+// @brief 全ての領域を解放する．
+void
+SimNodeArena::clear()
+{
+  delete [] mChunk;
+  mChunk = nullptr;
+  mTop = nullptr;
+  mSize = 0;
+  mUsed = 0;
+}
+
+END_NAMESPACE_SATPG
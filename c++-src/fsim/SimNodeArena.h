@@ -0,0 +1,168 @@
+#ifndef FSIM_SIMNODEARENA_H
+#define FSIM_SIMNODEARENA_H
+
+/// @file SimNodeArena.h
+/// @brief SimNodeArena のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+#include "SimNode.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimNodeArena SimNodeArena.h "SimNodeArena.h"
+/// @brief SimNode とそのファンアウト配列を確保する連続領域
+///
+/// init() で一つの大きな領域を確保し，alloc() で先頭から順に切り出す．
+/// SimNode をトポロジカル順に確保すればイベントドリブンシミュレーションの
+/// メモリアクセスがほぼ連続した領域に収まる．<br>
+/// SimNode 間のリンクはこの領域内の alignof(SimNode) 単位の 32 ビットの
+/// 相対位置で表されるので領域の大きさは max_size() 以下でなければならない．<br>
+/// 個々の領域の解放は行わない．clear() で全体をまとめて解放する．
+//////////////////////////////////////////////////////////////////////
+class SimNodeArena
+{
+public:
+
+  /// @brief コンストラクタ
+  SimNodeArena();
+
+  /// @brief コピーコンストラクタは禁止
+  SimNodeArena(const SimNodeArena& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  SimNodeArena&
+  operator=(const SimNodeArena& src) = delete;
+
+  /// @brief デストラクタ
+  ~SimNodeArena();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 領域を確保する．
+  /// @param[in] size 領域のサイズ(バイト数)
+  /// @return size が max_size() を越えていたら false を返す．
+  ///
+  /// 以前の領域は破棄される．<br>
+  /// false を返した時には領域は確保されない．
+  bool
+  init(SizeType size);
+
+  /// @brief 全ての領域を解放する．
+  void
+  clear();
+
+  /// @brief 領域を切り出す．
+  /// @param[in] size 必要なサイズ(バイト数)
+  ///
+  /// 返される領域は SimNode のアラインメントに揃えられている．
+  void*
+  alloc(SizeType size);
+
+  /// @brief 確保した領域のサイズを返す．
+  SizeType
+  size() const;
+
+  /// @brief 使用済みの領域のサイズを返す．
+  SizeType
+  used_size() const;
+
+  /// @brief 確保できる領域の最大サイズを返す．
+  static
+  SizeType
+  max_size();
+
+  /// @brief サイズをアラインメントの倍数に切り上げる．
+  /// @param[in] size サイズ(バイト数)
+  static
+  SizeType
+  round_up(SizeType size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 確保した領域の本当の先頭
+  char* mChunk;
+
+  // アラインメントを揃えた領域の先頭
+  char* mTop;
+
+  // 領域のサイズ
+  SizeType mSize;
+
+  // 使用済みのサイズ
+  SizeType mUsed;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 領域を切り出す．
+// @param[in] size 必要なサイズ(バイト数)
+inline
+void*
+SimNodeArena::alloc(SizeType size)
+{
+  size = round_up(size);
+  ASSERT_COND( mUsed + size <= mSize );
+
+  char* p = mTop + mUsed;
+  mUsed += size;
+  return p;
+}
+
+// @brief 確保した領域のサイズを返す．
+inline
+SizeType
+SimNodeArena::size() const
+{
+  return mSize;
+}
+
+// @brief 使用済みの領域のサイズを返す．
+inline
+SizeType
+SimNodeArena::used_size() const
+{
+  return mUsed;
+}
+
+// @brief 確保できる領域の最大サイズを返す．
+inline
+SizeType
+SimNodeArena::max_size()
+{
+  // 相対位置は alignof(SimNode) 単位の int で表す．
+  const SizeType align = alignof(SimNode);
+  return static_cast<SizeType>(0x7FFFFFFF) * align;
+}
+
+// @brief サイズをアラインメントの倍数に切り上げる．
+// @param[in] size サイズ(バイト数)
+inline
+SizeType
+SimNodeArena::round_up(SizeType size)
+{
+  const SizeType align = alignof(SimNode);
+  return (size + align - 1) / align * align;
+}
+
+END_NAMESPACE_SATPG
+
+#endif // FSIM_SIMNODEARENA_H
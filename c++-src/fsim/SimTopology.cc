@@ -0,0 +1,249 @@
+
+/// @file SimTopology.cc
+/// @brief SimTopology の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SimTopology.h"
+
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "TpgFault.h"
+
+#include "GateType.h"
+
+#include "ym/Range.h"
+#include <new>
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+// クラス SimTopology
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] network ネットワーク
+SimTopology::SimTopology(const TpgNetwork& network) :
+  mInputNum(network.input_num()),
+  mOutputNum(network.output_num()),
+  mDffNum(network.dff_num()),
+  mMaxLevel(0),
+  mFFRNum(0),
+  mFFRArray(nullptr),
+  mFaultNum(0),
+  mSimFaults(nullptr)
+{
+  auto nn = network.node_num();
+  auto ni = network.ppi_num();
+  auto no = network.ppo_num();
+
+  ASSERT_COND( ni == mInputNum + mDffNum );
+  ASSERT_COND( no == mOutputNum + mDffNum );
+
+  // SimNode とファンアウトの配列に必要な領域の大きさを見積もって
+  // アリーナを一度に確保しておく．
+  // 大きすぎて確保できない場合はエラーとなるので最初に行う．
+  // ファンアウトの配列の要素数の総和はファンイン数の総和を越えない．
+  {
+    SizeType arena_size = 0;
+    SizeType fanin_num = 0;
+    for ( auto tpgnode: network.node_list() ) {
+      int ni = 0;
+      if ( tpgnode->is_logic() ) {
+	ni = tpgnode->fanin_num();
+      }
+      else if ( !tpgnode->is_ppi() ) {
+	ni = 1;
+      }
+      arena_size += SimNodeArena::round_up(SimNode::node_size(ni));
+      // ファンアウトの配列ごとのアラインメントの余り
+      arena_size += SimNodeArena::round_up(1);
+      fanin_num += ni;
+    }
+    arena_size += sizeof(int) * fanin_num;
+    if ( !mArena.init(arena_size) ) {
+      // 他の領域を確保する前に調べているのでここで抜けても漏れはない．
+      cerr << "Error: the network is too large for the fault simulator ("
+	   << arena_size << " bytes required, "
+	   << SimNodeArena::max_size() << " bytes at most)" << endl;
+      throw std::bad_alloc();
+    }
+  }
+
+  // 構築中は SimNode に印をつけるので非 const のポインタを持っておく．
+  vector<SimNode*> node_array;
+  node_array.reserve(nn);
+
+  // TpgNode->id() をキーにして対応する SimNode を納める配列
+  vector<SimNode*> simmap(nn, nullptr);
+
+  mPPIArray.resize(ni, nullptr);
+  mPPOArray.resize(no, nullptr);
+
+  auto make_gate = [&](GateType type,
+		       const vector<SimNode*>& inputs) {
+    auto node = SimNode::new_gate(mArena, node_array.size(), type, inputs);
+    node_array.push_back(node);
+    mLogicArray.push_back(node);
+    return node;
+  };
+
+  auto nf = 0;
+  for ( auto tpgnode: network.node_list() ) {
+    nf += network.node_rep_fault_num(tpgnode->id());
+
+    SimNode* node = nullptr;
+
+    if ( tpgnode->is_ppi() ) {
+      // 外部入力に対応する SimNode の生成
+      node = SimNode::new_input(mArena, node_array.size());
+      node_array.push_back(node);
+      mPPIArray[tpgnode->input_id()] = node;
+    }
+    else if ( tpgnode->is_ppo() ) {
+      // 外部出力に対応する SimNode の生成
+      auto inode = simmap[tpgnode->fanin(0)->id()];
+      // 実際にはバッファタイプのノードに出力の印をつけるだけ．
+      node = make_gate(GateType::Buff, vector<SimNode*>(1, inode));
+      node->set_output();
+      mPPOArray[tpgnode->output_id()] = node;
+    }
+    else if ( tpgnode->is_dff_clock() ||
+	      tpgnode->is_dff_clear() ||
+	      tpgnode->is_dff_preset() ) {
+      // DFFの制御端子に対応する SimNode の生成
+      auto inode = simmap[tpgnode->fanin(0)->id()];
+      // 実際にはバッファタイプのノードに出力の印をつけるだけ．
+      node = make_gate(GateType::Buff, vector<SimNode*>(1, inode));
+      node->set_output();
+    }
+    else if ( tpgnode->is_logic() ) {
+      // 論理ノードに対する SimNode の作成
+      auto ni = tpgnode->fanin_num();
+
+      // ファンインに対応する SimNode を探す．
+      vector<SimNode*> inputs;
+      inputs.reserve(ni);
+      for ( auto itpgnode: tpgnode->fanin_list() ) {
+	auto inode = simmap[itpgnode->id()];
+	ASSERT_COND( inode != nullptr);
+
+	inputs.push_back(inode);
+      }
+
+      // 出力の論理を表す SimNode を作る．
+      auto type = tpgnode->gate_type();
+      node = make_gate(type, inputs);
+    }
+    // 対応表に登録しておく．
+    simmap[tpgnode->id()] = node;
+  }
+
+  // 各ノードのファンアウトリストの設定
+  auto node_num = node_array.size();
+  {
+    vector<vector<SimNode*> > fanout_lists(node_num);
+    vector<int> ipos(node_num);
+    for ( auto node: node_array ) {
+      auto ni = node->fanin_num();
+      for ( auto i: Range(0, ni) ) {
+	auto iid = node->fanin_id(i);
+	fanout_lists[iid].push_back(node);
+	ipos[iid] = i;
+      }
+    }
+    for ( auto i: Range(node_num) ) {
+      auto node = node_array[i];
+      node->set_fanout_list(mArena, fanout_lists[i], ipos[i]);
+    }
+  }
+
+  // FFR の設定
+  auto ffr_num = 0;
+  for ( auto node: node_array ) {
+    if ( node->is_output() || node->fanout_num() != 1 ) {
+      ++ ffr_num;
+    }
+  }
+
+  mFFRNum = ffr_num;
+  mFFRArray = new SimFFR[ffr_num];
+  // SimNode->id() をキーにして所属する FFR を納めた配列
+  vector<SimFFR*> ffr_map(node_num);
+  // 出力側から処理するので各 FFR のノードは根から順に追加される．
+  ffr_num = 0;
+  for ( int i = node_num; -- i >= 0; ) {
+    auto node = node_array[i];
+    if ( node->is_output() || node->fanout_num() != 1 ) {
+      auto ffr = &mFFRArray[ffr_num];
+      node->set_ffr_root();
+      ffr_map[node->id()] = ffr;
+      ffr->set_root(node);
+      ffr->add_node(node);
+      ++ ffr_num;
+    }
+    else {
+      auto fo_node = node->fanout_top();
+      auto ffr = ffr_map[fo_node->id()];
+      ffr_map[node->id()] = ffr;
+      ffr->add_node(node);
+    }
+  }
+
+  // 最大レベルを求める．
+  for ( auto onode: mPPOArray ) {
+    if ( mMaxLevel < onode->level() ) {
+      mMaxLevel = onode->level();
+    }
+  }
+
+  mNodeArray.assign(node_array.begin(), node_array.end());
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障リストの設定
+  //////////////////////////////////////////////////////////////////////
+
+  // 同時に各 SimFFR 内の故障リストも構築する．
+  mFaultNum = nf;
+  mSimFaults = new SimFault[nf];
+  mFaultMap.resize(network.max_fault_id(), nullptr);
+  auto fid = 0;
+  for ( auto tpgnode: network.node_list() ) {
+    auto simnode = simmap[tpgnode->id()];
+    auto ffr = ffr_map[simnode->id()];
+    auto nf1 = network.node_rep_fault_num(tpgnode->id());
+    for ( auto j: Range(0, nf1) ) {
+      auto fault = network.node_rep_fault(tpgnode->id(), j);
+      SimNode* isimnode = nullptr;
+      int ipos = 0;
+      if ( fault->is_branch_fault() ) {
+	ipos = fault->tpg_pos();
+	auto inode = tpgnode->fanin(ipos);
+	isimnode = simmap[inode->id()];
+      }
+      else {
+	isimnode = simnode;
+      }
+      auto ff = &mSimFaults[fid];
+      ff->set(fid, fault, simnode, ipos, isimnode);
+      mFaultMap[fault->id()] = ff;
+      ffr->add_fault(ff);
+      ++ fid;
+    }
+  }
+}
+
+// @brief デストラクタ
+SimTopology::~SimTopology()
+{
+  // SimNode の領域は mArena がまとめて解放する．
+  delete [] mFFRArray;
+  delete [] mSimFaults;
+}
+
+END_NAMESPACE_SATPG
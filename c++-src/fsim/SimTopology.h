@@ -0,0 +1,344 @@
+#ifndef SIMTOPOLOGY_H
+#define SIMTOPOLOGY_H
+
+/// @file SimTopology.h
+/// @brief SimTopology のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+#include "SimNode.h"
+#include "SimNodeArena.h"
+#include "SimFFR.h"
+#include "SimFault.h"
+#include "TpgFault.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class SimTopology SimTopology.h "SimTopology.h"
+/// @brief 故障シミュレーション用の回路構造
+///
+/// TpgNetwork から作った SimNode のグラフ，FFR の表，故障の配列を持つ．
+/// 構築後は変更されないので，同じネットワークに対する 2値/3値，
+/// 縮退故障/遷移故障の故障シミュレータの間で std::shared_ptr を用いて
+/// 共有できる．値やイベントキュー，故障ごとの検出状況などは
+/// 故障シミュレータがノード番号や SimFault::mId をキーにした配列で持つ．<br>
+/// 元の TpgNetwork の故障を参照するので TpgNetwork より長く
+/// 使ってはならない．
+//////////////////////////////////////////////////////////////////////
+class SimTopology
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network ネットワーク
+  ///
+  /// ネットワークが大きすぎて SimNodeArena に収まらない場合は
+  /// std::bad_alloc を送出する．
+  SimTopology(const TpgNetwork& network);
+
+  /// @brief コピーコンストラクタは禁止
+  SimTopology(const SimTopology& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  SimTopology&
+  operator=(const SimTopology& src) = delete;
+
+  /// @brief デストラクタ
+  ~SimTopology();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // ノードに関する情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 外部入力数を返す．
+  int
+  input_num() const;
+
+  /// @brief 外部出力数を返す．
+  int
+  output_num() const;
+
+  /// @brief DFF数を返す．
+  int
+  dff_num() const;
+
+  /// @brief PPI数を返す．
+  int
+  ppi_num() const;
+
+  /// @brief PPO数を返す．
+  int
+  ppo_num() const;
+
+  /// @brief ノード数を返す．
+  int
+  node_num() const;
+
+  /// @brief 全てのノードのリストを返す．
+  ///
+  /// ノード番号の順(トポロジカル順)に並んでいる．
+  const vector<const SimNode*>&
+  node_list() const;
+
+  /// @brief PPI のノードを返す．
+  /// @param[in] id PPI番号 ( 0 <= id < ppi_num() )
+  const SimNode*
+  ppi(int id) const;
+
+  /// @brief PPO のノードを返す．
+  /// @param[in] id PPO番号 ( 0 <= id < ppo_num() )
+  const SimNode*
+  ppo(int id) const;
+
+  /// @brief 論理ノードのリストを返す．
+  ///
+  /// 入力からのトポロジカル順に並んでいる．
+  const vector<const SimNode*>&
+  logic_list() const;
+
+  /// @brief 最大レベルを返す．
+  int
+  max_level() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // FFR と故障に関する情報を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief FFR 数を返す．
+  int
+  ffr_num() const;
+
+  /// @brief FFR を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < ffr_num() )
+  ///
+  /// 出力側の FFR から順に並んでいる．
+  const SimFFR&
+  ffr(int pos) const;
+
+  /// @brief 故障数を返す．
+  int
+  fault_num() const;
+
+  /// @brief 故障の配列を返す．
+  ///
+  /// サイズは fault_num() で，ノードのトポロジカル順に並んでいる．
+  /// 各要素の mId は配列上の位置に等しい．
+  const SimFault*
+  fault_array() const;
+
+  /// @brief TpgFault に対応する SimFault を返す．
+  /// @param[in] f 対象の故障(代表故障でなければならない)
+  const SimFault*
+  sim_fault(const TpgFault* f) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 外部入力数
+  int mInputNum;
+
+  // 外部出力数
+  int mOutputNum;
+
+  // DFF数
+  int mDffNum;
+
+  // SimNode とそのファンアウト配列を確保するアリーナ
+  SimNodeArena mArena;
+
+  // 全ての SimNode を納めた配列
+  // トポロジカル順に mArena 上に並んでいる．
+  vector<const SimNode*> mNodeArray;
+
+  // PPIに対応する SimNode を納めた配列
+  // サイズは mInputNum + mDffNum
+  vector<const SimNode*> mPPIArray;
+
+  // PPOに対応する SimNode を納めた配列
+  // サイズは mOutputNum + mDffNum
+  vector<const SimNode*> mPPOArray;
+
+  // 入力からのトポロジカル順に並べた logic ノードの配列
+  vector<const SimNode*> mLogicArray;
+
+  // 最大レベル
+  int mMaxLevel;
+
+  // FFR 数
+  int mFFRNum;
+
+  // FFR を納めた配列
+  // サイズは mFFRNum
+  SimFFR* mFFRArray;
+
+  // 故障数
+  int mFaultNum;
+
+  // 故障シミュレーション用の故障の配列
+  // サイズは mFaultNum
+  SimFault* mSimFaults;
+
+  // TpgFault::id() をキーとして SimFault を格納する配列
+  vector<const SimFault*> mFaultMap;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 外部入力数を返す．
+inline
+int
+SimTopology::input_num() const
+{
+  return mInputNum;
+}
+
+// @brief 外部出力数を返す．
+inline
+int
+SimTopology::output_num() const
+{
+  return mOutputNum;
+}
+
+// @brief DFF数を返す．
+inline
+int
+SimTopology::dff_num() const
+{
+  return mDffNum;
+}
+
+// @brief PPI数を返す．
+inline
+int
+SimTopology::ppi_num() const
+{
+  return mInputNum + mDffNum;
+}
+
+// @brief PPO数を返す．
+inline
+int
+SimTopology::ppo_num() const
+{
+  return mOutputNum + mDffNum;
+}
+
+// @brief ノード数を返す．
+inline
+int
+SimTopology::node_num() const
+{
+  return mNodeArray.size();
+}
+
+// @brief 全てのノードのリストを返す．
+inline
+const vector<const SimNode*>&
+SimTopology::node_list() const
+{
+  return mNodeArray;
+}
+
+// @brief PPI のノードを返す．
+// @param[in] id PPI番号 ( 0 <= id < ppi_num() )
+inline
+const SimNode*
+SimTopology::ppi(int id) const
+{
+  ASSERT_COND( id >= 0 && id < ppi_num() );
+
+  return mPPIArray[id];
+}
+
+// @brief PPO のノードを返す．
+// @param[in] id PPO番号 ( 0 <= id < ppo_num() )
+inline
+const SimNode*
+SimTopology::ppo(int id) const
+{
+  ASSERT_COND( id >= 0 && id < ppo_num() );
+
+  return mPPOArray[id];
+}
+
+// @brief 論理ノードのリストを返す．
+inline
+const vector<const SimNode*>&
+SimTopology::logic_list() const
+{
+  return mLogicArray;
+}
+
+// @brief 最大レベルを返す．
+inline
+int
+SimTopology::max_level() const
+{
+  return mMaxLevel;
+}
+
+// @brief FFR 数を返す．
+inline
+int
+SimTopology::ffr_num() const
+{
+  return mFFRNum;
+}
+
+// @brief FFR を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < ffr_num() )
+inline
+const SimFFR&
+SimTopology::ffr(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < ffr_num() );
+
+  return mFFRArray[pos];
+}
+
+// @brief 故障数を返す．
+inline
+int
+SimTopology::fault_num() const
+{
+  return mFaultNum;
+}
+
+// @brief 故障の配列を返す．
+inline
+const SimFault*
+SimTopology::fault_array() const
+{
+  return mSimFaults;
+}
+
+// @brief TpgFault に対応する SimFault を返す．
+// @param[in] f 対象の故障(代表故障でなければならない)
+inline
+const SimFault*
+SimTopology::sim_fault(const TpgFault* f) const
+{
+  return mFaultMap[f->id()];
+}
+
+END_NAMESPACE_SATPG
+
+#endif // SIMTOPOLOGY_H
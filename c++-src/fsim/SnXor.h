@@ -1,204 +0,0 @@
-﻿#ifndef SNXOR_H
-#define SNXOR_H
-
-/// @file SnXor.h
-/// @brief SnXor のヘッダファイル
-/// @author Yusuke Matsunaga (松永 裕介)
-///
-/// Copyright (C) 2016, 2017 Yusuke Matsunaga
-/// All rights reserved.
-
-
-#include "SnGate.h"
-
-
-BEGIN_NAMESPACE_SATPG_FSIM
-
-//////////////////////////////////////////////////////////////////////
-/// @class SnXor SimNode.h
-/// @brief XORノード
-//////////////////////////////////////////////////////////////////////
-class SnXor :
-  public SnGate
-{
-public:
-
-  /// @brief コンストラクタ
-  SnXor(int id,
-	const vector<SimNode*>& inputs);
-
-  /// @brief デストラクタ
-  virtual
-  ~SnXor();
-
-
-public:
-
-  /// @brief ゲートタイプを返す．
-  virtual
-  GateType
-  gate_type() const;
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 故障シミュレーション用の仮想関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値の計算を行う．
-  virtual
-  FSIM_VALTYPE
-  _calc_val();
-
-  /// @brief ゲートの入力から出力までの可観測性を計算する．
-  virtual
-  PackedVal
-  _calc_gobs(int ipos);
-
-
-protected:
-  //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief ファンインの値のXORを計算する．
-  FSIM_VALTYPE
-  _calc_xor();
-
-};
-
-
-//////////////////////////////////////////////////////////////////////
-/// @class SnNor2 SimNode.h
-/// @brief 2入力XORノード
-//////////////////////////////////////////////////////////////////////
-class SnXor2 :
-  public SnGate2
-{
-public:
-
-  /// @brief コンストラクタ
-  SnXor2(int id,
-	 const vector<SimNode*>& inputs);
-
-  /// @brief デストラクタ
-  virtual
-  ~SnXor2();
-
-
-public:
-
-  /// @brief ゲートタイプを返す．
-  virtual
-  GateType
-  gate_type() const;
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 故障シミュレーション用の仮想関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値の計算を行う．
-  virtual
-  FSIM_VALTYPE
-  _calc_val();
-
-  /// @brief ゲートの入力から出力までの可観測性を計算する．
-  virtual
-  PackedVal
-  _calc_gobs(int ipos);
-
-
-protected:
-  //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief ファンインの値のXORを計算する．
-  FSIM_VALTYPE
-  _calc_xor();
-
-};
-
-
-//////////////////////////////////////////////////////////////////////
-/// @class SnXnor SimNode.h
-/// @brief XNORノード
-//////////////////////////////////////////////////////////////////////
-class SnXnor :
-  public SnXor
-{
-public:
-
-  /// @brief コンストラクタ
-  SnXnor(int id,
-	 const vector<SimNode*>& inputs);
-
-  /// @brief デストラクタ
-  virtual
-  ~SnXnor();
-
-
-public:
-
-  /// @brief ゲートタイプを返す．
-  virtual
-  GateType
-  gate_type() const;
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 2値版の故障シミュレーション用の仮想関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値の計算を行う．
-  virtual
-  FSIM_VALTYPE
-  _calc_val();
-
-};
-
-
-//////////////////////////////////////////////////////////////////////
-/// @class SnNor2 SimNode.h
-/// @brief 2入力XNORノード
-//////////////////////////////////////////////////////////////////////
-class SnXnor2 :
-  public SnXor2
-{
-public:
-
-  /// @brief コンストラクタ
-  SnXnor2(int id,
-	  const vector<SimNode*>& inputs);
-
-  /// @brief デストラクタ
-  virtual
-  ~SnXnor2();
-
-
-public:
-
-  /// @brief ゲートタイプを返す．
-  virtual
-  GateType
-  gate_type() const;
-
-
-public:
-  //////////////////////////////////////////////////////////////////////
-  // 障シミュレーション用の仮想関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 出力値の計算を行う．(2値版)
-  virtual
-  FSIM_VALTYPE
-  _calc_val();
-
-};
-
-END_NAMESPACE_SATPG_FSIM
-
-#endif // SNXOR_H
@@ -0,0 +1,118 @@
+
+/// @file WorkerPool.cc
+/// @brief WorkerPool の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "WorkerPool.h"
+#include "ym/Range.h"
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+// クラス WorkerPool
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+WorkerPool::WorkerPool() :
+  mJob(nullptr),
+  mGeneration(0),
+  mDoneNum(0),
+  mQuit(false)
+{
+}
+
+// @brief デストラクタ
+WorkerPool::~WorkerPool()
+{
+  stop();
+}
+
+// @brief スレッドを生成する．
+// @param[in] num スレッド数
+void
+WorkerPool::start(int num)
+{
+  stop();
+
+  mQuit = false;
+  int generation = mGeneration;
+  mThreadList.reserve(num);
+  for ( auto tid: Range(num) ) {
+    mThreadList.push_back(std::thread([this, tid, generation]() {
+	  worker_loop(tid, generation);
+	}));
+  }
+}
+
+// @brief 全てのスレッドを終了させる．
+void
+WorkerPool::stop()
+{
+  if ( mThreadList.empty() ) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQuit = true;
+  }
+  mStartCond.notify_all();
+  for ( auto& th: mThreadList ) {
+    th.join();
+  }
+  mThreadList.clear();
+}
+
+// @brief 全てのスレッドで job を実行する．
+// @param[in] job 仕事を表す関数オブジェクト
+void
+WorkerPool::run(const std::function<void(int)>& job)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mJob = &job;
+  mDoneNum = 0;
+  ++ mGeneration;
+  mStartCond.notify_all();
+  mDoneCond.wait(lock, [this]() { return mDoneNum == thread_num(); });
+  mJob = nullptr;
+}
+
+// @brief スレッドの本体
+// @param[in] tid スレッド番号
+// @param[in] generation 生成時の世代番号
+void
+WorkerPool::worker_loop(int tid,
+			int generation)
+{
+  for ( ; ; ) {
+    const std::function<void(int)>* job = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mStartCond.wait(lock, [this, generation]() {
+	  return mQuit || mGeneration != generation;
+	});
+      if ( mQuit ) {
+	return;
+      }
+      generation = mGeneration;
+      job = mJob;
+    }
+
+    (*job)(tid);
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      ++ mDoneNum;
+      if ( mDoneNum == thread_num() ) {
+	mDoneCond.notify_one();
+      }
+    }
+  }
+}
+
+END_NAMESPACE_SATPG_FSIM
@@ -0,0 +1,134 @@
+#ifndef FSIM_WORKERPOOL_H
+#define FSIM_WORKERPOOL_H
+
+/// @file WorkerPool.h
+/// @brief WorkerPool のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+/// @class WorkerPool WorkerPool.h "WorkerPool.h"
+/// @brief ppsfp 用の常駐スレッドの集まり
+///
+/// スレッドは start() で一度だけ生成し，run() のたびに同じスレッドに
+/// 仕事を渡す．run() は全てのスレッドが仕事を終えるまで戻らない．
+//////////////////////////////////////////////////////////////////////
+class WorkerPool
+{
+public:
+
+  /// @brief コンストラクタ
+  WorkerPool();
+
+  /// @brief コピーコンストラクタは禁止
+  WorkerPool(const WorkerPool& src) = delete;
+
+  /// @brief 代入演算子も禁止
+  WorkerPool&
+  operator=(const WorkerPool& src) = delete;
+
+  /// @brief デストラクタ
+  ~WorkerPool();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドを生成する．
+  /// @param[in] num スレッド数
+  ///
+  /// すでにスレッドがある場合には stop() してから作り直す．
+  void
+  start(int num);
+
+  /// @brief 全てのスレッドを終了させる．
+  void
+  stop();
+
+  /// @brief スレッド数を返す．
+  int
+  thread_num() const;
+
+  /// @brief 全てのスレッドで job を実行する．
+  /// @param[in] job 仕事を表す関数オブジェクト
+  ///
+  /// job にはスレッド番号( 0 <= tid < thread_num() )が渡される．
+  /// 全てのスレッドが job を終えてから戻る．
+  void
+  run(const std::function<void(int)>& job);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief スレッドの本体
+  /// @param[in] tid スレッド番号
+  /// @param[in] generation 生成時の世代番号
+  void
+  worker_loop(int tid,
+	      int generation);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッドのリスト
+  vector<std::thread> mThreadList;
+
+  // 以下のメンバを保護する mutex
+  std::mutex mMutex;
+
+  // スレッドに仕事の開始(または終了)を知らせる条件変数
+  std::condition_variable mStartCond;
+
+  // run() に仕事の終了を知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 現在の仕事
+  const std::function<void(int)>* mJob;
+
+  // run() が呼ばれるたびに増える世代番号
+  int mGeneration;
+
+  // 現在の仕事を終えたスレッド数
+  int mDoneNum;
+
+  // スレッドを終了させる時に true にするフラグ
+  bool mQuit;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief スレッド数を返す．
+inline
+int
+WorkerPool::thread_num() const
+{
+  return mThreadList.size();
+}
+
+END_NAMESPACE_SATPG_FSIM
+
+#endif // FSIM_WORKERPOOL_H
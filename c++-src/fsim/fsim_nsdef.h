@@ -21,6 +21,32 @@
 //
 // FSIM_SA: 縮退故障用の故障シミュレータ
 // FSIM_TD: 遷移故障用の故障シミュレータ
+//
+// さらに FSIM_PV_WORDS でパタン並列のワード数を指定する．
+// 省略時は 1 で，PackedVal(64ビット)を用いる．
+// 4 や 8 を指定すると PackedValW<4>(256ビット)や PackedValW<8>(512ビット)
+// を用いてより多くのパタン(ppsfp)や FFR(sppfp)を一度に処理する．
+
+#if !defined(FSIM_PV_WORDS)
+#  define FSIM_PV_WORDS 1
+#endif
+
+#if FSIM_PV_WORDS == 1
+#  define FSIM_PVTYPE PackedVal
+#  define FSIM_PV3TYPE PackedVal3
+#elif FSIM_PV_WORDS > 1
+#  define FSIM_PVTYPE PackedValW<FSIM_PV_WORDS>
+#  define FSIM_PV3TYPE PackedVal3W<FSIM_PV_WORDS>
+#else
+#  error "FSIM_PV_WORDS must be a positive integer"
+#endif
+
+// FSIM_PVTYPE の定数
+#define FSIM_PV_ALL0 FSIM_PVTYPE(kPvAll0)
+#define FSIM_PV_ALL1 FSIM_PVTYPE(kPvAll1)
+
+// FSIM_PVTYPE のビット長
+#define FSIM_PV_BITLEN (kPvBitLen * FSIM_PV_WORDS)
 
 #if FSIM_VAL2
 #  if FSIM_SA
@@ -32,7 +58,7 @@
 #  else
 #    error "Neither FSIM_SA nor FSIM_TD are not set"
 #  endif
-#  define FSIM_VALTYPE PackedVal
+#  define FSIM_VALTYPE FSIM_PVTYPE
 #elif FSIM_VAL3
 #  if FSIM_SA
 #    define FSIM_NAMESPACE nsFsimSa3
@@ -43,7 +69,7 @@
 #  else
 #    error "Neither FSIM_SA nor FSIM_TD are not set"
 #  endif
-#  define FSIM_VALTYPE PackedVal3
+#  define FSIM_VALTYPE FSIM_PV3TYPE
 #else
 #  error "Neither FSIM_VAL2 nor FSIM_VAL3 are not set"
 #endif
@@ -25,9 +25,7 @@ END_NONAMESPACE
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] max_id ノード番号の最大値
-Just1::Just1(int max_id) :
-  JustImpl(max_id)
+Just1::Just1()
 {
 }
 
@@ -37,10 +35,10 @@ Just1::~Just1()
 }
 
 // @brief 初期化処理
-// @param[in] assign_list 割当リスト
+// @param[in] assign_array 時刻ごとの割当リストの配列
 // @param[in] jd justify 用のデータ
 void
-Just1::just_init(const NodeValList& assign_list,
+Just1::just_init(const vector<NodeValList>& assign_array,
 		 const JustData& jd)
 {
   // なにもしない．
@@ -49,7 +47,7 @@ Just1::just_init(const NodeValList& assign_list,
 // @brief 制御値を持つファンインを一つ選ぶ．
 // @param[in] jd justiry用のデータ
 // @param[in] node 対象のノード
-// @param[in] time 時刻 ( 0 or 1 )
+// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
 // @return 選んだファンインのノードを返す．
 const TpgNode*
 Just1::select_cval_node(const JustData& jd,
@@ -26,8 +26,7 @@ class Just1 :
 public:
 
   /// @brief コンストラクタ
-  /// @param[in] max_id ノード番号の最大値
-  Just1(int max_id);
+  Just1();
 
   /// @brief デストラクタ
   ~Just1();
@@ -39,16 +38,16 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化処理
-  /// @param[in] assign_list 割当リスト
+  /// @param[in] assign_array 時刻ごとの割当リストの配列
   /// @param[in] jd justify 用のデータ
   void
-  just_init(const NodeValList& assign_list,
+  just_init(const vector<NodeValList>& assign_array,
 	    const JustData& jd) override;
 
   /// @brief 制御値を持つファンインを一つ選ぶ．
   /// @param[in] jd justiry用のデータ
   /// @param[in] node 対象のノード
-  /// @param[in] time 時刻 ( 0 or 1 )
+  /// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
   /// @return 選んだファンインのノードを返す．
   const TpgNode*
   select_cval_node(const JustData& jd,
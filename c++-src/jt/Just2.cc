@@ -10,6 +10,7 @@
 #include "Just2.h"
 #include "JustData.h"
 #include "TpgDff.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -25,14 +26,9 @@ END_NONAMESPACE
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] max_id ノード番号の最大値
-Just2::Just2(int max_id) :
-  JustImpl(max_id),
-  mWeightArray(max_id * 2, 0U),
-  mTmpArray(max_id * 2, 0.0)
+Just2::Just2() :
+  mNodeList(2)
 {
-  mNodeList[0].reserve(max_id);
-  mNodeList[1].reserve(max_id);
 }
 
 // @brief デストラクタ
@@ -41,20 +37,24 @@ Just2::~Just2()
 }
 
 // @brief 初期化処理
-// @param[in] assign_list 割当リスト
+// @param[in] assign_array 時刻ごとの割当リストの配列
 // @param[in] jd justify 用のデータ
 void
-Just2::just_init(const NodeValList& assign_list,
+Just2::just_init(const vector<NodeValList>& assign_array,
 		 const JustData& jd)
 {
+  int nf = jd.frame_num();
+  // 作業領域は add_weight() でたどったノードの分だけ確保する．
+  // just_end() でクリアされているので中身は空になっている．
+  mNodeList.resize(nf);
+
   // ヒューリスティックで用いる重みを計算する．
-  for ( auto time: {0, 1} ) {
-    mNodeList[time].clear();
-  }
-  for ( auto nv: assign_list ) {
-    add_weight(jd, nv.node(), nv.time());
+  for ( auto time: Range(nf) ) {
+    for ( auto nv: assign_array[time] ) {
+      add_weight(jd, nv.node(), time);
+    }
   }
-  for ( auto time: {0, 1} ) {
+  for ( auto time: Range(nf) ) {
     for ( auto node: mNodeList[time] ) {
       calc_value(jd, node, time);
     }
@@ -64,7 +64,7 @@ Just2::just_init(const NodeValList& assign_list,
 // @brief 制御値を持つファンインを一つ選ぶ．
 // @param[in] jd justiry用のデータ
 // @param[in] node 対象のノード
-// @param[in] time 時刻 ( 0 or 1 )
+// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
 // @return 選んだファンインのノードを返す．
 const TpgNode*
 Just2::select_cval_node(const JustData& jd,
@@ -95,25 +95,26 @@ void
 Just2::just_end()
 {
   // 作業領域をクリアしておく．
-  for ( auto time: { 0, 1 } ) {
-    for ( auto node: mNodeList[time] ) {
-      int index = node->id() * 2 + time;
-      mWeightArray[index] = 0;
-      mTmpArray[index] = 0.0;
-    }
-    mNodeList[time].clear();
+  for ( auto& node_list: mNodeList ) {
+    node_list.clear();
   }
+  mWeightArray.clear();
+  mTmpArray.clear();
 }
 
 // @brief 重みの計算を行う．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
+// @param[in] time タイムフレーム
 void
 Just2::add_weight(const JustData& jd,
 		  const TpgNode* node,
 		  int time)
 {
-  int index = node->id() * 2 + time;
+  int index = local_index(node, time);
+  if ( index == static_cast<int>(mWeightArray.size()) ) {
+    mWeightArray.push_back(0);
+    mTmpArray.push_back(0.0);
+  }
 
   ++ mWeightArray[index];
   if ( mWeightArray[index] > 1 ) {
@@ -129,11 +130,11 @@ Just2::add_weight(const JustData& jd,
     ;
   }
   else if ( node->is_dff_output() ) {
-    if ( time == 1 && jd.td_mode() ) {
+    if ( jd.has_prev_frame(time) ) {
       // 1時刻前のタイムフレームに戻る．
       const TpgDff* dff = node->dff();
       const TpgNode* alt_node = dff->input();
-      add_weight(jd, alt_node, 0);
+      add_weight(jd, alt_node, time - 1);
     }
   }
   else {
@@ -162,13 +163,16 @@ Just2::add_weight(const JustData& jd,
 
 // @brief 見積もり値の計算を行う．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
+// @param[in] time タイムフレーム
 void
 Just2::calc_value(const JustData& jd,
 		  const TpgNode* node,
 		  int time)
 {
-  if ( mTmpArray[node->id() * 2 + time] != 0.0 ) {
+  int index = find_index(node, time);
+  ASSERT_COND( index >= 0 );
+
+  if ( mTmpArray[index] != 0.0 ) {
     return;
   }
 
@@ -177,10 +181,10 @@ Just2::calc_value(const JustData& jd,
     val = 1.0;
   }
   else if ( node->is_dff_output() ) {
-    if ( time == 1 && jd.td_mode() ) {
+    if ( jd.has_prev_frame(time) ) {
       const TpgDff* dff = node->dff();
       const TpgNode* alt_node = dff->input();
-      val = node_value(alt_node, 0);
+      val = node_value(alt_node, time - 1);
     }
     else {
       val = 1.0;
@@ -215,7 +219,7 @@ Just2::calc_value(const JustData& jd,
       }
     }
   }
-  mTmpArray[node->id() * 2 + time] = val;
+  mTmpArray[index] = val;
 }
 
 END_NAMESPACE_SATPG
@@ -27,8 +27,7 @@ class Just2 :
 public:
 
   /// @brief コンストラクタ
-  /// @param[in] max_id ノード番号の最大値
-  Just2(int max_id);
+  Just2();
 
   /// @brief デストラクタ
   virtual
@@ -41,17 +40,17 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化処理
-  /// @param[in] assign_list 割当リスト
+  /// @param[in] assign_array 時刻ごとの割当リストの配列
   /// @param[in] jd justify 用のデータ
   virtual
   void
-  just_init(const NodeValList& assign_list,
+  just_init(const vector<NodeValList>& assign_array,
 	    const JustData& jd) override;
 
   /// @brief 制御値を持つファンインを一つ選ぶ．
   /// @param[in] jd justiry用のデータ
   /// @param[in] node 対象のノード
-  /// @param[in] time 時刻 ( 0 or 1 )
+  /// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
   /// @return 選んだファンインのノードを返す．
   virtual
   const TpgNode*
@@ -72,7 +71,7 @@ private:
 
   /// @brief 重みの計算を行う．
   /// @param[in] node 対象のノード
-  /// @param[in] time タイムフレーム ( 0 or 1 )
+  /// @param[in] time タイムフレーム
   void
   add_weight(const JustData& jd,
 	     const TpgNode* node,
@@ -80,7 +79,7 @@ private:
 
   /// @brief 見積もり値の計算を行う．
   /// @param[in] node 対象のノード
-  /// @param[in] time タイムフレーム ( 0 or 1 )
+  /// @param[in] time タイムフレーム
   void
   calc_value(const JustData& jd,
 	     const TpgNode* node,
@@ -88,7 +87,7 @@ private:
 
   /// @brief 重みを考えた価値を返す．
   /// @param[in] node 対象のノード
-  /// @param[in] time タイムフレーム ( 0 or 1 )
+  /// @param[in] time タイムフレーム
   double
   node_value(const TpgNode* node,
 	     int time) const;
@@ -99,14 +98,16 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // ノードのリスト
-  // 作業領域のクリアで用いる．
-  vector<const TpgNode*> mNodeList[2];
+  // 時刻ごとのノードのリスト
+  // post order に並んでいる．
+  vector<vector<const TpgNode*> > mNodeList;
 
   // 重み配列
+  // インデックスは local_index() の値
   vector<int> mWeightArray;
 
   // 作業用の配列
+  // インデックスは local_index() の値
   vector<double> mTmpArray;
 
 };
@@ -118,14 +119,14 @@ private:
 
 // @brief 重みを考えた価値を返す．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
+// @param[in] time タイムフレーム
 inline
 double
 Just2::node_value(const TpgNode* node,
 		  int time) const
 {
-  int index = node->id() * 2 + time;
-  ASSERT_COND ( mWeightArray[index] > 0 );
+  int index = find_index(node, time);
+  ASSERT_COND ( index >= 0 && mWeightArray[index] > 0 );
 
   return mTmpArray[index] / mWeightArray[index];
 }
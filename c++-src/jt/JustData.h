@@ -40,6 +40,12 @@ public:
 	   const VidMap& var2_map,
 	   const vector<SatBool3>& model);
 
+  /// @brief コンストラクタ(時間展開用)
+  /// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+  /// @param[in] model SATソルバの作ったモデル
+  JustData(const vector<VidMap>& var_map_list,
+	   const vector<SatBool3>& model);
+
   /// @brief デストラクタ
   ~JustData();
 
@@ -49,21 +55,33 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 遷移故障モードの時 true を返す．
+  /// @brief 時間フレーム数を返す．
+  ///
+  /// 縮退故障用と遷移故障用の場合は 2 を返す．
+  int
+  frame_num() const;
+
+  /// @brief DFF の出力から1時刻前のフレームに戻れる時 true を返す．
+  /// @param[in] time 時刻
+  ///
+  /// 縮退故障用の場合は常に false となる．
   bool
-  td_mode() const;
+  has_prev_frame(int time) const;
 
   /// @brief ノードの正常値を返す．
   /// @param[in] node ノード
-  /// @param[in] time 時刻 ( 0 or 1 )
+  /// @param[in] time 時刻 ( 0 <= time < frame_num() )
   Val3
   val(const TpgNode* node,
       int time) const;
 
   /// @brief 入力ノードの値を記録する．
   /// @param[in] node 対象の外部入力ノード
-  /// @param[in] time 時刻 ( 0 or 1 )
+  /// @param[in] time 時刻 ( 0 <= time < frame_num() )
   /// @param[out] assign_list 値の割当リスト
+  ///
+  /// assign_list には時刻 0 として記録される．
+  /// 時刻ごとに異なるリストを用いること．
   void
   record_value(const TpgNode* node,
 	       int time,
@@ -74,17 +92,15 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 1時刻目の変数マップ
-  const VidMap& mVar0Map;
-
-  // 2時刻目の変数マップ
-  const VidMap& mVar1Map;
+  // 時刻ごとの変数マップ
+  // 縮退故障用の場合は同じマップを2つ持つ．
+  vector<const VidMap*> mVarMapList;
 
   // SAT ソルバの解
   const vector<SatBool3>& mSatModel;
 
-  // 遷移故障モード
-  bool mTdMode;
+  // DFF をまたいで時刻を遡る時 true
+  bool mMultiFrame;
 
 };
 
@@ -99,10 +115,9 @@ private:
 inline
 JustData::JustData(const VidMap& var_map,
 		   const vector<SatBool3>& model) :
-  mVar0Map(var_map),
-  mVar1Map(var_map),
+  mVarMapList{&var_map, &var_map},
   mSatModel(model),
-  mTdMode(false)
+  mMultiFrame(false)
 {
 }
 
@@ -114,42 +129,65 @@ inline
 JustData::JustData(const VidMap& var0_map,
 		   const VidMap& var1_map,
 		   const vector<SatBool3>& model) :
-  mVar0Map(var0_map),
-  mVar1Map(var1_map),
+  mVarMapList{&var0_map, &var1_map},
   mSatModel(model),
-  mTdMode(true)
+  mMultiFrame(true)
 {
 }
 
+// @brief コンストラクタ(時間展開用)
+// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+// @param[in] model SATソルバの作ったモデル
+inline
+JustData::JustData(const vector<VidMap>& var_map_list,
+		   const vector<SatBool3>& model) :
+  mSatModel(model),
+  mMultiFrame(true)
+{
+  mVarMapList.reserve(var_map_list.size());
+  for ( auto& var_map: var_map_list ) {
+    mVarMapList.push_back(&var_map);
+  }
+}
+
 // @brief デストラクタ
 inline
 JustData::~JustData()
 {
 }
 
-// @brief 遷移故障モードの時 true を返す．
+// @brief 時間フレーム数を返す．
+inline
+int
+JustData::frame_num() const
+{
+  return mVarMapList.size();
+}
+
+// @brief DFF の出力から1時刻前のフレームに戻れる時 true を返す．
+// @param[in] time 時刻
 inline
 bool
-JustData::td_mode() const
+JustData::has_prev_frame(int time) const
 {
-  return mTdMode;
+  return mMultiFrame && time > 0;
 }
 
 // @brief ノードの正常値を返す．
 // @param[in] node ノード
-// @param[in] time 時刻 ( 0 or 1 )
+// @param[in] time 時刻 ( 0 <= time < frame_num() )
 inline
 Val3
 JustData::val(const TpgNode* node,
 	      int time) const
 {
-  const VidMap& varmap = (time == 0) ? mVar0Map : mVar1Map;
+  const VidMap& varmap = *mVarMapList[time];
   return bool3_to_val3(mSatModel[varmap(node).val()]);
 }
 
 // @brief 入力ノードの値を記録する．
 // @param[in] node 対象の外部入力ノード
-// @param[in] time 時刻 (0 or 1)
+// @param[in] time 時刻 ( 0 <= time < frame_num() )
 // @param[out] assign_list 値の割当リスト
 inline
 void
@@ -160,7 +198,7 @@ JustData::record_value(const TpgNode* node,
   Val3 v = val(node, time);
   if ( v != Val3::_X ) {
     bool bval = (v == Val3::_1);
-    assign_list.add(node, time, bval);
+    assign_list.add(node, 0, bval);
   }
 }
 
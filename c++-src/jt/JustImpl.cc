@@ -10,6 +10,7 @@
 #include "JustImpl.h"
 #include "JustData.h"
 #include "TpgDff.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -19,9 +20,8 @@ BEGIN_NAMESPACE_SATPG
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] max_id ID番号の最大値
-JustImpl::JustImpl(int max_id) :
-  mMarkArray(max_id, 0U)
+JustImpl::JustImpl() :
+  mFrameNum(2)
 {
 }
 
@@ -40,22 +40,9 @@ JustImpl::justify(const NodeValList& assign_list,
 		  const VidMap& var_map,
 		  const vector<SatBool3>& model)
 {
-  clear_mark();
-
   JustData jd(var_map, model);
 
-  just_init(assign_list, jd);
-
-  NodeValList pi_assign_list;
-  for ( auto nv: assign_list ) {
-    const TpgNode* node = nv.node();
-    int time = nv.time();
-    just_main(jd, node, time, pi_assign_list);
-  }
-
-  just_end();
-
-  return pi_assign_list;
+  return justify_2frames(assign_list, jd);
 }
 
 // @brief 正当化に必要な割当を求める(遷移故障用)．
@@ -70,33 +57,88 @@ JustImpl::justify(const NodeValList& assign_list,
 		  const VidMap& var2_map,
 		  const vector<SatBool3>& model)
 {
-  clear_mark();
-
   JustData jd(var1_map, var2_map, model);
 
-  just_init(assign_list, jd);
+  return justify_2frames(assign_list, jd);
+}
 
-  NodeValList pi_assign_list;
+// @brief 正当化に必要な割当を求める(時間展開用)．
+// @param[in] assign_array 時刻ごとの値の割り当てリストの配列
+// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+// @param[in] model SAT問題の解
+// @return 時刻ごとの外部入力上の値の割当リストの配列
+vector<NodeValList>
+JustImpl::justify(const vector<NodeValList>& assign_array,
+		  const vector<VidMap>& var_map_list,
+		  const vector<SatBool3>& model)
+{
+  ASSERT_COND( assign_array.size() == var_map_list.size() );
+
+  JustData jd(var_map_list, model);
+
+  return _justify(assign_array, jd);
+}
+
+// @brief 2時刻分の justify() の共通処理
+// @param[in] assign_list 値の割り当てリスト
+// @param[in] jd justify 用のデータ
+// @return 外部入力上の値の割当リスト
+//
+// 割当リストを時刻ごとに分けて _justify() を呼び，結果を一つのリストにまとめる．
+NodeValList
+JustImpl::justify_2frames(const NodeValList& assign_list,
+			  const JustData& jd)
+{
+  vector<NodeValList> assign_array(2);
   for ( auto nv: assign_list ) {
-    const TpgNode* node = nv.node();
-    int time = nv.time();
-    just_main(jd, node, time, pi_assign_list);
+    assign_array[nv.time()].add(nv.node(), 0, nv.val());
   }
 
-  just_end();
+  vector<NodeValList> pi_assign_array = _justify(assign_array, jd);
 
+  NodeValList pi_assign_list;
+  for ( auto time: {0, 1} ) {
+    for ( auto nv: pi_assign_array[time] ) {
+      pi_assign_list.add(nv.node(), time, nv.val());
+    }
+  }
   return pi_assign_list;
 }
 
+// @brief justify() の共通処理
+// @param[in] assign_array 時刻ごとの割当リストの配列
+// @param[in] jd justify 用のデータ
+// @return 時刻ごとの外部入力上の値の割当リストの配列
+vector<NodeValList>
+JustImpl::_justify(const vector<NodeValList>& assign_array,
+		   const JustData& jd)
+{
+  int nf = jd.frame_num();
+  clear_mark(nf);
+
+  just_init(assign_array, jd);
+
+  vector<NodeValList> pi_assign_array(nf);
+  for ( auto time: Range(nf) ) {
+    for ( auto nv: assign_array[time] ) {
+      just_main(jd, nv.node(), time, pi_assign_array);
+    }
+  }
+
+  just_end();
+
+  return pi_assign_array;
+}
+
 // @brief 正当化に必要な割当を求める．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
-// @param[out] pi_assign_list 外部入力上の値の割当リスト
+// @param[in] time タイムフレーム ( 0 <= time < jd.frame_num() )
+// @param[out] pi_assign_array 時刻ごとの外部入力上の値の割当リスト
 void
 JustImpl::just_main(const JustData& jd,
 		    const TpgNode* node,
 		    int time,
-		    NodeValList& pi_assign_list)
+		    vector<NodeValList>& pi_assign_array)
 {
   if ( mark(node, time) ) {
     // 処理済みならなにもしない．
@@ -107,20 +149,20 @@ JustImpl::just_main(const JustData& jd,
 
   if ( node->is_primary_input() ) {
     // 外部入力なら値を記録する．
-    jd.record_value(node, time, pi_assign_list);
+    jd.record_value(node, time, pi_assign_array[time]);
     return;
   }
 
   if ( node->is_dff_output() ) {
-    if ( time == 1 && jd.td_mode() ) {
-      // DFF の出力で1時刻目の場合は0時刻目に戻る．
+    if ( jd.has_prev_frame(time) ) {
+      // DFF の出力で1時刻目以降の場合は1時刻前に戻る．
       const TpgDff* dff = node->dff();
       const TpgNode* alt_node = dff->input();
-      just_main(jd, alt_node, 0, pi_assign_list);
+      just_main(jd, alt_node, time - 1, pi_assign_array);
     }
     else {
       // DFFを擬似入力だと思って値を記録する．
-      jd.record_value(node, time, pi_assign_list);
+      jd.record_value(node, time, pi_assign_array[time]);
     }
     return;
   }
@@ -130,24 +172,24 @@ JustImpl::just_main(const JustData& jd,
     // cval を持つファンインを選ぶ．
     const TpgNode* inode = select_cval_node(jd, node, time);
     // そのノードに再帰する．
-    just_main(jd, inode, time, pi_assign_list);
+    just_main(jd, inode, time, pi_assign_array);
   }
   else {
     // すべてのファンインに再帰する．
     for ( auto inode: node->fanin_list() ) {
-      just_main(jd, inode, time, pi_assign_list);
+      just_main(jd, inode, time, pi_assign_array);
     }
   }
 }
 
-// @brief 全てのマークを消す．
+// @brief 全てのマークを消してフレーム数を設定する．
+// @param[in] frame_num フレーム数
 void
-JustImpl::clear_mark()
+JustImpl::clear_mark(int frame_num)
 {
-  for ( vector<ymuint8>::iterator p = mMarkArray.begin();
-	p != mMarkArray.end(); ++ p ) {
-    *p = 0U;
-  }
+  mFrameNum = frame_num;
+  mIndexMap.clear();
+  mMarkArray.clear();
 }
 
 END_NAMESPACE_SATPG
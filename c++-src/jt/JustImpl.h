@@ -11,6 +11,8 @@
 
 #include "satpg.h"
 #include "TpgNode.h"
+#include "NodeValList.h"
+#include "LocalIndexMap.h"
 #include "ym/SatBool3.h"
 
 
@@ -21,14 +23,16 @@ class JustData;
 //////////////////////////////////////////////////////////////////////
 /// @class JustImpl JustImpl.h "JustImpl.h"
 /// @brief Justifier の実装クラス
+///
+/// 作業領域は (ノード, 時刻) の組を局所的な番号に付け替えて持つので，
+/// 大きさは正当化でたどったコーンの大きさに比例する．
 //////////////////////////////////////////////////////////////////////
 class JustImpl
 {
 public:
 
   /// @brief コンストラクタ
-  /// @param[in] max_id ID番号の最大値
-  JustImpl(int max_id);
+  JustImpl();
 
   /// @brief デストラクタ
   virtual
@@ -62,6 +66,19 @@ public:
 	  const VidMap& var2_map,
 	  const vector<SatBool3>& model);
 
+  /// @brief 正当化に必要な割当を求める(時間展開用)．
+  /// @param[in] assign_array 時刻ごとの値の割り当てリストの配列
+  /// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+  /// @param[in] model SAT問題の解
+  /// @return 時刻ごとの外部入力上の値の割当リストの配列
+  ///
+  /// assign_array の要素の時刻は無視される．
+  /// 結果の時刻 0 のリストには DFF の出力の値も含まれる．
+  vector<NodeValList>
+  justify(const vector<NodeValList>& assign_array,
+	  const vector<VidMap>& var_map_list,
+	  const vector<SatBool3>& model);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -69,28 +86,28 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化処理
-  /// @param[in] assign_list 割当リスト
+  /// @param[in] assign_array 時刻ごとの割当リストの配列
   /// @param[in] jd justify 用のデータ
   virtual
   void
-  just_init(const NodeValList& assign_list,
+  just_init(const vector<NodeValList>& assign_array,
 	    const JustData& jd) = 0;
 
   /// @brief 正当化処理
   /// @param[in] jd justiry用のデータ
   /// @param[in] node 対象のノード
-  /// @param[in] time 時刻 ( 0 or 1 )
-  /// @param[in] pi_assign_list 結果の割当を保持するリスト
+  /// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
+  /// @param[in] pi_assign_array 結果の割当を時刻ごとに保持する配列
   void
   just_main(const JustData& jd,
 	    const TpgNode* node,
 	    int time,
-	    NodeValList& pi_assign_list);
+	    vector<NodeValList>& pi_assign_array);
 
   /// @brief 制御値を持つファンインを一つ選ぶ．
   /// @param[in] jd justiry用のデータ
   /// @param[in] node 対象のノード
-  /// @param[in] time 時刻 ( 0 or 1 )
+  /// @param[in] time 時刻 ( 0 <= time < jd.frame_num() )
   /// @return 選んだファンインのノードを返す．
   virtual
   const TpgNode*
@@ -104,28 +121,69 @@ private:
   just_end() = 0;
 
 
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスから用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief (ノード, 時刻) の組を登録して局所的な番号を返す．
+  /// @param[in] node 対象のノード
+  /// @param[in] time タイムフレーム
+  ///
+  /// 番号は _justify() の呼び出しごとに 0 から振り直される．
+  int
+  local_index(const TpgNode* node,
+	      int time);
+
+  /// @brief 登録済みの (ノード, 時刻) の組の局所的な番号を返す．
+  /// @param[in] node 対象のノード
+  /// @param[in] time タイムフレーム
+  ///
+  /// 登録されていない場合は -1 を返す．
+  int
+  find_index(const TpgNode* node,
+	     int time) const;
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
-   /// @brief justified マークをつけ，mJustifiedNodeList に加える．
+  /// @brief 2時刻分の justify() の共通処理
+  /// @param[in] assign_list 値の割り当てリスト
+  /// @param[in] jd justify 用のデータ
+  /// @return 外部入力上の値の割当リスト
+  NodeValList
+  justify_2frames(const NodeValList& assign_list,
+		  const JustData& jd);
+
+  /// @brief justify() の共通処理
+  /// @param[in] assign_array 時刻ごとの割当リストの配列
+  /// @param[in] jd justify 用のデータ
+  /// @return 時刻ごとの外部入力上の値の割当リストの配列
+  vector<NodeValList>
+  _justify(const vector<NodeValList>& assign_array,
+	   const JustData& jd);
+
+  /// @brief justified マークをつける．
   /// @param[in] node 対象のノード
-  /// @param[in] time タイムフレーム ( 0 or 1 )
+  /// @param[in] time タイムフレーム
   void
   set_mark(const TpgNode* node,
 	   int time);
 
   /// @brief justified マークを読む．
   /// @param[in] node 対象のノード
-  /// @param[in] time タイムフレーム ( 0 or 1 )
+  /// @param[in] time タイムフレーム
   bool
   mark(const TpgNode* node,
        int time) const;
 
-  /// @brief 全てのマークを消す．
+  /// @brief 全てのマークを消してフレーム数を設定する．
+  /// @param[in] frame_num フレーム数
   void
-  clear_mark();
+  clear_mark(int frame_num);
 
 
 private:
@@ -133,8 +191,15 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // 現在のフレーム数
+  int mFrameNum;
+
+  // node->id() * mFrameNum + time を局所的な番号に付け替えるマップ
+  LocalIndexMap mIndexMap;
+
   // 個々のノードのマークを表す配列
-  vector<ymuint8> mMarkArray;
+  // インデックスは local_index() の値
+  vector<bool> mMarkArray;
 
 };
 
@@ -143,30 +208,57 @@ private:
 // インライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
+// @brief (ノード, 時刻) の組を登録して局所的な番号を返す．
+// @param[in] node 対象のノード
+// @param[in] time タイムフレーム
+inline
+int
+JustImpl::local_index(const TpgNode* node,
+		      int time)
+{
+  ASSERT_COND( time >= 0 && time < mFrameNum );
+
+  int index = mIndexMap.reg(node->id() * mFrameNum + time);
+  if ( index == static_cast<int>(mMarkArray.size()) ) {
+    mMarkArray.push_back(false);
+  }
+  return index;
+}
+
+// @brief 登録済みの (ノード, 時刻) の組の局所的な番号を返す．
+// @param[in] node 対象のノード
+// @param[in] time タイムフレーム
+inline
+int
+JustImpl::find_index(const TpgNode* node,
+		     int time) const
+{
+  ASSERT_COND( time >= 0 && time < mFrameNum );
+
+  return mIndexMap.find(node->id() * mFrameNum + time);
+}
+
 // @brief justified マークをつける．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
+// @param[in] time タイムフレーム
 inline
 void
 JustImpl::set_mark(const TpgNode* node,
 		   int time)
 {
-  // 念のため time の最下位ビットだけ使う．
-  time &= 1;
-  mMarkArray[node->id()] |= (1U << time);
+  mMarkArray[local_index(node, time)] = true;
 }
 
 // @brief justified マークを読む．
 // @param[in] node 対象のノード
-// @param[in] time タイムフレーム ( 0 or 1 )
+// @param[in] time タイムフレーム
 inline
 bool
 JustImpl::mark(const TpgNode* node,
 	       int time) const
 {
-  // 念のため time の最下位ビットだけ使う．
-  time &= 1;
-  return static_cast<bool>((mMarkArray[node->id()] >> time) & 1U);
+  int index = find_index(node, time);
+  return index >= 0 && mMarkArray[index];
 }
 
 END_NAMESPACE_SATPG
@@ -12,7 +12,11 @@
 #include "Just2.h"
 #include "NodeValList.h"
 #include "TestVector.h"
+#include "InputVector.h"
+#include "DffVector.h"
 #include "TpgNetwork.h"
+#include "TpgDff.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -20,18 +24,17 @@ BEGIN_NAMESPACE_SATPG
 BEGIN_NONAMESPACE
 
 std::unique_ptr<JustImpl>
-new_just(const string& just_type,
-	 int max_id)
+new_just(const string& just_type)
 {
   if ( just_type == "just1" ) {
-    return std::unique_ptr<JustImpl>(new Just1(max_id));
+    return std::unique_ptr<JustImpl>(new Just1());
   }
   if ( just_type == "just2" ) {
-    return std::unique_ptr<JustImpl>(new Just2(max_id));
+    return std::unique_ptr<JustImpl>(new Just2());
   }
 
   // デフォルトフォールバックは Just2
-  return std::unique_ptr<JustImpl>(new Just2(max_id));
+  return std::unique_ptr<JustImpl>(new Just2());
 }
 
 END_NONAMESPACE
@@ -46,7 +49,7 @@ END_NONAMESPACE
 Justifier::Justifier(const string& just_type,
 		     const TpgNetwork& network) :
   mNetwork(network),
-  mImpl(new_just(just_type, network.node_num()))
+  mImpl(new_just(just_type))
 {
 }
 
@@ -87,4 +90,40 @@ Justifier::operator()(const NodeValList& assign_list,
 					  FaultType::TransitionDelay, pi_assign_list);
 }
 
+// @brief 正当化に必要な割当を求める(時間展開用)．
+// @param[in] assign_array 時刻ごとの値の割り当てリストの配列
+// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+// @param[in] model SAT問題の解
+// @param[out] init_state FFの初期値
+// @param[out] input_list 時刻ごとの外部入力の値のリスト
+void
+Justifier::operator()(const vector<NodeValList>& assign_array,
+		      const vector<VidMap>& var_map_list,
+		      const vector<SatBool3>& model,
+		      DffVector& init_state,
+		      vector<InputVector>& input_list)
+{
+  vector<NodeValList> pi_assign_array = mImpl->justify(assign_array, var_map_list, model);
+
+  int nf = pi_assign_array.size();
+  init_state = DffVector(mNetwork.dff_num());
+  input_list.clear();
+  input_list.resize(nf, InputVector(mNetwork.input_num()));
+  for ( auto time: Range(nf) ) {
+    for ( auto nv: pi_assign_array[time] ) {
+      const TpgNode* node = nv.node();
+      Val3 val = nv.val() ? Val3::_1 : Val3::_0;
+      if ( node->is_primary_input() ) {
+	input_list[time].set_val(node->input_id(), val);
+      }
+      else {
+	// DFF の出力の値が記録されるのは時刻 0 のみ
+	ASSERT_COND( node->is_dff_output() && time == 0 );
+
+	init_state.set_val(node->dff()->id(), val);
+      }
+    }
+  }
+}
+
 END_NAMESPACE_SATPG
@@ -0,0 +1,457 @@
+
+/// @file DomCheckerInc.cc
+/// @brief DomCheckerInc の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "DomCheckerInc.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "TpgDff.h"
+#include "GateEnc.h"
+#include "FaultyGateEnc.h"
+#include "NodeValList.h"
+
+#include "ym/SatSolver.h"
+#include "ym/SatStats.h"
+#include "ym/StopWatch.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+BEGIN_NONAMESPACE
+
+// SAT ソルバを作り直すまでに処理する検出させない故障の数の既定値
+const int kRebuildInterval = 500;
+
+// SAT ソルバを作り直す節の数の上限
+const int kClauseLimit = 2000000;
+
+END_NONAMESPACE
+
+// @brief コンストラクタ
+// @param[in] network 対象のネットワーク
+// @param[in] fault_type 故障の種類
+// @param[in] solver_type SATソルバの実装タイプ
+DomCheckerInc::DomCheckerInc(const TpgNetwork& network,
+			     FaultType fault_type,
+			     const SatSolverType& solver_type) :
+  mSolverType(solver_type),
+  mSolver(new SatSolver(solver_type)),
+  mRebuildInterval(kRebuildInterval),
+  mUndetNum(0),
+  mRebuildNum(0),
+  mNetwork(network),
+  mFaultType(fault_type),
+  mHvarMap(network.node_num()),
+  mGvarMap(network.node_num()),
+  mMarkArray(network.node_num(), 0U),
+  mUndetFault(nullptr),
+  mUndetLit(kSatLiteralX)
+{
+}
+
+// @brief デストラクタ
+DomCheckerInc::~DomCheckerInc()
+{
+}
+
+// @brief 検出させない故障を設定する．
+// @param[in] fault 対象の故障
+void
+DomCheckerInc::set_undet_fault(const TpgFault* fault)
+{
+  ASSERT_COND( mUndetFault == nullptr );
+
+  if ( mUndetNum >= mRebuildInterval ) {
+    rebuild_solver();
+  }
+  else {
+    SatStats sat_stats;
+    mSolver->get_stats(sat_stats);
+    if ( sat_stats.mConstrClauseNum > kClauseLimit ) {
+      rebuild_solver();
+    }
+  }
+  ++ mUndetNum;
+
+  mUndetFault = fault;
+
+  const TpgNode* root = fault->tpg_onode();
+  vector<const TpgNode*> tfo_list;
+  get_tfo_list(root, tfo_list);
+
+  VidMap fvar_map;
+  fvar_map.init_sparse(tfo_list.size());
+  make_fvars(tfo_list, fvar_map);
+
+  // 活性化リテラル
+  // 仮定として使い続けるので凍結しておく．
+  // 故障値の変数はこのコーンの節からしか参照されないので凍結しない．
+  mUndetLit = SatLiteral(mSolver->new_variable());
+  mSolver->freeze_literal(mUndetLit);
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障回路の CNF を生成
+  // 全ての節は mUndetLit が 1 の時のみ有効となる．
+  //////////////////////////////////////////////////////////////////////
+  FaultyGateEnc fenc(*mSolver, fvar_map, fault, mUndetLit);
+  fenc.make_cnf();
+  GateEnc fval_enc(*mSolver, fvar_map, mUndetLit);
+  for ( auto node: tfo_list ) {
+    if ( node != root ) {
+      fval_enc.make_cnf(node);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障の非検出条件
+  // mUndetLit が 1 の時，全ての出力の正常値と故障値が等しい
+  //////////////////////////////////////////////////////////////////////
+  for ( auto node: tfo_list ) {
+    if ( node->is_ppo() ) {
+      SatLiteral glit(mGvarMap(node));
+      SatLiteral flit(fvar_map(node));
+      add_undet_clause({ glit, ~flit});
+      add_undet_clause({~glit,  flit});
+    }
+  }
+
+  // TFO の TFI に印をつける．
+  for ( auto node: tfo_list ) {
+    mMarkArray[node->id()] |= 2U;
+    mUndetConeList.push_back(node);
+  }
+  for ( int rpos = 0; rpos < static_cast<int>(mUndetConeList.size()); ++ rpos ) {
+    const TpgNode* node = mUndetConeList[rpos];
+    for ( auto inode: node->fanin_list() ) {
+      if ( (mMarkArray[inode->id()] & 2U) == 0U ) {
+	mMarkArray[inode->id()] |= 2U;
+	mUndetConeList.push_back(inode);
+      }
+    }
+  }
+}
+
+// @brief set_undet_fault() で設定した故障を解放する．
+void
+DomCheckerInc::release_undet_fault()
+{
+  if ( mUndetFault == nullptr ) {
+    return;
+  }
+
+  // 活性化リテラルを恒久的に 0 にする．
+  // コーンの節は全て ~mUndetLit を含むのでこの単位節で充足され，
+  // SAT ソルバの簡単化で取り除かれる．
+  mSolver->add_clause(~mUndetLit);
+
+  for ( auto node: mUndetConeList ) {
+    mMarkArray[node->id()] &= ~2U;
+  }
+  mUndetConeList.clear();
+  mUndetFault = nullptr;
+  mUndetLit = kSatLiteralX;
+}
+
+// @brief 検出させない故障のもとで条件が満たされるか調べる．
+// @param[in] cond 条件
+SatBool3
+DomCheckerInc::check_undetect(const NodeValList& cond)
+{
+  ASSERT_COND( mUndetFault != nullptr );
+
+  vector<SatLiteral> assumptions;
+  assumptions.push_back(mUndetLit);
+  conv_to_assumptions(cond, assumptions);
+
+  return solve(assumptions);
+}
+
+// @brief 検出させない故障のもとで故障が検出可能か調べる．
+// @param[in] fault 対象の故障
+SatBool3
+DomCheckerInc::check_detectable(const TpgFault* fault)
+{
+  ASSERT_COND( mUndetFault != nullptr );
+
+  vector<SatLiteral> assumptions;
+  assumptions.push_back(mUndetLit);
+  assumptions.push_back(det_literal(fault->tpg_onode()->ffr_root()));
+
+  NodeValList ffr_cond = ffr_propagate_condition(fault, mFaultType);
+  conv_to_assumptions(ffr_cond, assumptions);
+
+  return solve(assumptions);
+}
+
+// @brief SAT ソルバと作成済みの CNF を破棄して作り直す．
+void
+DomCheckerInc::rebuild_solver()
+{
+  ASSERT_COND( mUndetFault == nullptr );
+
+  mSolver.reset(new SatSolver(mSolverType));
+  mHvarMap.init(mNetwork.node_num());
+  mGvarMap.init(mNetwork.node_num());
+  mDetConeMap.clear();
+  mDetConeArray.clear();
+  mUndetNum = 0;
+  ++ mRebuildNum;
+}
+
+// @brief 正常回路の CNF を作る．
+// @param[in] node 対象のノード
+void
+DomCheckerInc::make_good_cnf(const TpgNode* node)
+{
+  if ( mGvarMap(node) != kSatVarIdIllegal ) {
+    return;
+  }
+  // 正常値の変数は後から作られる節や仮定から参照されるので凍結しておく．
+  SatVarId var = mSolver->new_variable();
+  mSolver->freeze_literal(SatLiteral(var));
+  mGvarMap.set_vid(node, var);
+
+  for ( auto inode: node->fanin_list() ) {
+    make_good_cnf(inode);
+  }
+
+  GateEnc gval_enc(*mSolver, mGvarMap);
+  gval_enc.make_cnf(node);
+
+  if ( mFaultType == FaultType::TransitionDelay && node->is_dff_output() ) {
+    // DFF の入力の1時刻前の値と出力の値が等しい．
+    const TpgNode* inode = node->dff()->input();
+    make_prev_cnf(inode);
+    SatLiteral olit(var);
+    SatLiteral ilit(mHvarMap(inode));
+    mSolver->add_eq_rel(olit, ilit);
+  }
+}
+
+// @brief 1時刻前の正常回路の CNF を作る．
+// @param[in] node 対象のノード
+void
+DomCheckerInc::make_prev_cnf(const TpgNode* node)
+{
+  if ( mHvarMap(node) != kSatVarIdIllegal ) {
+    return;
+  }
+  SatVarId var = mSolver->new_variable();
+  mSolver->freeze_literal(SatLiteral(var));
+  mHvarMap.set_vid(node, var);
+
+  for ( auto inode: node->fanin_list() ) {
+    make_prev_cnf(inode);
+  }
+
+  GateEnc hval_enc(*mSolver, mHvarMap);
+  hval_enc.make_cnf(node);
+}
+
+// @brief node の TFO のリストを作る．
+// @param[in] node 起点のノード
+// @param[out] tfo_list TFO のノードを格納するリスト
+void
+DomCheckerInc::get_tfo_list(const TpgNode* node,
+			    vector<const TpgNode*>& tfo_list)
+{
+  tfo_list.clear();
+  tfo_list.push_back(node);
+  mMarkArray[node->id()] |= 1U;
+  for ( int rpos = 0; rpos < static_cast<int>(tfo_list.size()); ++ rpos ) {
+    const TpgNode* node1 = tfo_list[rpos];
+    for ( auto onode: node1->fanout_list() ) {
+      if ( (mMarkArray[onode->id()] & 1U) == 0U ) {
+	mMarkArray[onode->id()] |= 1U;
+	tfo_list.push_back(onode);
+      }
+    }
+  }
+  for ( auto node1: tfo_list ) {
+    mMarkArray[node1->id()] &= ~1U;
+  }
+}
+
+// @brief TFO のノードに故障値の変数を割り当てる．
+// @param[in] tfo_list TFO のノードのリスト
+// @param[in] fvar_map 故障値の変数のマップ
+void
+DomCheckerInc::make_fvars(const vector<const TpgNode*>& tfo_list,
+			  VidMap& fvar_map)
+{
+  for ( auto node: tfo_list ) {
+    make_good_cnf(node);
+    SatVarId fvar = mSolver->new_variable();
+    fvar_map.set_vid(node, fvar);
+  }
+
+  // TFO に含まれないファンインの故障値は正常値と等しい．
+  for ( auto node: tfo_list ) {
+    for ( auto inode: node->fanin_list() ) {
+      if ( fvar_map(inode) == kSatVarIdIllegal ) {
+	fvar_map.set_vid(inode, mGvarMap(inode));
+      }
+    }
+  }
+}
+
+// @brief FFR の根から外部出力まで故障が伝搬する条件を表すリテラルを返す．
+// @param[in] root FFR の根
+SatLiteral
+DomCheckerInc::det_literal(const TpgNode* root)
+{
+  auto p = mDetConeMap.find(root->id());
+  if ( p != mDetConeMap.end() ) {
+    const DetCone& cone = mDetConeArray[p->second];
+    return SatLiteral(cone.mDvarMap(root));
+  }
+
+  int pos = mDetConeArray.size();
+  mDetConeMap.emplace(root->id(), pos);
+  mDetConeArray.push_back(DetCone());
+  DetCone& cone = mDetConeArray[pos];
+
+  vector<const TpgNode*> tfo_list;
+  get_tfo_list(root, tfo_list);
+
+  cone.mFvarMap.init_sparse(tfo_list.size());
+  cone.mDvarMap.init_sparse(tfo_list.size());
+  make_fvars(tfo_list, cone.mFvarMap);
+  for ( auto node: tfo_list ) {
+    SatVarId dvar = mSolver->new_variable();
+    cone.mDvarMap.set_vid(node, dvar);
+  }
+  // 根の dvar は仮定として使い続けるので凍結しておく．
+  mSolver->freeze_literal(SatLiteral(cone.mDvarMap(root)));
+
+  // 根の故障値は自由変数のままにしておく．
+  GateEnc fval_enc(*mSolver, cone.mFvarMap);
+  for ( auto node: tfo_list ) {
+    if ( node != root ) {
+      fval_enc.make_cnf(node);
+    }
+    make_dchain_cnf(node, cone);
+  }
+
+  // root の dvar が 1 なら外部出力のどれかで値が異なる．
+  return SatLiteral(cone.mDvarMap(root));
+}
+
+// @brief 故障伝搬条件を表すCNF式を生成する．
+// @param[in] node 対象のノード
+// @param[in] cone 対象のコーン
+void
+DomCheckerInc::make_dchain_cnf(const TpgNode* node,
+			       const DetCone& cone)
+{
+  SatLiteral glit(mGvarMap(node));
+  SatLiteral flit(cone.mFvarMap(node));
+  SatLiteral dlit(cone.mDvarMap(node));
+
+  // dlit -> XOR(glit, flit) を追加する．
+  // 要するに正常回路と故障回路で異なっているとき dlit が 1 となる．
+  mSolver->add_clause(~glit, ~flit, ~dlit);
+  mSolver->add_clause( glit,  flit, ~dlit);
+
+  if ( node->is_ppo() ) {
+    mSolver->add_clause(~glit,  flit,  dlit);
+    mSolver->add_clause( glit, ~flit,  dlit);
+  }
+  else {
+    // dlit -> ファンアウト先のノードの dlit の一つが 1
+    int nfo = node->fanout_num();
+    if ( nfo == 1 ) {
+      auto onode = node->fanout_list()[0];
+      SatLiteral odlit(cone.mDvarMap(onode));
+      mSolver->add_clause(~dlit, odlit);
+    }
+    else {
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(nfo + 1);
+      for ( auto onode: node->fanout_list() ) {
+	tmp_lits.push_back(SatLiteral(cone.mDvarMap(onode)));
+      }
+      tmp_lits.push_back(~dlit);
+      mSolver->add_clause(tmp_lits);
+
+      const TpgNode* imm_dom = node->imm_dom();
+      if ( imm_dom != nullptr ) {
+	SatLiteral odlit(cone.mDvarMap(imm_dom));
+	mSolver->add_clause(~dlit, odlit);
+      }
+    }
+  }
+}
+
+// @brief 検出させない故障の節を追加する．
+// @param[in] lits 節のリテラルのリスト
+//
+// mUndetLit の否定を加えて追加する．
+void
+DomCheckerInc::add_undet_clause(vector<SatLiteral> lits)
+{
+  lits.push_back(~mUndetLit);
+  mSolver->add_clause(lits);
+}
+
+// @brief 値割り当てをリテラルのリストに変換する．
+// @param[in] assign_list 値の割り当てリスト
+// @param[out] assumptions 変換したリテラルを追加するリスト
+void
+DomCheckerInc::conv_to_assumptions(const NodeValList& assign_list,
+				   vector<SatLiteral>& assumptions)
+{
+  assumptions.reserve(assumptions.size() + assign_list.size());
+  for ( auto nv: assign_list ) {
+    const TpgNode* node = nv.node();
+    bool inv = !nv.val(); // 0 の時が inv = true
+    SatVarId vid;
+    if ( nv.time() == 0 ) {
+      make_prev_cnf(node);
+      vid = mHvarMap(node);
+    }
+    else {
+      make_good_cnf(node);
+      vid = mGvarMap(node);
+    }
+    assumptions.push_back(SatLiteral(vid, inv));
+  }
+}
+
+// @brief 一つの SAT問題を解く．
+// @param[in] assumptions 値の決まっている変数のリスト
+// @return 結果を返す．
+SatBool3
+DomCheckerInc::solve(const vector<SatLiteral>& assumptions)
+{
+  StopWatch timer;
+  timer.start();
+
+  vector<SatBool3> model;
+  SatBool3 ans = mSolver->solve(assumptions, model);
+
+  timer.stop();
+  USTime time = timer.time();
+
+  SatStats sat_stats;
+  mSolver->get_stats(sat_stats);
+
+  if ( ans == SatBool3::True ) {
+    mStats.update_det(sat_stats, time);
+  }
+  else if ( ans == SatBool3::False ) {
+    mStats.update_red(sat_stats, time);
+  }
+  else {
+    mStats.update_abort(sat_stats, time);
+  }
+
+  return ans;
+}
+
+END_NAMESPACE_SATPG
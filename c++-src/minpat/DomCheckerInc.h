@@ -0,0 +1,313 @@
+#ifndef DOMCHECKERINC_H
+#define DOMCHECKERINC_H
+
+/// @file DomCheckerInc.h
+/// @brief DomCheckerInc のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "DtpgStats.h"
+#include "FaultType.h"
+
+#include "ym/sat.h"
+#include "ym/SatBool3.h"
+#include "ym/SatLiteral.h"
+#include "ym/SatSolver.h"
+
+#include "VidMap.h"
+
+#include <unordered_map>
+#include <memory>
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class DomCheckerInc DomCheckerInc.h "DomCheckerInc.h"
+/// @brief 一つの SAT ソルバで支配関係の判定を繰り返し行うクラス
+///
+/// UndetChecker や DomChecker は故障(と FFR)ごとに CNF 式を作り直すが，
+/// このクラスは一つの SAT ソルバを使い回して CNF 式を少しずつ追加していく．
+/// - 正常回路の CNF 式は必要になった部分だけを作り，一度作ったものは共有する．
+/// - 故障を検出しない条件(故障回路のコーン)は set_undet_fault() で
+///   作られ，活性化リテラルによって有効/無効が切り替えられる．
+///   release_undet_fault() の後は二度と有効にならない．
+/// - FFR の根から外部出力までの故障伝搬条件は根ごとに一度だけ作られ，
+///   伝搬条件の変数を仮定として与えることで有効になる．
+/// 個々の判定は仮定付きの SAT 問題として解かれるので，学習節は
+/// 判定をまたがって引き継がれる．
+///
+/// 無効化された節や使われなくなった伝搬条件が溜まり続けないように
+/// 検出させない故障を一定数処理するか節の数が上限を越えたら
+/// set_undet_fault() の中で SAT ソルバを作り直す．
+//////////////////////////////////////////////////////////////////////
+class DomCheckerInc
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] fault_type 故障の種類
+  /// @param[in] solver_type SATソルバの実装タイプ
+  DomCheckerInc(const TpgNetwork& network,
+		FaultType fault_type,
+		const SatSolverType& solver_type = SatSolverType());
+
+  /// @brief デストラクタ
+  ~DomCheckerInc();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 検出させない故障を設定する．
+  /// @param[in] fault 対象の故障
+  ///
+  /// 以降の check_undetect(), check_detectable() は fault が
+  /// 検出されない条件のもとで判定を行う．<br>
+  /// 直前の故障は release_undet_fault() で解放されていなければならない．
+  void
+  set_undet_fault(const TpgFault* fault);
+
+  /// @brief set_undet_fault() で設定した故障を解放する．
+  ///
+  /// 故障回路の CNF 式は無効化されて以降の判定には影響しない．
+  void
+  release_undet_fault();
+
+  /// @brief ノードが検出させない故障に関係している時 true を返す．
+  /// @param[in] node 対象のノード
+  ///
+  /// 故障の TFO の TFI に含まれている時 true となる．
+  bool
+  in_undet_cone(const TpgNode* node) const;
+
+  /// @brief 検出させない故障のもとで条件が満たされるか調べる．
+  /// @param[in] cond 条件
+  /// @retval SatBool3::False 条件が満たされる時には故障が必ず検出される．
+  SatBool3
+  check_undetect(const NodeValList& cond);
+
+  /// @brief 検出させない故障のもとで故障が検出可能か調べる．
+  /// @param[in] fault 対象の故障
+  /// @retval SatBool3::False fault は検出させない故障を支配している．
+  SatBool3
+  check_detectable(const TpgFault* fault);
+
+  /// @brief 統計情報を得る．
+  const DtpgStats&
+  stats() const;
+
+  /// @brief SAT ソルバを作り直した回数を返す．
+  int
+  rebuild_num() const;
+
+  /// @brief SAT ソルバを作り直すまでに処理する検出させない故障の数を設定する．
+  /// @param[in] num 故障数 ( num > 0 )
+  void
+  set_rebuild_interval(int num);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // FFR の根から外部出力までの故障伝搬条件を表す変数のマップ
+  struct DetCone
+  {
+    // 故障値を表す変数のマップ
+    VidMap mFvarMap;
+
+    // 故障伝搬条件を表す変数のマップ
+    VidMap mDvarMap;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief SAT ソルバと作成済みの CNF を破棄して作り直す．
+  void
+  rebuild_solver();
+
+  /// @brief 正常回路の CNF を作る．
+  /// @param[in] node 対象のノード
+  ///
+  /// node の TFI の CNF も作る．
+  void
+  make_good_cnf(const TpgNode* node);
+
+  /// @brief 1時刻前の正常回路の CNF を作る．
+  /// @param[in] node 対象のノード
+  ///
+  /// node の TFI の CNF も作る．
+  void
+  make_prev_cnf(const TpgNode* node);
+
+  /// @brief node の TFO のリストを作る．
+  /// @param[in] node 起点のノード
+  /// @param[out] tfo_list TFO のノードを格納するリスト
+  void
+  get_tfo_list(const TpgNode* node,
+	       vector<const TpgNode*>& tfo_list);
+
+  /// @brief TFO のノードに故障値の変数を割り当てる．
+  /// @param[in] tfo_list TFO のノードのリスト
+  /// @param[in] fvar_map 故障値の変数のマップ
+  ///
+  /// TFO に含まれないファンインには正常値の変数を割り当てる．
+  void
+  make_fvars(const vector<const TpgNode*>& tfo_list,
+	     VidMap& fvar_map);
+
+  /// @brief FFR の根から外部出力まで故障が伝搬する条件を表すリテラルを返す．
+  /// @param[in] root FFR の根
+  ///
+  /// 必要なら CNF 式を作る．
+  SatLiteral
+  det_literal(const TpgNode* root);
+
+  /// @brief 故障伝搬条件を表すCNF式を生成する．
+  /// @param[in] node 対象のノード
+  /// @param[in] cone 対象のコーン
+  void
+  make_dchain_cnf(const TpgNode* node,
+		  const DetCone& cone);
+
+  /// @brief 検出させない故障の節を追加する．
+  /// @param[in] lits 節のリテラルのリスト
+  ///
+  /// mUndetLit の否定を加えて追加する．
+  void
+  add_undet_clause(vector<SatLiteral> lits);
+
+  /// @brief 値割り当てをリテラルのリストに変換する．
+  /// @param[in] assign_list 値の割り当てリスト
+  /// @param[out] assumptions 変換したリテラルを追加するリスト
+  void
+  conv_to_assumptions(const NodeValList& assign_list,
+		      vector<SatLiteral>& assumptions);
+
+  /// @brief 一つの SAT問題を解く．
+  /// @param[in] assumptions 値の決まっている変数のリスト
+  /// @return 結果を返す．
+  SatBool3
+  solve(const vector<SatLiteral>& assumptions);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 統計情報
+  DtpgStats mStats;
+
+  // SATソルバの実装タイプ
+  SatSolverType mSolverType;
+
+  // SATソルバ
+  // 作り直すためにポインタで持つ．
+  std::unique_ptr<SatSolver> mSolver;
+
+  // SAT ソルバを作り直すまでに処理する検出させない故障の数
+  int mRebuildInterval;
+
+  // 現在の SAT ソルバで処理した検出させない故障の数
+  int mUndetNum;
+
+  // SAT ソルバを作り直した回数
+  int mRebuildNum;
+
+  // 対象のネットワーク
+  const TpgNetwork& mNetwork;
+
+  // 故障の種類
+  FaultType mFaultType;
+
+  // 1時刻前の正常値を表す変数のマップ
+  VidMap mHvarMap;
+
+  // 正常値を表す変数のマップ
+  VidMap mGvarMap;
+
+  // 作業用のマークを入れておく配列
+  // サイズは mNetwork.node_num()
+  // bit-0: TFO マーク
+  // bit-1: 検出させない故障の TFO の TFI マーク
+  vector<ymuint8> mMarkArray;
+
+  // 検出させない故障
+  const TpgFault* mUndetFault;
+
+  // 検出させない条件を有効にする活性化リテラル
+  SatLiteral mUndetLit;
+
+  // 検出させない故障の TFO の TFI のノードのリスト
+  vector<const TpgNode*> mUndetConeList;
+
+  // FFR の根のノード番号をキーにして mDetConeArray の位置を保持するハッシュ表
+  std::unordered_map<int, int> mDetConeMap;
+
+  // FFR の根ごとの故障伝搬条件の配列
+  vector<DetCone> mDetConeArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノードが検出させない故障に関係している時 true を返す．
+// @param[in] node 対象のノード
+inline
+bool
+DomCheckerInc::in_undet_cone(const TpgNode* node) const
+{
+  return (mMarkArray[node->id()] & 2U) != 0U;
+}
+
+// @brief 統計情報を得る．
+inline
+const DtpgStats&
+DomCheckerInc::stats() const
+{
+  return mStats;
+}
+
+// @brief SAT ソルバを作り直した回数を返す．
+inline
+int
+DomCheckerInc::rebuild_num() const
+{
+  return mRebuildNum;
+}
+
+// @brief SAT ソルバを作り直すまでに処理する検出させない故障の数を設定する．
+// @param[in] num 故障数 ( num > 0 )
+inline
+void
+DomCheckerInc::set_rebuild_interval(int num)
+{
+  ASSERT_COND( num > 0 );
+
+  mRebuildInterval = num;
+}
+
+END_NAMESPACE_SATPG
+
+#endif // DOMCHECKERINC_H
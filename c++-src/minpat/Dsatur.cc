@@ -22,234 +22,290 @@ BEGIN_NAMESPACE_SATPG
 Dsatur::Dsatur(MpColGraph& graph) :
   mGraph(graph)
 {
-  init();
+  vector<int> node_list;
+  node_list.reserve(graph.node_num());
+  for ( auto node_id: Range(graph.node_num()) ) {
+    node_list.push_back(node_id);
+  }
+  init(node_list);
+}
+
+// @brief 対象のノードを指定したコンストラクタ
+// @param[in] graph 対象のグラフ
+// @param[in] node_list 対象のノードのリスト
+Dsatur::Dsatur(MpColGraph& graph,
+	       const vector<int>& node_list) :
+  mGraph(graph)
+{
+  init(node_list);
 }
 
 // @brief 初期化する．
+// @param[in] node_list 対象のノードのリスト
 void
-Dsatur::init()
+Dsatur::init(const vector<int>& node_list)
 {
   int n = mGraph.node_num();
-  mCandList.reserve(n);
-  if ( n > 0 ) {
-    mSatDegree = new int[n];
-    mAdjDegree = new int[n];
-    mCovDegree = new int[n];
-    for ( auto node_id: Range(n) ) {
-      int c = mGraph.color(node_id);
-      if ( c != 0 ) {
-	continue;
-      }
-      int row_num = 0;
-      for ( auto row_id: mGraph.cover_list(node_id) ) {
-	if ( !mGraph.is_covered(row_id) ) {
-	  ++ row_num;
-	}
-      }
-      if ( row_num == 0 ) {
-	continue;
-      }
-      mCandList.push_back(node_id);
-      vector<bool> used_color(mGraph.color_num() + 1, false);
-      int adj_num = 0;
-      HashSet<int> node_set;
-      for ( auto node1_id: mGraph.adj_list(node_id) ) {
-	if ( !node_set.check(node1_id) ) {
-	  node_set.add(node1_id);
-	  ++ adj_num;
-	  int c1 = mGraph.color(node1_id);
-	  used_color[c1] = true;
-	}
+  mNodeList.clear();
+  mSatDegree.clear();
+  mSatDegree.resize(n, 0);
+  mAdjDegree.clear();
+  mAdjDegree.resize(n, 0);
+  mColorSet.clear();
+  mColorSet.resize(n);
+  mNext.clear();
+  mNext.resize(n, -1);
+  mPrev.clear();
+  mPrev.resize(n, -1);
+  mInQueue.clear();
+  mInQueue.resize(n, false);
+  mBucket.clear();
+  mMaxAdj.clear();
+  mMaxSat = -1;
+  mColorList.clear();
+  mColorCount.clear();
+
+  // 彩色済みのノードは衝突リストに現れないので色ごとにまとめておく．
+  int nc = mGraph.color_num();
+  vector<vector<int>> color_class(nc + 1);
+  for ( auto node_id: Range(n) ) {
+    int c = mGraph.color(node_id);
+    if ( c != 0 ) {
+      color_class[c].push_back(node_id);
+    }
+  }
+
+  // adj_degree は対象のノードだけを数える．
+  vector<bool> target(n, false);
+  for ( auto node_id: node_list ) {
+    if ( mGraph.color(node_id) != 0 || target[node_id] ) {
+      continue;
+    }
+    mNodeList.push_back(node_id);
+    target[node_id] = true;
+  }
+
+  vector<int> adj_list;
+  for ( auto node_id: mNodeList ) {
+    int sat = 0;
+    for ( auto c: Range(1, nc + 1) ) {
+      if ( !color_class[c].empty() &&
+	   !mGraph.compatible_check(node_id, color_class[c]) ) {
+	add_color(node_id, c);
+	++ sat;
       }
-      int sat = 0;
-      for ( auto c1: Range(1, mGraph.color_num()) ) {
-	if ( used_color[c1] ) {
-	  ++ sat;
-	}
+    }
+    mSatDegree[node_id] = sat;
+    mGraph.get_conflict_list(node_id, adj_list);
+    int adj = 0;
+    for ( auto node1_id: adj_list ) {
+      if ( target[node1_id] ) {
+	++ adj;
       }
-      mSatDegree[node_id] = sat;
-      mAdjDegree[node_id] = adj_num;
-      mCovDegree[node_id] = row_num;
     }
-  }
-  else {
-    mSatDegree = nullptr;
-    mAdjDegree = nullptr;
-    mCovDegree = nullptr;
+    mAdjDegree[node_id] = adj;
+    put(node_id);
   }
 }
 
 // @brief デストラクタ
 Dsatur::~Dsatur()
 {
-  delete [] mSatDegree;
-  delete [] mAdjDegree;
-  delete [] mCovDegree;
 }
 
 // @brief 彩色する．
-// @return 彩色数を返す．
 void
 Dsatur::coloring()
 {
   // dsatur アルゴリズムを用いる．
-
-  // 1: 隣接するノード数が最大のノードを選び彩色する．
-  int max_node = get_max_node();
-  update(max_node, mGraph.new_color());
-
-  // 2: saturation degree が最大の未彩色ノードを選び最小の色番号で彩色する．
+  // saturation degree が最大の未彩色ノードを選び彩色する．
+  // 最初は全てのノードの saturation degree が 0 なので
+  // 隣接するノード数が最大のノードが選ばれる．
+  vector<int> adj_list;
   for ( ; ; ) {
-    cout << "Dsatur: mUncolNum = " << mCandList.size()
-	 << ", color_num() = " << mGraph.color_num() << endl;
     int max_node = get_max_node();
     if ( max_node == -1 ) {
       break;
     }
-    // max_node に隣接している未彩色の色のリストを作る．
-    vector<int> free_list;
-    free_list.reserve(mGraph.adj_list(max_node).num());
-    vector<bool> used_color(mGraph.color_num() + 1, false);
-    for ( auto node1_id: mGraph.adj_list(max_node) ) {
-      int c = mGraph.color(node1_id);
-      if ( c == 0 ) {
-	free_list.push_back(node1_id);
-      }
-      else {
-	used_color[c] = true;
-      }
-    }
-    vector<int> color_list;
-    color_list.reserve(mGraph.color_num());
-    for ( auto c: Range(1, mGraph.color_num() + 1) ) {
-      if ( !used_color[c] ) {
-	color_list.push_back(c);
-      }
-    }
-    int sel_col = 0;
-    if ( color_list.empty() ) {
-      // 可能な色がなかったので新しい色を割り当てる．
-      sel_col = mGraph.new_color();
-    }
-    else {
-      // color_list に含まれる色のなかで隣接するノードの sat_degree の増加が
-      // 最小となるものを選ぶ．
-      vector<int> color_count(mGraph.color_num() + 1, 0);
-      for ( auto node1_id: free_list ) {
-	vector<bool> used_color(mGraph.color_num() + 1, false);
-	for ( auto node2_id: mGraph.adj_list(node1_id) ) {
-	  int c = mGraph.color(node2_id);
-	  used_color[c] = true;
-	}
-	for ( auto col: color_list ) {
-	  if ( used_color[col] ) {
-	    ++ color_count[col];
-	  }
-	}
-      }
-      int min_count = free_list.size() + 1;
-      for ( auto col: color_list ) {
-	int n = color_count[col];
-	if ( min_count > n ) {
-	  min_count = n;
-	  sel_col = col;
-	}
-      }
-    }
-    update(max_node, sel_col);
+    mGraph.get_conflict_list(max_node, adj_list);
+    int color = select_color(max_node, adj_list);
+    update(max_node, color, adj_list);
   }
 
   // 検証
-  // もちろん最小色数の保証はないが，同じ色が隣接していないことを確認する．
-  // また，未彩色のノードがないことも確認する．
-  // 違反が見つかったら例外を送出する．
-  if ( true ) {
-    ASSERT_COND( mGraph.is_covered() );
-    ASSERT_COND( mGraph.verify() );
-  }
-  if ( !mGraph.is_covered() || !mGraph.verify() ) {
-    cout << "Error" << endl;
+  // もちろん最小色数の保証はないが，未彩色のノードがないことを確認する．
+  for ( auto node_id: mNodeList ) {
+    ASSERT_COND( mGraph.color(node_id) != 0 );
   }
 }
 
 // @brief (sat_degree, adj_degree) の辞書順で最大のノードを取ってくる．
+// @return ノード番号を返す．
+//
+// 未彩色のノードがない場合には -1 を返す．
 int
 Dsatur::get_max_node()
 {
-  int max_row = -1;
-  int max_sat = -1;
-  int max_adj = -1;
-  int max_node = -1;
-  int rpos = 0;
-  int wpos = 0;
-  for ( ; rpos < mCandList.size(); ++ rpos ) {
-    int node_id = mCandList[rpos];
-    if ( mGraph.color(node_id) != 0 ) {
+  // remove() では上限を更新しないのでここで空のバケットを読み飛ばす．
+  // mMaxSat は put() 1回につき高々1しか増えないので，その走査は償却定数となる．
+  // 一方 mMaxAdj[sat] は put() でそのノードの adj_degree まで戻り得るので，
+  // その走査は償却定数ではなく，全体で put() したノードの adj_degree の和で抑えられる．
+  for ( ; mMaxSat >= 0; -- mMaxSat ) {
+    const auto& bucket = mBucket[mMaxSat];
+    int& max_adj = mMaxAdj[mMaxSat];
+    if ( bucket.empty() ) {
+      max_adj = -1;
       continue;
     }
-
-    int num_rows = 0;
-    for ( auto row_id: mGraph.cover_list(node_id) ) {
-      if ( !mGraph.is_covered(row_id) ) {
-	++ num_rows;
+    for ( ; max_adj >= 0; -- max_adj ) {
+      auto p = bucket.find(max_adj);
+      if ( p != bucket.end() ) {
+	return p->second;
       }
     }
-    if ( num_rows > 0 ) {
-      mCandList[wpos] = node_id;
-      ++ wpos;
-
-      int sat = mSatDegree[node_id];
-      int adj = mAdjDegree[node_id];
-      if ( max_row < num_rows ) {
-	max_row = num_rows;
-	max_sat = sat;
-	max_adj = adj;
-	max_node = node_id;
-      }
-      else if ( max_row == num_rows ) {
-	if ( max_sat < sat ) {
-	  max_sat = sat;
-	  max_adj = adj;
-	  max_node = node_id;
-	}
-	else if ( max_sat == sat ) {
-	  if ( max_adj < adj ) {
-	    max_adj = adj;
-	    max_node = node_id;
-	  }
-	}
+  }
+  return -1;
+}
+
+// @brief 彩色に用いる色を選ぶ．
+// @param[in] node_id ノード番号
+// @param[in] adj_list node_id に隣接する未彩色のノードのリスト
+// @return 色番号を返す．
+int
+Dsatur::select_color(int node_id,
+		     const vector<int>& adj_list)
+{
+  // node_id に使える色のリストを作る．
+  // 作業領域は呼び出しごとに確保せずに使い回す．
+  int nc = mGraph.color_num();
+  if ( static_cast<int>(mColorCount.size()) <= nc ) {
+    mColorCount.resize(nc + 1, 0);
+  }
+  mColorList.clear();
+  for ( auto c: Range(1, nc + 1) ) {
+    if ( !check_color(node_id, c) ) {
+      mColorList.push_back(c);
+    }
+  }
+  if ( mColorList.empty() ) {
+    // 可能な色がなかったので新しい色を割り当てる．
+    return mGraph.new_color();
+  }
+
+  // mColorList に含まれる色のなかで隣接する対象ノードの sat_degree の増加が
+  // 最小となるものを選ぶ．
+  for ( auto node1_id: adj_list ) {
+    if ( !mInQueue[node1_id] ) {
+      continue;
+    }
+    for ( auto c: mColorList ) {
+      if ( !check_color(node1_id, c) ) {
+	++ mColorCount[c];
       }
     }
   }
-  if ( wpos < rpos ) {
-    mCandList.erase(mCandList.begin() + wpos, mCandList.end());
+  int min_count = adj_list.size() + 1;
+  int sel_col = 0;
+  for ( auto c: mColorList ) {
+    int n = mColorCount[c];
+    if ( min_count > n ) {
+      min_count = n;
+      sel_col = c;
+    }
+    // 次の呼び出しのために使った要素だけ0に戻しておく．
+    mColorCount[c] = 0;
   }
-  return max_node;
+  return sel_col;
 }
 
 // @brief node_id に color の色を割り当て情報を更新する．
 // @param[in] node_id ノード番号
 // @param[in] color 色
+// @param[in] adj_list node_id に隣接する未彩色のノードのリスト
 void
 Dsatur::update(int node_id,
-	       int color)
+	       int color,
+	       const vector<int>& adj_list)
 {
-  for ( auto node1_id: mGraph.adj_list(node_id) ) {
-    bool already_colored = false;
-    for ( auto node2_id: mGraph.adj_list(node1_id) ) {
-      if ( mGraph.color(node2_id) == color ) {
-	already_colored = true;
-	break;
-      }
+  remove(node_id);
+
+  // 隣接するノードの sat_degree は高々1増え，adj_degree は1減る．
+  for ( auto node1_id: adj_list ) {
+    if ( !mInQueue[node1_id] ) {
+      continue;
     }
-    if ( !already_colored ) {
+    remove(node1_id);
+    if ( !check_color(node1_id, color) ) {
+      add_color(node1_id, color);
       ++ mSatDegree[node1_id];
     }
+    -- mAdjDegree[node1_id];
+    put(node1_id);
   }
+
   mGraph.set_color(node_id, color);
-  for ( auto row_id: mGraph.cover_list(node_id) ) {
-    mGraph.set_covered(row_id);
+
+  // もう使わないので領域を開放しておく．
+  vector<PackedVal>().swap(mColorSet[node_id]);
+}
+
+// @brief ノードをキューに入れる．
+// @param[in] node_id ノード番号
+void
+Dsatur::put(int node_id)
+{
+  int sat = mSatDegree[node_id];
+  int adj = mAdjDegree[node_id];
+  if ( static_cast<int>(mBucket.size()) <= sat ) {
+    mBucket.resize(sat + 1);
+    mMaxAdj.resize(sat + 1, -1);
+  }
+  auto& bucket = mBucket[sat];
+  auto p = bucket.find(adj);
+  int head = -1;
+  if ( p != bucket.end() ) {
+    head = p->second;
+    mPrev[head] = node_id;
+  }
+  mPrev[node_id] = -1;
+  mNext[node_id] = head;
+  bucket[adj] = node_id;
+  mInQueue[node_id] = true;
+
+  if ( mMaxAdj[sat] < adj ) {
+    mMaxAdj[sat] = adj;
+  }
+  if ( mMaxSat < sat ) {
+    mMaxSat = sat;
+  }
+}
+
+// @brief ノードをキューから取り除く．
+// @param[in] node_id ノード番号
+void
+Dsatur::remove(int node_id)
+{
+  ASSERT_COND( mInQueue[node_id] );
+
+  int prev = mPrev[node_id];
+  int next = mNext[node_id];
+  if ( prev != -1 ) {
+    mNext[prev] = next;
+  }
+  else {
+    // 空になったバケットは取り除く．
+    auto& bucket = mBucket[mSatDegree[node_id]];
+    if ( next != -1 ) {
+      bucket[mAdjDegree[node_id]] = next;
+    }
+    else {
+      bucket.erase(mAdjDegree[node_id]);
+    }
+  }
+  if ( next != -1 ) {
+    mPrev[next] = prev;
   }
+  mInQueue[node_id] = false;
 }
 
 END_NAMESPACE_SATPG
@@ -11,6 +11,8 @@
 
 #include "satpg.h"
 #include "MpColGraph.h"
+#include "PackedVal.h"
+#include <unordered_map>
 
 
 BEGIN_NAMESPACE_SATPG
@@ -18,6 +20,19 @@ BEGIN_NAMESPACE_SATPG
 //////////////////////////////////////////////////////////////////////
 /// @class Dsatur Dsatur.h "Dsatur.h"
 /// @brief 彩色問題を dsatur アルゴリズムで解くためのクラス
+///
+/// 未彩色のノードを (sat_degree, adj_degree) をキーとした
+/// バケットキューで管理する．
+/// - sat_degree は隣接するノードに使われている色数
+/// - adj_degree は隣接する未彩色の対象ノード数
+/// 1つのノードを彩色した時に隣接ノードのキーはそれぞれ高々1しか
+/// 変化しないので，バケット間の移動は定数時間で行える．
+/// バケットは sat_degree ごとに adj_degree をキーとしたハッシュ表で持ち，
+/// 空になったものは取り除くので，領域はノード数と色数の和に比例する．<br>
+/// 隣接するノードに使われている色の集合はノードごとにビットベクタで
+/// 保持する．<br>
+/// MpColGraph::set_color() で彩色されたノードはグラフから削除されるので
+/// 衝突リストには未彩色のノードしか現れない．
 //////////////////////////////////////////////////////////////////////
 class Dsatur
 {
@@ -25,8 +40,19 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] graph 対象のグラフ
+  ///
+  /// graph の未彩色のノードが対象となる．
   Dsatur(MpColGraph& graph);
 
+  /// @brief 対象のノードを指定したコンストラクタ
+  /// @param[in] graph 対象のグラフ
+  /// @param[in] node_list 対象のノードのリスト
+  ///
+  /// node_list の未彩色のノードが対象となる．
+  /// graph から削除されたノードを含んではいけない．
+  Dsatur(MpColGraph& graph,
+	 const vector<int>& node_list);
+
   /// @brief デストラクタ
   ~Dsatur();
 
@@ -47,19 +73,59 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期化する．
+  /// @param[in] node_list 対象のノードのリスト
   void
-  init();
+  init(const vector<int>& node_list);
 
   /// @brief (sat_degree, adj_degree) の辞書順で最大のノードを取ってくる．
+  /// @return ノード番号を返す．
+  ///
+  /// 未彩色のノードがない場合には -1 を返す．
   int
   get_max_node();
 
+  /// @brief 彩色に用いる色を選ぶ．
+  /// @param[in] node_id ノード番号
+  /// @param[in] adj_list node_id に隣接する未彩色のノードのリスト
+  /// @return 色番号を返す．
+  int
+  select_color(int node_id,
+	       const vector<int>& adj_list);
+
   /// @brief node_id に color の色を割り当て情報を更新する．
   /// @param[in] node_id ノード番号
   /// @param[in] color 色
+  /// @param[in] adj_list node_id に隣接する未彩色のノードのリスト
   void
   update(int node_id,
-	 int color);
+	 int color,
+	 const vector<int>& adj_list);
+
+  /// @brief ノードをキューに入れる．
+  /// @param[in] node_id ノード番号
+  ///
+  /// mSatDegree[node_id], mAdjDegree[node_id] で決まるバケットに入れる．
+  void
+  put(int node_id);
+
+  /// @brief ノードをキューから取り除く．
+  /// @param[in] node_id ノード番号
+  void
+  remove(int node_id);
+
+  /// @brief ノードの隣接ノードで color が使われている時 true を返す．
+  /// @param[in] node_id ノード番号
+  /// @param[in] color 色
+  bool
+  check_color(int node_id,
+	      int color) const;
+
+  /// @brief ノードの隣接ノードで使われている色に color を加える．
+  /// @param[in] node_id ノード番号
+  /// @param[in] color 色
+  void
+  add_color(int node_id,
+	    int color);
 
 
 private:
@@ -70,23 +136,90 @@ private:
   // 対象のグラフ
   MpColGraph& mGraph;
 
-  // 彩色の候補のノードリスト
-  vector<int> mCandList;
+  // 対象のノードのリスト
+  vector<int> mNodeList;
 
   // ノードの saturation degree の配列
   // サイズは mGraph.node_num();
-  int* mSatDegree;
+  vector<int> mSatDegree;
 
   // ノードの隣接次数の配列
   // サイズは mGraph.node_num();
-  int* mAdjDegree;
+  vector<int> mAdjDegree;
+
+  // ノードの隣接ノードで使われている色のビットベクタの配列
+  // サイズは mGraph.node_num();
+  vector<vector<PackedVal>> mColorSet;
+
+  // バケット内のリンクの配列
+  // サイズは mGraph.node_num();
+  vector<int> mNext;
+  vector<int> mPrev;
 
-  // ノードの被覆数の配列
+  // キューに入っている時 true となる配列
   // サイズは mGraph.node_num();
-  int* mCovDegree;
+  vector<bool> mInQueue;
+
+  // (sat_degree, adj_degree) ごとのバケットの先頭のノード番号
+  // mBucket[sat] は adj_degree をキーにしたハッシュ表で，
+  // 空のバケットは登録しない．
+  vector<std::unordered_map<int, int>> mBucket;
+
+  // sat_degree ごとの空でないバケットの adj_degree の上限
+  // 空の場合は -1
+  vector<int> mMaxAdj;
+
+  // 空でないバケットの sat_degree の上限
+  int mMaxSat;
+
+  // select_color() で用いる作業領域
+  // 使える色のリスト
+  vector<int> mColorList;
+
+  // select_color() で用いる作業領域
+  // 色ごとの隣接ノードの sat_degree の増加数
+  // サイズは mGraph.color_num() + 1 以上で，呼び出しの間は全て0
+  vector<int> mColorCount;
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ノードの隣接ノードで color が使われている時 true を返す．
+// @param[in] node_id ノード番号
+// @param[in] color 色
+inline
+bool
+Dsatur::check_color(int node_id,
+		    int color) const
+{
+  const vector<PackedVal>& color_set = mColorSet[node_id];
+  int blk = color / kPvBitLen;
+  if ( blk >= static_cast<int>(color_set.size()) ) {
+    return false;
+  }
+  return (color_set[blk] >> (color % kPvBitLen)) & 1UL;
+}
+
+// @brief ノードの隣接ノードで使われている色に color を加える．
+// @param[in] node_id ノード番号
+// @param[in] color 色
+inline
+void
+Dsatur::add_color(int node_id,
+		  int color)
+{
+  vector<PackedVal>& color_set = mColorSet[node_id];
+  int blk = color / kPvBitLen;
+  if ( blk >= static_cast<int>(color_set.size()) ) {
+    color_set.resize(blk + 1, kPvAll0);
+  }
+  color_set[blk] |= (1UL << (color % kPvBitLen));
+}
+
 END_NAMESPACE_SATPG
 
 #endif // DSATUR_H
@@ -9,14 +9,16 @@
 
 #include "FaultReducer.h"
 #include "DtpgFFR.h"
-#include "UndetChecker.h"
-#include "DomChecker.h"
+#include "DomCheckerInc.h"
 #include "TpgFFR.h"
 #include "TpgFault.h"
 #include "NodeValList.h"
 #include "MatrixGen.h"
 #include "ym/Range.h"
+#include <atomic>
+#include <cstdlib>
 #include <random>
+#include <thread>
 
 
 BEGIN_NAMESPACE_SATPG
@@ -67,7 +69,9 @@ FaultReducer::FaultReducer(const TpgNetwork& network,
 			   FaultType fault_type) :
   mNetwork(network),
   mFaultType(fault_type),
-  mDebug(false)
+  mDebug(false),
+  mThreadNum(1),
+  mSimPatNum(4096)
 {
   mFsim.init_fsim3(mNetwork, mFaultType);
 }
@@ -93,6 +97,30 @@ FaultReducer::set_debug(bool debug)
   mDebug = debug;
 }
 
+// @brief 支配関係のチェックを行うスレッド数を設定する．
+// @param[in] num スレッド数
+//
+// num が 0 以下の場合にはハードウェアのスレッド数を用いる．
+void
+FaultReducer::set_thread_num(int num)
+{
+  if ( num <= 0 ) {
+    num = std::thread::hardware_concurrency();
+    if ( num == 0 ) {
+      num = 1;
+    }
+  }
+  mThreadNum = num;
+}
+
+// @brief 支配故障の候補を求める際の乱数パタン数を設定する．
+// @param[in] num パタン数
+void
+FaultReducer::set_sim_pat_num(int num)
+{
+  mSimPatNum = num;
+}
+
 // @brief 故障の支配関係を調べて故障リストを縮約する．
 // @param[inout] fault_list 対象の故障リスト
 // @param[in] algorithm アルゴリズム
@@ -112,12 +140,18 @@ FaultReducer::fault_reduction(vector<const TpgFault*>& fault_list,
     if ( (alg == "red1" || alg == "red3") && opt == "" ) {
       need_mand_cond = true;
     }
+    else if ( alg == "thread" ) {
+      set_thread_num(atoi(opt.c_str()));
+    }
+    else if ( alg == "sim" ) {
+      set_sim_pat_num(atoi(opt.c_str()));
+    }
   }
 
   // 初期化する．
   init(fault_list, need_mand_cond);
 
-  make_dom_candidate(1);
+  make_dom_candidate(mSimPatNum);
 
   ffr_reduction();
 
@@ -166,8 +200,8 @@ FaultReducer::init(const vector<const TpgFault*>& fault_list,
   for ( auto id: Range(mNetwork.max_fault_id()) ) {
     auto& fi = mFaultInfoArray[id];
     fi.mDeleted = true;
-    fi.mPat = 0UL;
     fi.mDetCount = 0;
+    fi.mSig.clear();
   }
 
   mFaultList.clear();
@@ -228,129 +262,166 @@ FaultReducer::init(const vector<const TpgFault*>& fault_list,
 }
 
 // @brief 故障シミュレーションを行って支配故障の候補を作る．
+// @param[in] rand_num 乱数パタン数
 void
-FaultReducer::make_dom_candidate(int loop_limit)
+FaultReducer::make_dom_candidate(int rand_num)
 {
   if ( mDebug ) {
     mTimer.reset();
     mTimer.start();
   }
 
-  mFsim.clear_patterns();
+  // mTvList と rand_num 個の乱数パタンで故障シミュレーションを行い，
+  // 各故障のシグネチャを求める．
+  // 一回の ppsfp で mFsim.pv_bitlen() 個のパタンを処理する．
+  int bitlen = mFsim.pv_bitlen();
+  int block = 0;
   int wpos = 0;
-  for ( auto tv: mTvList ) {
+  mFsim.clear_patterns();
+  auto put_pattern = [&](const TestVector& tv) {
     mFsim.set_pattern(wpos, tv);
     ++ wpos;
-    if ( wpos == kPvBitLen ) {
-      do_fsim();
+    if ( wpos == bitlen ) {
+      do_fsim(block);
+      ++ block;
       mFsim.clear_patterns();
       wpos = 0;
     }
-  }
-  if ( wpos > 0 ) {
-    do_fsim();
+  };
+  for ( auto& tv: mTvList ) {
+    put_pattern(tv);
   }
   // mTvList を空にする．
   vector<TestVector>().swap(mTvList);
 
   std::mt19937 rg;
   TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), mFaultType);
-  for ( int nc_count = 0; nc_count < loop_limit; ) {
-    for ( auto i: Range(kPvBitLen) ) {
-      tv.set_from_random(rg);
-      mFsim.set_pattern(i, tv);
-    }
-    if ( do_fsim() ) {
-      nc_count = 0;
-    }
-    else {
-      ++ nc_count;
-    }
+  for ( int i = 0; i < rand_num; ++ i ) {
+    tv.set_from_random(rg);
+    put_pattern(tv);
+  }
+  if ( wpos > 0 ) {
+    do_fsim(block);
+    ++ block;
   }
 
+  make_cand_list(block * (bitlen / kPvBitLen));
+
   if ( mDebug ) {
     mTimer.stop();
     cout << "Fault Simulation" << endl;
+    cout << "    # of patterns:                     " << (block * bitlen) << endl;
     cout << "CPU time:                              " << mTimer.time() << endl;
   }
 }
 
-// @brief 故障シミュレーションを行って支配故障の候補を作る．
-bool
-FaultReducer::do_fsim()
+// @brief 一回の故障シミュレーションを行ってシグネチャに追加する．
+// @param[in] block ブロック番号
+void
+FaultReducer::do_fsim(int block)
 {
-  bool changed = false;
+  // 一つのブロックは nw ワードからなる．
+  int nw = mFsim.pv_bitlen() / kPvBitLen;
   int n = mFsim.ppsfp();
-
-  // mPat の設定
-  bool first_time = false;
   for ( auto i: Range(n) ) {
     auto fault = mFsim.det_fault(i);
-    auto pat = mFsim.det_fault_pat(i);
     auto& fi = mFaultInfoArray[fault->id()];
-    fi.mPat = pat;
-    if ( fi.mDetCount == 0 ) {
-      first_time = true;
+    for ( auto w: Range(nw) ) {
+      auto pat = mFsim.det_fault_pat(i, w);
+      fi.mSig.add_word(block * nw + w, pat);
+      fi.mDetCount += count_ones(pat);
     }
   }
+}
 
-  vector<const TpgFault*> tmp_list;
-  if ( first_time ) {
-    tmp_list.reserve(n);
+// @brief シグネチャをもとに支配故障の候補リストを作る．
+// @param[in] word_num シグネチャのワード数
+//
+// fault1 が fault2 を支配するためには fault1 のシグネチャが
+// fault2 のシグネチャに含まれていなければならない．<br>
+// 全ての対を調べるのは大変なので，fault1 を検出するワードのうち
+// 検出故障数の最も少ないワード(ピボット)で検出される故障のみを
+// fault2 の候補とする．
+void
+FaultReducer::make_cand_list(int word_num)
+{
+  // シグネチャの 0 でないワードのワード番号に対して func を呼ぶ．
+  auto for_each_word = [](const FaultSig& sig, auto func) {
+    for ( auto r: Range(sig.run_num()) ) {
+      int start = sig.run_start(r);
+      int end = start + sig.run_len(r);
+      for ( int wpos = start; wpos < end; ++ wpos ) {
+	func(wpos);
+      }
+    }
+  };
+
+  // ワードごとの検出故障数を数える．
+  vector<int> count_array(word_num, 0);
+  for ( auto fault: mFaultList ) {
+    for_each_word(mFaultInfoArray[fault->id()].mSig,
+		  [&](int wpos) { ++ count_array[wpos]; });
   }
-  for ( auto i1: Range(n) ) {
-    auto fault1 = mFsim.det_fault(i1);
-    auto pat1 = mFsim.det_fault_pat(i1);
-    auto& fi1 = mFaultInfoArray[fault1->id()];
-    if ( fi1.mDetCount == 0 ) {
-      // pat1 を含むパタンを持っている故障を tmp_list に入れる．
-      tmp_list.clear();
-      for ( auto i2: Range(n) ) {
-	if ( i2 == i1 ) {
-	  continue;
-	}
-	auto fault2 = mFsim.det_fault(i2);
-	auto pat2 = mFsim.det_fault_pat(i2);
-	if ( (pat1 & pat2) == pat1 ) {
-	  // fault1 を検出しているパタンはすべて fault2 を検出している．
-	  tmp_list.push_back(fault2);
+
+  // 各故障のピボットを求める．
+  int nf = mFaultList.size();
+  vector<int> pivot_array(nf, -1);
+  vector<bool> pivot_mark(word_num, false);
+  for ( auto i: Range(nf) ) {
+    auto& sig = mFaultInfoArray[mFaultList[i]->id()].mSig;
+    int pivot = -1;
+    int min_count = 0;
+    for_each_word(sig, [&](int wpos) {
+	if ( pivot == -1 || min_count > count_array[wpos] ) {
+	  pivot = wpos;
+	  min_count = count_array[wpos];
 	}
-      }
-      // tmp_list を mDomCandList にコピーする．
-      fi1.mDomCandList = tmp_list;
+      });
+    pivot_array[i] = pivot;
+    if ( pivot != -1 ) {
+      pivot_mark[pivot] = true;
     }
-    else {
-      // mDomCandList の要素のうち，pat1 を含むもののみを残す．
-      int rpos1 = 0;
-      int n1 = fi1.mDomCandList.size();
-      int wpos1 = 0;
-      for ( ; rpos1 < n1; ++ rpos1 ) {
-	auto fault2 = fi1.mDomCandList[rpos1];
-	auto pat2 = mFaultInfoArray[fault2->id()].mPat;
-	if ( (pat1 & pat2) == pat1 ) {
-	  fi1.mDomCandList[wpos1] = fault2;
-	  ++ wpos1;
+  }
+
+  // ピボットとなっているワードについて検出故障のリストを作る．
+  vector<vector<const TpgFault*>> word_fault_list(word_num);
+  for ( auto fault: mFaultList ) {
+    for_each_word(mFaultInfoArray[fault->id()].mSig, [&](int wpos) {
+	if ( pivot_mark[wpos] ) {
+	  word_fault_list[wpos].push_back(fault);
 	}
+      });
+  }
+
+  for ( auto i: Range(nf) ) {
+    auto fault1 = mFaultList[i];
+    auto& fi1 = mFaultInfoArray[fault1->id()];
+    fi1.mDomCandList.clear();
+    int pivot = pivot_array[i];
+    if ( pivot == -1 ) {
+      // 一度も検出されなかった故障は候補を持たない．
+      continue;
+    }
+    for ( auto fault2: word_fault_list[pivot] ) {
+      if ( fault2 == fault1 ) {
+	continue;
       }
-      if ( wpos1 < n1 ) {
-	vector<const TpgFault*> tmp_list(wpos1);
-	for ( auto i: Range(wpos1) ) {
-	  tmp_list[i] = fi1.mDomCandList[i];
-	}
-	fi1.mDomCandList.swap(tmp_list);
-	changed = true;
+      auto& fi2 = mFaultInfoArray[fault2->id()];
+      if ( fi2.mDetCount < fi1.mDetCount ) {
+	// 検出パタン数が少なければ含まれることはない．
+	continue;
+      }
+      if ( fi1.mSig.is_contained(fi2.mSig) ) {
+	// fault1 を検出しているパタンはすべて fault2 を検出している．
+	fi1.mDomCandList.push_back(fault2);
       }
     }
-    fi1.mDetCount += count_ones(pat1);
   }
 
-  // mPat のクリア
-  for ( auto i: Range(n) ) {
-    auto fault = mFsim.det_fault(i);
-    mFaultInfoArray[fault->id()].mPat = 0UL;
+  // シグネチャはもう使わない．
+  for ( auto fault: mFaultList ) {
+    mFaultInfoArray[fault->id()].mSig.shrink();
   }
-
-  return changed;
 }
 
 // @brief 同一 FFR 内の支配故障のチェックを行う．
@@ -430,6 +501,95 @@ FaultReducer::ffr_reduction()
   }
 }
 
+// @brief 異なる FFR 間の支配故障のチェックを並列に行う．
+// @param[in] dom_func fault1 を支配している故障を一つ求める関数
+// @param[out] count チェック回数の合計
+template<class DomFunc>
+void
+FaultReducer::_dom_reduction(DomFunc dom_func,
+			     DomCount& count)
+{
+  count = DomCount{0, 0, 0, 0, 0};
+
+  vector<const TpgFault*> fault1_list;
+  fault1_list.reserve(mFaultList.size());
+  for ( auto fault: mFaultList ) {
+    if ( !mFaultInfoArray[fault->id()].mDeleted ) {
+      fault1_list.push_back(fault);
+    }
+  }
+
+  vector<const TpgFault*> retry_list;
+  while ( !fault1_list.empty() ) {
+    // 各スレッドは現在の削除マークのもとで fault1 を支配している故障を求める．
+    // dom_array の各要素に書き込むスレッドは一つだけ．
+    int nf = fault1_list.size();
+    vector<const TpgFault*> dom_array(nf, nullptr);
+    vector<DomCount> count_array(mThreadNum, DomCount{0, 0, 0, 0, 0});
+    std::atomic<int> next_pos(0);
+    auto worker = [&](int thread_id) {
+      DomCheckerInc checker(mNetwork, mFaultType, mSolverType);
+      auto& count1 = count_array[thread_id];
+      for ( ; ; ) {
+	int pos = next_pos.fetch_add(1);
+	if ( pos >= nf ) {
+	  break;
+	}
+	dom_array[pos] = dom_func(checker, fault1_list[pos], count1);
+      }
+    };
+
+    if ( mThreadNum == 1 ) {
+      worker(0);
+    }
+    else {
+      vector<std::thread> thread_list;
+      thread_list.reserve(mThreadNum);
+      for ( auto i: Range(mThreadNum) ) {
+	thread_list.push_back(std::thread(worker, i));
+      }
+      for ( auto& th: thread_list ) {
+	th.join();
+      }
+    }
+
+    for ( auto& count1: count_array ) {
+      count.mCheckNum += count1.mCheckNum;
+      count.mSuccessNum += count1.mSuccessNum;
+      count.mUCheckNum += count1.mUCheckNum;
+      count.mUSuccessNum += count1.mUSuccessNum;
+      count.mPairNum += count1.mPairNum;
+    }
+
+    // 結果を fault1_list の順にマージする．
+    // 支配している故障がすでに削除されていたら fault1 は削除せずに
+    // 次のラウンドで調べなおす．
+    // こうしておけば相互に支配し合っている故障が両方とも削除されることはない．
+    retry_list.clear();
+    int del_num = 0;
+    for ( auto pos: Range(nf) ) {
+      auto dom_fault = dom_array[pos];
+      if ( dom_fault == nullptr ) {
+	continue;
+      }
+      auto fault1 = fault1_list[pos];
+      if ( mFaultInfoArray[dom_fault->id()].mDeleted ) {
+	retry_list.push_back(fault1);
+	continue;
+      }
+      auto& fi1 = mFaultInfoArray[fault1->id()];
+      fi1.mDeleted = true;
+      // 不要となったベクタの領域を解放するハックコード
+      vector<const TpgFault*>().swap(fi1.mDomCandList);
+      ++ del_num;
+    }
+    if ( del_num == 0 ) {
+      break;
+    }
+    fault1_list.swap(retry_list);
+  }
+}
+
 // @brief 異なる FFR 間の支配故障の簡易チェックを行う．
 void
 FaultReducer::dom_reduction1(bool simple)
@@ -439,14 +599,11 @@ FaultReducer::dom_reduction1(bool simple)
     mTimer.start();
   }
 
-  int check_num = 0;
-  int success_num = 0;
-  for ( auto fault1: mFaultList ) {
-    auto& fi1 = mFaultInfoArray[fault1->id()];
-    if ( fi1.mDeleted ) {
-      continue;
-    }
-    UndetChecker undet_checker(mNetwork, mFaultType, fault1, mSolverType);
+  auto dom_func = [&](DomCheckerInc& checker,
+		      const TpgFault* fault1,
+		      DomCount& count) -> const TpgFault* {
+    const TpgFault* dom_fault = nullptr;
+    checker.set_undet_fault(fault1);
     for ( auto fault2: mFaultList ) {
       auto& fi2 = mFaultInfoArray[fault2->id()];
       if ( fault2 == fault1 || fi2.mDeleted ) {
@@ -457,40 +614,37 @@ FaultReducer::dom_reduction1(bool simple)
 	continue;
       }
 
-      if ( !undet_checker.has_gvar(fault2->tpg_onode()) ) {
+      if ( !checker.in_undet_cone(fault2->tpg_onode()) ) {
 	continue;
       }
       // fault1 が fault2 の mDomCandList に含まれるか調べる．
-      bool found = false;
-      for ( auto fault3: fi2.mDomCandList ) {
-	if ( fault3 == fault1 ) {
-	  found = true;
-	  break;
-	}
+      if ( !is_dom_cand(fault2, fault1) ) {
+	continue;
       }
-      if ( found ) {
-	++ check_num;
-	const auto& cond = simple ? fi2.mFFRCond : fi2.mMandCond;
-	SatBool3 res = undet_checker.check(cond);
-	if ( res == SatBool3::False ) {
-	  ++ success_num;
-	  // fault2 が検出可能の条件のもとで fault1 が検出不能となることはない．
-	  // fault2 が fault1 を支配している．
-	  fi1.mDeleted = true;
-	  // 不要となったベクタの領域を解放するハックコード
-	  vector<const TpgFault*>().swap(fi1.mDomCandList);
-	  break;
-	}
+      ++ count.mCheckNum;
+      const auto& cond = simple ? fi2.mFFRCond : fi2.mMandCond;
+      SatBool3 res = checker.check_undetect(cond);
+      if ( res == SatBool3::False ) {
+	++ count.mSuccessNum;
+	// fault2 が検出可能の条件のもとで fault1 が検出不能となることはない．
+	// fault2 が fault1 を支配している．
+	dom_fault = fault2;
+	break;
       }
     }
-  }
+    checker.release_undet_fault();
+    return dom_fault;
+  };
+
+  DomCount count;
+  _dom_reduction(dom_func, count);
 
   if ( mDebug ) {
     mTimer.stop();
     int n = count_faults();
     cout << "after semi-global dominance reduction: " << n << endl
-	 << "    # of total checks:                 " << check_num << endl
-	 << "    # of total successes:              " << success_num << endl
+	 << "    # of total checks:                 " << count.mCheckNum << endl
+	 << "    # of total successes:              " << count.mSuccessNum << endl
 	 << "CPU time:                              " << mTimer.time() << endl;
   }
 }
@@ -504,66 +658,55 @@ FaultReducer::dom_reduction2()
     mTimer.start();
   }
 
-  int check_num = 0;
-  int dom_num = 0;
-  int success_num = 0;
-  for ( auto fault1: mFaultList ) {
-    auto& fi1 = mFaultInfoArray[fault1->id()];
-    if ( fi1.mDeleted ) {
-      continue;
-    }
+  auto dom_func = [&](DomCheckerInc& checker,
+		      const TpgFault* fault1,
+		      DomCount& count) -> const TpgFault* {
+    const TpgFault* dom_fault = nullptr;
+    // fault1 の故障回路は必要になるまで作らない．
+    bool undet_set = false;
+    vector<const TpgFault*> fault2_list;
     for ( auto& ffr2: mNetwork.ffr_list() ) {
       if ( ffr2.root() == fault1->tpg_onode()->ffr_root() ) {
 	continue;
       }
-      vector<const TpgFault*> fault2_list;
-      for ( auto fault2: ffr2.fault_list() ) {
-	auto& fi2 = mFaultInfoArray[fault2->id()];
-	if ( fi2.mDeleted ) {
-	  continue;
-	}
-	bool found = false;
-	for ( auto fault3: fi2.mDomCandList ) {
-	  if ( fault3 == fault1 ) {
-	    found = true;
-	    break;
-	  }
-	}
-	if ( found ) {
-	  fault2_list.push_back(fault2);
-	}
-      }
+      get_dom_cand_list(ffr2, fault1, fault2_list);
       if ( fault2_list.empty() ) {
 	continue;
       }
-      ++ dom_num;
-      DomChecker dom_checker(mNetwork, mFaultType, ffr2.root(), fault1, mSolverType);
+      ++ count.mPairNum;
+      if ( !undet_set ) {
+	checker.set_undet_fault(fault1);
+	undet_set = true;
+      }
       for ( auto fault2: fault2_list ) {
-	++ check_num;
-	SatBool3 res = dom_checker.check_detectable(fault2);
+	++ count.mCheckNum;
+	SatBool3 res = checker.check_detectable(fault2);
 	if ( res == SatBool3::False ) {
-	  ++ success_num;
+	  ++ count.mSuccessNum;
 	  // fault2 が検出可能の条件のもとで fault1 が検出不能となることはない．
 	  // fault2 が fault1 を支配している．
-	  fi1.mDeleted = true;
-	  // 不要となったベクタの領域を解放するハックコード
-	  vector<const TpgFault*>().swap(fi1.mDomCandList);
+	  dom_fault = fault2;
 	  break;
 	}
       }
-      if ( fi1.mDeleted ) {
+      if ( dom_fault != nullptr ) {
 	break;
       }
     }
-  }
+    checker.release_undet_fault();
+    return dom_fault;
+  };
+
+  DomCount count;
+  _dom_reduction(dom_func, count);
 
   if ( mDebug ) {
     mTimer.stop();
     int n = count_faults();
     cout << "after global dominance reduction:      " << n << endl;
-    cout << "    # of total checkes:                " << check_num << endl
-	 << "    # of total successes:              " << success_num << endl
-	 << "    # of DomCheckers:                  " << dom_num << endl
+    cout << "    # of total checkes:                " << count.mCheckNum << endl
+	 << "    # of total successes:              " << count.mSuccessNum << endl
+	 << "    # of fault-FFR pairs:              " << count.mPairNum << endl
 	 << "CPU time:                              " << mTimer.time() << endl;
   }
 }
@@ -577,97 +720,110 @@ FaultReducer::dom_reduction3(bool simple)
     mTimer.start();
   }
 
-  int check_num = 0;
-  int dom_num = 0;
-  int success_num = 0;
-  int u_check_num = 0;
-  int u_success_num = 0;
-  for ( auto fault1: mFaultList ) {
-    auto& fi1 = mFaultInfoArray[fault1->id()];
-    if ( fi1.mDeleted ) {
-      continue;
-    }
-    UndetChecker undet_checker(mNetwork, mFaultType, fault1, mSolverType);
+  auto dom_func = [&](DomCheckerInc& checker,
+		      const TpgFault* fault1,
+		      DomCount& count) -> const TpgFault* {
+    const TpgFault* dom_fault = nullptr;
+    checker.set_undet_fault(fault1);
+    vector<const TpgFault*> fault2_list;
     for ( auto& ffr2: mNetwork.ffr_list() ) {
       if ( ffr2.root() == fault1->tpg_onode()->ffr_root() ) {
 	continue;
       }
-      vector<const TpgFault*> fault2_list;
-      for ( auto fault2: ffr2.fault_list() ) {
-	auto& fi2 = mFaultInfoArray[fault2->id()];
-	if ( fi2.mDeleted ) {
-	  continue;
-	}
-	bool found = false;
-	for ( auto fault3: fi2.mDomCandList ) {
-	  if ( fault3 == fault1 ) {
-	    found = true;
-	    break;
-	  }
-	}
-	if ( found ) {
-	  fault2_list.push_back(fault2);
-	}
-
-      }
+      get_dom_cand_list(ffr2, fault1, fault2_list);
       if ( fault2_list.empty() ) {
 	continue;
       }
       for ( auto fault2: fault2_list ) {
-	if ( undet_checker.has_gvar(fault2->tpg_onode()) ) {
-	  ++ u_check_num;
+	if ( checker.in_undet_cone(fault2->tpg_onode()) ) {
+	  ++ count.mUCheckNum;
 	  auto& fi2 = mFaultInfoArray[fault2->id()];
 	  const auto& cond = simple ? fi2.mFFRCond : fi2.mMandCond;
-	  SatBool3 res = undet_checker.check(cond);
+	  SatBool3 res = checker.check_undetect(cond);
 	  if ( res == SatBool3::False ) {
-	    ++ u_success_num;
+	    ++ count.mUSuccessNum;
 	    // fault2 が検出可能の条件のもとで fault1 が検出不能となることはない．
 	    // fault2 が fault1 を支配している．
-	    fi1.mDeleted = true;
-	    // 不要となったベクタの領域を解放するハックコード
-	    vector<const TpgFault*>().swap(fi1.mDomCandList);
+	    dom_fault = fault2;
 	    break;
 	  }
 	}
       }
-      if ( fi1.mDeleted ) {
+      if ( dom_fault != nullptr ) {
 	break;
       }
 
-      ++ dom_num;
-      DomChecker dom_checker(mNetwork, mFaultType, ffr2.root(), fault1, mSolverType);
+      ++ count.mPairNum;
       for ( auto fault2: fault2_list ) {
-	++ check_num;
-	SatBool3 res = dom_checker.check_detectable(fault2);
+	++ count.mCheckNum;
+	SatBool3 res = checker.check_detectable(fault2);
 	if ( res == SatBool3::False ) {
-	  ++ success_num;
+	  ++ count.mSuccessNum;
 	  // fault2 が検出可能の条件のもとで fault1 が検出不能となることはない．
 	  // fault2 が fault1 を支配している．
-	  fi1.mDeleted = true;
-	  // 不要となったベクタの領域を解放するハックコード
-	  vector<const TpgFault*>().swap(fi1.mDomCandList);
+	  dom_fault = fault2;
 	  break;
 	}
       }
-      if ( fi1.mDeleted ) {
+      if ( dom_fault != nullptr ) {
 	break;
       }
     }
-  }
+    checker.release_undet_fault();
+    return dom_fault;
+  };
+
+  DomCount count;
+  _dom_reduction(dom_func, count);
 
   if ( mDebug ) {
     mTimer.stop();
     int n = count_faults();
     cout << "after global dominance reduction:      " << n << endl;
-    cout << "    # of total checkes(1):             " << check_num << endl
-	 << "    # of total successes(1):           " << success_num << endl
-	 << "    # of total checkes(2):             " << u_check_num << endl
-	 << "    # of total successes(2):           " << u_success_num << endl
-	 << "    # of DomCheckers:                  " << dom_num << endl
+    cout << "    # of total checkes(1):             " << count.mCheckNum << endl
+	 << "    # of total successes(1):           " << count.mSuccessNum << endl
+	 << "    # of total checkes(2):             " << count.mUCheckNum << endl
+	 << "    # of total successes(2):           " << count.mUSuccessNum << endl
+	 << "    # of fault-FFR pairs:              " << count.mPairNum << endl
 	 << "CPU time:                              " << mTimer.time() << endl;
   }
 }
 
+// @brief fault1 が fault2 の支配故障の候補に含まれている時 true を返す．
+// @param[in] fault2 支配する側の故障
+// @param[in] fault1 支配される側の故障
+bool
+FaultReducer::is_dom_cand(const TpgFault* fault2,
+			  const TpgFault* fault1) const
+{
+  for ( auto fault3: mFaultInfoArray[fault2->id()].mDomCandList ) {
+    if ( fault3 == fault1 ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief FFR 内の故障のうち fault1 を支配している可能性のあるものを求める．
+// @param[in] ffr2 対象の FFR
+// @param[in] fault1 支配される側の故障
+// @param[out] fault2_list 結果を格納するリスト
+void
+FaultReducer::get_dom_cand_list(const TpgFFR& ffr2,
+				const TpgFault* fault1,
+				vector<const TpgFault*>& fault2_list) const
+{
+  fault2_list.clear();
+  for ( auto fault2: ffr2.fault_list() ) {
+    if ( mFaultInfoArray[fault2->id()].mDeleted ) {
+      continue;
+    }
+    if ( is_dom_cand(fault2, fault1) ) {
+      fault2_list.push_back(fault2);
+    }
+  }
+}
+
 // @brief mFaultList 中の mDeleted マークが付いていない故障数を数える．
 int
 FaultReducer::count_faults() const
@@ -12,6 +12,7 @@
 #include "Fsim.h"
 #include "NodeValList.h"
 #include "TestVector.h"
+#include "FaultSig.h"
 #include "ym/McMatrix.h"
 #include "ym/SatSolverType.h"
 #include "ym/StopWatch.h"
@@ -19,9 +20,17 @@
 
 BEGIN_NAMESPACE_SATPG
 
+class DomCheckerInc;
+
 //////////////////////////////////////////////////////////////////////
 /// @class FaultReducer FaultReducer.h "FaultReducer.h"
 /// @brief 支配故障を求めるクラスn
+///
+/// 異なる FFR 間の支配関係のチェックは複数のスレッドで行う．
+/// 各スレッドは直前の削除マークのスナップショットをもとに
+/// 故障ごとに支配故障を一つ求め，その結果を故障リストの順に
+/// マージして削除マークをつける．
+/// そのため結果はスレッド数によらずに一定となる．
 //////////////////////////////////////////////////////////////////////
 class FaultReducer
 {
@@ -52,9 +61,27 @@ public:
   void
   set_debug(bool debug);
 
+  /// @brief 支配故障の候補を求める際の乱数パタン数を設定する．
+  /// @param[in] num パタン数
+  ///
+  /// この他に各故障のテストパタンも用いられる．
+  void
+  set_sim_pat_num(int num);
+
+  /// @brief 支配関係のチェックを行うスレッド数を設定する．
+  /// @param[in] num スレッド数
+  ///
+  /// num が 0 以下の場合にはハードウェアのスレッド数を用いる．
+  void
+  set_thread_num(int num);
+
   /// @brief 故障の支配関係を調べて故障リストを縮約する．
   /// @param[inout] fault_list 対象の故障リスト
   /// @param[in] algorithm アルゴリズム
+  ///
+  /// algorithm は "red1", "red2", "red3" をカンマで区切ったもの．<br>
+  /// "thread:<数>" でスレッド数を，"sim:<数>" で支配故障の候補を
+  /// 求める際の乱数パタン数を指定することもできる．
   void
   fault_reduction(vector<const TpgFault*>& fault_list,
 		  const string& algorithm);
@@ -72,15 +99,23 @@ private:
        bool need_mand_cond);
 
   /// @brief 故障シミュレーションを行って支配故障の候補を作る．
-  /// @param[in] loop_limit 変化がなくなってから繰り返すループ数
+  /// @param[in] rand_num 乱数パタン数
+  ///
+  /// mTvList のパタンと rand_num 個の乱数パタンを用いる．
   void
-  make_dom_candidate(int loop_limit);
+  make_dom_candidate(int rand_num);
 
-  /// @brief 一回の故障シミュレーションを行う．
-  /// @retval true 支配故障のリストに変化があった．
-  /// @retval false 変化がなかった．
-  bool
-  do_fsim();
+  /// @brief 一回の故障シミュレーションを行ってシグネチャに追加する．
+  /// @param[in] block ブロック番号
+  ///
+  /// 一つのブロックは mFsim.pv_bitlen() 個のパタンからなる．
+  void
+  do_fsim(int block);
+
+  /// @brief シグネチャをもとに支配故障の候補リストを作る．
+  /// @param[in] word_num シグネチャのワード数
+  void
+  make_cand_list(int word_num);
 
   /// @brief 同一 FFR 内の支配故障のチェックを行う．
   void
@@ -100,6 +135,55 @@ private:
   void
   dom_reduction3(bool simple);
 
+  /// @brief 支配故障のチェック回数を数えるための構造体
+  struct DomCount
+  {
+    // チェック回数
+    int mCheckNum;
+
+    // 支配故障が見つかった回数
+    int mSuccessNum;
+
+    // UndetChecker 相当のチェック回数
+    int mUCheckNum;
+
+    // UndetChecker 相当のチェックで支配故障が見つかった回数
+    int mUSuccessNum;
+
+    // 調べた故障と FFR の対の数
+    int mPairNum;
+  };
+
+  /// @brief 異なる FFR 間の支配故障のチェックを並列に行う．
+  /// @param[in] dom_func fault1 を支配している故障を一つ求める関数
+  /// @param[out] count チェック回数の合計
+  ///
+  /// dom_func は (DomCheckerInc&, const TpgFault* fault1, DomCount&) を
+  /// 引数にとり，見つからなかった時は nullptr を返す．<br>
+  /// dom_func の中では mFaultInfoArray を変更してはいけない．
+  template<class DomFunc>
+  void
+  _dom_reduction(DomFunc dom_func,
+		 DomCount& count);
+
+  /// @brief fault1 が fault2 の支配故障の候補に含まれている時 true を返す．
+  /// @param[in] fault2 支配する側の故障
+  /// @param[in] fault1 支配される側の故障
+  bool
+  is_dom_cand(const TpgFault* fault2,
+	      const TpgFault* fault1) const;
+
+  /// @brief FFR 内の故障のうち fault1 を支配している可能性のあるものを求める．
+  /// @param[in] ffr2 対象の FFR
+  /// @param[in] fault1 支配される側の故障
+  /// @param[out] fault2_list 結果を格納するリスト
+  ///
+  /// 削除マークのついた故障は含まない．
+  void
+  get_dom_cand_list(const TpgFFR& ffr2,
+		    const TpgFault* fault1,
+		    vector<const TpgFault*>& fault2_list) const;
+
   /// @brief mFaultList 中の mDeleted マークが付いていない故障数を数える．
   int
   count_faults() const;
@@ -116,8 +200,8 @@ private:
     // 削除マーク
     bool mDeleted;
 
-    // 故障シミュレーションの検出パタン
-    PackedVal mPat;
+    // 故障シミュレーションの検出パタンのシグネチャ
+    FaultSig mSig;
 
     // FFR 内の伝搬条件
     NodeValList mFFRCond;
@@ -131,7 +215,7 @@ private:
     // この故障が支配している故障の候補リスト
     vector<const TpgFault*> mDomCandList;
 
-    // 検出回数
+    // 故障シミュレーションでの検出回数
     int mDetCount;
 
   };
@@ -151,6 +235,12 @@ private:
   // デバッグフラグ
   bool mDebug;
 
+  // スレッド数
+  int mThreadNum;
+
+  // 支配故障の候補を求める際の乱数パタン数
+  int mSimPatNum;
+
   // 故障リスト
   vector<const TpgFault*> mFaultList;
 
@@ -0,0 +1,106 @@
+
+/// @file FaultSig.cc
+/// @brief FaultSig の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "FaultSig.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+BEGIN_NONAMESPACE
+
+// ワードを左に回転させる．
+inline
+PackedVal
+rotate(PackedVal pat,
+       int sft)
+{
+  sft %= kPvBitLen;
+  if ( sft == 0 ) {
+    return pat;
+  }
+  return (pat << sft) | (pat >> (kPvBitLen - sft));
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス FaultSig
+//////////////////////////////////////////////////////////////////////
+
+// @brief ワードを追加する．
+// @param[in] wpos ワード番号
+// @param[in] pat ワードの値
+void
+FaultSig::add_word(int wpos,
+		   PackedVal pat)
+{
+  if ( pat == kPvAll0 ) {
+    return;
+  }
+
+  if ( !mRunList.empty() ) {
+    auto& last = mRunList.back();
+    int end = last.first + last.second;
+    ASSERT_COND( wpos >= end );
+    if ( wpos == end ) {
+      // 直前の区間を延ばす．
+      ++ last.second;
+    }
+    else {
+      mRunList.push_back(make_pair(wpos, 1));
+    }
+  }
+  else {
+    mRunList.push_back(make_pair(wpos, 1));
+  }
+  mWordList.push_back(pat);
+  mHash |= rotate(pat, wpos);
+}
+
+// @brief 自分が sig に含まれている時 true を返す．
+// @param[in] sig 比較対象のシグネチャ
+bool
+FaultSig::is_contained(const FaultSig& sig) const
+{
+  if ( (mHash & ~sig.mHash) != kPvAll0 ) {
+    return false;
+  }
+  if ( word_num() > sig.word_num() ) {
+    return false;
+  }
+
+  // sig 側の現在位置
+  int n2 = sig.run_num();
+  int r2 = 0;    // 区間の番号
+  int base2 = 0; // 区間の先頭のワードの mWordList 上の位置
+
+  int pos1 = 0;
+  for ( auto& run1: mRunList ) {
+    for ( int k = 0; k < run1.second; ++ k, ++ pos1 ) {
+      int wpos = run1.first + k;
+      // wpos を含む sig の区間まで進める．
+      // 区間単位で読み飛ばせる．
+      while ( r2 < n2 && sig.mRunList[r2].first + sig.mRunList[r2].second <= wpos ) {
+	base2 += sig.mRunList[r2].second;
+	++ r2;
+      }
+      if ( r2 == n2 || sig.mRunList[r2].first > wpos ) {
+	// sig のこのワードは 0
+	return false;
+      }
+      int pos2 = base2 + (wpos - sig.mRunList[r2].first);
+      if ( (mWordList[pos1] & ~sig.mWordList[pos2]) != kPvAll0 ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,203 @@
+#ifndef FAULTSIG_H
+#define FAULTSIG_H
+
+/// @file FaultSig.h
+/// @brief FaultSig のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "satpg.h"
+#include "PackedVal.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FaultSig FaultSig.h "FaultSig.h"
+/// @brief 故障シミュレーションの検出パタンのシグネチャを表すクラス
+///
+/// 検出パタンのビットベクタを kPvBitLen ビットのワードに区切り，
+/// 0 でないワードのみを以下の形で保持する．
+/// - 0 でないワードが連続する区間の (先頭のワード番号, ワード数) のリスト
+/// - 0 でないワードの値をワード番号の順に並べたリスト
+/// 乱数パタンでは検出ワードが連続しやすいので
+/// ワードごとに番号を持つよりも小さくなる．<br>
+/// さらに全てのワードを畳み込んだ固定長のハッシュ値を持ち，
+/// 包含関係の判定で明らかに含まれない場合を素早く除外する．
+//////////////////////////////////////////////////////////////////////
+class FaultSig
+{
+public:
+
+  /// @brief コンストラクタ
+  ///
+  /// 空のシグネチャとなる．
+  FaultSig();
+
+  /// @brief デストラクタ
+  ~FaultSig();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief ワードを追加する．
+  /// @param[in] wpos ワード番号
+  /// @param[in] pat ワードの値
+  ///
+  /// wpos は直前に追加したワード番号より大きくなければならない．<br>
+  /// pat が 0 の場合には何もしない．
+  void
+  add_word(int wpos,
+	   PackedVal pat);
+
+  /// @brief 0 でないワード数を返す．
+  int
+  word_num() const;
+
+  /// @brief 0 でないワードの連続区間の数を返す．
+  int
+  run_num() const;
+
+  /// @brief 連続区間の先頭のワード番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < run_num() )
+  int
+  run_start(int pos) const;
+
+  /// @brief 連続区間のワード数を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < run_num() )
+  int
+  run_len(int pos) const;
+
+  /// @brief ハッシュ値を返す．
+  ///
+  /// このシグネチャが別のシグネチャに含まれるならば
+  /// ハッシュ値も含まれる．
+  PackedVal
+  hash() const;
+
+  /// @brief 自分が sig に含まれている時 true を返す．
+  /// @param[in] sig 比較対象のシグネチャ
+  ///
+  /// 自分の検出パタンが全て sig の検出パタンに含まれる時 true となる．
+  bool
+  is_contained(const FaultSig& sig) const;
+
+  /// @brief 使用しているメモリを解放する．
+  void
+  shrink();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ハッシュ値
+  // 各ワードをワード番号だけ回転させたものの OR
+  PackedVal mHash;
+
+  // 0 でないワードの連続区間のリスト
+  // (先頭のワード番号, ワード数) の対をワード番号の昇順に並べたもの
+  vector<pair<int, int>> mRunList;
+
+  // 0 でないワードの値のリスト
+  vector<PackedVal> mWordList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+FaultSig::FaultSig() :
+  mHash(kPvAll0)
+{
+}
+
+// @brief デストラクタ
+inline
+FaultSig::~FaultSig()
+{
+}
+
+// @brief 内容をクリアする．
+inline
+void
+FaultSig::clear()
+{
+  mHash = kPvAll0;
+  mRunList.clear();
+  mWordList.clear();
+}
+
+// @brief 0 でないワード数を返す．
+inline
+int
+FaultSig::word_num() const
+{
+  return mWordList.size();
+}
+
+// @brief 0 でないワードの連続区間の数を返す．
+inline
+int
+FaultSig::run_num() const
+{
+  return mRunList.size();
+}
+
+// @brief 連続区間の先頭のワード番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < run_num() )
+inline
+int
+FaultSig::run_start(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < run_num() );
+
+  return mRunList[pos].first;
+}
+
+// @brief 連続区間のワード数を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < run_num() )
+inline
+int
+FaultSig::run_len(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < run_num() );
+
+  return mRunList[pos].second;
+}
+
+// @brief ハッシュ値を返す．
+inline
+PackedVal
+FaultSig::hash() const
+{
+  return mHash;
+}
+
+// @brief 使用しているメモリを解放する．
+inline
+void
+FaultSig::shrink()
+{
+  mHash = kPvAll0;
+  vector<pair<int, int>>().swap(mRunList);
+  vector<PackedVal>().swap(mWordList);
+}
+
+END_NAMESPACE_SATPG
+
+#endif // FAULTSIG_H
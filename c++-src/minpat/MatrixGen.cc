@@ -51,44 +51,13 @@ MatrixGen::generate()
 {
   McMatrix matrix(mFaultList.size(), mTvList.size());
 
-  int wpos = 0;
-  int tv_base = 0;
-  for ( auto tv: mTvList ) {
-    mFsim.set_pattern(wpos, tv);
-    ++ wpos;
-    if ( wpos == kPvBitLen ) {
-      do_fsim(matrix, tv_base, wpos);
-      mFsim.clear_patterns();
-      wpos = 0;
-      tv_base += kPvBitLen;
-    }
-  }
-  if ( wpos > 0 ) {
-    do_fsim(matrix, tv_base, wpos);
-  }
+  mFsim.grade(mTvList,
+	      [&](const TpgFault* fault, int tv_id) {
+		int row_id = mRowIdMap[fault->id()];
+		matrix.insert_elem(row_id, tv_id);
+	      });
 
   return std::move(matrix);
 }
 
-// @brief 故障シミュレーションを行う．
-void
-MatrixGen::do_fsim(McMatrix& matrix,
-		   int tv_base,
-		   int num)
-{
-  int ndet = mFsim.ppsfp();
-  vector<int> det_list[kPvBitLen];
-  for ( auto i: Range(ndet) ) {
-    const TpgFault* fault = mFsim.det_fault(i);
-    PackedVal dbits = mFsim.det_fault_pat(i);
-    int row_id = mRowIdMap[fault->id()];
-    for ( auto bit: Range(num) ) {
-      if ( dbits & (1UL << bit) ) {
-	int tvid = tv_base + bit;
-	matrix.insert_elem(row_id, tv_base + bit);
-      }
-    }
-  }
-}
-
 END_NAMESPACE_SATPG
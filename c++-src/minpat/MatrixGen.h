@@ -47,21 +47,6 @@ public:
   generate();
 
 
-private:
-  //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief 故障シミュレーションを行い，被覆行列に要素を設定する．
-  /// @param[in] matrix 対象の行列
-  /// @param[in] tv_base テストベクタ番号の基点
-  /// @param[in] num セットしたパタン数
-  void
-  do_fsim(McMatrix& matrix,
-	  int tv_base,
-	  int num);
-
-
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -15,6 +15,7 @@
 #include "FaultReducer.h"
 #include "FaultInfo.h"
 #include "TvMerger.h"
+#include "Dsatur.h"
 #include "ym/McMatrix.h"
 #include "ym/HashSet.h"
 #include "ym/Range.h"
@@ -234,6 +235,7 @@ MinPatMgr::gen_mcsets(const vector<TestVector>& tv_list,
 
 // @brief 彩色問題でパタン圧縮を行う．
 // @param[in] tv_list 初期テストパタンのリストnn
+// @param[in] algorithm 彩色アルゴリズム
 // @param[out] new_tv_list 圧縮結果のテストパタンのリスト
 // @return 結果のパタン数を返す．
 int
@@ -241,6 +243,7 @@ MinPatMgr::coloring(const vector<const TpgFault*>& fault_list,
 		    const vector<TestVector>& tv_list,
 		    const TpgNetwork& network,
 		    FaultType fault_type,
+		    const string& algorithm,
 		    vector<TestVector>& new_tv_list)
 {
   new_tv_list.clear();
@@ -294,7 +297,12 @@ MinPatMgr::coloring(const vector<const TpgFault*>& fault_list,
 	 << "# of avg. detects: " << (n_sum / static_cast<double>(nf)) << endl;
   }
 
-  heuristic1(matrix, graph, selected_cols);
+  if ( algorithm == "dsatur" ) {
+    dsatur(matrix, graph, selected_cols);
+  }
+  else {
+    heuristic1(matrix, graph, selected_cols);
+  }
 
   vector<int> color_map;
   int nc = graph.get_color_map(color_map);
@@ -305,6 +313,28 @@ MinPatMgr::coloring(const vector<const TpgFault*>& fault_list,
   return new_tv_list.size();
 }
 
+// @brief Dsatur を用いて彩色する．
+// @param[in] matrix 対象の被覆行列
+// @param[in] graph 衝突グラフ
+// @param[in] selected_cols 縮約で選択された列のリスト
+void
+MinPatMgr::dsatur(const McMatrix& matrix,
+		  MpColGraph& graph,
+		  const vector<int>& selected_cols)
+{
+  // 縮約で削除された列は衝突グラフからも削除されているので
+  // 選択された列と行列に残っている列だけを対象にする．
+  vector<int> node_list(selected_cols);
+  for ( auto col: Range(matrix.col_size()) ) {
+    if ( !matrix.col_deleted(col) ) {
+      node_list.push_back(col);
+    }
+  }
+
+  Dsatur dsatur(graph, node_list);
+  dsatur.coloring();
+}
+
 // @brief 縮約を行う．
 // @param[in] matrix 対象の被覆行列
 // @param[in] graph 衝突グラフ
@@ -9,31 +9,44 @@
 
 #include "MpColGraph.h"
 #include "TestVector.h"
-#include "ym/HashSet.h"
 #include "ym/Range.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_SATPG
 
+BEGIN_NONAMESPACE
+
+// w 中の最下位の 1 のビット位置を返す．
+// w は 0 であってはならない．
+inline
+int
+lowest_one(PackedVal w)
+{
+  return count_ones((w & (~w + 1UL)) - 1UL);
+}
+
+END_NONAMESPACE
+
 // @brief コンストラクタ
 // @param[in] tv_list テストパタンのリスト
 MpColGraph::MpColGraph(const vector<TestVector>& tv_list) :
   mTvList(tv_list),
   mNodeNum(mTvList.size()),
   mVectorSize(0),
+  mBlockNum((mNodeNum + kPvBitLen - 1) / kPvBitLen),
   mOidListArray(mNodeNum),
   mColNum(0),
   mColorMap(mNodeNum, 0),
-  mTmpMark(mNodeNum, 0)
+  mTmpBits(mBlockNum, kPvAll0)
 {
   if ( mNodeNum > 0 ) {
     TestVector tv0 = mTvList[0];
     mVectorSize = tv0.vector_size();
-    mNodeListArray.resize(mVectorSize * 2);
+    mGroupArray.resize(mVectorSize * 2 * mBlockNum, kPvAll0);
+    mOidMark.resize(mVectorSize * 2, false);
 
     gen_conflict_list();
-
-    mTmpList.reserve(mNodeNum);
   }
 }
 
@@ -46,35 +59,51 @@ MpColGraph::~MpColGraph()
 void
 MpColGraph::gen_conflict_list()
 {
-  for ( auto bit: Range(mVectorSize) ) {
-    int oid0 = bit * 2 + 0;
-    int oid1 = bit * 2 + 1;
-    vector<int>& list0 = mNodeListArray[oid0];
-    vector<int>& list1 = mNodeListArray[oid1];
-    for ( auto id: Range(mNodeNum) ) {
-      const TestVector& tv = mTvList[id];
+  // テストベクタのケアビットを転置してグループを作る．
+  for ( auto id: Range(mNodeNum) ) {
+    const TestVector& tv = mTvList[id];
+    int blk = id / kPvBitLen;
+    int sft = id % kPvBitLen;
+    for ( auto bit: Range(mVectorSize) ) {
       Val3 val = tv.val(bit);
       if ( val == Val3::_0 ) {
-	list0.push_back(id);
+	set_bit(_group(bit * 2 + 0)[blk], sft);
       }
       else if ( val == Val3::_1 ) {
-	list1.push_back(id);
+	set_bit(_group(bit * 2 + 1)[blk], sft);
       }
     }
-    if ( !list0.empty() && !list1.empty() ) {
-      for ( auto id: list0 ) {
+  }
+
+  // 0 と 1 の両方のグループが空でないビットについて
+  // 各ノードに相反するグループの OID を登録する．
+  // ビットの昇順に処理するので mOidListArray はソートされている．
+  for ( auto bit: Range(mVectorSize) ) {
+    int oid0 = bit * 2 + 0;
+    int oid1 = bit * 2 + 1;
+    const PackedVal* group0 = _group(oid0);
+    const PackedVal* group1 = _group(oid1);
+    PackedVal any0 = kPvAll0;
+    PackedVal any1 = kPvAll0;
+    for ( auto blk: Range(mBlockNum) ) {
+      any0 |= group0[blk];
+      any1 |= group1[blk];
+    }
+    if ( any0 == kPvAll0 || any1 == kPvAll0 ) {
+      continue;
+    }
+    for ( auto blk: Range(mBlockNum) ) {
+      int base = blk * kPvBitLen;
+      for ( PackedVal w = group0[blk]; w != kPvAll0; w &= (w - 1) ) {
+	int id = base + lowest_one(w);
 	mOidListArray[id].push_back(oid1);
       }
-      for ( auto id: list1 ) {
+      for ( PackedVal w = group1[blk]; w != kPvAll0; w &= (w - 1) ) {
+	int id = base + lowest_one(w);
 	mOidListArray[id].push_back(oid0);
       }
     }
   }
-
-  for ( auto id: Range(mNodeNum) ) {
-    vector<int>& list = mOidListArray[id];
-    sort(list.begin(), list.end());
-  }
 }
 
 // @brief ノードを削除する．
@@ -84,23 +113,11 @@ MpColGraph::delete_node(int node)
 {
   ASSERT_COND( node >= 0 && node < node_num() );
 
+  // node は自分の OID と相反するグループに含まれている．
+  int blk = node / kPvBitLen;
+  PackedVal mask = ~(1UL << (node % kPvBitLen));
   for ( auto oid: mOidListArray[node] ) {
-    vector<int>& list = mNodeListArray[oid ^ 1];
-    // list から node を削除する．
-    int rpos = 0;
-    int n = list.size();
-    for ( ; rpos < n; ++ rpos ) {
-      if ( list[rpos] == node ) {
-	break;
-      }
-    }
-    ASSERT_COND( rpos < n );
-
-    int wpos = rpos;
-    for ( ++ rpos; rpos < n; ++ rpos, ++ wpos ) {
-      list[wpos] = list[rpos];
-    }
-    list.erase(list.end() - 1, list.end());
+    _group(oid ^ 1)[blk] &= mask;
   }
 }
 
@@ -111,19 +128,30 @@ bool
 MpColGraph::compatible_check(int node,
 			     const vector<int>& node_list) const
 {
-  vector<bool> mark(mVectorSize * 2, false);
+  // node_list の衝突集合の OID に印をつける．
+  // 削除されたノードも対象となるのでグループは使わない．
+  vector<int> oid_list;
   for ( auto node1: node_list ) {
     for ( auto oid1: mOidListArray[node1] ) {
-      mark[oid1] = true;
+      if ( !mOidMark[oid1] ) {
+	mOidMark[oid1] = true;
+	oid_list.push_back(oid1);
+      }
     }
   }
 
+  bool ans = true;
   for ( auto oid: mOidListArray[node] ) {
-    if ( mark[oid ^ 1] ) {
-      return false;
+    if ( mOidMark[oid ^ 1] ) {
+      ans = false;
+      break;
     }
   }
-  return true;
+
+  for ( auto oid: oid_list ) {
+    mOidMark[oid] = false;
+  }
+  return ans;
 }
 
 // @brief node1 の衝突集合が node2 の衝突集合に含まれていたら true を返す．
@@ -131,67 +159,18 @@ bool
 MpColGraph::containment_check(int node1,
 			      int node2) const
 {
-  // まず mOidListArray[node1] と mOidListArray[node2] を比較する．
-  // 共通に含まれる oid は削除する．
-  const vector<int>& src_list1 = mOidListArray[node1];
-  const vector<int>& src_list2 = mOidListArray[node2];
-  vector<int> tmp_list1; tmp_list1.reserve(src_list1.size());
-  vector<int> tmp_list2; tmp_list2.reserve(src_list2.size());
-  int rpos1 = 0;
-  int rpos2 = 0;
-  int n1 = src_list1.size();
-  int n2 = src_list2.size();
-  while ( rpos1 < n1 && rpos2 < n2 ) {
-    int oid1 = src_list1[rpos1];
-    int oid2 = src_list2[rpos2];
-    if ( oid1 < oid2 ) {
-      tmp_list1.push_back(oid1);
-      ++ rpos1;
-    }
-    else if ( oid1 > oid2 ) {
-      tmp_list2.push_back(oid2);
-      ++ rpos2;
-    }
-    else {
-      ++ rpos1;
-      ++ rpos2;
-    }
-  }
-  for ( ; rpos1 < n1; ++ rpos1 ) {
-    int oid1 = src_list1[rpos1];
-    tmp_list1.push_back(oid1);
-  }
-  for ( ; rpos2 < n2; ++ rpos2 ) {
-    int oid2 = src_list2[rpos2];
-    tmp_list2.push_back(oid2);
-  }
-  // tmp_list1 に含まれる oid の要素が tmp_list2 に含まれているか調べる．
-  for ( auto oid1: tmp_list1 ) {
-    for ( auto id1: mNodeListArray[oid1] ) {
-      bool found = false;
-      for ( auto oid2: tmp_list2 ) {
-	for ( auto id2: mNodeListArray[oid2] ) {
-	  if ( id2 == id1 ) {
-	    found = true;
-	    break;
-	  }
-	  if ( id2 > id1 ) {
-	    break;
-	  }
-	}
-	if ( found ) {
-	  break;
-	}
-      }
-      if ( !found ) {
-	// node1 の衝突集合に含まれていて node2 の衝突集合に含まれない
-	// ノードがある．
-	return false;
-      }
-    }
+  vector<PackedVal> bits1(mBlockNum, kPvAll0);
+  vector<PackedVal> bits2(mBlockNum, kPvAll0);
+  _or_conflict_bits(node1, bits1);
+  _or_conflict_bits(node2, bits2);
+
+  // node1 の衝突集合に含まれていて node2 の衝突集合に含まれない
+  // ノードがあるか調べる．
+  PackedVal diff = kPvAll0;
+  for ( auto blk: Range(mBlockNum) ) {
+    diff |= bits1[blk] & ~bits2[blk];
   }
-
-  return true;
+  return diff == kPvAll0;
 }
 
 // @brief ノードの衝突数を返す．
@@ -201,10 +180,13 @@ MpColGraph::containment_check(int node1,
 int
 MpColGraph::conflict_num(int node) const
 {
-  get_conflict_list(node, mTmpList);
-  int n = mTmpList.size();
-  mTmpList.clear();
+  std::fill(mTmpBits.begin(), mTmpBits.end(), kPvAll0);
+  _or_conflict_bits(node, mTmpBits);
 
+  int n = 0;
+  for ( auto w: mTmpBits ) {
+    n += count_ones(w);
+  }
   return n;
 }
 
@@ -215,18 +197,7 @@ void
 MpColGraph::get_conflict_list(int node,
 			      vector<int>& conflict_list) const
 {
-  conflict_list.clear();
-  for ( auto oid: mOidListArray[node] ) {
-    for ( auto id: mNodeListArray[oid] ) {
-      if ( mTmpMark[id] == 0 ) {
-	mTmpMark[id] = 1;
-	conflict_list.push_back(id);
-      }
-    }
-  }
-  for ( auto id: conflict_list ) {
-    mTmpMark[id] = 0;
-  }
+  get_conflict_list(vector<int>(1, node), conflict_list);
 }
 
 // @brief ノードの衝突リストを返す．
@@ -236,19 +207,35 @@ void
 MpColGraph::get_conflict_list(const vector<int>& node_list,
 			      vector<int>& conflict_list) const
 {
-  conflict_list.clear();
+  std::fill(mTmpBits.begin(), mTmpBits.end(), kPvAll0);
   for ( auto node: node_list ) {
-    for ( auto oid: mOidListArray[node] ) {
-      for ( auto id: mNodeListArray[oid] ) {
-	if ( mTmpMark[id] == 0 ) {
-	  mTmpMark[id] = 1;
-	  conflict_list.push_back(id);
-	}
-      }
+    _or_conflict_bits(node, mTmpBits);
+  }
+
+  conflict_list.clear();
+  for ( auto blk: Range(mBlockNum) ) {
+    int base = blk * kPvBitLen;
+    for ( PackedVal w = mTmpBits[blk]; w != kPvAll0; w &= (w - 1) ) {
+      conflict_list.push_back(base + lowest_one(w));
     }
   }
-  for ( auto id: conflict_list ) {
-    mTmpMark[id] = 0;
+}
+
+// @brief ノードの衝突集合を表すビットベクタを作る．
+// @param[in] node ノード番号
+// @param[inout] bits 結果を OR するビットベクタ
+void
+MpColGraph::_or_conflict_bits(int node,
+			      vector<PackedVal>& bits) const
+{
+  ASSERT_COND( static_cast<int>(bits.size()) == mBlockNum );
+
+  PackedVal* dst = bits.data();
+  for ( auto oid: mOidListArray[node] ) {
+    const PackedVal* src = _group(oid);
+    for ( int blk = 0; blk < mBlockNum; ++ blk ) {
+      dst[blk] |= src[blk];
+    }
   }
 }
 
@@ -9,6 +9,7 @@
 /// All rights reserved.
 
 #include "satpg.h"
+#include "PackedVal.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -18,7 +19,10 @@ BEGIN_NAMESPACE_SATPG
 /// @brief MinPatMgr の coloring 用のグラフを表すクラス
 ///
 /// * 隣接ペア(n1, n2)の枝を明示的には持たない．
-/// * 代わりにテストベクタの各ビットごとに相反するグループのリストを持つ．
+/// * 代わりにテストベクタの各ビットごとに相反するグループを持つ．
+/// * グループはノード数のビット長を持つビットベクタで表す．
+///   (テストベクタのケアビットを転置した行列になっている)
+/// * 衝突集合はグループの OR で，衝突数はその popcount で求める．
 /// * テストベクタ(グラフのノード)は一時的に削除される．
 //////////////////////////////////////////////////////////////////////
 class MpColGraph
@@ -134,6 +138,25 @@ private:
   void
   gen_conflict_list();
 
+  /// @brief ノードの衝突集合を表すビットベクタを作る．
+  /// @param[in] node ノード番号
+  /// @param[inout] bits 結果を OR するビットベクタ
+  ///
+  /// bits のサイズは mBlockNum でなければならない．
+  void
+  _or_conflict_bits(int node,
+		    vector<PackedVal>& bits) const;
+
+  /// @brief グループを表すビットベクタの先頭を返す．
+  /// @param[in] oid グループ番号
+  const PackedVal*
+  _group(int oid) const;
+
+  /// @brief グループを表すビットベクタの先頭を返す．
+  /// @param[in] oid グループ番号
+  PackedVal*
+  _group(int oid);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -149,9 +172,13 @@ private:
   // テストベクタのビット長
   int mVectorSize;
 
-  // 衝突関係にあるノード番号のリストの配列
-  // サイズはテストベクタのベクタ長 x 2
-  vector<vector<int>> mNodeListArray;
+  // ノード集合を表すビットベクタのワード数
+  int mBlockNum;
+
+  // 衝突関係にあるノード集合を表すビットベクタの配列
+  // サイズはテストベクタのベクタ長 x 2 x mBlockNum
+  // 削除されたノードのビットは 0 になる．
+  vector<PackedVal> mGroupArray;
 
   // 衝突関係にあるノード集合を表す OID のリスト
   // サイズは mNodeNum
@@ -164,14 +191,15 @@ private:
   // サイズは mNodeNum
   vector<int> mColorMap;
 
-  // 作業用に用いる配列
-  // サイズは mNodeNum;
+  // 作業用に用いるビットベクタ
+  // サイズは mBlockNum
   mutable
-  vector<int> mTmpMark;
+  vector<PackedVal> mTmpBits;
 
-  // 作業用に用いるリスト
+  // 作業用に用いる OID の印
+  // サイズはテストベクタのベクタ長 x 2
   mutable
-  vector<int> mTmpList;
+  vector<bool> mOidMark;
 
 };
 
@@ -198,6 +226,24 @@ MpColGraph::compatible_check(int node1,
   return compatible_check(node1, vector<int>(1, node2));
 }
 
+// @brief グループを表すビットベクタの先頭を返す．
+// @param[in] oid グループ番号
+inline
+const PackedVal*
+MpColGraph::_group(int oid) const
+{
+  return &mGroupArray[oid * mBlockNum];
+}
+
+// @brief グループを表すビットベクタの先頭を返す．
+// @param[in] oid グループ番号
+inline
+PackedVal*
+MpColGraph::_group(int oid)
+{
+  return &mGroupArray[oid * mBlockNum];
+}
+
 // @brief 色数を返す．
 inline
 int
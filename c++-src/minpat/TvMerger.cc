@@ -334,32 +334,44 @@ TvMerger::select_bit(const vector<int>& signature)
 TestVector
 TvMerger::gen_vector(const vector<int>& signature)
 {
+  // シグネチャと両立するベクタを一度にまとめて求める．
+  TestVector sig_tv = signature_vector(signature);
+  vector<bool> compat_list;
+  is_compatible(sig_tv, mOrigTvList, compat_list);
+
   vector<TestVector> tmp_list;
   tmp_list.reserve(mOrigTvList.size());
-  for ( auto tv: mOrigTvList ) {
-    if ( check_compatible(tv, signature) ) {
-      tmp_list.push_back(tv);
+  for ( auto i: Range(mOrigTvList.size()) ) {
+    if ( compat_list[i] ) {
+      tmp_list.push_back(mOrigTvList[i]);
     }
   }
   return merge(tmp_list);
 }
 
-// @brief テストベクタとシグネチャが両立しているか調べる．
-bool
-TvMerger::check_compatible(const TestVector& tv,
-			   const vector<int>& signature)
+// @brief シグネチャを表すテストベクタを作る．
+//
+// 値が 0/1 のビット以外は X となる．
+TestVector
+TvMerger::signature_vector(const vector<int>& signature)
 {
+  TestVector tv(mOrigTvList[0]);
+  tv.init();
+  int ppi_num = tv.ppi_num();
   for ( auto bit: Range(mBitLen) ) {
     int s = signature[bit];
-    Val3 val = tv.val(bit);
-    if ( s == 0 && val == Val3::_1 ) {
-      return false;
+    if ( s != 0 && s != 1 ) {
+      continue;
+    }
+    Val3 val = ( s == 0 ) ? Val3::_0 : Val3::_1;
+    if ( bit < ppi_num ) {
+      tv.set_ppi_val(bit, val);
     }
-    if ( s == 1 && val == Val3::_0 ) {
-      return false;
+    else {
+      tv.set_aux_input_val(bit - ppi_num, val);
     }
   }
-  return true;
+  return tv;
 }
 
 END_NAMESPACE_SATPG
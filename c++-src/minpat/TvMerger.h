@@ -59,10 +59,11 @@ private:
   TestVector
   gen_vector(const vector<int>& signature);
 
-  /// @brief テストベクタとシグネチャが両立しているか調べる．
-  bool
-  check_compatible(const TestVector& tv,
-		   const vector<int>& signature);
+  /// @brief シグネチャを表すテストベクタを作る．
+  ///
+  /// 値が 0/1 のビット以外は X となる．
+  TestVector
+  signature_vector(const vector<int>& signature);
 
   /// @brief ブロックリストを得る．
   /// @param[in] bit ビット位置
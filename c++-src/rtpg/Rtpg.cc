@@ -8,6 +8,9 @@
 
 
 #include "Rtpg.h"
+#include "FaultStatusMgr.h"
+#include "TpgFault.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -18,32 +21,23 @@ BEGIN_NAMESPACE_SATPG
 
 // @brief コンストラクタ
 // @param[in] network 対象のネットワーク
-// @param[in] tvmgr TvMgr
 // @param[in] fault_type 故障の種類
 Rtpg::Rtpg(const TpgNetwork& network,
-	   TvMgr& tvmgr,
 	   FaultType fault_type) :
   mFaultType(fault_type),
-  mTvMgr(tvmgr)
+  mNetwork(network),
+  mSimPatNum(0)
 {
-  mFsim = Fsim::new_Fsim2(network, fault_type);
+  // ランダムパタンは X を含まないので2値のシミュレータでよい．
+  mFsim.init_fsim2(network, fault_type);
 
-  for ( int i = 0; i < kPvBitLen; ++ i ) {
-    tv_array[i] = mTvMgr.new_vector();
-  }
-
-  mDetFaultList.clear();
-  mPatternList.clear();
+  TestVector tv(network.input_num(), network.dff_num(), fault_type);
+  mTvArray.resize(mFsim.pv_bitlen(), tv);
 }
 
 // @brief デストラクタ
 Rtpg::~Rtpg()
 {
-  delete mFsim;
-
-  for ( int i = 0; i < kPvBitLen; ++ i ) {
-    mTvMgr.delete_vector(tv_array[i]);
-  }
 }
 
 // @brief 乱数生成器を初期化する．
@@ -51,28 +45,169 @@ Rtpg::~Rtpg()
 void
 Rtpg::randgen_init(ymuint32 seed)
 {
-  mRandGen.init(seed);
+  mRandGen.seed(seed);
 }
 
-// @brief 1セット(kPvBitLen個)のパタンで故障シミュレーションを行う．
-// @return 新たに検出された故障数を返す．
-int
-Rtpg::do_fsim()
+// @brief 重み付きランダムパタン用の重みを設定する．
+// @param[in] prob_list 各入力が 1 になる確率のリスト
+void
+Rtpg::set_weight(const vector<double>& prob_list)
 {
+  ASSERT_COND( prob_list.empty() || static_cast<int>(prob_list.size()) == mTvArray[0].vector_size() );
+
+  mWeight = prob_list;
 }
 
-// @brief 検出された故障のリストを返す．
-const vector<const TpgFault*>&
-Rtpg::det_fault_list() const
+// @brief テストキューブのリストから重みを求める．
+// @param[in] cube_list テストキューブ(X を含むテストベクタ)のリスト
+// @param[in] min_prob 確率の下限
+// @return 各入力が 1 になる確率のリスト
+vector<double>
+Rtpg::weight_from_cubes(const vector<TestVector>& cube_list,
+			double min_prob)
 {
-  return mDetFaultList;
+  if ( cube_list.empty() ) {
+    // 重みなし(一様なランダムパタン)を表す空のリストを返す．
+    return vector<double>();
+  }
+
+  int n = cube_list[0].vector_size();
+  vector<int> n0_array(n, 0);
+  vector<int> n1_array(n, 0);
+  for ( auto& cube: cube_list ) {
+    ASSERT_COND( cube.vector_size() == n );
+    for ( auto pos: Range(n) ) {
+      switch ( cube.val(pos) ) {
+      case Val3::_0: ++ n0_array[pos]; break;
+      case Val3::_1: ++ n1_array[pos]; break;
+      case Val3::_X: break;
+      }
+    }
+  }
+
+  double max_prob = 1.0 - min_prob;
+  vector<double> prob_list(n);
+  for ( auto pos: Range(n) ) {
+    // ラプラス補正を行っているので値が一度も現れない入力は 0.5 になる．
+    int n0 = n0_array[pos];
+    int n1 = n1_array[pos];
+    double p = static_cast<double>(n1 + 1) / static_cast<double>(n0 + n1 + 2);
+    if ( p < min_prob ) {
+      p = min_prob;
+    }
+    else if ( p > max_prob ) {
+      p = max_prob;
+    }
+    prob_list[pos] = p;
+  }
+  return prob_list;
 }
 
-// @brief 故障を検出したパタンのリストを返す．
-const vector<const TestVector*>&
-Rtpg::pattern_list() const
+// @brief ランダムパタンによるテスト生成を行う．
+// @param[in] fmgr 故障の状態を保持するオブジェクト
+// @param[in] min_f 1ブロックで検出する故障数の下限
+// @param[in] max_i min_f を下回るブロックの連続回数の上限
+// @param[in] max_pat シミュレーションするパタン数の上限
+// @return 検出された故障数を返す．
+int
+Rtpg::run(FaultStatusMgr& fmgr,
+	  int min_f,
+	  int max_i,
+	  int max_pat)
 {
-  return mPatternList;
+  mDetFaultList.clear();
+  mPatternList.clear();
+  mSimPatNum = 0;
+
+  int fnum = 0;
+  mFsim.set_skip_all();
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( fmgr.get(f) == FaultStatus::Undetected ) {
+      mFsim.clear_skip(f);
+      ++ fnum;
+    }
+  }
+
+  int bitlen = mFsim.pv_bitlen();
+  int undet_i = 0;
+  while ( mSimPatNum < max_pat && static_cast<int>(mDetFaultList.size()) < fnum ) {
+    int num = max_pat - mSimPatNum;
+    if ( num > bitlen ) {
+      num = bitlen;
+    }
+    int det_count = do_fsim(fmgr, num);
+    mSimPatNum += num;
+
+    if ( det_count >= min_f ) {
+      undet_i = 0;
+    }
+    else {
+      ++ undet_i;
+      if ( undet_i > max_i ) {
+	// 検出故障数の少ないブロックが max_i 回を越えて続いた．
+	break;
+      }
+    }
+  }
+
+  return mDetFaultList.size();
+}
+
+// @brief 1ブロック分のパタンで故障シミュレーションを行う．
+// @param[in] fmgr 故障の状態を保持するオブジェクト
+// @param[in] num パタン数 ( 1 <= num <= mFsim.pv_bitlen() )
+// @return 新たに検出された故障数を返す．
+int
+Rtpg::do_fsim(FaultStatusMgr& fmgr,
+	      int num)
+{
+  mFsim.clear_patterns();
+  for ( auto i: Range(num) ) {
+    TestVector& tv = mTvArray[i];
+    if ( mWeight.empty() ) {
+      tv.set_from_random(mRandGen);
+    }
+    else {
+      tv.set_from_random(mRandGen, mWeight);
+    }
+    mFsim.set_pattern(i, tv);
+  }
+
+  int det_count = mFsim.ppsfp();
+
+  // 各故障を最初に検出したパタンに印をつける．
+  vector<bool> det_flags(num, false);
+  int nw = (num + kPvBitLen - 1) / kPvBitLen;
+  for ( auto i: Range(det_count) ) {
+    const TpgFault* f = mFsim.det_fault(i);
+    fmgr.set(f, FaultStatus::Detected);
+    mFsim.set_skip(f);
+    mDetFaultList.push_back(f);
+
+    int first = -1;
+    for ( int w = 0; w < nw && first == -1; ++ w ) {
+      PackedVal dpat = mFsim.det_fault_pat(i, w);
+      for ( int b = 0; b < kPvBitLen; ++ b ) {
+	if ( get_bit(dpat, b) ) {
+	  first = w * kPvBitLen + b;
+	  break;
+	}
+      }
+    }
+    ASSERT_COND( first >= 0 && first < num );
+    det_flags[first] = true;
+  }
+
+  // 検出できたパタンは mPatternList に移す．
+  // TestVector は copy-on-write なので mTvArray の内容は
+  // 次の set_from_random() で複製される．
+  for ( auto i: Range(num) ) {
+    if ( det_flags[i] ) {
+      mPatternList.push_back(mTvArray[i]);
+    }
+  }
+
+  return det_count;
 }
 
 END_NAMESPACE_SATPG
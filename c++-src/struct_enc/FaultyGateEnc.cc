@@ -27,7 +27,25 @@ FaultyGateEnc::FaultyGateEnc(SatSolver& solver,
 			     const TpgFault* fault) :
   mSolver(solver),
   mVarMap(varmap),
-  mFault(fault)
+  mFault(fault),
+  mHasCond(false)
+{
+}
+
+// @brief 条件リテラル付きのコンストラクタ
+// @param[in] solver SATソルバ
+// @param[in] varmap 変数番号のマップ
+// @param[in] fault 対象の故障
+// @param[in] cond_lit 条件リテラル
+FaultyGateEnc::FaultyGateEnc(SatSolver& solver,
+			     const VidMap& varmap,
+			     const TpgFault* fault,
+			     SatLiteral cond_lit) :
+  mSolver(solver),
+  mVarMap(varmap),
+  mFault(fault),
+  mHasCond(true),
+  mCondLit(cond_lit)
 {
 }
 
@@ -51,6 +69,10 @@ void
 FaultyGateEnc::make_cnf(SatVarId ovar)
 {
   SatLiteral olit(ovar);
+  if ( mHasCond ) {
+    make_cond_cnf(olit);
+    return;
+  }
 
   int fval = mFault->val();
   if ( mFault->is_stem_fault() ) {
@@ -182,6 +204,124 @@ FaultyGateEnc::make_cnf(SatVarId ovar)
   }
 }
 
+// @brief 条件リテラル付きで入出力の関係を表すCNF式を作る．
+// @param[in] olit 出力のリテラル
+void
+FaultyGateEnc::make_cond_cnf(SatLiteral olit)
+{
+  int fval = mFault->val();
+  if ( mFault->is_stem_fault() ) {
+    // 出力の故障の場合，ゲートの種類は関係ない．
+    add_cond_clause({fval ? olit : ~olit});
+    return;
+  }
+
+  // 入力の故障の場合
+  // 該当の入力以外のファンインのリテラルのリストを作る．
+  const TpgNode* node = mFault->tpg_onode();
+  int ni = node->fanin_num();
+  Array<const TpgNode*> fanin_array = node->fanin_list();
+  vector<SatLiteral> ilits;
+  ilits.reserve(ni - 1);
+  int fpos = mFault->tpg_pos();
+  for ( int i: Range(ni) ) {
+    if ( i != fpos ) {
+      ilits.push_back(lit(fanin_array[i]));
+    }
+  }
+
+  switch ( node->gate_type() ) {
+  case GateType::Const0:
+  case GateType::Const1:
+  case GateType::Input:
+    ASSERT_NOT_REACHED;
+    break;
+
+  case GateType::Buff:
+    add_cond_clause({fval ? olit : ~olit});
+    break;
+
+  case GateType::Not:
+    add_cond_clause({fval ? ~olit : olit});
+    break;
+
+  case GateType::And:
+  case GateType::Nand:
+    if ( node->gate_type() == GateType::Nand ) {
+      olit = ~olit;
+    }
+    if ( fval == 0 ) {
+      // 入力の0縮退故障
+      add_cond_clause({~olit});
+    }
+    else {
+      // 入力の1縮退故障
+      // olit -> ilit[i], (ilit[0] & ... & ilit[n - 1]) -> olit
+      // ilits の要素数が 0 の時は olit = 1 となる．
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(ilits.size() + 1);
+      for ( auto ilit: ilits ) {
+	add_cond_clause({~olit, ilit});
+	tmp_lits.push_back(~ilit);
+      }
+      tmp_lits.push_back(olit);
+      add_cond_clause(tmp_lits);
+    }
+    break;
+
+  case GateType::Or:
+  case GateType::Nor:
+    if ( node->gate_type() == GateType::Nor ) {
+      olit = ~olit;
+    }
+    if ( fval == 1 ) {
+      // 入力の1縮退故障
+      add_cond_clause({olit});
+    }
+    else {
+      // 入力の0縮退故障
+      // ilit[i] -> olit, olit -> (ilit[0] | ... | ilit[n - 1])
+      // ilits の要素数が 0 の時は olit = 0 となる．
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(ilits.size() + 1);
+      for ( auto ilit: ilits ) {
+	add_cond_clause({~ilit, olit});
+	tmp_lits.push_back(ilit);
+      }
+      tmp_lits.push_back(~olit);
+      add_cond_clause(tmp_lits);
+    }
+    break;
+
+  case GateType::Xor:
+  case GateType::Xnor:
+    ASSERT_COND( ni == 2 );
+    {
+      // fval が 1 の時は olit = ~ilits[0] (Xor の場合)
+      if ( (node->gate_type() == GateType::Xnor) ^ (fval == 1) ) {
+	olit = ~olit;
+      }
+      SatLiteral ilit0 = ilits[0];
+      add_cond_clause({~ilit0,  olit});
+      add_cond_clause({ ilit0, ~olit});
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+// @brief 条件リテラルの否定を加えて節を追加する．
+// @param[in] lits 節のリテラルのリスト
+void
+FaultyGateEnc::add_cond_clause(vector<SatLiteral> lits)
+{
+  lits.push_back(~mCondLit);
+  mSolver.add_clause(lits);
+}
+
 // @brief ノードに対応するリテラルを返す．
 SatLiteral
 FaultyGateEnc::lit(const TpgNode* node)
@@ -23,7 +23,22 @@ BEGIN_NAMESPACE_SATPG
 GateEnc::GateEnc(SatSolver& solver,
 		 const VidMap& varmap) :
   mSolver(solver),
-  mVarMap(varmap)
+  mVarMap(varmap),
+  mHasCond(false)
+{
+}
+
+// @brief 条件リテラル付きのコンストラクタ
+// @param[in] solver SATソルバ
+// @param[in] varmap 変数番号のマップ
+// @param[in] cond_lit 条件リテラル
+GateEnc::GateEnc(SatSolver& solver,
+		 const VidMap& varmap,
+		 SatLiteral cond_lit) :
+  mSolver(solver),
+  mVarMap(varmap),
+  mHasCond(true),
+  mCondLit(cond_lit)
 {
 }
 
@@ -49,6 +64,11 @@ GateEnc::make_cnf(const TpgNode* node,
 		  SatVarId ovar)
 {
   SatLiteral olit(ovar);
+  if ( mHasCond ) {
+    make_cond_cnf(node, olit);
+    return;
+  }
+
   int ni = node->fanin_num();
   Array<const TpgNode*> fanin_array = node->fanin_list();
   switch ( node->gate_type() ) {
@@ -270,6 +290,112 @@ GateEnc::make_cnf(const TpgNode* node,
   }
 }
 
+// @brief 条件リテラル付きで入出力の関係を表すCNF式を作る．
+// @param[in] node 対象のノード
+// @param[in] olit 出力のリテラル
+//
+// SatSolver の add_XXXgate_rel() は条件リテラルを扱えないので
+// 節を直接生成する．Nand/Nor/Not/Xnor は出力を反転して扱う．
+void
+GateEnc::make_cond_cnf(const TpgNode* node,
+		       SatLiteral olit)
+{
+  int ni = node->fanin_num();
+  Array<const TpgNode*> fanin_array = node->fanin_list();
+  switch ( node->gate_type() ) {
+  case GateType::Const0:
+    add_cond_clause({~olit});
+    break;
+
+  case GateType::Const1:
+    add_cond_clause({ olit});
+    break;
+
+  case GateType::Input:
+    // なにもしない．
+    break;
+
+  case GateType::Buff:
+  case GateType::Not:
+    {
+      SatLiteral ilit = lit(fanin_array[0]);
+      if ( node->gate_type() == GateType::Not ) {
+	olit = ~olit;
+      }
+      add_cond_clause({~ilit,  olit});
+      add_cond_clause({ ilit, ~olit});
+    }
+    break;
+
+  case GateType::And:
+  case GateType::Nand:
+    {
+      if ( node->gate_type() == GateType::Nand ) {
+	olit = ~olit;
+      }
+      // olit -> ilit[i], (ilit[0] & ... & ilit[ni - 1]) -> olit
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(ni + 1);
+      for ( int i = 0; i < ni; ++ i ) {
+	SatLiteral ilit = lit(fanin_array[i]);
+	add_cond_clause({~olit, ilit});
+	tmp_lits.push_back(~ilit);
+      }
+      tmp_lits.push_back(olit);
+      add_cond_clause(tmp_lits);
+    }
+    break;
+
+  case GateType::Or:
+  case GateType::Nor:
+    {
+      if ( node->gate_type() == GateType::Nor ) {
+	olit = ~olit;
+      }
+      // ilit[i] -> olit, olit -> (ilit[0] | ... | ilit[ni - 1])
+      vector<SatLiteral> tmp_lits;
+      tmp_lits.reserve(ni + 1);
+      for ( int i = 0; i < ni; ++ i ) {
+	SatLiteral ilit = lit(fanin_array[i]);
+	add_cond_clause({~ilit, olit});
+	tmp_lits.push_back(ilit);
+      }
+      tmp_lits.push_back(~olit);
+      add_cond_clause(tmp_lits);
+    }
+    break;
+
+  case GateType::Xor:
+  case GateType::Xnor:
+    ASSERT_COND( ni == 2 );
+    {
+      if ( node->gate_type() == GateType::Xnor ) {
+	olit = ~olit;
+      }
+      SatLiteral ilit0 = lit(fanin_array[0]);
+      SatLiteral ilit1 = lit(fanin_array[1]);
+      add_cond_clause({~ilit0, ~ilit1, ~olit});
+      add_cond_clause({ ilit0,  ilit1, ~olit});
+      add_cond_clause({~ilit0,  ilit1,  olit});
+      add_cond_clause({ ilit0, ~ilit1,  olit});
+    }
+    break;
+
+  default:
+    ASSERT_NOT_REACHED;
+    break;
+  }
+}
+
+// @brief 条件リテラルの否定を加えて節を追加する．
+// @param[in] lits 節のリテラルのリスト
+void
+GateEnc::add_cond_clause(vector<SatLiteral> lits)
+{
+  lits.push_back(~mCondLit);
+  mSolver.add_clause(lits);
+}
+
 // @brief ノードに対応するリテラルを返す．
 SatLiteral
 GateEnc::lit(const TpgNode* node)
@@ -0,0 +1,64 @@
+
+/// @file LocalIndexMap.cc
+/// @brief LocalIndexMap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LocalIndexMap.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+// クラス LocalIndexMap
+//////////////////////////////////////////////////////////////////////
+
+// @brief 全ての登録を消す．
+//
+// 確保した領域はそのまま再利用する．
+void
+LocalIndexMap::clear()
+{
+  // 使った位置だけ消すので登録数に比例した時間で済む．
+  for ( auto pos: mPosArray ) {
+    mKeyArray[pos] = -1;
+  }
+  mPosArray.clear();
+}
+
+// @brief ハッシュ表を拡大する．
+// @param[in] req_size 必要な要素数
+void
+LocalIndexMap::_expand(int req_size)
+{
+  // 充填率が 1/2 以下になるようにサイズを決める．
+  int size = 16;
+  while ( size < req_size * 2 ) {
+    size <<= 1;
+  }
+  if ( size <= mHashMask + 1 ) {
+    return;
+  }
+
+  vector<int> old_key_array;
+  vector<int> old_index_array;
+  old_key_array.swap(mKeyArray);
+  old_index_array.swap(mIndexArray);
+
+  mHashMask = size - 1;
+  mKeyArray.resize(size, -1);
+  mIndexArray.resize(size, -1);
+  for ( auto& pos: mPosArray ) {
+    int key = old_key_array[pos];
+    int index = old_index_array[pos];
+    int new_pos = _find(key);
+    mKeyArray[new_pos] = key;
+    mIndexArray[new_pos] = index;
+    pos = new_pos;
+  }
+}
+
+END_NAMESPACE_SATPG
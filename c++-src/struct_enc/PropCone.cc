@@ -13,6 +13,7 @@
 #include "TpgFault.h"
 #include "NodeValList.h"
 #include "GateEnc.h"
+#include <unordered_set>
 
 BEGIN_NAMESPACE_SATPG
 
@@ -59,16 +60,16 @@ PropCone::PropCone(StructEnc& struct_sat,
 		   bool detect) :
   mStructEnc(struct_sat),
   mDetect(detect),
-  mMaxNodeId(struct_sat.max_node_id()),
-  mMarkArray(max_id()),
-  mFvarMap(max_id()),
-  mDvarMap(max_id())
+  mMaxNodeId(struct_sat.max_node_id())
 {
+  // 変数は TFO のノードにしか割り当てないので疎なマップを用いる．
+  mFvarMap.init_sparse();
+  mDvarMap.init_sparse();
+
   if ( block_node != nullptr ) {
     set_end_mark(block_node);
   }
 
-  mNodeList.reserve(max_id());
   mark_tfo(root_node);
 }
 
@@ -134,12 +135,12 @@ PropCone::make_vars()
   // 暫定的
   // TFO の TFI のノードの fvar を gvar と同じにする．
   vector<const TpgNode*> tmp_list;
-  vector<bool> tfi_mark(max_id(), false);
+  std::unordered_set<int> tfi_mark;
   for (int i = 0; i < mNodeList.size(); ++ i) {
     const TpgNode* node = mNodeList[i];
     for ( auto inode: node->fanin_list() ) {
-      if ( !tfo_mark(inode) && !tfi_mark[inode->id()] ) {
-	tfi_mark[inode->id()] = true;
+      if ( !tfo_mark(inode) && tfi_mark.count(inode->id()) == 0 ) {
+	tfi_mark.insert(inode->id());
 	tmp_list.push_back(inode);
       }
     }
@@ -148,8 +149,8 @@ PropCone::make_vars()
     const TpgNode* node = tmp_list[rpos];
     set_fvar(node, gvar(node));
     for ( auto inode: node->fanin_list() ) {
-      if ( !tfi_mark[inode->id()] ) {
-	tfi_mark[inode->id()] = true;
+      if ( tfi_mark.count(inode->id()) == 0 ) {
+	tfi_mark.insert(inode->id());
 	tmp_list.push_back(inode);
       }
     }
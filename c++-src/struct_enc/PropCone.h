@@ -13,6 +13,7 @@
 #include "structenc_nsdef.h"
 #include "StructEnc.h"
 #include "TpgNode.h"
+#include "LocalIndexMap.h"
 
 
 BEGIN_NAMESPACE_SATPG_STRUCTENC
@@ -204,6 +205,20 @@ private:
   void
   set_end_mark(const TpgNode* node);
 
+  /// @brief ノードの印を得る．
+  /// @param[in] node 対象のノード
+  ///
+  /// 登録されていない場合は 0 を返す．
+  ymuint8
+  _mark(const TpgNode* node) const;
+
+  /// @brief ノードの印の格納場所を得る．
+  /// @param[in] node 対象のノード
+  ///
+  /// 登録されていない場合は 0 で登録する．
+  ymuint8&
+  _mark_ref(const TpgNode* node);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -219,7 +234,13 @@ private:
   // ノードのIDの最大値
   int mMaxNodeId;
 
-  // ノードごとのいくつかのフラグをまとめた配列
+  // 印を持つノードの局所的な番号
+  // キーはノード番号
+  // TFO のノードにしか印をつけないので印をつけたノードだけに番号を振る．
+  LocalIndexMap mMarkIndex;
+
+  // ノードごとのいくつかのフラグをまとめたもの
+  // インデックスは mMarkIndex の値
   vector<ymuint8> mMarkArray;
 
   // 故障の TFO のノードリスト
@@ -384,7 +405,7 @@ inline
 bool
 PropCone::tfo_mark(const TpgNode* node) const
 {
-  return static_cast<bool>((mMarkArray[node->id()] >> 0) & 1U);
+  return static_cast<bool>((_mark(node) >> 0) & 1U);
 }
 
 // @brief tfo マークをつける．
@@ -392,9 +413,9 @@ inline
 void
 PropCone::set_tfo_mark(const TpgNode* node)
 {
-  int id = node->id();
-  if ( ((mMarkArray[id] >> 0) & 1U) == 0U ) {
-    mMarkArray[id] |= 1U;
+  auto& mark = _mark_ref(node);
+  if ( ((mark >> 0) & 1U) == 0U ) {
+    mark |= 1U;
     mNodeList.push_back(node);
     if ( node->is_ppo() ) {
       set_end_mark(node);
@@ -412,7 +433,7 @@ inline
 bool
 PropCone::end_mark(const TpgNode* node) const
 {
-  return static_cast<bool>((mMarkArray[node->id()] >> 1) & 1U);
+  return static_cast<bool>((_mark(node) >> 1) & 1U);
 }
 
 // @brief end マークをつける．
@@ -421,7 +442,37 @@ inline
 void
 PropCone::set_end_mark(const TpgNode* node)
 {
-  mMarkArray[node->id()] |= 2U;
+  _mark_ref(node) |= 2U;
+}
+
+// @brief ノードの印を得る．
+// @param[in] node 対象のノード
+//
+// 登録されていない場合は 0 を返す．
+inline
+ymuint8
+PropCone::_mark(const TpgNode* node) const
+{
+  int index = mMarkIndex.find(node->id());
+  if ( index < 0 ) {
+    return 0U;
+  }
+  return mMarkArray[index];
+}
+
+// @brief ノードの印の格納場所を得る．
+// @param[in] node 対象のノード
+//
+// 登録されていない場合は 0 で登録する．
+inline
+ymuint8&
+PropCone::_mark_ref(const TpgNode* node)
+{
+  int index = mMarkIndex.reg(node->id());
+  if ( index == static_cast<int>(mMarkArray.size()) ) {
+    mMarkArray.push_back(0U);
+  }
+  return mMarkArray[index];
 }
 
 // @brief StructEnc を得る．
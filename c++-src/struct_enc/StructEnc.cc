@@ -54,11 +54,11 @@ StructEnc::StructEnc(const TpgNetwork& network,
   mNetwork(network),
   mFaultType(fault_type),
   mSolver(solver_type),
-  mMaxId(network.node_num()),
-  mMark(mMaxId, false)
+  mMaxId(network.node_num())
 {
+  // 変数は関係するノードにしか割り当てないので疎なマップを用いる．
   for (int i = 0; i < 2; ++ i) {
-    mVarMap[i].init(mMaxId);
+    mVarMap[i].init_sparse();
   }
   mDebugFlag = 0;
 
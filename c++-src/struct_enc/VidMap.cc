@@ -0,0 +1,66 @@
+
+/// @file VidMap.cc
+/// @brief VidMap の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "VidMap.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+// クラス VidMap
+//////////////////////////////////////////////////////////////////////
+
+// @brief 疎なモードで初期化する．
+// @param[in] size_hint 登録されるノード数の見積もり
+//
+// size_hint を越えて登録しても構わない．
+void
+VidMap::init_sparse(int size_hint)
+{
+  mSparse = true;
+  mNum = 0;
+  mHashMask = 0;
+  mKeyArray.clear();
+  mVidArray.clear();
+  _expand(size_hint);
+}
+
+// @brief ハッシュ表を拡大する．
+// @param[in] req_size 必要な要素数
+void
+VidMap::_expand(int req_size)
+{
+  // 充填率が 1/2 以下になるようにサイズを決める．
+  int size = 16;
+  while ( size < req_size * 2 ) {
+    size <<= 1;
+  }
+  if ( size <= mHashMask + 1 ) {
+    return;
+  }
+
+  vector<int> old_key_array;
+  vector<SatVarId> old_vid_array;
+  old_key_array.swap(mKeyArray);
+  old_vid_array.swap(mVidArray);
+
+  mHashMask = size - 1;
+  mKeyArray.resize(size, -1);
+  mVidArray.resize(size, kSatVarIdIllegal);
+  for ( int i = 0; i < static_cast<int>(old_key_array.size()); ++ i ) {
+    int id = old_key_array[i];
+    if ( id != -1 ) {
+      int pos = _find(id);
+      mKeyArray[pos] = id;
+      mVidArray[pos] = old_vid_array[i];
+    }
+  }
+}
+
+END_NAMESPACE_SATPG
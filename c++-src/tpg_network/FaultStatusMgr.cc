@@ -23,6 +23,9 @@ BEGIN_NAMESPACE_SATPG
 FaultStatusMgr::FaultStatusMgr(const TpgNetwork& network) :
   mStatusArray(network.max_fault_id())
 {
+  for ( auto& status: mStatusArray ) {
+    status = FaultStatus::Undetected;
+  }
 }
 
 // @brief デストラクタ
@@ -40,6 +43,18 @@ FaultStatusMgr::set(const TpgFault* fault,
   mStatusArray[fault->id()] = status;
 }
 
+// @brief 故障が未検出の場合のみ状態をセットする．
+// @param[in] fault 故障
+// @param[in] status 故障の状態
+// @return 状態を変更した場合に true を返す．
+bool
+FaultStatusMgr::set_if_undetected(const TpgFault* fault,
+				  FaultStatus status)
+{
+  FaultStatus expected = FaultStatus::Undetected;
+  return mStatusArray[fault->id()].compare_exchange_strong(expected, status);
+}
+
 // @brief 故障の状態を得る．
 FaultStatus
 FaultStatusMgr::get(const TpgFault* fault) const
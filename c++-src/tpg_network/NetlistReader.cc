@@ -0,0 +1,774 @@
+
+/// @file NetlistReader.cc
+/// @brief NetlistReader の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "NetlistReader.h"
+#include "GateType.h"
+
+#include "ym/Expr.h"
+#include "ym/Range.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+
+BEGIN_NAMESPACE_SATPG
+
+BEGIN_NONAMESPACE
+
+// 1行読み込む．
+// 行末の '\' による継続行をつなげ，'#' 以降のコメントを取り除く．
+// ファイルの末尾に達したら false を返す．
+bool
+read_line(std::istream& s,
+	  string& line,
+	  int& line_no)
+{
+  line.clear();
+  string buf;
+  for ( ; ; ) {
+    if ( !getline(s, buf) ) {
+      return !line.empty();
+    }
+    ++ line_no;
+    auto cpos = buf.find('#');
+    if ( cpos != string::npos ) {
+      buf.erase(cpos);
+    }
+    if ( !buf.empty() && buf.back() == '\r' ) {
+      buf.pop_back();
+    }
+    if ( !buf.empty() && buf.back() == '\\' ) {
+      buf.pop_back();
+      line += buf;
+      line += ' ';
+      continue;
+    }
+    line += buf;
+    return true;
+  }
+}
+
+// 空白で区切られたトークンに分割する．
+void
+split(const string& line,
+      vector<string>& token_list)
+{
+  token_list.clear();
+  int n = line.size();
+  int pos = 0;
+  for ( ; ; ) {
+    while ( pos < n && isspace(line[pos]) ) {
+      ++ pos;
+    }
+    if ( pos == n ) {
+      break;
+    }
+    int start = pos;
+    while ( pos < n && !isspace(line[pos]) ) {
+      ++ pos;
+    }
+    token_list.push_back(line.substr(start, pos - start));
+  }
+}
+
+// エラーメッセージを出力する．
+void
+error(const string& filename,
+      int line_no,
+      const string& msg)
+{
+  cerr << filename << ": " << line_no << ": " << msg << endl;
+}
+
+// iscas89 形式のゲート名をゲートタイプに変換する．
+// 入力数が1の場合は BUFF か NOT にする．
+// 該当しない場合は false を返す．
+bool
+conv_to_gate_type(const string& name,
+		  int ni,
+		  GateType& gate_type)
+{
+  string uname(name);
+  for ( auto& c: uname ) {
+    c = toupper(c);
+  }
+  if ( uname == "BUF" || uname == "BUFF" ) {
+    if ( ni != 1 ) {
+      return false;
+    }
+    gate_type = GateType::Buff;
+    return true;
+  }
+  if ( uname == "NOT" ) {
+    if ( ni != 1 ) {
+      return false;
+    }
+    gate_type = GateType::Not;
+    return true;
+  }
+  if ( ni == 0 ) {
+    return false;
+  }
+  if ( uname == "AND" ) {
+    gate_type = (ni == 1) ? GateType::Buff : GateType::And;
+  }
+  else if ( uname == "NAND" ) {
+    gate_type = (ni == 1) ? GateType::Not : GateType::Nand;
+  }
+  else if ( uname == "OR" ) {
+    gate_type = (ni == 1) ? GateType::Buff : GateType::Or;
+  }
+  else if ( uname == "NOR" ) {
+    gate_type = (ni == 1) ? GateType::Not : GateType::Nor;
+  }
+  else if ( uname == "XOR" ) {
+    gate_type = (ni == 1) ? GateType::Buff : GateType::Xor;
+  }
+  else if ( uname == "XNOR" ) {
+    gate_type = (ni == 1) ? GateType::Not : GateType::Xnor;
+  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス NetlistReader
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+NetlistReader::NetlistReader() :
+  mClock(-1),
+  mExtraNodeNum(0)
+{
+}
+
+// @brief デストラクタ
+NetlistReader::~NetlistReader()
+{
+}
+
+// @brief 内容をクリアする．
+void
+NetlistReader::clear()
+{
+  mSignalArray.clear();
+  mNameBuf.clear();
+  mFaninBuf.clear();
+  mNameMap.clear();
+  mCoverMap.clear();
+  mInputList.clear();
+  mOutputList.clear();
+  mDffInputList.clear();
+  mDffOutputList.clear();
+  mClock = -1;
+  mLogicList.clear();
+  mExtraNodeNum = 0;
+}
+
+// @brief blif ファイルを読み込む．
+// @param[in] filename ファイル名
+// @return 読み込みが成功したら true を返す．
+bool
+NetlistReader::read_blif(const string& filename)
+{
+  clear();
+
+  std::ifstream s(filename);
+  if ( !s ) {
+    cerr << filename << ": No such file" << endl;
+    return false;
+  }
+
+  string line;
+  vector<string> token_list;
+  int line_no = 0;
+
+  // 処理中の .names の情報
+  bool in_names = false;
+  vector<string> name_list;
+  vector<string> cube_list;
+  char opat = '\0';
+  int names_line = 0;
+
+  while ( read_line(s, line, line_no) ) {
+    split(line, token_list);
+    if ( token_list.empty() ) {
+      continue;
+    }
+
+    const string& cmd = token_list[0];
+    if ( cmd[0] != '.' ) {
+      // .names のキューブ
+      if ( !in_names ) {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      int ni = name_list.size() - 1;
+      string ipat;
+      string opat1;
+      if ( ni == 0 ) {
+	if ( token_list.size() != 1 ) {
+	  error(filename, line_no, "syntax error");
+	  return false;
+	}
+	opat1 = token_list[0];
+      }
+      else {
+	if ( token_list.size() != 2 ) {
+	  error(filename, line_no, "syntax error");
+	  return false;
+	}
+	ipat = token_list[0];
+	opat1 = token_list[1];
+      }
+      if ( static_cast<int>(ipat.size()) != ni ||
+	   ipat.find_first_not_of("01-") != string::npos ) {
+	error(filename, line_no, "illegal input pattern");
+	return false;
+      }
+      if ( opat1 != "0" && opat1 != "1" ) {
+	error(filename, line_no, "illegal output pattern");
+	return false;
+      }
+      if ( opat != '\0' && opat != opat1[0] ) {
+	error(filename, line_no, "mixed output patterns");
+	return false;
+      }
+      opat = opat1[0];
+      cube_list.push_back(ipat);
+      continue;
+    }
+
+    if ( in_names ) {
+      // 直前の .names を処理する．
+      if ( !new_cover(name_list, cube_list, opat) ) {
+	error(filename, names_line, name_list.back() + ": defined more than once");
+	return false;
+      }
+      in_names = false;
+    }
+
+    if ( cmd == ".model" ) {
+      ;
+    }
+    else if ( cmd == ".inputs" ) {
+      for ( auto i: Range(1, token_list.size()) ) {
+	if ( !new_input(token_list[i]) ) {
+	  error(filename, line_no, token_list[i] + ": defined more than once");
+	  return false;
+	}
+      }
+    }
+    else if ( cmd == ".outputs" ) {
+      for ( auto i: Range(1, token_list.size()) ) {
+	mOutputList.push_back(find_signal(token_list[i]));
+      }
+    }
+    else if ( cmd == ".names" ) {
+      if ( token_list.size() < 2 ) {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      name_list.assign(token_list.begin() + 1, token_list.end());
+      cube_list.clear();
+      opat = '\0';
+      names_line = line_no;
+      in_names = true;
+    }
+    else if ( cmd == ".latch" ) {
+      // 初期値とクロックの指定は無視する．
+      if ( token_list.size() < 3 ) {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      if ( !new_dff(token_list[1], token_list[2]) ) {
+	error(filename, line_no, token_list[2] + ": defined more than once");
+	return false;
+      }
+    }
+    else if ( cmd == ".end" || cmd == ".exdc" ) {
+      break;
+    }
+    else if ( cmd == ".gate" || cmd == ".mlatch" || cmd == ".subckt" ) {
+      error(filename, line_no, cmd + ": not supported");
+      return false;
+    }
+    // それ以外のコマンドは無視する．
+  }
+  if ( in_names ) {
+    if ( !new_cover(name_list, cube_list, opat) ) {
+      error(filename, names_line, name_list.back() + ": defined more than once");
+      return false;
+    }
+  }
+
+  return post_read(filename);
+}
+
+// @brief iscas89 形式のファイルを読み込む．
+// @param[in] filename ファイル名
+// @return 読み込みが成功したら true を返す．
+bool
+NetlistReader::read_iscas89(const string& filename)
+{
+  clear();
+
+  std::ifstream s(filename);
+  if ( !s ) {
+    cerr << filename << ": No such file" << endl;
+    return false;
+  }
+
+  string line;
+  vector<string> token_list;
+  vector<int> fanin_list;
+  int line_no = 0;
+  while ( read_line(s, line, line_no) ) {
+    bool has_eq = line.find('=') != string::npos;
+    for ( auto& c: line ) {
+      if ( c == '(' || c == ')' || c == ',' || c == '=' ) {
+	c = ' ';
+      }
+    }
+    split(line, token_list);
+    if ( token_list.empty() ) {
+      continue;
+    }
+
+    if ( !has_eq ) {
+      // INPUT(name) か OUTPUT(name)
+      if ( token_list.size() != 2 ) {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      string kwd(token_list[0]);
+      for ( auto& c: kwd ) {
+	c = toupper(c);
+      }
+      const string& name = token_list[1];
+      if ( kwd == "INPUT" ) {
+	if ( !new_input(name) ) {
+	  error(filename, line_no, name + ": defined more than once");
+	  return false;
+	}
+      }
+      else if ( kwd == "OUTPUT" ) {
+	mOutputList.push_back(find_signal(name));
+      }
+      else {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      continue;
+    }
+
+    // oname = GATE(iname, ...)
+    if ( token_list.size() < 2 ) {
+      error(filename, line_no, "syntax error");
+      return false;
+    }
+    const string& oname = token_list[0];
+    const string& gname = token_list[1];
+    // ゲート名は conv_to_gate_type() と同じく大文字小文字を区別しない．
+    string uname(gname);
+    for ( auto& c: uname ) {
+      c = toupper(c);
+    }
+    int ni = token_list.size() - 2;
+    bool stat;
+    if ( uname == "DFF" ) {
+      if ( ni != 1 ) {
+	error(filename, line_no, "syntax error");
+	return false;
+      }
+      stat = new_dff(token_list[2], oname);
+    }
+    else {
+      GateType gate_type;
+      if ( !conv_to_gate_type(gname, ni, gate_type) ) {
+	error(filename, line_no, gname + ": illegal gate type");
+	return false;
+      }
+      fanin_list.clear();
+      for ( auto i: Range(ni) ) {
+	fanin_list.push_back(find_signal(token_list[i + 2]));
+      }
+      stat = new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+    if ( !stat ) {
+      error(filename, line_no, oname + ": defined more than once");
+      return false;
+    }
+  }
+
+  return post_read(filename);
+}
+
+// @brief 名前に対応する信号番号を返す．
+// @param[in] name 名前
+int
+NetlistReader::find_signal(const string& name)
+{
+  auto p = mNameMap.find(name);
+  if ( p != mNameMap.end() ) {
+    return p->second;
+  }
+  int id = new_signal(name);
+  mNameMap.emplace(name, id);
+  return id;
+}
+
+// @brief 辞書に登録しない信号を作る．
+// @param[in] name 名前
+int
+NetlistReader::new_signal(const string& name)
+{
+  int id = mSignalArray.size();
+  int name_pos = mNameBuf.size();
+  mNameBuf.insert(mNameBuf.end(), name.begin(), name.end());
+  mNameBuf.push_back('\0');
+  mSignalArray.push_back(Signal{kUndef, name_pos, 0, 0, 0, nullptr});
+  return id;
+}
+
+// @brief 外部入力を定義する．
+// @param[in] name 名前
+// @return 二重定義の場合は false を返す．
+bool
+NetlistReader::new_input(const string& name)
+{
+  int id = find_signal(name);
+  auto& signal = mSignalArray[id];
+  if ( signal.mType != kUndef ) {
+    return false;
+  }
+  signal.mType = kInput;
+  mInputList.push_back(id);
+  return true;
+}
+
+// @brief DFF を定義する．
+// @param[in] iname 入力の名前
+// @param[in] oname 出力の名前
+// @return 二重定義の場合は false を返す．
+bool
+NetlistReader::new_dff(const string& iname,
+		       const string& oname)
+{
+  int oid = find_signal(oname);
+  auto& signal = mSignalArray[oid];
+  if ( signal.mType != kUndef ) {
+    return false;
+  }
+  signal.mType = kDffOutput;
+  int iid = find_signal(iname);
+  mDffInputList.push_back(iid);
+  mDffOutputList.push_back(oid);
+  return true;
+}
+
+// @brief 論理ノードを定義する．
+// @param[in] oname 出力の名前
+// @param[in] gate_info 論理関数の情報
+// @param[in] fanin_list ファンインの信号番号のリスト
+// @return 二重定義の場合は false を返す．
+bool
+NetlistReader::new_logic(const string& oname,
+			 const TpgGateInfo* gate_info,
+			 const vector<int>& fanin_list)
+{
+  int id = find_signal(oname);
+  auto& signal = mSignalArray[id];
+  if ( signal.mType != kUndef ) {
+    return false;
+  }
+  int ni = fanin_list.size();
+  signal.mType = kLogic;
+  signal.mFaninPos = mFaninBuf.size();
+  signal.mFaninNum = ni;
+  signal.mGateInfo = gate_info;
+  mFaninBuf.insert(mFaninBuf.end(), fanin_list.begin(), fanin_list.end());
+  mLogicList.push_back(id);
+
+  // TpgNetworkImpl::make_logic_node() で追加されるノード数
+  if ( gate_info->is_simple() ) {
+    GateType gate_type = gate_info->gate_type();
+    if ( (gate_type == GateType::Xor || gate_type == GateType::Xnor) && ni > 2 ) {
+      mExtraNodeNum += ni - 2;
+    }
+  }
+  else {
+    mExtraNodeNum += gate_info->extra_node_num();
+  }
+  return true;
+}
+
+// @brief .names の内容から論理ノードを定義する．
+// @param[in] name_list 入力と出力の名前のリスト
+// @param[in] cube_list 入力部分のキューブのリスト
+// @param[in] opat 出力の値 ( '0' or '1' )
+// @return 二重定義の場合は false を返す．
+bool
+NetlistReader::new_cover(const vector<string>& name_list,
+			 const vector<string>& cube_list,
+			 char opat)
+{
+  int ni0 = name_list.size() - 1;
+  const string& oname = name_list[ni0];
+  vector<int> fanin_list;
+
+  // キューブがない場合は定数0
+  // 全て '-' のキューブがある場合は定数
+  if ( cube_list.empty() ) {
+    return new_logic(oname, mGateInfoMgr.simple_type(GateType::Const0), fanin_list);
+  }
+  for ( auto& cube: cube_list ) {
+    if ( cube.find_first_not_of('-') == string::npos ) {
+      GateType gate_type = (opat == '1') ? GateType::Const1 : GateType::Const0;
+      return new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+  }
+
+  // どのキューブにも現れない入力を取り除く．
+  vector<int> ipos_list;
+  for ( auto i: Range(ni0) ) {
+    for ( auto& cube: cube_list ) {
+      if ( cube[i] != '-' ) {
+	ipos_list.push_back(i);
+	break;
+      }
+    }
+  }
+  int ni = ipos_list.size();
+  int nc = cube_list.size();
+  vector<string> cube_list1(nc, string(ni, '-'));
+  for ( auto c: Range(nc) ) {
+    for ( auto i: Range(ni) ) {
+      cube_list1[c][i] = cube_list[c][ipos_list[i]];
+    }
+  }
+  for ( auto i: Range(ni) ) {
+    fanin_list.push_back(find_signal(name_list[ipos_list[i]]));
+  }
+
+  // 組み込み型になるか調べる．
+  bool inv = (opat == '0');
+  if ( nc == 1 ) {
+    // ここに来るキューブは全ての入力がリテラルになっている．
+    const string& cube = cube_list1[0];
+    if ( cube.find('0') == string::npos ) {
+      // AND
+      GateType gate_type;
+      if ( ni == 1 ) {
+	gate_type = inv ? GateType::Not : GateType::Buff;
+      }
+      else {
+	gate_type = inv ? GateType::Nand : GateType::And;
+      }
+      return new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+    if ( cube.find('1') == string::npos ) {
+      // NOR
+      GateType gate_type;
+      if ( ni == 1 ) {
+	gate_type = inv ? GateType::Buff : GateType::Not;
+      }
+      else {
+	gate_type = inv ? GateType::Or : GateType::Nor;
+      }
+      return new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+  }
+  else if ( nc == ni ) {
+    // 全てのキューブが1リテラルなら OR か NAND
+    // 使われていない入力はないので各入力が1回ずつ現れる．
+    bool single = true;
+    int n0 = 0;
+    for ( auto& cube: cube_list1 ) {
+      int n = 0;
+      for ( auto c: cube ) {
+	if ( c != '-' ) {
+	  ++ n;
+	  if ( c == '0' ) {
+	    ++ n0;
+	  }
+	}
+      }
+      if ( n != 1 ) {
+	single = false;
+	break;
+      }
+    }
+    if ( single && (n0 == 0 || n0 == nc) ) {
+      GateType gate_type;
+      if ( n0 == 0 ) {
+	gate_type = inv ? GateType::Nor : GateType::Or;
+      }
+      else {
+	gate_type = inv ? GateType::And : GateType::Nand;
+      }
+      return new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+  }
+  if ( ni >= 2 && ni < 20 && nc == (1 << (ni - 1)) ) {
+    // 全てのキューブが最小項で1の数の偶奇が揃っていれば XOR か XNOR
+    bool xor_like = true;
+    int parity = -1;
+    for ( auto& cube: cube_list1 ) {
+      if ( cube.find('-') != string::npos ) {
+	xor_like = false;
+	break;
+      }
+      int p = std::count(cube.begin(), cube.end(), '1') % 2;
+      if ( parity == -1 ) {
+	parity = p;
+      }
+      else if ( parity != p ) {
+	xor_like = false;
+	break;
+      }
+    }
+    if ( xor_like ) {
+      vector<string> tmp_list(cube_list1);
+      sort(tmp_list.begin(), tmp_list.end());
+      xor_like = unique(tmp_list.begin(), tmp_list.end()) == tmp_list.end();
+    }
+    if ( xor_like ) {
+      bool is_xor = (parity == 1) ^ inv;
+      GateType gate_type = is_xor ? GateType::Xor : GateType::Xnor;
+      return new_logic(oname, mGateInfoMgr.simple_type(gate_type), fanin_list);
+    }
+  }
+
+  // それ以外は論理式にする．
+  // 同じ内容の .names は同じ TpgGateInfo を共有する．
+  string key(1, opat);
+  for ( auto& cube: cube_list1 ) {
+    key += ' ';
+    key += cube;
+  }
+  const TpgGateInfo* gate_info = nullptr;
+  auto p = mCoverMap.find(key);
+  if ( p != mCoverMap.end() ) {
+    gate_info = p->second;
+  }
+  else {
+    Expr expr = Expr::zero();
+    for ( auto& cube: cube_list1 ) {
+      Expr prod = Expr::one();
+      for ( auto i: Range(ni) ) {
+	if ( cube[i] == '0' ) {
+	  prod &= Expr::literal(VarId(i), true);
+	}
+	else if ( cube[i] == '1' ) {
+	  prod &= Expr::literal(VarId(i), false);
+	}
+      }
+      expr |= prod;
+    }
+    if ( inv ) {
+      expr = ~expr;
+    }
+    gate_info = mGateInfoMgr.complex_type(ni, expr);
+    mCoverMap.emplace(key, gate_info);
+  }
+  return new_logic(oname, gate_info, fanin_list);
+}
+
+// @brief 読み込み後の処理を行う．
+// @param[in] filename ファイル名(エラーメッセージ用)
+// @return 未定義の信号やループがあったら false を返す．
+bool
+NetlistReader::post_read(const string& filename)
+{
+  // 辞書はもう使わないので領域ごと解放する．
+  std::unordered_map<string, int>().swap(mNameMap);
+  std::unordered_map<string, const TpgGateInfo*>().swap(mCoverMap);
+
+  int ns = mSignalArray.size();
+  for ( auto id: Range(ns) ) {
+    if ( mSignalArray[id].mType == kUndef ) {
+      cerr << filename << ": " << signal_name(id) << ": undefined" << endl;
+      return false;
+    }
+  }
+
+  // クロック用の外部入力を追加する．
+  if ( dff_num() > 0 ) {
+    mClock = new_signal("clock");
+    mSignalArray[mClock].mType = kInput;
+    mInputList.push_back(mClock);
+    ++ ns;
+  }
+
+  // ファンアウト数を数える．
+  for ( auto id: mLogicList ) {
+    for ( auto i: Range(fanin_num(id)) ) {
+      ++ mSignalArray[fanin(id, i)].mFanoutNum;
+    }
+  }
+  for ( auto id: mOutputList ) {
+    ++ mSignalArray[id].mFanoutNum;
+  }
+  for ( auto id: mDffInputList ) {
+    ++ mSignalArray[id].mFanoutNum;
+    ++ mSignalArray[mClock].mFanoutNum;
+  }
+
+  // 論理ノードを深さ優先でたどってトポロジカル順に並べる．
+  // 深いネットワークでもスタックがあふれないように再帰は使わない．
+  // mark は 0: 未処理, 1: 処理中, 2: 処理済み
+  vector<int> mark(ns, 0);
+  vector<int> logic_list;
+  logic_list.reserve(mLogicList.size());
+  vector<pair<int, int> > stack;
+  for ( auto root: mLogicList ) {
+    if ( mark[root] != 0 ) {
+      continue;
+    }
+    mark[root] = 1;
+    stack.push_back(make_pair(root, 0));
+    while ( !stack.empty() ) {
+      int id = stack.back().first;
+      int pos = stack.back().second;
+      if ( pos < fanin_num(id) ) {
+	++ stack.back().second;
+	int iid = fanin(id, pos);
+	if ( mSignalArray[iid].mType != kLogic ) {
+	  continue;
+	}
+	if ( mark[iid] == 1 ) {
+	  cerr << filename << ": " << signal_name(iid)
+	       << ": combinational loop" << endl;
+	  return false;
+	}
+	if ( mark[iid] == 0 ) {
+	  mark[iid] = 1;
+	  stack.push_back(make_pair(iid, 0));
+	}
+      }
+      else {
+	mark[id] = 2;
+	logic_list.push_back(id);
+	stack.pop_back();
+      }
+    }
+  }
+  mLogicList.swap(logic_list);
+
+  return true;
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,470 @@
+#ifndef NETLISTREADER_H
+#define NETLISTREADER_H
+
+/// @file NetlistReader.h
+/// @brief NetlistReader のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+#include "TpgGateInfo.h"
+
+#include <unordered_map>
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class NetlistReader NetlistReader.h "NetlistReader.h"
+/// @brief blif/iscas89 形式のファイルを直接読み込むクラス
+///
+/// BnNetwork を経由せずに TpgNetworkImpl::set() に必要な情報だけを
+/// 1回のファイル読み込みで作る．
+/// - 信号は名前ごとに番号(信号番号)を割り当てて参照する．
+///   定義より前に参照された信号も番号だけ先に割り当てておく．
+/// - ファンインは全ての信号で一つの配列に詰めて格納する．
+/// - 論理関数は読み込んだ時点で TpgGateInfo に変換し，
+///   .names のキューブなどは保持しない．
+/// - 名前から信号番号を引く辞書は読み込みが終わった時点で捨てる．
+///
+/// DFF がある場合にはクロック用の外部入力 "clock" を最後の入力として
+/// 追加する．
+//////////////////////////////////////////////////////////////////////
+class NetlistReader
+{
+public:
+
+  /// @brief コンストラクタ
+  NetlistReader();
+
+  /// @brief デストラクタ
+  ~NetlistReader();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 読み込みを行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief blif ファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @return 読み込みが成功したら true を返す．
+  ///
+  /// .gate や .subckt を含むファイルは読み込めない．
+  bool
+  read_blif(const string& filename);
+
+  /// @brief iscas89 形式のファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @return 読み込みが成功したら true を返す．
+  bool
+  read_iscas89(const string& filename);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 読み込んだ結果を取り出す関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 信号数を返す．
+  int
+  signal_num() const;
+
+  /// @brief 信号名を返す．
+  /// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+  const char*
+  signal_name(int id) const;
+
+  /// @brief 外部入力数を返す．
+  ///
+  /// クロック用の入力も含む．
+  int
+  input_num() const;
+
+  /// @brief 外部入力の信号番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < input_num() )
+  int
+  input(int pos) const;
+
+  /// @brief 外部出力数を返す．
+  int
+  output_num() const;
+
+  /// @brief 外部出力の信号番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < output_num() )
+  int
+  output(int pos) const;
+
+  /// @brief DFF数を返す．
+  int
+  dff_num() const;
+
+  /// @brief DFF の入力の信号番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < dff_num() )
+  int
+  dff_input(int pos) const;
+
+  /// @brief DFF の出力の信号番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < dff_num() )
+  int
+  dff_output(int pos) const;
+
+  /// @brief クロックの信号番号を返す．
+  ///
+  /// dff_num() == 0 の時は -1 を返す．
+  int
+  clock() const;
+
+  /// @brief 論理ノードの信号番号のリストを返す．
+  ///
+  /// トポロジカル順に並んでいる．
+  const vector<int>&
+  logic_list() const;
+
+  /// @brief 論理ノードの論理関数の情報を返す．
+  /// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+  const TpgGateInfo*
+  gate_info(int id) const;
+
+  /// @brief 論理ノードのファンイン数を返す．
+  /// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+  int
+  fanin_num(int id) const;
+
+  /// @brief 論理ノードのファンインの信号番号を返す．
+  /// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+  /// @param[in] pos 位置番号 ( 0 <= pos < fanin_num(id) )
+  int
+  fanin(int id,
+	int pos) const;
+
+  /// @brief ファンアウト数を返す．
+  /// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+  ///
+  /// 外部出力，DFF の入力とクロックへの接続も数える．
+  int
+  fanout_num(int id) const;
+
+  /// @brief 論理ノードを TpgNode にした時の追加ノード数を返す．
+  int
+  extra_node_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 信号の種類
+  enum SignalType {
+    kUndef,
+    kInput,
+    kDffOutput,
+    kLogic
+  };
+
+  // 信号の情報
+  struct Signal
+  {
+    // 種類
+    SignalType mType;
+
+    // 名前の mNameBuf 上の位置
+    int mNamePos;
+
+    // ファンインの mFaninBuf 上の位置
+    int mFaninPos;
+
+    // ファンイン数
+    int mFaninNum;
+
+    // ファンアウト数
+    int mFanoutNum;
+
+    // 論理関数の情報
+    const TpgGateInfo* mGateInfo;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief 名前に対応する信号番号を返す．
+  /// @param[in] name 名前
+  ///
+  /// 未登録の場合は未定義の信号を作る．
+  int
+  find_signal(const string& name);
+
+  /// @brief 辞書に登録しない信号を作る．
+  /// @param[in] name 名前
+  int
+  new_signal(const string& name);
+
+  /// @brief 外部入力を定義する．
+  /// @param[in] name 名前
+  /// @return 二重定義の場合は false を返す．
+  bool
+  new_input(const string& name);
+
+  /// @brief DFF を定義する．
+  /// @param[in] iname 入力の名前
+  /// @param[in] oname 出力の名前
+  /// @return 二重定義の場合は false を返す．
+  bool
+  new_dff(const string& iname,
+	  const string& oname);
+
+  /// @brief 論理ノードを定義する．
+  /// @param[in] oname 出力の名前
+  /// @param[in] gate_info 論理関数の情報
+  /// @param[in] fanin_list ファンインの信号番号のリスト
+  /// @return 二重定義の場合は false を返す．
+  bool
+  new_logic(const string& oname,
+	    const TpgGateInfo* gate_info,
+	    const vector<int>& fanin_list);
+
+  /// @brief .names の内容から論理ノードを定義する．
+  /// @param[in] name_list 入力と出力の名前のリスト
+  /// @param[in] cube_list 入力部分のキューブのリスト
+  /// @param[in] opat 出力の値 ( '0' or '1' )
+  /// @return 二重定義の場合は false を返す．
+  ///
+  /// どのキューブにも現れない入力は取り除く．
+  bool
+  new_cover(const vector<string>& name_list,
+	    const vector<string>& cube_list,
+	    char opat);
+
+  /// @brief 読み込み後の処理を行う．
+  /// @param[in] filename ファイル名(エラーメッセージ用)
+  /// @return 未定義の信号やループがあったら false を返す．
+  ///
+  /// ファンアウト数を数え，論理ノードをトポロジカル順に並べる．
+  bool
+  post_read(const string& filename);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 論理関数の情報を管理するオブジェクト
+  TpgGateInfoMgr mGateInfoMgr;
+
+  // 信号の配列
+  vector<Signal> mSignalArray;
+
+  // 信号名を '\0' 区切りで詰めたバッファ
+  vector<char> mNameBuf;
+
+  // ファンインの信号番号を詰めたバッファ
+  vector<int> mFaninBuf;
+
+  // 名前から信号番号を引く辞書
+  // 読み込みの間だけ用いる．
+  std::unordered_map<string, int> mNameMap;
+
+  // .names の内容から論理関数の情報を引く辞書
+  // 読み込みの間だけ用いる．
+  std::unordered_map<string, const TpgGateInfo*> mCoverMap;
+
+  // 外部入力の信号番号のリスト
+  vector<int> mInputList;
+
+  // 外部出力の信号番号のリスト
+  vector<int> mOutputList;
+
+  // DFF の入力の信号番号のリスト
+  vector<int> mDffInputList;
+
+  // DFF の出力の信号番号のリスト
+  vector<int> mDffOutputList;
+
+  // クロックの信号番号
+  int mClock;
+
+  // 論理ノードの信号番号のリスト
+  vector<int> mLogicList;
+
+  // 追加ノード数
+  int mExtraNodeNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 信号数を返す．
+inline
+int
+NetlistReader::signal_num() const
+{
+  return mSignalArray.size();
+}
+
+// @brief 信号名を返す．
+// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+inline
+const char*
+NetlistReader::signal_name(int id) const
+{
+  ASSERT_COND( id >= 0 && id < signal_num() );
+
+  return &mNameBuf[mSignalArray[id].mNamePos];
+}
+
+// @brief 外部入力数を返す．
+inline
+int
+NetlistReader::input_num() const
+{
+  return mInputList.size();
+}
+
+// @brief 外部入力の信号番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < input_num() )
+inline
+int
+NetlistReader::input(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < input_num() );
+
+  return mInputList[pos];
+}
+
+// @brief 外部出力数を返す．
+inline
+int
+NetlistReader::output_num() const
+{
+  return mOutputList.size();
+}
+
+// @brief 外部出力の信号番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < output_num() )
+inline
+int
+NetlistReader::output(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < output_num() );
+
+  return mOutputList[pos];
+}
+
+// @brief DFF数を返す．
+inline
+int
+NetlistReader::dff_num() const
+{
+  return mDffInputList.size();
+}
+
+// @brief DFF の入力の信号番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < dff_num() )
+inline
+int
+NetlistReader::dff_input(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < dff_num() );
+
+  return mDffInputList[pos];
+}
+
+// @brief DFF の出力の信号番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < dff_num() )
+inline
+int
+NetlistReader::dff_output(int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < dff_num() );
+
+  return mDffOutputList[pos];
+}
+
+// @brief クロックの信号番号を返す．
+inline
+int
+NetlistReader::clock() const
+{
+  return mClock;
+}
+
+// @brief 論理ノードの信号番号のリストを返す．
+inline
+const vector<int>&
+NetlistReader::logic_list() const
+{
+  return mLogicList;
+}
+
+// @brief 論理ノードの論理関数の情報を返す．
+// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+inline
+const TpgGateInfo*
+NetlistReader::gate_info(int id) const
+{
+  ASSERT_COND( id >= 0 && id < signal_num() );
+
+  return mSignalArray[id].mGateInfo;
+}
+
+// @brief 論理ノードのファンイン数を返す．
+// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+inline
+int
+NetlistReader::fanin_num(int id) const
+{
+  ASSERT_COND( id >= 0 && id < signal_num() );
+
+  return mSignalArray[id].mFaninNum;
+}
+
+// @brief 論理ノードのファンインの信号番号を返す．
+// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+// @param[in] pos 位置番号 ( 0 <= pos < fanin_num(id) )
+inline
+int
+NetlistReader::fanin(int id,
+		     int pos) const
+{
+  ASSERT_COND( pos >= 0 && pos < fanin_num(id) );
+
+  return mFaninBuf[mSignalArray[id].mFaninPos + pos];
+}
+
+// @brief ファンアウト数を返す．
+// @param[in] id 信号番号 ( 0 <= id < signal_num() )
+inline
+int
+NetlistReader::fanout_num(int id) const
+{
+  ASSERT_COND( id >= 0 && id < signal_num() );
+
+  return mSignalArray[id].mFanoutNum;
+}
+
+// @brief 論理ノードを TpgNode にした時の追加ノード数を返す．
+inline
+int
+NetlistReader::extra_node_num() const
+{
+  return mExtraNodeNum;
+}
+
+END_NAMESPACE_SATPG
+
+#endif // NETLISTREADER_H
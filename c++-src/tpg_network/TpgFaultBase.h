@@ -86,6 +86,15 @@ protected:
   node_name() const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // フレンド関数の宣言
+  //////////////////////////////////////////////////////////////////////
+
+  // スナップショットの書き出しで node_name() を用いる．
+  friend class TpgNetworkImpl;
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -9,6 +9,7 @@
 
 #include "TpgNetwork.h"
 #include "TpgNetworkImpl.h"
+#include "NetlistReader.h"
 #include "TpgNode.h"
 #include "TpgDff.h"
 #include "GateType.h"
@@ -318,10 +319,18 @@ TpgNetwork::set(const BnNetwork& network)
 // @brief blif ファイルを読み込む．
 // @param[in] filename ファイル名
 // @return 読み込みが成功したら true を返す．
+//
+// セルライブラリを用いないので BnNetwork を介さずに直接読み込む．
 bool
 TpgNetwork::read_blif(const string& filename)
 {
-  return read_blif(filename, ClibCellLibrary());
+  NetlistReader reader;
+  bool stat = reader.read_blif(filename);
+  if ( stat ) {
+    mImpl->set(reader);
+  }
+
+  return stat;
 }
 
 // @brief blif ファイルを読み込む．
@@ -347,15 +356,33 @@ TpgNetwork::read_blif(const string& filename,
 bool
 TpgNetwork::read_iscas89(const string& filename)
 {
-  BnNetwork network = BnNetwork::read_iscas89(filename);
-  bool stat = network.node_num() != 0;
+  NetlistReader reader;
+  bool stat = reader.read_iscas89(filename);
   if ( stat ) {
-    set(network);
+    mImpl->set(reader);
   }
 
   return stat;
 }
 
+// @brief 内容をスナップショットファイルに書き出す．
+// @param[in] filename ファイル名
+// @return 書き出しが成功したら true を返す．
+bool
+TpgNetwork::save_snapshot(const string& filename) const
+{
+  return mImpl->save_snapshot(filename);
+}
+
+// @brief スナップショットファイルを読み込む．
+// @param[in] filename ファイル名
+// @return 読み込みが成功したら true を返す．
+bool
+TpgNetwork::load_snapshot(const string& filename)
+{
+  return mImpl->load_snapshot(filename);
+}
+
 // @brief TpgNetwork の内容を出力する関数
 // @param[in] s 出力先のストリーム
 // @param[in] network 対象のネットワーク
@@ -19,6 +19,7 @@
 #include "GateType.h"
 
 #include "NodeMap.h"
+#include "NetlistReader.h"
 #include "AuxNodeInfo.h"
 
 #include "ym/BnNetwork.h"
@@ -201,6 +202,15 @@ TpgNetworkImpl::clear()
   mMffcArray = nullptr;
   mFfrArray = nullptr;
   mRepFaultArray = nullptr;
+
+  mInputNum = 0;
+  mOutputNum = 0;
+  mDffNum = 0;
+  mNodeNum = 0;
+  mMffcNum = 0;
+  mFfrNum = 0;
+  mFaultNum = 0;
+  mRepFaultNum = 0;
 }
 
 // @brief ノード名を得る．
@@ -557,7 +567,128 @@ TpgNetworkImpl::set(const BnNetwork& network)
 
   ASSERT_COND( mNodeNum == nn );
 
+  post_op(connection_list);
+}
+
+// @brief NetlistReader から内容を設定する．
+// @param[in] reader 読み込み結果
+void
+TpgNetworkImpl::set(const NetlistReader& reader)
+{
+  // まずクリアしておく．
+  clear();
+
+  int input_num = reader.input_num();
+  int output_num = reader.output_num();
+  int dff_num = reader.dff_num();
+  int nl = reader.logic_list().size();
+
+  // DFF の制御端子はクロックのみ
+  int nn = input_num + output_num + dff_num * 3 + nl + reader.extra_node_num();
+  set_size(input_num, output_num, dff_num, nn);
+
+  // 信号番号をキーにして TpgNode を納める配列
+  vector<TpgNode*> node_map(reader.signal_num(), nullptr);
+
+  mNodeNum = 0;
+  mFaultNum = 0;
+
+  vector<pair<int, int> > connection_list;
+
+  //////////////////////////////////////////////////////////////////////
+  // 入力ノードを作成する．
+  //////////////////////////////////////////////////////////////////////
+  for ( auto i: Range(mInputNum) ) {
+    int id = reader.input(i);
+    int nfo = reader.fanout_num(id);
+    TpgNode* node = make_input_node(i, reader.signal_name(id), nfo);
+    mPPIArray[i] = node;
+
+    node_map[id] = node;
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // DFFの出力ノードを作成する．
+  //////////////////////////////////////////////////////////////////////
+  for ( auto i: Range(mDffNum) ) {
+    int id = reader.dff_output(i);
+    int nfo = reader.fanout_num(id);
+    TpgDff* dff = &mDffArray[i];
+    int iid = i + mInputNum;
+    TpgNode* node = make_dff_output_node(iid, dff, reader.signal_name(id), nfo);
+    mPPIArray[iid] = node;
+    dff->mOutput = node;
+
+    node_map[id] = node;
+  }
+
 
+  //////////////////////////////////////////////////////////////////////
+  // 論理ノードを作成する．
+  // NetlistReader::logic_list() はトポロジカルソートされている．
+  //////////////////////////////////////////////////////////////////////
+  vector<TpgNode*> fanin_array;
+  for ( int id: reader.logic_list() ) {
+    int ni = reader.fanin_num(id);
+    fanin_array.clear();
+    for ( auto i: Range(ni) ) {
+      fanin_array.push_back(node_map[reader.fanin(id, i)]);
+    }
+    int nfo = reader.fanout_num(id);
+    TpgNode* node = make_logic_node(reader.signal_name(id), reader.gate_info(id),
+				    fanin_array, nfo, connection_list);
+
+    node_map[id] = node;
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 出力ノードを作成する．
+  //////////////////////////////////////////////////////////////////////
+  for ( auto i: Range(mOutputNum) ) {
+    int id = reader.output(i);
+    TpgNode* inode = node_map[id];
+    string buf = "*";
+    buf += reader.signal_name(id);
+    TpgNode* node = make_output_node(i, buf, inode);
+    connection_list.push_back(make_pair(inode->id(), node->id()));
+    mPPOArray[i] = node;
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // DFFの入力ノードを作成する．
+  //////////////////////////////////////////////////////////////////////
+  for ( auto i: Range(mDffNum) ) {
+    TpgNode* inode = node_map[reader.dff_input(i)];
+    string dff_name = reader.signal_name(reader.dff_output(i));
+    string input_name = dff_name + ".input";
+    TpgDff* dff = &mDffArray[i];
+    int oid = i + mOutputNum;
+    TpgNode* node = make_dff_input_node(oid, dff, input_name, inode);
+    connection_list.push_back(make_pair(inode->id(), node->id()));
+    mPPOArray[oid] = node;
+    dff->mInput = node;
+
+    // クロック端子を作る．
+    TpgNode* clock_fanin = node_map[reader.clock()];
+    string clock_name = dff_name + ".clock";
+    TpgNode* clock = make_dff_clock_node(dff, clock_name, clock_fanin);
+    connection_list.push_back(make_pair(clock_fanin->id(), clock->id()));
+    dff->mClock = clock;
+  }
+
+  ASSERT_COND( mNodeNum == nn );
+
+  post_op(connection_list);
+}
+
+// @brief ノードを作った後の処理を行う．
+// @param[in] connection_list ノードの接続のリスト
+void
+TpgNetworkImpl::post_op(const vector<pair<int, int> >& connection_list)
+{
   //////////////////////////////////////////////////////////////////////
   // ファンアウトをセットする．
   //////////////////////////////////////////////////////////////////////
@@ -634,7 +765,7 @@ TpgNetworkImpl::set(const BnNetwork& network)
   for ( auto i: Range(npo) ) {
     const TpgNode* onode = ppo(i);
     // onode の TFI のノード数を計算する．
-    vector<bool> mark(nn, false);
+    vector<bool> mark(mNodeNum, false);
     int n = tfimark(onode, mark);
     tmp_list[i] = make_pair(n, i);
   }
@@ -24,6 +24,7 @@ class TpgNodeInfo;
 class AuxNodeInfo;
 class TpgGateInfo;
 class TpgFaultBase;
+class NetlistReader;
 
 //////////////////////////////////////////////////////////////////////
 /// @class TpgNetworkImpl TpgNetworkImpl.h "TpgNetworkImpl.h"
@@ -241,6 +242,26 @@ public:
   void
   set(const BnNetwork& network);
 
+  /// @brief NetlistReader から内容を設定する．
+  /// @param[in] reader 読み込み結果
+  void
+  set(const NetlistReader& reader);
+
+  /// @brief 内容をスナップショットファイルに書き出す．
+  /// @param[in] filename ファイル名
+  /// @return 書き出しが成功したら true を返す．
+  bool
+  save_snapshot(const string& filename) const;
+
+  /// @brief スナップショットファイルから内容を設定する．
+  /// @param[in] filename ファイル名
+  /// @return 読み込みが成功したら true を返す．
+  ///
+  /// ファイルは mmap で読み込み，BnNetwork の構築や
+  /// FFR/MFFC，代表故障の解析を行わずに直接内容を設定する．
+  bool
+  load_snapshot(const string& filename);
+
   /// @brief サイズを設定する．
   void
   set_size(int input_num,
@@ -476,6 +497,13 @@ public:
 		    int pos);
 
 
+  /// @brief ノードを作った後の処理を行う．
+  /// @param[in] connection_list ノードの接続のリスト
+  ///
+  /// ファンアウト，代表故障，immediate dominator, FFR, MFFC を設定する．
+  void
+  post_op(const vector<pair<int, int> >& connection_list);
+
   /// @brief 代表故障を設定する．
   /// @param[in] node 対象のノード
   int
@@ -499,6 +527,14 @@ public:
   const TpgFault**
   make_fault_array(const vector<const TpgFault*>& fault_list);
 
+  /// @brief load_snapshot() の本体
+  /// @param[in] filename ファイル名
+  /// @return 読み込みが成功したら true を返す．
+  ///
+  /// 失敗した場合には途中まで設定された内容が残る．
+  bool
+  _load_snapshot(const string& filename);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
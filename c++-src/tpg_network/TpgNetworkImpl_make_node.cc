@@ -294,7 +294,7 @@ TpgNetworkImpl::make_logic_node(const string& src_name,
 	  tmp_node = make_prim_node(src_name, GateType::Xnor, tmp_list, fanout_num,
 				    connection_list);
 	}
-	inode_array[i].set(tmp_node, i);
+	inode_array[i].set(tmp_node, 1);
       }
       node = tmp_node;
     }
@@ -0,0 +1,784 @@
+
+/// @file TpgNetworkImpl_snapshot.cc
+/// @brief TpgNetworkImpl のスナップショット関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "TpgNetworkImpl.h"
+#include "TpgNode.h"
+#include "TpgNodeFactory.h"
+#include "TpgFaultBase.h"
+#include "TpgStemFault.h"
+#include "TpgBranchFault.h"
+#include "TpgDff.h"
+#include "TpgMFFC.h"
+#include "TpgFFR.h"
+#include "AuxNodeInfo.h"
+
+#include "GateType.h"
+
+#include "ym/Range.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+BEGIN_NAMESPACE_SATPG
+
+BEGIN_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// スナップショットの形式
+//
+// ファイルは 32ビット整数(ワード)の列と文字列領域からなる．
+// ノードや故障は全て番号で参照するのでポインタは含まれない．
+//
+// ヘッダ
+//   kMagic, kVersion, kByteOrder
+//   入力数, 出力数, DFF数, ノード数, 故障数, FFR数, MFFC数
+//   本体のワード数, 文字列領域のバイト数
+// ノード表(ノード番号順)
+//   種類, 種類ごとの引数, DFF番号, 名前の位置, 名前の長さ,
+//   ファンイン数, ファンイン番号..., ファンアウト数, ファンアウト番号...,
+//   immediate dominator の番号
+// 故障表(故障番号順)
+//   種類(0: 出力, 1: 入力), 故障値, ノード番号, 名前を持つノード番号,
+//   入力番号, ノード上の入力位置, 代表故障番号
+// ノードごとの代表故障リスト
+//   故障数, 故障番号...
+// TFI サイズ順の PPO のリスト
+//   ノード番号...
+// FFR 表
+//   根のノード番号, 故障数, 故障番号...
+// MFFC 表
+//   根のノード番号, FFR数, FFR番号..., 故障数, 故障番号...
+// 文字列領域
+//////////////////////////////////////////////////////////////////////
+
+// ファイルの先頭の識別子
+const std::int32_t kMagic = 0x4e505453; // "STPN"
+
+// 形式のバージョン
+const std::int32_t kVersion = 1;
+
+// バイトオーダーの確認用の値
+const std::int32_t kByteOrder = 0x01020304;
+
+// ヘッダのワード数
+const int kHeaderSize = 12;
+
+// ノードの種類
+enum {
+  kInput,
+  kOutput,
+  kDffInput,
+  kDffOutput,
+  kDffClock,
+  kDffClear,
+  kDffPreset,
+  kLogic
+};
+
+// 該当しない番号を表す値
+const std::int32_t kNoId = -1;
+
+// ノードの種類を返す．
+int
+node_kind(const TpgNode* node)
+{
+  if ( node->is_primary_input() ) {
+    return kInput;
+  }
+  if ( node->is_primary_output() ) {
+    return kOutput;
+  }
+  if ( node->is_dff_input() ) {
+    return kDffInput;
+  }
+  if ( node->is_dff_output() ) {
+    return kDffOutput;
+  }
+  if ( node->is_dff_clock() ) {
+    return kDffClock;
+  }
+  if ( node->is_dff_clear() ) {
+    return kDffClear;
+  }
+  if ( node->is_dff_preset() ) {
+    return kDffPreset;
+  }
+  ASSERT_COND( node->is_logic() );
+  return kLogic;
+}
+
+//////////////////////////////////////////////////////////////////////
+// スナップショットを読み出すクラス
+//
+// ファイルを mmap してワード単位で先頭から順に読む．
+// 範囲外の読み出しを行った場合はエラーフラグを立てて 0 を返す．
+//////////////////////////////////////////////////////////////////////
+class SnapshotReader
+{
+public:
+
+  // コンストラクタ
+  SnapshotReader() :
+    mAddr(MAP_FAILED),
+    mSize(0),
+    mWords(nullptr),
+    mWordNum(0),
+    mStrings(nullptr),
+    mStrSize(0),
+    mPos(0),
+    mError(false)
+  {
+  }
+
+  // デストラクタ
+  ~SnapshotReader()
+  {
+    if ( mAddr != MAP_FAILED ) {
+      munmap(mAddr, mSize);
+    }
+  }
+
+  // ファイルを開いてヘッダを確認する．
+  bool
+  open(const string& filename)
+  {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if ( fd < 0 ) {
+      return false;
+    }
+    struct stat st;
+    if ( fstat(fd, &st) < 0 ||
+	 st.st_size < static_cast<off_t>(kHeaderSize * sizeof(std::int32_t)) ) {
+      ::close(fd);
+      return false;
+    }
+    mSize = st.st_size;
+    mAddr = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( mAddr == MAP_FAILED ) {
+      return false;
+    }
+
+    mWords = reinterpret_cast<const std::int32_t*>(mAddr);
+    if ( mWords[0] != kMagic || mWords[1] != kVersion || mWords[2] != kByteOrder ) {
+      return false;
+    }
+    std::int64_t word_num = mWords[kHeaderSize - 2];
+    std::int64_t str_size = mWords[kHeaderSize - 1];
+    if ( word_num < kHeaderSize || str_size < 0 ||
+	 word_num * sizeof(std::int32_t) + str_size != mSize ) {
+      return false;
+    }
+    mWordNum = word_num;
+    mStrings = reinterpret_cast<const char*>(mWords + mWordNum);
+    mStrSize = str_size;
+    mPos = 3;
+    return true;
+  }
+
+  // 1ワード読み出す．
+  int
+  read()
+  {
+    if ( mPos >= mWordNum ) {
+      mError = true;
+      return 0;
+    }
+    return mWords[mPos ++];
+  }
+
+  // 0 以上 limit 未満の値を読み出す．
+  int
+  read_id(int limit)
+  {
+    int val = read();
+    if ( val < 0 || val >= limit ) {
+      mError = true;
+      return 0;
+    }
+    return val;
+  }
+
+  // kNoId か 0 以上 limit 未満の値を読み出す．
+  int
+  read_id_or_none(int limit)
+  {
+    int val = read();
+    if ( val != kNoId && (val < 0 || val >= limit) ) {
+      mError = true;
+      return kNoId;
+    }
+    return val;
+  }
+
+  // 文字列を取り出す．
+  string
+  read_string()
+  {
+    int pos = read();
+    int len = read();
+    if ( pos < 0 || len < 0 || static_cast<std::int64_t>(pos) + len > mStrSize ) {
+      mError = true;
+      return string();
+    }
+    return string(mStrings + pos, len);
+  }
+
+  // 全て読み終わっていたら true を返す．
+  bool
+  is_end() const
+  {
+    return mPos == mWordNum;
+  }
+
+  // エラーが起きていたら true を返す．
+  bool
+  error() const
+  {
+    return mError;
+  }
+
+
+private:
+
+  // mmap したアドレス
+  void* mAddr;
+
+  // mmap したサイズ
+  size_t mSize;
+
+  // ワード領域の先頭
+  const std::int32_t* mWords;
+
+  // ワード数
+  std::int64_t mWordNum;
+
+  // 文字列領域の先頭
+  const char* mStrings;
+
+  // 文字列領域のサイズ
+  std::int64_t mStrSize;
+
+  // 次に読み出す位置
+  std::int64_t mPos;
+
+  // エラーフラグ
+  bool mError;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス TpgNetworkImpl
+//////////////////////////////////////////////////////////////////////
+
+// @brief 内容をスナップショットファイルに書き出す．
+// @param[in] filename ファイル名
+// @return 書き出しが成功したら true を返す．
+bool
+TpgNetworkImpl::save_snapshot(const string& filename) const
+{
+  vector<std::int32_t> words;
+  string strings;
+
+  words.push_back(kMagic);
+  words.push_back(kVersion);
+  words.push_back(kByteOrder);
+  words.push_back(mInputNum);
+  words.push_back(mOutputNum);
+  words.push_back(mDffNum);
+  words.push_back(mNodeNum);
+  words.push_back(mFaultNum);
+  words.push_back(mFfrNum);
+  words.push_back(mMffcNum);
+  // 本体のワード数と文字列領域のサイズは最後に書き込む．
+  words.push_back(0);
+  words.push_back(0);
+
+  // 故障の名前からノード番号を引くための辞書
+  // 名前はノードごとに別の領域に確保されている．
+  std::unordered_map<const char*, int> name_map;
+
+  // ノード表
+  for ( auto id: Range(mNodeNum) ) {
+    const TpgNode* node = mNodeArray[id];
+    int kind = node_kind(node);
+    words.push_back(kind);
+    switch ( kind ) {
+    case kInput:
+    case kDffOutput:
+      words.push_back(node->input_id());
+      break;
+
+    case kOutput:
+    case kDffInput:
+      words.push_back(node->output_id());
+      break;
+
+    case kLogic:
+      words.push_back(__gate_type_to_int(node->gate_type()));
+      break;
+
+    default:
+      words.push_back(0);
+      break;
+    }
+    // dff() は DFF 関係のノード以外では呼べない．
+    if ( kind != kInput && kind != kOutput && kind != kLogic ) {
+      words.push_back(node->dff()->id());
+    }
+    else {
+      words.push_back(kNoId);
+    }
+
+    const char* name = mAuxInfoArray[id].name();
+    name_map[name] = id;
+    words.push_back(strings.size());
+    int len = strlen(name);
+    words.push_back(len);
+    strings.append(name, len);
+
+    words.push_back(node->fanin_num());
+    for ( auto inode: node->fanin_list() ) {
+      words.push_back(inode->id());
+    }
+    words.push_back(node->fanout_num());
+    for ( auto onode: node->fanout_list() ) {
+      words.push_back(onode->id());
+    }
+    if ( node->imm_dom() != nullptr ) {
+      words.push_back(node->imm_dom()->id());
+    }
+    else {
+      words.push_back(kNoId);
+    }
+  }
+
+  // 故障表
+  // 故障は AuxNodeInfo にしか記録されていないので番号順に並べ直す．
+  vector<const TpgFaultBase*> fault_array(mFaultNum, nullptr);
+  for ( auto id: Range(mNodeNum) ) {
+    const AuxNodeInfo& aux_info = mAuxInfoArray[id];
+    for ( int val: {0, 1} ) {
+      auto f = aux_info.output_fault(val);
+      if ( f != nullptr ) {
+	fault_array[f->id()] = f;
+      }
+      for ( auto ipos: Range(mNodeArray[id]->fanin_num()) ) {
+	auto f = aux_info.input_fault(ipos, val);
+	if ( f != nullptr ) {
+	  fault_array[f->id()] = f;
+	}
+      }
+    }
+  }
+  for ( auto f: fault_array ) {
+    ASSERT_COND( f != nullptr );
+    auto p = name_map.find(f->node_name());
+    ASSERT_COND( p != name_map.end() );
+    words.push_back(f->is_stem_fault() ? 0 : 1);
+    words.push_back(f->val());
+    words.push_back(f->tpg_onode()->id());
+    words.push_back(p->second);
+    if ( f->is_stem_fault() ) {
+      words.push_back(0);
+      words.push_back(0);
+    }
+    else {
+      words.push_back(f->fault_pos());
+      words.push_back(f->tpg_pos());
+    }
+    if ( f->rep_fault() != nullptr ) {
+      words.push_back(f->rep_fault()->id());
+    }
+    else {
+      words.push_back(kNoId);
+    }
+  }
+
+  // ノードごとの代表故障リスト
+  for ( auto id: Range(mNodeNum) ) {
+    const AuxNodeInfo& aux_info = mAuxInfoArray[id];
+    int nf = aux_info.fault_num();
+    words.push_back(nf);
+    for ( auto i: Range(nf) ) {
+      words.push_back(aux_info.fault(i)->id());
+    }
+  }
+
+  // TFI サイズ順の PPO のリスト
+  for ( auto i: Range(ppo_num()) ) {
+    words.push_back(mPPOArray2[i]->id());
+  }
+
+  // FFR 表
+  for ( auto i: Range(mFfrNum) ) {
+    const TpgFFR& ffr = mFfrArray[i];
+    words.push_back(ffr.root()->id());
+    words.push_back(ffr.fault_num());
+    for ( auto f: ffr.fault_list() ) {
+      words.push_back(f->id());
+    }
+  }
+
+  // MFFC 表
+  for ( auto i: Range(mMffcNum) ) {
+    const TpgMFFC& mffc = mMffcArray[i];
+    words.push_back(mffc.root()->id());
+    words.push_back(mffc.ffr_num());
+    for ( auto ffr: mffc.ffr_list() ) {
+      words.push_back(ffr - mFfrArray);
+    }
+    words.push_back(mffc.fault_num());
+    for ( auto f: mffc.fault_list() ) {
+      words.push_back(f->id());
+    }
+  }
+
+  words[kHeaderSize - 2] = words.size();
+  words[kHeaderSize - 1] = strings.size();
+
+  std::ofstream s(filename, std::ios::binary);
+  if ( !s ) {
+    return false;
+  }
+  s.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(std::int32_t));
+  s.write(strings.data(), strings.size());
+  return static_cast<bool>(s);
+}
+
+// @brief スナップショットファイルから内容を設定する．
+// @param[in] filename ファイル名
+// @return 読み込みが成功したら true を返す．
+bool
+TpgNetworkImpl::load_snapshot(const string& filename)
+{
+  // まずクリアしておく．
+  clear();
+
+  bool stat = _load_snapshot(filename);
+  if ( !stat ) {
+    // 途中まで設定された内容は捨てる．
+    clear();
+  }
+  return stat;
+}
+
+// @brief load_snapshot() の本体
+// @param[in] filename ファイル名
+// @return 読み込みが成功したら true を返す．
+bool
+TpgNetworkImpl::_load_snapshot(const string& filename)
+{
+
+  SnapshotReader reader;
+  if ( !reader.open(filename) ) {
+    return false;
+  }
+
+  int input_num = reader.read();
+  int output_num = reader.read();
+  int dff_num = reader.read();
+  int node_num = reader.read();
+  int fault_num = reader.read();
+  int ffr_num = reader.read();
+  int mffc_num = reader.read();
+  reader.read();
+  reader.read();
+  if ( input_num < 0 || output_num < 0 || dff_num < 0 || node_num < 0 ||
+       fault_num < 0 || ffr_num < 0 || mffc_num < 0 ) {
+    return false;
+  }
+
+  set_size(input_num, output_num, dff_num, node_num);
+
+  mNodeNum = 0;
+
+  //////////////////////////////////////////////////////////////////////
+  // ノードを作る．
+  // ファンインは必ず前に現れるのでノード番号順に作ればよい．
+  //////////////////////////////////////////////////////////////////////
+  TpgNodeFactory factory(mAlloc);
+  vector<vector<int>> fanout_list_array(node_num);
+  vector<int> imm_dom_array(node_num);
+  vector<TpgNode*> fanin_list;
+  for ( auto id: Range(node_num) ) {
+    int kind = reader.read();
+    int arg = reader.read();
+    int dff_id = reader.read_id_or_none(dff_num);
+    string name = reader.read_string();
+    int ni = reader.read();
+    if ( ni < 0 || ni > id ) {
+      return false;
+    }
+    fanin_list.clear();
+    for ( auto i: Range(ni) ) {
+      fanin_list.push_back(mNodeArray[reader.read_id(id)]);
+    }
+    int nfo = reader.read();
+    if ( nfo < 0 || nfo > node_num ) {
+      return false;
+    }
+    vector<int>& fanout_list = fanout_list_array[id];
+    for ( auto i: Range(nfo) ) {
+      fanout_list.push_back(reader.read_id(node_num));
+    }
+    imm_dom_array[id] = reader.read_id_or_none(node_num);
+    if ( reader.error() ) {
+      return false;
+    }
+
+    TpgDff* dff = (dff_id != kNoId) ? &mDffArray[dff_id] : nullptr;
+    TpgNode* node = nullptr;
+    switch ( kind ) {
+    case kInput:
+      if ( arg < 0 || arg >= input_num || ni != 0 ) {
+	return false;
+      }
+      node = factory.make_input(id, arg, nfo);
+      mPPIArray[arg] = node;
+      break;
+
+    case kOutput:
+      if ( arg < 0 || arg >= output_num || ni != 1 ) {
+	return false;
+      }
+      node = factory.make_output(id, arg, fanin_list[0]);
+      mPPOArray[arg] = node;
+      break;
+
+    case kDffInput:
+      if ( arg < output_num || arg >= output_num + dff_num || dff == nullptr || ni != 1 ) {
+	return false;
+      }
+      node = factory.make_dff_input(id, arg, dff, fanin_list[0]);
+      mPPOArray[arg] = node;
+      dff->mInput = node;
+      break;
+
+    case kDffOutput:
+      if ( arg < input_num || arg >= input_num + dff_num || dff == nullptr || ni != 0 ) {
+	return false;
+      }
+      node = factory.make_dff_output(id, arg, dff, nfo);
+      mPPIArray[arg] = node;
+      dff->mOutput = node;
+      break;
+
+    case kDffClock:
+      if ( dff == nullptr || ni != 1 ) {
+	return false;
+      }
+      node = factory.make_dff_clock(id, dff, fanin_list[0]);
+      dff->mClock = node;
+      break;
+
+    case kDffClear:
+      if ( dff == nullptr || ni != 1 ) {
+	return false;
+      }
+      node = factory.make_dff_clear(id, dff, fanin_list[0]);
+      dff->mClear = node;
+      break;
+
+    case kDffPreset:
+      if ( dff == nullptr || ni != 1 ) {
+	return false;
+      }
+      node = factory.make_dff_preset(id, dff, fanin_list[0]);
+      dff->mPreset = node;
+      break;
+
+    case kLogic:
+      // GateType の最後の値は Xnor
+      if ( arg < 0 || arg > __gate_type_to_int(GateType::Xnor) ) {
+	return false;
+      }
+      node = factory.make_logic(id, __int_to_gate_type(arg), fanin_list, nfo);
+      break;
+
+    default:
+      return false;
+    }
+    mNodeArray[id] = node;
+    ++ mNodeNum;
+
+    mAuxInfoArray[id].init(name, ni, mAlloc);
+  }
+
+  for ( auto id: Range(mNodeNum) ) {
+    TpgNode* node = mNodeArray[id];
+    const vector<int>& fanout_list = fanout_list_array[id];
+    if ( static_cast<int>(fanout_list.size()) != node->fanout_num() ) {
+      return false;
+    }
+    for ( auto pos: Range(fanout_list.size()) ) {
+      node->set_fanout(pos, mNodeArray[fanout_list[pos]]);
+    }
+    int dom_id = imm_dom_array[id];
+    node->set_imm_dom(dom_id != kNoId ? mNodeArray[dom_id] : nullptr);
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 故障を作る．
+  //////////////////////////////////////////////////////////////////////
+  vector<TpgFaultBase*> fault_array(fault_num);
+  vector<int> rep_array(fault_num);
+  for ( auto fid: Range(fault_num) ) {
+    int type = reader.read();
+    int val = reader.read();
+    int node_id = reader.read_id(node_num);
+    int name_id = reader.read_id(node_num);
+    int ipos = reader.read();
+    int tpg_pos = reader.read();
+    rep_array[fid] = reader.read_id_or_none(fault_num);
+    if ( reader.error() || (val != 0 && val != 1) ) {
+      return false;
+    }
+
+    const TpgNode* node = mNodeArray[node_id];
+    const char* name = node_name(name_id);
+    TpgFaultBase* f = nullptr;
+    if ( type == 0 ) {
+      void* p = mAlloc.get_memory(sizeof(TpgStemFault));
+      f = new (p) TpgStemFault(fid, val, node, name, nullptr);
+      mAuxInfoArray[node_id].set_output_fault(val, f);
+    }
+    else if ( type == 1 ) {
+      if ( tpg_pos < 0 || tpg_pos >= node->fanin_num() ) {
+	return false;
+      }
+      const TpgNode* inode = node->fanin(tpg_pos);
+      void* p = mAlloc.get_memory(sizeof(TpgBranchFault));
+      f = new (p) TpgBranchFault(fid, val, node, name, ipos, inode, tpg_pos, nullptr);
+      mAuxInfoArray[node_id].set_input_fault(tpg_pos, val, f);
+    }
+    else {
+      return false;
+    }
+    fault_array[fid] = f;
+  }
+  mFaultNum = fault_num;
+
+  // 代表故障は全ての故障を作ってから設定する．
+  for ( auto fid: Range(fault_num) ) {
+    int rep_id = rep_array[fid];
+    if ( rep_id != kNoId ) {
+      fault_array[fid]->set_rep(fault_array[rep_id]);
+    }
+  }
+
+  // ノードごとの代表故障リスト
+  vector<const TpgFault*> fault_list;
+  mRepFaultNum = 0;
+  for ( auto id: Range(mNodeNum) ) {
+    int nf = reader.read();
+    if ( nf < 0 || nf > fault_num ) {
+      return false;
+    }
+    fault_list.clear();
+    for ( auto i: Range(nf) ) {
+      fault_list.push_back(fault_array[reader.read_id(fault_num)]);
+    }
+    mAuxInfoArray[id].set_fault_list(nf, make_fault_array(fault_list));
+    mRepFaultNum += nf;
+  }
+  if ( reader.error() ) {
+    return false;
+  }
+
+  mRepFaultArray = new const TpgFault*[mRepFaultNum];
+  int wpos = 0;
+  for ( auto id: Range(mNodeNum) ) {
+    const AuxNodeInfo& aux_node_info = mAuxInfoArray[id];
+    for ( auto i: Range(aux_node_info.fault_num()) ) {
+      mRepFaultArray[wpos] = aux_node_info.fault(i);
+      ++ wpos;
+    }
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // TFI サイズ順の PPO のリストを設定する．
+  //////////////////////////////////////////////////////////////////////
+  for ( auto i: Range(ppo_num()) ) {
+    TpgNode* onode = mNodeArray[reader.read_id(node_num)];
+    if ( reader.error() || !onode->is_ppo() ) {
+      return false;
+    }
+    mPPOArray2[i] = onode;
+    onode->set_output_id2(i);
+  }
+
+
+  //////////////////////////////////////////////////////////////////////
+  // FFR と MFFC の情報を設定する．
+  //////////////////////////////////////////////////////////////////////
+  mFfrNum = ffr_num;
+  mFfrArray = new TpgFFR[mFfrNum];
+  for ( auto i: Range(mFfrNum) ) {
+    int root_id = reader.read_id(node_num);
+    int nf = reader.read();
+    if ( nf < 0 || nf > fault_num ) {
+      return false;
+    }
+    fault_list.clear();
+    for ( auto j: Range(nf) ) {
+      fault_list.push_back(fault_array[reader.read_id(fault_num)]);
+    }
+    if ( reader.error() ) {
+      return false;
+    }
+    TpgFFR* ffr = &mFfrArray[i];
+    mAuxInfoArray[root_id].set_ffr(ffr);
+    ffr->set(mNodeArray[root_id], nf, make_fault_array(fault_list));
+  }
+
+  mMffcNum = mffc_num;
+  mMffcArray = new TpgMFFC[mMffcNum];
+  for ( auto i: Range(mMffcNum) ) {
+    int root_id = reader.read_id(node_num);
+    int nffr = reader.read();
+    if ( nffr < 0 || nffr > ffr_num ) {
+      return false;
+    }
+    const TpgFFR** ffr_array = mAlloc.get_array<const TpgFFR*>(nffr);
+    for ( auto j: Range(nffr) ) {
+      ffr_array[j] = &mFfrArray[reader.read_id(ffr_num)];
+    }
+    int nf = reader.read();
+    if ( nf < 0 || nf > fault_num ) {
+      return false;
+    }
+    fault_list.clear();
+    for ( auto j: Range(nf) ) {
+      fault_list.push_back(fault_array[reader.read_id(fault_num)]);
+    }
+    if ( reader.error() ) {
+      return false;
+    }
+    TpgMFFC* mffc = &mMffcArray[i];
+    mAuxInfoArray[root_id].set_mffc(mffc);
+    mffc->set(mNodeArray[root_id], nffr, ffr_array, nf, make_fault_array(fault_list));
+  }
+
+  return reader.is_end();
+}
+
+END_NAMESPACE_SATPG
@@ -8,10 +8,57 @@
 
 
 #include "BitVectorRep.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_SATPG
 
+BEGIN_NONAMESPACE
+
+// 途中で打ち切るかどうかを判定する単位(ワード数)
+// この単位の中は分岐なしでまとめて計算するので
+// コンパイラがベクタ命令に変換しやすい．
+const int kChunkSize = 8;
+
+// ブロック単位の演算結果の中に 0 でないものがあれば true を返す．
+// op(i) は i 番目と i + 1 番目のブロック(0 と 1 のビット)から
+// PackedVal を計算する．
+template<class Op>
+inline
+bool
+check_any(int nb,
+	  Op op)
+{
+  for ( int i = 0; i < nb; i += kChunkSize ) {
+    int end = std::min(i + kChunkSize, nb);
+    PackedVal acc = kPvAll0;
+    for ( int j = i; j < end; j += 2 ) {
+      acc |= op(j);
+    }
+    if ( acc != kPvAll0 ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 2つのビットベクタのパタンがコンフリクトしていたら true を返す．
+inline
+bool
+has_conflict(const PackedVal* pat1,
+	     const PackedVal* pat2,
+	     int nb)
+{
+  // 0 のビットと 1 のビットの両方が異なっていると
+  // コンフリクトしている．
+  return check_any(nb, [pat1, pat2](int i) {
+      return (pat1[i + 0] ^ pat2[i + 0]) & (pat1[i + 1] ^ pat2[i + 1]);
+    });
+}
+
+END_NONAMESPACE
+
+
 // @brief ベクタ長を指定してオブジェクトを作る．
 // @param[in] len ベクタ長
 //
@@ -84,12 +131,11 @@ BitVectorRep::is_eq(const BitVectorRep& bv1,
   ASSERT_COND( bv1.len() == bv2.len() );
 
   int nb = block_num(bv1.len());
-  for ( int i = 0; i < nb; ++ i ) {
-    if ( bv1.mPat[i] != bv2.mPat[i] ) {
-      return false;
-    }
-  }
-  return true;
+  const PackedVal* pat1 = bv1.mPat;
+  const PackedVal* pat2 = bv2.mPat;
+  return !check_any(nb, [pat1, pat2](int i) {
+      return (pat1[i + 0] ^ pat2[i + 0]) | (pat1[i + 1] ^ pat2[i + 1]);
+    });
 }
 
 // @brief 2つのビットベクタの包含関係を調べる．
@@ -99,26 +145,7 @@ bool
 BitVectorRep::is_lt(const BitVectorRep& bv1,
 		    const BitVectorRep& bv2)
 {
-  ASSERT_COND( bv1.len() == bv2.len() );
-
-  int nb = block_num(bv1.len());
-  bool diff = false;
-  for ( int i = 0; i < nb; i += 2 ) {
-    int i0 = i;
-    int i1 = i + 1;
-    PackedVal val1_0 = bv1.mPat[i0];
-    PackedVal val1_1 = bv1.mPat[i1];
-    PackedVal val2_0 = bv2.mPat[i0];
-    PackedVal val2_1 = bv2.mPat[i1];
-    if ( (val1_0 & ~val2_0) != kPvAll0 ||
-	 (val1_1 & ~val2_1) != kPvAll0 ) {
-      return false;
-    }
-    if ( val1_0 != val2_0 || val1_1 != val2_1 ) {
-      diff = true;
-    }
-  }
-  return diff;
+  return is_le(bv1, bv2) && !is_eq(bv1, bv2);
 }
 
 // @brief 2つのビットベクタの包含関係を調べる．
@@ -132,20 +159,13 @@ BitVectorRep::is_le(const BitVectorRep& bv1,
 {
   ASSERT_COND( bv1.len() == bv2.len() );
 
+  // bv1 の 0 と 1 のビットがそれぞれ bv2 に含まれていなければならない．
   int nb = block_num(bv1.len());
-  for ( int i = 0; i < nb; i += 2 ) {
-    int i0 = i;
-    int i1 = i + 1;
-    PackedVal val1_0 = bv1.mPat[i0];
-    PackedVal val1_1 = bv1.mPat[i1];
-    PackedVal val2_0 = bv2.mPat[i0];
-    PackedVal val2_1 = bv2.mPat[i1];
-    if ( (val1_0 & ~val2_0) != kPvAll0 ||
-	 (val1_1 & ~val2_1) != kPvAll0 ) {
-      return false;
-    }
-  }
-  return true;
+  const PackedVal* pat1 = bv1.mPat;
+  const PackedVal* pat2 = bv2.mPat;
+  return !check_any(nb, [pat1, pat2](int i) {
+      return (pat1[i + 0] & ~pat2[i + 0]) | (pat1[i + 1] & ~pat2[i + 1]);
+    });
 }
 
 // @brief 2つのベクタが両立するとき true を返す．
@@ -156,18 +176,31 @@ BitVectorRep::is_compat(const BitVectorRep& bv1,
   ASSERT_COND( bv1.len() == bv2.len() );
 
   int nb = block_num(bv1.len());
-  for ( int i = 0; i < nb; i += 2 ) {
-    int i0 = i;
-    int i1 = i + 1;
-    // 0 のビットと 1 のビットの両方が異なっていると
-    // コンフリクトしている．
-    PackedVal diff0 = (bv1.mPat[i0] ^ bv2.mPat[i0]);
-    PackedVal diff1 = (bv1.mPat[i1] ^ bv2.mPat[i1]);
-    if ( (diff0 & diff1) != kPvAll0 ) {
-      return false;
-    }
+  return !has_conflict(bv1.mPat, bv2.mPat, nb);
+}
+
+// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+// @param[in] bv 基準となるビットベクタ
+// @param[in] bv_list 比較対象のビットベクタのリスト
+// @param[out] result 結果を格納するリスト
+//
+// result[i] に bv と bv_list[i] が両立する時 true が入る．
+void
+BitVectorRep::is_compat(const BitVectorRep& bv,
+			const vector<const BitVectorRep*>& bv_list,
+			vector<bool>& result)
+{
+  int n = bv_list.size();
+  result.clear();
+  result.resize(n, false);
+
+  int nb = block_num(bv.len());
+  const PackedVal* pat0 = bv.mPat;
+  for ( int i = 0; i < n; ++ i ) {
+    const BitVectorRep* bv1 = bv_list[i];
+    ASSERT_COND( bv1->len() == bv.len() );
+    result[i] = !has_conflict(pat0, bv1->mPat, nb);
   }
-  return true;
 }
 
 // @brief すべて未定(X) で初期化する．
@@ -280,6 +313,13 @@ BitVectorRep::set_from_hex(const string& hex_string)
     mPat[blk + 1] =  pat;
   }
 
+  // 最後のブロックの余分なビットは他の関数と同じく 0 にしておく．
+  int nb = block_num(len());
+  if ( nb > 0 ) {
+    mPat[nb - 2] &= mMask;
+    mPat[nb - 1] &= mMask;
+  }
+
   return true;
 }
 
@@ -293,22 +333,14 @@ BitVectorRep::merge(const BitVectorRep& src)
   int nb = block_num(len());
 
   // コンフリクトチェック
-  for ( int i = 0; i < nb; i += 2 ) {
-    int i0 = i;
-    int i1 = i + 1;
-    PackedVal diff0 = (mPat[i0] ^ src.mPat[i0]);
-    PackedVal diff1 = (mPat[i1] ^ src.mPat[i1]);
-    if ( (diff0 & diff1) != kPvAll0 ) {
-      return false;
-    }
+  if ( has_conflict(mPat, src.mPat, nb) ) {
+    return false;
   }
 
   // 実際のマージ
-  for ( int i = 0; i < nb; i += 2 ) {
-    int i0 = i;
-    int i1 = i + 1;
-    mPat[i0] &= src.mPat[i0];
-    mPat[i1] &= src.mPat[i1];
+  // 0 のビットと 1 のビットを区別する必要はない．
+  for ( int i = 0; i < nb; ++ i ) {
+    mPat[i] &= src.mPat[i];
   }
   return true;
 }
@@ -317,14 +349,25 @@ BitVectorRep::merge(const BitVectorRep& src)
 string
 BitVectorRep::bin_str() const
 {
+  // (0 のビット, 1 のビット) から文字への変換表
+  static const char kBinChar[4] = {
+    '-', // ありえないけどバグで起こりうる．
+    '1',
+    '0',
+    'X'
+  };
+
   // よく問題になるが，ここでは最下位ビット側から出力する．
-  string ans;
-  for ( int i = 0; i < len(); ++ i ) {
-    switch ( val(i) ) {
-    case Val3::_0: ans += '0'; break;
-    case Val3::_1: ans += '1'; break;
-    case Val3::_X: ans += 'X'; break;
-    default:       ans += '-'; break; // ありえないけどバグで起こりうる．
+  int nl = len();
+  string ans(nl, '-');
+  for ( int pos = 0, blk = 0; pos < nl; pos += kPvBitLen, blk += 2 ) {
+    PackedVal pat0 = mPat[blk + 0];
+    PackedVal pat1 = mPat[blk + 1];
+    int n = std::min(kPvBitLen, nl - pos);
+    for ( int b = 0; b < n; ++ b ) {
+      int v0 = (pat0 >> b) & 1ULL;
+      int v1 = (pat1 >> b) & 1ULL;
+      ans[pos + b] = kBinChar[v0 + v0 + v1];
     }
   }
   return ans;
@@ -334,33 +377,28 @@ BitVectorRep::bin_str() const
 string
 BitVectorRep::hex_str() const
 {
+  static const char kHexChar[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+  };
+
   // よく問題になるが，ここでは最下位ビット側から出力する．
-  int tmp = 0U;
-  int bit = 1U;
-  string ans;
-  for ( int i = 0; ; ++ i ) {
-    if ( i < len() ) {
-      if ( val(i) == Val3::_1 ) {
-	// 面倒くさいので Val3::X は Val3::_0 と同じとみなす．
-	tmp += bit;
-      }
-      bit <<= 1;
-      if ( bit != 16U ) {
-	continue;
-      }
-    }
-    else if ( bit == 1U ) {
-      break;
+  int nh = hex_length(len());
+  int nb = block_num(len());
+  string ans(nh, '0');
+  for ( int pos = 0, blk = 0; pos < nh; pos += HPW, blk += 2 ) {
+    // 面倒くさいので Val3::X は Val3::_0 と同じとみなす．
+    PackedVal v = mPat[blk + 1] & ~mPat[blk + 0];
+    if ( blk == nb - 2 ) {
+      v &= mMask;
     }
-
-    if ( tmp <= 9 ) {
-      ans += static_cast<char>('0' + tmp);
+    int n = nh - pos;
+    if ( n > HPW ) {
+      n = HPW;
     }
-    else {
-      ans += static_cast<char>('A' + tmp - 10);
+    for ( int k = 0; k < n; ++ k ) {
+      ans[pos + k] = kHexChar[(v >> (k * 4)) & 0xFULL];
     }
-    bit = 1U;
-    tmp = 0U;
   }
   return ans;
 }
@@ -76,4 +76,23 @@ merge(const vector<TestVector>& tv_list)
   return ans;
 }
 
+// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+// @param[in] tv 基準となるテストベクタ
+// @param[in] tv_list 比較対象のテストベクタのリスト
+// @param[out] result 結果を格納するリスト
+//
+// result[i] に tv と tv_list[i] が両立する時 true が入る．
+void
+is_compatible(const TestVector& tv,
+	      const vector<TestVector>& tv_list,
+	      vector<bool>& result)
+{
+  vector<const BitVector*> bv_list;
+  bv_list.reserve(tv_list.size());
+  for ( auto& tv1: tv_list ) {
+    bv_list.push_back(&tv1.mVector);
+  }
+  is_compat(tv.mVector, bv_list, result);
+}
+
 END_NAMESPACE_SATPG
@@ -0,0 +1,95 @@
+
+/// @file CfsTest.cc
+/// @brief 並行故障シミュレーションのテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <algorithm>
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class CfsTest :
+public ::testing::TestWithParam<std::tuple<string, bool>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief sppfp を行い検出された故障番号のリストを返す．
+  vector<int>
+  do_sppfp(Fsim& fsim,
+	   const TestVector& tv);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+void
+CfsTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+vector<int>
+CfsTest::do_sppfp(Fsim& fsim,
+		  const TestVector& tv)
+{
+  fsim.sppfp(tv);
+  vector<int> id_list;
+  for ( auto fault: fsim.det_fault_list() ) {
+    id_list.push_back(fault->id());
+  }
+  // 並行故障シミュレーションでは det_fault() の順序が異なる．
+  std::sort(id_list.begin(), id_list.end());
+  return id_list;
+}
+
+// 並行故障シミュレーションと通常の sppfp の結果を比べる．
+// dup.blif は同じノードが複数の入力につながっているゲートを含む．
+TEST_P(CfsTest, compare_with_sppfp)
+{
+  bool val3 = std::get<1>(GetParam());
+
+  Fsim fsim;
+  Fsim fsim_cfs;
+  if ( val3 ) {
+    fsim.init_fsim3(mNetwork, FaultType::StuckAt);
+    fsim_cfs.init_fsim3(mNetwork, FaultType::StuckAt);
+  }
+  else {
+    fsim.init_fsim2(mNetwork, FaultType::StuckAt);
+    fsim_cfs.init_fsim2(mNetwork, FaultType::StuckAt);
+  }
+  fsim_cfs.set_concurrent(true);
+
+  std::mt19937 rg;
+  TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), FaultType::StuckAt);
+  for ( int i = 0; i < 200; ++ i ) {
+    tv.set_from_random(rg);
+    auto id_list = do_sppfp(fsim, tv);
+    auto cfs_list = do_sppfp(fsim_cfs, tv);
+    EXPECT_EQ( id_list, cfs_list ) << tv.bin_str();
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(CfsTest, CfsTest,
+			::testing::Combine(::testing::Values("dup.blif", "s27.blif", "s1196.blif"),
+					   ::testing::Bool()));
+
+END_NAMESPACE_SATPG
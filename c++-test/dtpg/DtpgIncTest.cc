@@ -0,0 +1,108 @@
+
+/// @file DtpgIncTest.cc
+/// @brief DtpgInc のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFFR.h"
+#include "TpgFault.h"
+#include "Dtpg_se.h"
+#include "DtpgInc.h"
+#include "DtpgResult.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include "ym/SatSolverType.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class DtpgIncTest :
+public ::testing::TestWithParam<std::tuple<string, FaultType>>
+{
+public:
+
+  /// @brief コンストラクタ
+  DtpgIncTest();
+
+
+protected:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  // SAT ソルバの種類
+  SatSolverType mSolverType;
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+DtpgIncTest::DtpgIncTest() :
+  mSolverType("ymsat2")
+{
+}
+
+void
+DtpgIncTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+// 全ての故障に対して DtpgInc と Dtpg_se(FFRモード)の結果を比べる．
+// DtpgInc のパタンは故障シミュレーションで検証する．
+TEST_P(DtpgIncTest, compare_with_dtpg)
+{
+  FaultType fault_type = std::get<1>(GetParam());
+
+  DtpgInc dtpg_inc(mNetwork, fault_type, "just1", mSolverType);
+  Fsim fsim;
+  fsim.init_fsim3(mNetwork, fault_type);
+
+  int det_num = 0;
+  int untest_num = 0;
+  int ffr_num = 0;
+  for ( auto& ffr: mNetwork.ffr_list() ) {
+    if ( ffr.fault_num() > 0 ) {
+      ++ ffr_num;
+    }
+    Dtpg_se dtpg(mNetwork, fault_type, ffr, "just1", mSolverType);
+    for ( auto fault: ffr.fault_list() ) {
+      TestVector testvect(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+      SatBool3 ans = dtpg.dtpg(fault, testvect);
+      DtpgResult result = dtpg_inc.gen_pattern(fault);
+      if ( ans == SatBool3::True ) {
+	EXPECT_EQ( FaultStatus::Detected, result.status() ) << fault->str();
+	if ( result.status() == FaultStatus::Detected ) {
+	  EXPECT_TRUE( fsim.spsfp(result.testvector(), fault) ) << fault->str();
+	  ++ det_num;
+	}
+      }
+      else if ( ans == SatBool3::False ) {
+	EXPECT_EQ( FaultStatus::Untestable, result.status() ) << fault->str();
+	++ untest_num;
+      }
+    }
+  }
+
+  EXPECT_EQ( mNetwork.rep_fault_num(), det_num + untest_num );
+
+  // コーンは故障を持つ FFR ごとに一つしか作らない．
+  EXPECT_EQ( ffr_num, dtpg_inc.cone_num() );
+}
+
+INSTANTIATE_TEST_CASE_P(DtpgIncTest, DtpgIncTest,
+			::testing::Combine(::testing::Values("s27.blif", "s1196.blif", "s5378.blif"),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
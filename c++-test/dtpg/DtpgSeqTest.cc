@@ -0,0 +1,98 @@
+
+/// @file DtpgSeqTest.cc
+/// @brief DtpgSeq のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "DtpgSeq.h"
+#include "Fsim.h"
+#include "InputVector.h"
+#include "DffVector.h"
+#include "ym/SatSolverType.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class DtpgSeqTest :
+public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief コンストラクタ
+  DtpgSeqTest();
+
+
+protected:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  // SAT ソルバの種類
+  SatSolverType mSolverType;
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+DtpgSeqTest::DtpgSeqTest() :
+  mSolverType("ymsat2")
+{
+}
+
+void
+DtpgSeqTest::SetUp()
+{
+  string filename = DATAPATH + GetParam();
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+// 全ての故障に対してテスト系列を生成し，
+// 順序回路の故障シミュレーションで検証する．
+TEST_P(DtpgSeqTest, verify_with_seqsim)
+{
+  const int max_frame = 4;
+
+  Fsim fsim;
+  fsim.init_fsim3(mNetwork, FaultType::StuckAt);
+
+  int det_num = 0;
+  for ( auto fault: mNetwork.rep_fault_list() ) {
+    DtpgSeq dtpg(mNetwork, fault, "just1", mSolverType);
+    DffVector init_state(mNetwork.dff_num());
+    vector<InputVector> input_list;
+    SatBool3 ans = dtpg.dtpg(max_frame, init_state, input_list);
+    EXPECT_NE( SatBool3::X, ans ) << fault->str();
+    if ( ans != SatBool3::True ) {
+      continue;
+    }
+    ++ det_num;
+
+    // 検出した時刻の分だけ展開されている．
+    EXPECT_EQ( dtpg.frame_num(), static_cast<int>(input_list.size()) ) << fault->str();
+    EXPECT_LE( static_cast<int>(input_list.size()), max_frame ) << fault->str();
+
+    fsim.set_skip_all();
+    fsim.clear_skip(fault);
+    int n = fsim.seqsim(init_state, input_list);
+    EXPECT_EQ( 1, n ) << fault->str();
+    if ( n == 1 ) {
+      EXPECT_EQ( fault, fsim.det_fault(0) ) << fault->str();
+    }
+  }
+  EXPECT_LT( 0, det_num );
+}
+
+INSTANTIATE_TEST_CASE_P(DtpgSeqTest, DtpgSeqTest,
+			::testing::Values("s27.blif", "s1196.blif"));
+
+END_NAMESPACE_SATPG
@@ -11,12 +11,15 @@
 #include "Dtpg_se.h"
 #include "DtpgFFR.h"
 #include "DtpgMFFC.h"
+#include "DtpgInc.h"
+#include "DtpgMgr.h"
 
 #include "TpgMFFC.h"
 #include "TpgFFR.h"
 #include "TpgFault.h"
 #include "TestVector.h"
 #include "ym/StopWatch.h"
+#include "ym/Range.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -209,6 +212,80 @@ DtpgTest::mffc_new_test()
   return make_pair(mDetectNum, mUntestNum);
 }
 
+// @brief インクリメンタルモードのテストを行う．
+// @return 検出故障数と冗長故障数を返す．
+pair<int, int>
+DtpgTest::ffr_inc_test()
+{
+  mTimer.reset();
+  mTimer.start();
+
+  mDetectNum = 0;
+  mUntestNum = 0;
+  DtpgInc dtpg(mNetwork, mFaultType, mJustType, mSolverType);
+  for ( auto& ffr: mNetwork.ffr_list() ) {
+    for ( auto fault: ffr.fault_list() ) {
+      if ( mFaultMgr.get(fault) == FaultStatus::Undetected ) {
+	DtpgResult result = dtpg.gen_pattern(fault);
+	update_result(fault, result);
+      }
+    }
+  }
+  mStats.merge(dtpg.stats());
+
+  mTimer.stop();
+
+  int n = mVerifyResult.error_count();
+  for ( int i = 0; i < n; ++ i ) {
+    const TpgFault* f = mVerifyResult.error_fault(i);
+    TestVector tv = mVerifyResult.error_testvector(i);
+    cout << "Error: " << f->str() << " is not detected with "
+	 << tv << endl;
+  }
+  if ( n > 0 ) {
+    return make_pair(0, 0);
+  }
+
+  return make_pair(mDetectNum, mUntestNum);
+}
+
+// @brief マルチスレッドモードのテストを行う．
+// @return 検出故障数と冗長故障数を返す．
+pair<int, int>
+DtpgTest::ffr_mt_test()
+{
+  mTimer.reset();
+  mTimer.start();
+
+  DtpgMgr mgr(mNetwork, mFaultType, mJustType, mSolverType);
+  mgr.set_thread_num(4);
+  mgr.ffr_mode(mFaultMgr, false);
+
+  // 故障ドロップを行っていないので
+  // fault_list() と tv_list() は一対一に対応している．
+  auto& fault_list = mgr.fault_list();
+  auto& tv_list = mgr.tv_list();
+  for ( auto i: Range(fault_list.size()) ) {
+    mDop(fault_list[i], tv_list[i]);
+  }
+  mStats.merge(mgr.stats());
+
+  mTimer.stop();
+
+  int n = mVerifyResult.error_count();
+  for ( int i = 0; i < n; ++ i ) {
+    const TpgFault* f = mVerifyResult.error_fault(i);
+    TestVector tv = mVerifyResult.error_testvector(i);
+    cout << "Error: " << f->str() << " is not detected with "
+	 << tv << endl;
+  }
+  if ( n > 0 ) {
+    return make_pair(0, 0);
+  }
+
+  return make_pair(mgr.det_count(), mgr.untest_count());
+}
+
 // @brief 一つの故障に対する処理
 void
 DtpgTest::update_result(const TpgFault* fault,
@@ -70,6 +70,16 @@ public:
   pair<int, int>
   mffc_new_test();
 
+  /// @brief インクリメンタルモードのテストを行う．
+  /// @return 検出故障数と冗長故障数を返す．
+  pair<int, int>
+  ffr_inc_test();
+
+  /// @brief マルチスレッドモードのテストを行う．
+  /// @return 検出故障数と冗長故障数を返す．
+  pair<int, int>
+  ffr_mt_test();
+
   /// @brief 検証結果を得る．
   const DopVerifyResult&
   verify_result() const;
@@ -0,0 +1,108 @@
+
+/// @file WsaTest.cc
+/// @brief Fsim::calc_wsa() のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include "InputVector.h"
+#include "DffVector.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class WsaTest :
+public ::testing::TestWithParam<std::tuple<string, bool>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+void
+WsaTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+// ビット並列の calc_wsa() と1パタンずつの calc_wsa() の結果を比べる．
+// 3値の場合は X を含むパタンも用いる．
+TEST_P(WsaTest, compare_with_scalar)
+{
+  bool val3 = std::get<1>(GetParam());
+
+  Fsim fsim;
+  if ( val3 ) {
+    fsim.init_fsim3(mNetwork, FaultType::StuckAt);
+  }
+  else {
+    fsim.init_fsim2(mNetwork, FaultType::StuckAt);
+  }
+
+  int ni = mNetwork.input_num();
+  int nd = mNetwork.dff_num();
+
+  // FSIM_PV_BITLEN をまたぐように多めに作る．
+  const int n = 200;
+  std::mt19937 rg;
+  std::uniform_int_distribution<int> rd(0, 3);
+  vector<TestVector> tv_list(n, TestVector(ni, nd, FaultType::StuckAt));
+  for ( auto& tv: tv_list ) {
+    tv.set_from_random(rg);
+    if ( val3 ) {
+      for ( int i = 0; i < ni; ++ i ) {
+	if ( rd(rg) == 0 ) {
+	  tv.set_input_val(i, Val3::_X);
+	}
+      }
+      for ( int i = 0; i < nd; ++ i ) {
+	if ( rd(rg) == 0 ) {
+	  tv.set_dff_val(i, Val3::_X);
+	}
+      }
+    }
+  }
+
+  for ( auto weighted: { false, true } ) {
+    vector<int> wsa_list;
+    fsim.calc_wsa(tv_list, weighted, wsa_list);
+    ASSERT_EQ( n, static_cast<int>(wsa_list.size()) );
+
+    for ( int k = 0; k < n; ++ k ) {
+      const auto& tv = tv_list[k];
+      InputVector i_vect(ni);
+      for ( int i = 0; i < ni; ++ i ) {
+	i_vect.set_val(i, tv.input_val(i));
+      }
+      DffVector f_vect(nd);
+      for ( int i = 0; i < nd; ++ i ) {
+	f_vect.set_val(i, tv.dff_val(i));
+      }
+      fsim.set_state(i_vect, f_vect);
+      int wsa = fsim.calc_wsa(i_vect, weighted);
+      EXPECT_EQ( wsa, wsa_list[k] ) << tv.bin_str();
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(WsaTest, WsaTest,
+			::testing::Combine(::testing::Values("s27.blif", "s1196.blif", "s5378.blif"),
+					   ::testing::Bool()));
+
+END_NAMESPACE_SATPG
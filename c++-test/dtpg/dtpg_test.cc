@@ -180,6 +180,12 @@ DtpgTestWithParam::do_test()
   else if ( mode == "mffc_new" ) {
     num_pair = mDtpgTest->mffc_new_test();
   }
+  else if ( mode == "ffr_inc" ) {
+    num_pair = mDtpgTest->ffr_inc_test();
+  }
+  else if ( mode == "ffr_mt" ) {
+    num_pair = mDtpgTest->ffr_mt_test();
+  }
   else {
     ASSERT_NOT_REACHED;
   }
@@ -263,7 +269,8 @@ TEST_P(DtpgTestWithParam, test1)
 INSTANTIATE_TEST_CASE_P(DtpgTest, DtpgTestWithParam,
 			::testing::Combine(::testing::ValuesIn(mydata),
 					   ::testing::Values("ffr",    "ffr_new",
-							     "mffc",   "mffc_new"),
+							     "mffc",   "mffc_new",
+							     "ffr_inc", "ffr_mt"),
 					   ::testing::Values(FaultType::StuckAt, FaultType::TransitionDelay),
 					   ::testing::Values("just1", "just2")));
 
@@ -0,0 +1,182 @@
+
+/// @file CompiledGvalTest.cc
+/// @brief コンパイル方式の正常値計算のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include "GateType.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class CompiledGvalTest :
+public ::testing::TestWithParam<std::tuple<string, bool, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込んで故障シミュレータを初期化する．
+  void
+  SetUp();
+
+  /// @brief num 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns(int num);
+
+  /// @brief ppsfp を行って (故障番号, 検出パタン) のリストを返す．
+  vector<pair<int, PackedVal>>
+  do_ppsfp(Fsim& fsim,
+	   const vector<TestVector>& tv_list);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // イベントドリブンで正常値を計算する故障シミュレータ
+  Fsim mFsimE;
+
+  // コンパイル方式で正常値を計算する故障シミュレータ
+  Fsim mFsimC;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+CompiledGvalTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  bool val3 = std::get<1>(GetParam());
+  FaultType fault_type = std::get<2>(GetParam());
+  if ( val3 ) {
+    mFsimE.init_fsim3(mNetwork, fault_type, false);
+    mFsimC.init_fsim3(mNetwork, fault_type, true);
+  }
+  else {
+    mFsimE.init_fsim2(mNetwork, fault_type, false);
+    mFsimC.init_fsim2(mNetwork, fault_type, true);
+  }
+}
+
+vector<TestVector>
+CompiledGvalTest::make_patterns(int num)
+{
+  FaultType fault_type = std::get<2>(GetParam());
+  vector<TestVector> tv_list;
+  tv_list.reserve(num);
+  for ( int i = 0; i < num; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+vector<pair<int, PackedVal>>
+CompiledGvalTest::do_ppsfp(Fsim& fsim,
+			   const vector<TestVector>& tv_list)
+{
+  fsim.clear_patterns();
+  int n = tv_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    fsim.set_pattern(i, tv_list[i]);
+  }
+  fsim.ppsfp();
+
+  int nw = fsim.pv_bitlen() / kPvBitLen;
+  vector<pair<int, PackedVal>> ans_list;
+  for ( int pos = 0; pos < fsim.det_fault_num(); ++ pos ) {
+    auto f = fsim.det_fault(pos);
+    for ( int w = 0; w < nw; ++ w ) {
+      ans_list.push_back(make_pair(f->id(), fsim.det_fault_pat(pos, w)));
+    }
+  }
+  return ans_list;
+}
+
+// ppsfp の結果がイベントドリブン方式と一致するか調べる．
+TEST_P(CompiledGvalTest, ppsfp)
+{
+  int bitlen = mFsimE.pv_bitlen();
+  for ( int c = 0; c < 4; ++ c ) {
+    auto tv_list = make_patterns(bitlen);
+    EXPECT_EQ( do_ppsfp(mFsimE, tv_list), do_ppsfp(mFsimC, tv_list) );
+  }
+}
+
+// sppfp の結果がイベントドリブン方式と一致するか調べる．
+TEST_P(CompiledGvalTest, sppfp)
+{
+  auto tv_list = make_patterns(64);
+  for ( auto& tv: tv_list ) {
+    mFsimE.sppfp(tv);
+    vector<int> exp_list;
+    for ( auto f: mFsimE.det_fault_list() ) {
+      exp_list.push_back(f->id());
+    }
+
+    mFsimC.sppfp(tv);
+    vector<int> ans_list;
+    for ( auto f: mFsimC.det_fault_list() ) {
+      ans_list.push_back(f->id());
+    }
+
+    EXPECT_EQ( exp_list, ans_list ) << tv.bin_str();
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(CompiledGvalTest, CompiledGvalTest,
+			::testing::Combine(::testing::Values("dup.blif", "s27.blif", "s1196.blif",
+							     "s5378.blif", "nary.blif"),
+					   ::testing::Bool(),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+
+// nary.blif が多入力のゲートを含んでいるか調べる．
+//
+// 上のテストで多入力のゲートの命令が使われていることを保証する．
+TEST(CompiledGvalDataTest, nary_gates)
+{
+  TpgNetwork network;
+  bool stat = network.read_blif(string(DATAPATH) + "nary.blif");
+  ASSERT_TRUE( stat );
+
+  // ゲートの種類ごとの最大の入力数
+  int max_and = 0;
+  int max_nand = 0;
+  int max_or = 0;
+  int max_nor = 0;
+  for ( auto node: network.node_list() ) {
+    if ( !node->is_logic() ) {
+      continue;
+    }
+    int ni = node->fanin_num();
+    switch ( node->gate_type() ) {
+    case GateType::And:  max_and = std::max(max_and, ni); break;
+    case GateType::Nand: max_nand = std::max(max_nand, ni); break;
+    case GateType::Or:   max_or = std::max(max_or, ni); break;
+    case GateType::Nor:  max_nor = std::max(max_nor, ni); break;
+    default: break;
+    }
+  }
+  EXPECT_LE( 5, max_and );
+  EXPECT_LE( 5, max_nand );
+  EXPECT_LE( 5, max_or );
+  EXPECT_LE( 5, max_nor );
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,218 @@
+
+/// @file GradeTest.cc
+/// @brief grade のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <random>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class GradeTest :
+public ::testing::TestWithParam<std::tuple<string, bool, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込んで故障シミュレータを初期化する．
+  void
+  SetUp();
+
+  /// @brief num 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns(int num);
+
+  /// @brief 1パタンずつ sppfp を行って故障ごとの検出パタン番号のリストを作る．
+  vector<vector<int>>
+  make_exp_list(const vector<TestVector>& tv_list);
+
+  /// @brief grade を行って故障ごとの検出パタン番号のリストを作る．
+  vector<vector<int>>
+  do_grade(const vector<TestVector>& tv_list,
+	   int ndet);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 故障シミュレータ
+  Fsim mFsim;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+GradeTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  bool val3 = std::get<1>(GetParam());
+  FaultType fault_type = std::get<2>(GetParam());
+  if ( val3 ) {
+    mFsim.init_fsim3(mNetwork, fault_type);
+  }
+  else {
+    mFsim.init_fsim2(mNetwork, fault_type);
+  }
+}
+
+vector<TestVector>
+GradeTest::make_patterns(int num)
+{
+  FaultType fault_type = std::get<2>(GetParam());
+  vector<TestVector> tv_list;
+  tv_list.reserve(num);
+  for ( int i = 0; i < num; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+vector<vector<int>>
+GradeTest::make_exp_list(const vector<TestVector>& tv_list)
+{
+  vector<vector<int>> exp_list(mNetwork.max_fault_id());
+  int n = tv_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    mFsim.sppfp(tv_list[i]);
+    for ( auto f: mFsim.det_fault_list() ) {
+      exp_list[f->id()].push_back(i);
+    }
+  }
+  return exp_list;
+}
+
+vector<vector<int>>
+GradeTest::do_grade(const vector<TestVector>& tv_list,
+		    int ndet)
+{
+  vector<vector<int>> ans_list(mNetwork.max_fault_id());
+  int n_pair = mFsim.grade(tv_list,
+			   [&](const TpgFault* f, int pat_id) {
+			     ans_list[f->id()].push_back(pat_id);
+			   },
+			   ndet);
+  int n = 0;
+  for ( auto& pat_list: ans_list ) {
+    n += pat_list.size();
+  }
+  EXPECT_EQ( n, n_pair );
+  return ans_list;
+}
+
+// 連続して grade を呼んでも毎回同じパタン番号が送られるか調べる．
+TEST_P(GradeTest, repeated_grade)
+{
+  // 複数のブロックと端数のブロックができるようにする．
+  int bitlen = mFsim.pv_bitlen();
+  auto tv_list = make_patterns(bitlen * 2 + 5);
+  auto exp_list = make_exp_list(tv_list);
+
+  // 呼び出し側でスキップマークをつけた故障は送られない．
+  const TpgFault* skip_fault = nullptr;
+  // 呼び出し側で設定した目標検出回数は grade の後も有効
+  const TpgFault* target_fault = nullptr;
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( exp_list[f->id()].size() < 2 ) {
+      continue;
+    }
+    if ( skip_fault == nullptr ) {
+      skip_fault = f;
+    }
+    else if ( target_fault == nullptr ) {
+      target_fault = f;
+      break;
+    }
+  }
+  if ( skip_fault != nullptr ) {
+    mFsim.set_skip(skip_fault);
+  }
+  if ( target_fault != nullptr ) {
+    mFsim.set_det_target(target_fault, 1);
+  }
+
+  for ( int ndet: { 1, 3, 0, 1 } ) {
+    auto ans_list = do_grade(tv_list, ndet);
+    for ( auto f: mNetwork.rep_fault_list() ) {
+      vector<int> exp_pat_list;
+      if ( f != skip_fault ) {
+	exp_pat_list = exp_list[f->id()];
+	if ( ndet > 0 && static_cast<int>(exp_pat_list.size()) > ndet ) {
+	  exp_pat_list.resize(ndet);
+	}
+      }
+      EXPECT_EQ( exp_pat_list, ans_list[f->id()] )
+	<< f->str() << " ndet = " << ndet;
+    }
+  }
+
+  // grade でドロップされた故障のスキップマークは消えている．
+  // 呼び出し側のスキップマークと目標検出回数は残っている．
+  int pat_id = target_fault != nullptr ? exp_list[target_fault->id()][0] : 0;
+  mFsim.clear_det_count();
+  for ( int c = 0; c < 2; ++ c ) {
+    mFsim.sppfp(tv_list[pat_id]);
+    vector<bool> det(mNetwork.max_fault_id(), false);
+    for ( auto f: mFsim.det_fault_list() ) {
+      det[f->id()] = true;
+    }
+    for ( auto f: mNetwork.rep_fault_list() ) {
+      auto& pat_list = exp_list[f->id()];
+      bool exp = std::find(pat_list.begin(), pat_list.end(), pat_id) != pat_list.end();
+      if ( f == skip_fault || (f == target_fault && c == 1) ) {
+	exp = false;
+      }
+      EXPECT_EQ( exp, det[f->id()] ) << f->str() << " c = " << c;
+    }
+  }
+}
+
+// sink の中でつけたスキップマークは grade の後も残る．
+TEST_P(GradeTest, skip_in_sink)
+{
+  int bitlen = mFsim.pv_bitlen();
+  auto tv_list = make_patterns(bitlen + 3);
+  auto exp_list = make_exp_list(tv_list);
+
+  vector<bool> marked(mNetwork.max_fault_id(), false);
+  mFsim.grade(tv_list,
+	      [&](const TpgFault* f, int pat_id) {
+		marked[f->id()] = true;
+		mFsim.set_skip(f);
+	      });
+
+  mFsim.clear_patterns();
+  for ( int i = 0; i < bitlen; ++ i ) {
+    mFsim.set_pattern(i, tv_list[i]);
+  }
+  mFsim.ppsfp();
+  for ( auto f: mFsim.det_fault_list() ) {
+    EXPECT_FALSE( marked[f->id()] ) << f->str();
+  }
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    EXPECT_EQ( !exp_list[f->id()].empty(), marked[f->id()] ) << f->str();
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(GradeTest, GradeTest,
+			::testing::Combine(::testing::Values("s27.blif", "s1196.blif"),
+					   ::testing::Bool(),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
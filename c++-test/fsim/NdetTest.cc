@@ -0,0 +1,278 @@
+
+/// @file NdetTest.cc
+/// @brief N検出用の関数のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <random>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class NdetTest :
+public ::testing::TestWithParam<std::tuple<string, bool, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込んで故障シミュレータを初期化する．
+  void
+  SetUp();
+
+  /// @brief 故障シミュレータを初期化する．
+  void
+  init_fsim(Fsim& fsim);
+
+  /// @brief num 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns(int num);
+
+  /// @brief sppfp を行って検出された故障番号のリストを返す．
+  ///
+  /// リストは故障番号の昇順に並べる．
+  static
+  vector<int>
+  do_sppfp(Fsim& fsim,
+	   const TestVector& tv);
+
+  /// @brief ppsfp を行って故障番号をキーにした検出パタン数の配列を返す．
+  vector<int>
+  do_ppsfp(Fsim& fsim,
+	   const vector<TestVector>& tv_list);
+
+  /// @brief 全ての代表故障の検出回数が exp_count と等しいか調べる．
+  /// @param[in] exp_count 故障番号をキーにした検出回数の配列
+  void
+  check_count(Fsim& fsim,
+	      const vector<int>& exp_count);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 対象の故障シミュレータ
+  Fsim mFsim;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+NdetTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  init_fsim(mFsim);
+}
+
+void
+NdetTest::init_fsim(Fsim& fsim)
+{
+  bool val3 = std::get<1>(GetParam());
+  FaultType fault_type = std::get<2>(GetParam());
+  if ( val3 ) {
+    fsim.init_fsim3(mNetwork, fault_type);
+  }
+  else {
+    fsim.init_fsim2(mNetwork, fault_type);
+  }
+}
+
+vector<TestVector>
+NdetTest::make_patterns(int num)
+{
+  FaultType fault_type = std::get<2>(GetParam());
+  vector<TestVector> tv_list;
+  tv_list.reserve(num);
+  for ( int i = 0; i < num; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+vector<int>
+NdetTest::do_sppfp(Fsim& fsim,
+		   const TestVector& tv)
+{
+  fsim.sppfp(tv);
+  vector<int> ans_list;
+  for ( auto f: fsim.det_fault_list() ) {
+    ans_list.push_back(f->id());
+  }
+  std::sort(ans_list.begin(), ans_list.end());
+  return ans_list;
+}
+
+vector<int>
+NdetTest::do_ppsfp(Fsim& fsim,
+		   const vector<TestVector>& tv_list)
+{
+  fsim.clear_patterns();
+  int n = tv_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    fsim.set_pattern(i, tv_list[i]);
+  }
+  fsim.ppsfp();
+
+  int nw = fsim.pv_bitlen() / kPvBitLen;
+  vector<int> num_array(mNetwork.max_fault_id(), 0);
+  for ( int pos = 0; pos < fsim.det_fault_num(); ++ pos ) {
+    auto f = fsim.det_fault(pos);
+    for ( int w = 0; w < nw; ++ w ) {
+      PackedVal pat = fsim.det_fault_pat(pos, w);
+      for ( int b = 0; b < kPvBitLen; ++ b ) {
+	if ( pat & (1UL << b) ) {
+	  ++ num_array[f->id()];
+	}
+      }
+    }
+  }
+  return num_array;
+}
+
+void
+NdetTest::check_count(Fsim& fsim,
+		      const vector<int>& exp_count)
+{
+  // ヒストグラムも故障ごとの検出回数から作って比較する．
+  vector<int> exp_hist;
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    int count = exp_count[f->id()];
+    EXPECT_EQ( count, fsim.det_count(f) ) << f->str();
+    if ( static_cast<int>(exp_hist.size()) <= count ) {
+      exp_hist.resize(count + 1, 0);
+    }
+    ++ exp_hist[count];
+  }
+
+  auto hist = fsim.det_count_histogram();
+  EXPECT_EQ( exp_hist, hist );
+
+  int sum = 0;
+  for ( auto n: hist ) {
+    sum += n;
+  }
+  EXPECT_EQ( mNetwork.rep_fault_num(), sum );
+}
+
+// sppfp で数えた検出回数が det_count() と一致するか調べる．
+TEST_P(NdetTest, sppfp_count)
+{
+  vector<int> exp_count(mNetwork.max_fault_id(), 0);
+  check_count(mFsim, exp_count);
+
+  for ( auto& tv: make_patterns(100) ) {
+    for ( auto id: do_sppfp(mFsim, tv) ) {
+      ++ exp_count[id];
+    }
+  }
+  check_count(mFsim, exp_count);
+
+  // clear_det_count() で全て0に戻る．
+  mFsim.clear_det_count();
+  check_count(mFsim, vector<int>(mNetwork.max_fault_id(), 0));
+}
+
+// ppsfp で数えた検出回数が det_count() と一致するか調べる．
+TEST_P(NdetTest, ppsfp_count)
+{
+  vector<int> exp_count(mNetwork.max_fault_id(), 0);
+  int bitlen = mFsim.pv_bitlen();
+  for ( int num: { bitlen, bitlen / 2 + 1, 1 } ) {
+    auto num_array = do_ppsfp(mFsim, make_patterns(num));
+    for ( auto f: mNetwork.rep_fault_list() ) {
+      exp_count[f->id()] += num_array[f->id()];
+    }
+    check_count(mFsim, exp_count);
+  }
+}
+
+// 目標検出回数に達した故障がちょうどその時点でスキップされるか調べる．
+TEST_P(NdetTest, sppfp_target)
+{
+  // 比較用の目標検出回数を設定しない故障シミュレータ
+  Fsim ref_fsim;
+  init_fsim(ref_fsim);
+
+  auto tv_list = make_patterns(100);
+  for ( int target: { 1, 2, 5 } ) {
+    mFsim.clear_skip_all();
+    mFsim.clear_det_count();
+    mFsim.set_det_target(target);
+
+    // 故障ごとの目標検出回数を設定した場合も調べる．
+    vector<int> target_array(mNetwork.max_fault_id(), target);
+    if ( target == 5 ) {
+      for ( auto f: mNetwork.rep_fault_list() ) {
+	int t = (f->id() % 4) + 1;
+	mFsim.set_det_target(f, t);
+	target_array[f->id()] = t;
+      }
+    }
+
+    vector<int> exp_count(mNetwork.max_fault_id(), 0);
+    for ( auto& tv: tv_list ) {
+      vector<int> exp_list;
+      for ( auto id: do_sppfp(ref_fsim, tv) ) {
+	if ( exp_count[id] < target_array[id] ) {
+	  exp_list.push_back(id);
+	  ++ exp_count[id];
+	}
+      }
+      EXPECT_EQ( exp_list, do_sppfp(mFsim, tv) ) << "target = " << target;
+    }
+    check_count(mFsim, exp_count);
+  }
+}
+
+// ppsfp でも目標検出回数に達した故障が以降スキップされるか調べる．
+//
+// 1回の ppsfp の中では目標検出回数を超えて数えられる．
+TEST_P(NdetTest, ppsfp_target)
+{
+  Fsim ref_fsim;
+  init_fsim(ref_fsim);
+
+  int target = 3;
+  mFsim.set_det_target(target);
+
+  vector<int> exp_count(mNetwork.max_fault_id(), 0);
+  int bitlen = mFsim.pv_bitlen();
+  for ( int num: { 1, 1, bitlen / 2 + 1, bitlen, 1 } ) {
+    auto tv_list = make_patterns(num);
+    auto ref_array = do_ppsfp(ref_fsim, tv_list);
+    auto num_array = do_ppsfp(mFsim, tv_list);
+    for ( auto f: mNetwork.rep_fault_list() ) {
+      int id = f->id();
+      if ( exp_count[id] < target ) {
+	EXPECT_EQ( ref_array[id], num_array[id] ) << f->str();
+	exp_count[id] += ref_array[id];
+      }
+      else {
+	EXPECT_EQ( 0, num_array[id] ) << f->str();
+      }
+    }
+    check_count(mFsim, exp_count);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(NdetTest, NdetTest,
+			::testing::Combine(::testing::Values("dup.blif", "s27.blif", "s1196.blif", "s5378.blif"),
+					   ::testing::Bool(),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
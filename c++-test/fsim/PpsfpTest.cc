@@ -0,0 +1,140 @@
+/// @file PpsfpTest.cc
+/// @brief ppsfp のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class PpsfpTest :
+public ::testing::TestWithParam<std::tuple<string, bool, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込んで故障シミュレータを初期化する．
+  void
+  SetUp();
+
+  /// @brief pv_bitlen() 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns();
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 故障シミュレータ
+  Fsim mFsim;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+PpsfpTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  bool val3 = std::get<1>(GetParam());
+  FaultType fault_type = std::get<2>(GetParam());
+  if ( val3 ) {
+    mFsim.init_fsim3(mNetwork, fault_type);
+  }
+  else {
+    mFsim.init_fsim2(mNetwork, fault_type);
+  }
+}
+
+vector<TestVector>
+PpsfpTest::make_patterns()
+{
+  FaultType fault_type = std::get<2>(GetParam());
+  int bitlen = mFsim.pv_bitlen();
+  vector<TestVector> tv_list;
+  tv_list.reserve(bitlen);
+  for ( int i = 0; i < bitlen; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+// pv_bitlen() がコンパイル時に指定したワード数に一致するか調べる．
+TEST_P(PpsfpTest, pv_bitlen)
+{
+  EXPECT_EQ( kPvBitLen * PV_WORDS, mFsim.pv_bitlen() );
+}
+
+// ppsfp の検出ビットパタンが1パタンずつの sppfp の結果と一致するか調べる．
+TEST_P(PpsfpTest, compare_with_sppfp)
+{
+  int bitlen = mFsim.pv_bitlen();
+  int nw = bitlen / kPvBitLen;
+  int nf = mNetwork.max_fault_id();
+
+  for ( int c = 0; c < 2; ++ c ) {
+    auto tv_list = make_patterns();
+
+    // (故障番号 * bitlen + パタン番号) をキーにした検出の有無
+    vector<bool> exp_det(nf * bitlen, false);
+    for ( int i = 0; i < bitlen; ++ i ) {
+      mFsim.sppfp(tv_list[i]);
+      for ( auto f: mFsim.det_fault_list() ) {
+	exp_det[f->id() * bitlen + i] = true;
+      }
+    }
+
+    mFsim.clear_patterns();
+    for ( int i = 0; i < bitlen; ++ i ) {
+      mFsim.set_pattern(i, tv_list[i]);
+    }
+    mFsim.ppsfp();
+
+    vector<bool> act_det(nf * bitlen, false);
+    for ( int pos = 0; pos < mFsim.det_fault_num(); ++ pos ) {
+      auto f = mFsim.det_fault(pos);
+      bool found = false;
+      for ( int w = 0; w < nw; ++ w ) {
+	PackedVal pat = mFsim.det_fault_pat(pos, w);
+	for ( int b = 0; b < kPvBitLen; ++ b ) {
+	  if ( pat & (1ULL << b) ) {
+	    act_det[f->id() * bitlen + w * kPvBitLen + b] = true;
+	    found = true;
+	  }
+	}
+      }
+      // 検出された故障は少なくとも1つのビットが立っている．
+      EXPECT_TRUE( found ) << f->str();
+    }
+
+    for ( auto f: mNetwork.rep_fault_list() ) {
+      for ( int i = 0; i < bitlen; ++ i ) {
+	int key = f->id() * bitlen + i;
+	EXPECT_EQ( exp_det[key], act_det[key] )
+	  << f->str() << " @ " << tv_list[i].bin_str();
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(PpsfpTest, PpsfpTest,
+			::testing::Combine(::testing::Values("dup.blif", "s27.blif", "s1196.blif"),
+					   ::testing::Bool(),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
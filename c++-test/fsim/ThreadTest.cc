@@ -0,0 +1,165 @@
+
+/// @file ThreadTest.cc
+/// @brief 複数スレッドの ppsfp のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class ThreadTest :
+public ::testing::TestWithParam<std::tuple<string, bool, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief 故障シミュレータを初期化する．
+  void
+  init_fsim(Fsim& fsim);
+
+  /// @brief pv_bitlen() 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns(int bitlen);
+
+  /// @brief ppsfp を行って (故障番号, 検出パタン) のリストを返す．
+  ///
+  /// リストは det_fault() の順に並んでいる．
+  vector<pair<int, PackedVal>>
+  do_ppsfp(Fsim& fsim,
+	   const vector<TestVector>& tv_list);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+ThreadTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+void
+ThreadTest::init_fsim(Fsim& fsim)
+{
+  bool val3 = std::get<1>(GetParam());
+  FaultType fault_type = std::get<2>(GetParam());
+  if ( val3 ) {
+    fsim.init_fsim3(mNetwork, fault_type);
+  }
+  else {
+    fsim.init_fsim2(mNetwork, fault_type);
+  }
+}
+
+vector<TestVector>
+ThreadTest::make_patterns(int bitlen)
+{
+  FaultType fault_type = std::get<2>(GetParam());
+  vector<TestVector> tv_list;
+  tv_list.reserve(bitlen);
+  for ( int i = 0; i < bitlen; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+vector<pair<int, PackedVal>>
+ThreadTest::do_ppsfp(Fsim& fsim,
+		     const vector<TestVector>& tv_list)
+{
+  fsim.clear_patterns();
+  int n = tv_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    fsim.set_pattern(i, tv_list[i]);
+  }
+  fsim.ppsfp();
+
+  int nw = fsim.pv_bitlen() / kPvBitLen;
+  vector<pair<int, PackedVal>> ans_list;
+  for ( int pos = 0; pos < fsim.det_fault_num(); ++ pos ) {
+    auto f = fsim.det_fault(pos);
+    for ( int w = 0; w < nw; ++ w ) {
+      ans_list.push_back(make_pair(f->id(), fsim.det_fault_pat(pos, w)));
+    }
+  }
+  return ans_list;
+}
+
+// スレッド数によらずに同じ故障が同じ順序，同じパタンで検出されるか調べる．
+TEST_P(ThreadTest, compare_with_single)
+{
+  Fsim fsim1;
+  init_fsim(fsim1);
+  EXPECT_EQ( 1, fsim1.thread_num() );
+
+  for ( int thread_num: { 2, 3, 4, 8 } ) {
+    Fsim fsimn;
+    fsimn.set_thread_num(thread_num);
+    init_fsim(fsimn);
+    EXPECT_EQ( thread_num, fsimn.thread_num() );
+
+    for ( int c = 0; c < 3; ++ c ) {
+      auto tv_list = make_patterns(fsim1.pv_bitlen());
+      auto exp_list = do_ppsfp(fsim1, tv_list);
+      EXPECT_EQ( exp_list, do_ppsfp(fsimn, tv_list) )
+	<< "thread_num = " << thread_num;
+    }
+  }
+}
+
+// スキップマークがついていても同じ結果になるか調べる．
+TEST_P(ThreadTest, with_skip)
+{
+  Fsim fsim1;
+  Fsim fsim4;
+  init_fsim(fsim1);
+  fsim4.set_thread_num(4);
+  init_fsim(fsim4);
+
+  // 半分の故障にスキップマークをつける．
+  int pos = 0;
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( pos ++ % 2 == 0 ) {
+      fsim1.set_skip(f);
+      fsim4.set_skip(f);
+    }
+  }
+
+  // パタン数が pv_bitlen() に満たない場合も調べる．
+  int bitlen = fsim1.pv_bitlen();
+  for ( int num: { bitlen, bitlen / 2 + 1, 1 } ) {
+    auto tv_list = make_patterns(num);
+    EXPECT_EQ( do_ppsfp(fsim1, tv_list), do_ppsfp(fsim4, tv_list) )
+      << "# of patterns = " << num;
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(ThreadTest, ThreadTest,
+			::testing::Combine(::testing::Values("dup.blif", "s27.blif", "s1196.blif", "s5378.blif"),
+					   ::testing::Bool(),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
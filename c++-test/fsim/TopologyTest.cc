@@ -0,0 +1,149 @@
+
+/// @file TopologyTest.cc
+/// @brief 回路構造を共有した故障シミュレータのテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "Fsim.h"
+#include "TestVector.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class TopologyTest :
+public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief pv_bitlen() 個のランダムパタンを作る．
+  vector<TestVector>
+  make_patterns(int bitlen,
+		FaultType fault_type);
+
+  /// @brief ppsfp を行って (故障番号, 検出パタン) のリストを返す．
+  vector<pair<int, PackedVal>>
+  do_ppsfp(Fsim& fsim,
+	   const vector<TestVector>& tv_list);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+void
+TopologyTest::SetUp()
+{
+  string filename = DATAPATH + GetParam();
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+vector<TestVector>
+TopologyTest::make_patterns(int bitlen,
+			    FaultType fault_type)
+{
+  vector<TestVector> tv_list;
+  tv_list.reserve(bitlen);
+  for ( int i = 0; i < bitlen; ++ i ) {
+    TestVector tv(mNetwork.input_num(), mNetwork.dff_num(), fault_type);
+    tv.set_from_random(mRandGen);
+    tv_list.push_back(tv);
+  }
+  return tv_list;
+}
+
+vector<pair<int, PackedVal>>
+TopologyTest::do_ppsfp(Fsim& fsim,
+		       const vector<TestVector>& tv_list)
+{
+  fsim.clear_patterns();
+  int n = tv_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    fsim.set_pattern(i, tv_list[i]);
+  }
+  fsim.ppsfp();
+
+  int nw = fsim.pv_bitlen() / kPvBitLen;
+  vector<pair<int, PackedVal>> ans_list;
+  for ( int pos = 0; pos < fsim.det_fault_num(); ++ pos ) {
+    auto f = fsim.det_fault(pos);
+    for ( int w = 0; w < nw; ++ w ) {
+      ans_list.push_back(make_pair(f->id(), fsim.det_fault_pat(pos, w)));
+    }
+  }
+  return ans_list;
+}
+
+// 共有した回路構造から作った故障シミュレータの結果が
+// ネットワークから直接作ったものと一致するか調べる．
+TEST_P(TopologyTest, shared_vs_private)
+{
+  auto topology = Fsim::make_topology(mNetwork);
+
+  for ( auto fault_type: { FaultType::StuckAt, FaultType::TransitionDelay } ) {
+    for ( int val3 = 0; val3 < 2; ++ val3 ) {
+      Fsim fsim_s;
+      Fsim fsim_p;
+      if ( val3 ) {
+	fsim_s.init_fsim3(topology, fault_type);
+	fsim_p.init_fsim3(mNetwork, fault_type);
+      }
+      else {
+	fsim_s.init_fsim2(topology, fault_type);
+	fsim_p.init_fsim2(mNetwork, fault_type);
+      }
+      for ( int c = 0; c < 2; ++ c ) {
+	auto tv_list = make_patterns(fsim_s.pv_bitlen(), fault_type);
+	EXPECT_EQ( do_ppsfp(fsim_p, tv_list), do_ppsfp(fsim_s, tv_list) );
+      }
+    }
+  }
+}
+
+// 回路構造を共有していても故障ごとの状態は別々に持つか調べる．
+TEST_P(TopologyTest, independent_state)
+{
+  auto topology = Fsim::make_topology(mNetwork);
+  Fsim fsim1;
+  Fsim fsim2;
+  fsim1.init_fsim2(topology, FaultType::StuckAt);
+  fsim2.init_fsim3(topology, FaultType::StuckAt);
+
+  // fsim1 の故障を全てスキップしても fsim2 には影響しない．
+  fsim1.set_skip_all();
+  fsim1.set_det_target(3);
+
+  auto tv_list = make_patterns(fsim1.pv_bitlen(), FaultType::StuckAt);
+  EXPECT_TRUE( do_ppsfp(fsim1, tv_list).empty() );
+
+  Fsim fsim3;
+  fsim3.init_fsim3(mNetwork, FaultType::StuckAt);
+  EXPECT_EQ( do_ppsfp(fsim3, tv_list), do_ppsfp(fsim2, tv_list) );
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    EXPECT_EQ( fsim3.det_count(f), fsim2.det_count(f) );
+  }
+
+  // 回路構造の所有者が先に消えても故障シミュレータは使える．
+  topology.reset();
+  EXPECT_EQ( do_ppsfp(fsim3, tv_list), do_ppsfp(fsim2, tv_list) );
+}
+
+INSTANTIATE_TEST_CASE_P(TopologyTest, TopologyTest,
+			::testing::Values("dup.blif", "s27.blif", "s1196.blif"));
+
+END_NAMESPACE_SATPG
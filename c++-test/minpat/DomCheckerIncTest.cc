@@ -0,0 +1,143 @@
+
+/// @file DomCheckerIncTest.cc
+/// @brief DomCheckerInc のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "DomCheckerInc.h"
+#include "DomChecker.h"
+#include "UndetChecker.h"
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "TpgFFR.h"
+#include "NodeValList.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class DomCheckerIncTest :
+public ::testing::TestWithParam<std::tuple<string, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief DomCheckerInc の結果を UndetChecker, DomChecker と比較する．
+  /// @param[in] checker 対象の DomCheckerInc
+  ///
+  /// 大きな回路でも時間がかからないように故障を間引いて調べる．
+  void
+  compare(DomCheckerInc& checker);
+
+
+protected:
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 故障の種類
+  FaultType mFaultType;
+
+  // 調べる故障の間隔
+  int mStride;
+
+};
+
+void
+DomCheckerIncTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  mFaultType = std::get<1>(GetParam());
+
+  // 故障と FFR の対がおおよそ一定数になるようにする．
+  int nf = mNetwork.rep_fault_num();
+  int nffr = mNetwork.ffr_num();
+  mStride = 1;
+  while ( (nf / mStride) * (nffr / mStride) > 2000 ) {
+    ++ mStride;
+  }
+}
+
+void
+DomCheckerIncTest::compare(DomCheckerInc& checker)
+{
+  int pos1 = 0;
+  for ( auto fault1: mNetwork.rep_fault_list() ) {
+    // 全ての故障を set_undet_fault() に通して SAT ソルバの
+    // 作り直しが起こるようにする．
+    checker.set_undet_fault(fault1);
+    if ( pos1 % mStride != 0 ) {
+      checker.release_undet_fault();
+      ++ pos1;
+      continue;
+    }
+    ++ pos1;
+
+    auto root1 = fault1->tpg_onode()->ffr_root();
+    UndetChecker undet_checker(mNetwork, mFaultType, fault1);
+    int pos2 = 0;
+    for ( auto& ffr2: mNetwork.ffr_list() ) {
+      if ( ffr2.root() == root1 ) {
+	continue;
+      }
+      if ( pos2 ++ % mStride != 0 ) {
+	continue;
+      }
+      DomChecker dom_checker(mNetwork, mFaultType, ffr2.root(), fault1);
+      for ( auto fault2: ffr2.fault_list() ) {
+	SatBool3 exp_res = dom_checker.check_detectable(fault2);
+	SatBool3 res = checker.check_detectable(fault2);
+	EXPECT_EQ( exp_res, res )
+	  << "check_detectable(" << fault2->str() << ") under "
+	  << fault1->str();
+
+	if ( checker.in_undet_cone(fault2->tpg_onode()) ) {
+	  auto cond = ffr_propagate_condition(fault2, mFaultType);
+	  SatBool3 exp_ures = undet_checker.check(cond);
+	  SatBool3 ures = checker.check_undetect(cond);
+	  EXPECT_EQ( exp_ures, ures )
+	    << "check_undetect(" << fault2->str() << ") under "
+	    << fault1->str();
+	}
+      }
+    }
+    checker.release_undet_fault();
+  }
+}
+
+// UndetChecker, DomChecker と同じ結果になるか調べる．
+TEST_P(DomCheckerIncTest, compare)
+{
+  DomCheckerInc checker(mNetwork, mFaultType);
+  compare(checker);
+}
+
+// SAT ソルバを作り直した後も同じ結果になるか調べる．
+TEST_P(DomCheckerIncTest, compare_after_rebuild)
+{
+  DomCheckerInc checker(mNetwork, mFaultType);
+  checker.set_rebuild_interval(3);
+  compare(checker);
+  EXPECT_LT( 0, checker.rebuild_num() );
+
+  // 続けて2巡目を行っても結果は変わらない．
+  int n = checker.rebuild_num();
+  compare(checker);
+  EXPECT_LT( n, checker.rebuild_num() );
+}
+
+INSTANTIATE_TEST_CASE_P(DomCheckerIncTest, DomCheckerIncTest,
+			::testing::Combine(::testing::Values("s27.blif", "s1196.blif"),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+END_NAMESPACE_SATPG
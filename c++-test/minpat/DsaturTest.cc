@@ -0,0 +1,194 @@
+
+/// @file DsaturTest.cc
+/// @brief Dsatur のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "Dsatur.h"
+#include "MpColGraph.h"
+#include "TestVector.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class DsaturTest :
+public ::testing::Test
+{
+public:
+
+  /// @brief X を多く含む乱数パタンのリストを作る．
+  /// @param[in] nv パタン数
+  /// @param[in] ni 入力数
+  void
+  make_tv_list(int nv,
+	       int ni);
+
+  /// @brief 彩色結果が正しいか調べる．
+  /// @param[in] graph 彩色したグラフ
+  ///
+  /// 同じ色のパタンは全て両立していなければならない．
+  void
+  check_coloring(const MpColGraph& graph);
+
+
+protected:
+
+  // 乱数生成器
+  std::mt19937 mRandGen;
+
+  // パタンのリスト
+  vector<TestVector> mTvList;
+
+};
+
+void
+DsaturTest::make_tv_list(int nv,
+			 int ni)
+{
+  std::uniform_int_distribution<int> rd(0, 9);
+  mTvList.clear();
+  for ( int i = 0; i < nv; ++ i ) {
+    TestVector tv(ni);
+    for ( int j = 0; j < ni; ++ j ) {
+      int r = rd(mRandGen);
+      if ( r == 0 ) {
+	tv.set_input_val(j, Val3::_0);
+      }
+      else if ( r == 1 ) {
+	tv.set_input_val(j, Val3::_1);
+      }
+    }
+    mTvList.push_back(tv);
+  }
+}
+
+void
+DsaturTest::check_coloring(const MpColGraph& graph)
+{
+  int nv = mTvList.size();
+  int nc = graph.color_num();
+  for ( int i = 0; i < nv; ++ i ) {
+    int c = graph.color(i);
+    EXPECT_LE( 1, c );
+    EXPECT_GE( nc, c );
+    for ( int j = i + 1; j < nv; ++ j ) {
+      if ( graph.color(j) == c ) {
+	EXPECT_TRUE( is_compatible(mTvList[i], mTvList[j]) )
+	  << "#" << i << " and #" << j << " have the same color " << c;
+      }
+    }
+  }
+}
+
+// 全てのノードを彩色する．
+TEST_F(DsaturTest, all_nodes)
+{
+  // ノード数は PackedVal のワードをまたぐようにする．
+  make_tv_list(150, 40);
+  MpColGraph graph(mTvList);
+
+  Dsatur dsatur(graph);
+  dsatur.coloring();
+
+  check_coloring(graph);
+  EXPECT_LT( 0, graph.color_num() );
+  EXPECT_GE( static_cast<int>(mTvList.size()), graph.color_num() );
+}
+
+// 彩色済みのノードがある状態から彩色する．
+TEST_F(DsaturTest, precolored)
+{
+  make_tv_list(150, 40);
+  MpColGraph graph(mTvList);
+
+  // 先頭のノードとそれに両立するノードに色をつけておく．
+  int color = graph.new_color();
+  vector<int> node_list{0};
+  for ( int i = 1; i < static_cast<int>(mTvList.size()); ++ i ) {
+    if ( graph.compatible_check(i, node_list) ) {
+      node_list.push_back(i);
+    }
+  }
+  graph.set_color(node_list, color);
+
+  Dsatur dsatur(graph);
+  dsatur.coloring();
+
+  check_coloring(graph);
+}
+
+// 対象のノードを指定して彩色する．
+TEST_F(DsaturTest, node_list)
+{
+  make_tv_list(150, 40);
+  MpColGraph graph(mTvList);
+
+  // 奇数番目のノードは削除して対象から外す．
+  int nv = mTvList.size();
+  vector<int> node_list;
+  for ( int i = 0; i < nv; ++ i ) {
+    if ( i % 2 == 0 ) {
+      node_list.push_back(i);
+    }
+    else {
+      graph.delete_node(i);
+    }
+  }
+
+  Dsatur dsatur(graph, node_list);
+  dsatur.coloring();
+
+  for ( int i = 0; i < nv; ++ i ) {
+    int c = graph.color(i);
+    if ( i % 2 == 0 ) {
+      EXPECT_NE( 0, c );
+      for ( int j = i + 2; j < nv; j += 2 ) {
+	if ( graph.color(j) == c ) {
+	  EXPECT_TRUE( is_compatible(mTvList[i], mTvList[j]) )
+	    << "#" << i << " and #" << j << " have the same color " << c;
+	}
+      }
+    }
+    else {
+      EXPECT_EQ( 0, c );
+    }
+  }
+}
+
+// 対象外のノードを削除せずに残しておいても
+// 削除した場合と同じ彩色結果になる．
+TEST_F(DsaturTest, node_list_without_delete)
+{
+  make_tv_list(150, 40);
+  MpColGraph graph1(mTvList);
+  MpColGraph graph2(mTvList);
+
+  int nv = mTvList.size();
+  vector<int> node_list;
+  for ( int i = 0; i < nv; ++ i ) {
+    if ( i % 3 != 0 ) {
+      node_list.push_back(i);
+    }
+    else {
+      graph1.delete_node(i);
+    }
+  }
+
+  Dsatur dsatur1(graph1, node_list);
+  dsatur1.coloring();
+
+  Dsatur dsatur2(graph2, node_list);
+  dsatur2.coloring();
+
+  EXPECT_EQ( graph1.color_num(), graph2.color_num() );
+  for ( int i = 0; i < nv; ++ i ) {
+    EXPECT_EQ( graph1.color(i), graph2.color(i) ) << "#" << i;
+  }
+}
+
+END_NAMESPACE_SATPG
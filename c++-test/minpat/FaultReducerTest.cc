@@ -0,0 +1,86 @@
+
+/// @file FaultReducerTest.cc
+/// @brief FaultReducer のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "FaultReducer.h"
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class FaultReducerTest :
+public ::testing::TestWithParam<std::tuple<string, FaultType, string>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief fault_reduction() を行って残った故障の番号のリストを返す．
+  /// @param[in] thread_num スレッド数
+  vector<int>
+  do_reduction(int thread_num);
+
+
+protected:
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+void
+FaultReducerTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+vector<int>
+FaultReducerTest::do_reduction(int thread_num)
+{
+  FaultType fault_type = std::get<1>(GetParam());
+  string algorithm = std::get<2>(GetParam());
+  algorithm += ",thread:" + std::to_string(thread_num);
+
+  FaultReducer reducer(mNetwork, fault_type);
+  vector<const TpgFault*> fault_list(mNetwork.rep_fault_list().begin(),
+				     mNetwork.rep_fault_list().end());
+  reducer.fault_reduction(fault_list, algorithm);
+
+  vector<int> id_list;
+  id_list.reserve(fault_list.size());
+  for ( auto fault: fault_list ) {
+    id_list.push_back(fault->id());
+  }
+  return id_list;
+}
+
+// スレッド数によらずに同じ故障が残るか調べる．
+TEST_P(FaultReducerTest, thread_num)
+{
+  auto id_list1 = do_reduction(1);
+  auto id_list4 = do_reduction(4);
+
+  EXPECT_FALSE( id_list1.empty() );
+  EXPECT_EQ( id_list1, id_list4 );
+}
+
+INSTANTIATE_TEST_CASE_P(FaultReducerTest, FaultReducerTest,
+			::testing::Combine(::testing::Values("s1196.blif"),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay),
+					   ::testing::Values("red1", "red1:simple",
+							     "red2", "red3",
+							     "red3:simple")));
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,217 @@
+
+/// @file FaultSigTest.cc
+/// @brief FaultSig のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "FaultSig.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class FaultSigTest :
+public ::testing::Test
+{
+public:
+
+  /// @brief ワードの配列からシグネチャを作る．
+  /// @param[in] word_array ワード番号をキーにしたワードの配列
+  static
+  FaultSig
+  make_sig(const vector<PackedVal>& word_array);
+
+  /// @brief ワードの配列どうしで包含関係を調べる．
+  /// @param[in] word_array1 含まれる側のワードの配列
+  /// @param[in] word_array2 含む側のワードの配列
+  static
+  bool
+  is_contained(const vector<PackedVal>& word_array1,
+	       const vector<PackedVal>& word_array2);
+
+};
+
+FaultSig
+FaultSigTest::make_sig(const vector<PackedVal>& word_array)
+{
+  FaultSig sig;
+  int n = word_array.size();
+  for ( int wpos = 0; wpos < n; ++ wpos ) {
+    sig.add_word(wpos, word_array[wpos]);
+  }
+  return sig;
+}
+
+bool
+FaultSigTest::is_contained(const vector<PackedVal>& word_array1,
+			   const vector<PackedVal>& word_array2)
+{
+  int n = word_array1.size();
+  for ( int wpos = 0; wpos < n; ++ wpos ) {
+    PackedVal pat2 = wpos < static_cast<int>(word_array2.size()) ? word_array2[wpos] : kPvAll0;
+    if ( (word_array1[wpos] & ~pat2) != kPvAll0 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 空のシグネチャ
+TEST_F(FaultSigTest, empty)
+{
+  FaultSig sig0;
+  FaultSig sig1 = make_sig({ 0x1UL });
+
+  EXPECT_EQ( 0, sig0.word_num() );
+  EXPECT_EQ( 0, sig0.run_num() );
+  EXPECT_EQ( kPvAll0, sig0.hash() );
+
+  EXPECT_TRUE( sig0.is_contained(sig0) );
+  EXPECT_TRUE( sig0.is_contained(sig1) );
+  EXPECT_FALSE( sig1.is_contained(sig0) );
+
+  // 0 のワードは無視される．
+  sig0.add_word(3, kPvAll0);
+  EXPECT_EQ( 0, sig0.word_num() );
+  EXPECT_EQ( 0, sig0.run_num() );
+}
+
+// 連続区間の作られ方
+TEST_F(FaultSigTest, run_list)
+{
+  FaultSig sig = make_sig({ 0x1UL, 0x2UL, 0UL, 0UL, 0x3UL, 0UL, 0x4UL, 0x5UL, 0x6UL });
+
+  EXPECT_EQ( 6, sig.word_num() );
+  ASSERT_EQ( 3, sig.run_num() );
+  EXPECT_EQ( 0, sig.run_start(0) );
+  EXPECT_EQ( 2, sig.run_len(0) );
+  EXPECT_EQ( 4, sig.run_start(1) );
+  EXPECT_EQ( 1, sig.run_len(1) );
+  EXPECT_EQ( 6, sig.run_start(2) );
+  EXPECT_EQ( 3, sig.run_len(2) );
+
+  sig.clear();
+  EXPECT_EQ( 0, sig.word_num() );
+  EXPECT_EQ( 0, sig.run_num() );
+  EXPECT_EQ( kPvAll0, sig.hash() );
+}
+
+// 共通部分のないシグネチャ
+TEST_F(FaultSigTest, disjoint)
+{
+  // 同じワード番号でビットが異なる場合
+  FaultSig sig1 = make_sig({ 0x0fUL });
+  FaultSig sig2 = make_sig({ 0xf0UL });
+  EXPECT_FALSE( sig1.is_contained(sig2) );
+  EXPECT_FALSE( sig2.is_contained(sig1) );
+
+  // ワード番号が異なる場合
+  FaultSig sig3 = make_sig({ 0UL, 0UL, 0x0fUL });
+  EXPECT_FALSE( sig1.is_contained(sig3) );
+  EXPECT_FALSE( sig3.is_contained(sig1) );
+}
+
+// 一部が重なっているシグネチャ
+TEST_F(FaultSigTest, overlapping)
+{
+  FaultSig sig1 = make_sig({ 0x0fUL, 0x0fUL });
+  FaultSig sig2 = make_sig({ 0x0fUL, 0xffUL, 0x01UL });
+  FaultSig sig3 = make_sig({ 0UL, 0xffUL, 0x01UL });
+
+  EXPECT_TRUE( sig1.is_contained(sig2) );
+  EXPECT_FALSE( sig2.is_contained(sig1) );
+
+  // ワード1は含まれるがワード0が含まれない．
+  EXPECT_FALSE( sig1.is_contained(sig3) );
+  EXPECT_FALSE( sig3.is_contained(sig1) );
+}
+
+// 同一のシグネチャ
+TEST_F(FaultSigTest, identical)
+{
+  vector<PackedVal> word_array{ 0x1234UL, 0UL, kPvAll1, 0x8000000000000000UL };
+  FaultSig sig1 = make_sig(word_array);
+  FaultSig sig2 = make_sig(word_array);
+
+  EXPECT_EQ( sig1.hash(), sig2.hash() );
+  EXPECT_TRUE( sig1.is_contained(sig2) );
+  EXPECT_TRUE( sig2.is_contained(sig1) );
+  EXPECT_TRUE( sig1.is_contained(sig1) );
+}
+
+// 複数の連続区間をまたぐ包含関係
+TEST_F(FaultSigTest, multi_run)
+{
+  // sig1 の二つの区間が sig2 の一つの区間に含まれる．
+  FaultSig sig1 = make_sig({ 0UL, 0x1UL, 0UL, 0x2UL, 0UL, 0UL, 0x4UL });
+  FaultSig sig2 = make_sig({ 0x8UL, 0x1UL, 0x8UL, 0x3UL, 0UL, 0x8UL, 0x4UL, 0x8UL });
+  EXPECT_EQ( 3, sig1.run_num() );
+  EXPECT_EQ( 2, sig2.run_num() );
+  EXPECT_TRUE( sig1.is_contained(sig2) );
+  EXPECT_FALSE( sig2.is_contained(sig1) );
+
+  // sig2 の区間の隙間に sig4 のワードがある．
+  FaultSig sig4 = make_sig({ 0UL, 0x1UL, 0UL, 0UL, 0x1UL });
+  EXPECT_FALSE( sig4.is_contained(sig2) );
+
+  // sig2 の最後の区間より後ろにワードがある．
+  FaultSig sig5 = make_sig({ 0UL, 0x1UL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL, 0x1UL });
+  EXPECT_FALSE( sig5.is_contained(sig2) );
+}
+
+// ハッシュ値では含まれるが実際には含まれない場合
+TEST_F(FaultSigTest, hash_collision)
+{
+  // ワード番号だけ回転させるので (0, bit1) と (1, bit0) のハッシュ値は等しい．
+  FaultSig sig1 = make_sig({ 0x2UL });
+  FaultSig sig2 = make_sig({ 0UL, 0x1UL });
+  EXPECT_EQ( sig1.hash(), sig2.hash() );
+  EXPECT_FALSE( sig1.is_contained(sig2) );
+  EXPECT_FALSE( sig2.is_contained(sig1) );
+
+  // ワード数も同じで同じワード番号にワードがあるがビットが異なる．
+  FaultSig sig3 = make_sig({ 0x2UL, 0x1UL });
+  FaultSig sig4 = make_sig({ 0x1UL, 0x1UL });
+  EXPECT_EQ( sig4.hash() | sig3.hash(), sig4.hash() );
+  EXPECT_FALSE( sig3.is_contained(sig4) );
+}
+
+// 乱数で作ったシグネチャを単純な方法と比較する．
+TEST_F(FaultSigTest, random)
+{
+  std::mt19937 randgen;
+  std::uniform_int_distribution<int> rd_len(1, 20);
+  std::uniform_int_distribution<int> rd_kind(0, 3);
+  std::uniform_int_distribution<PackedVal> rd_pat;
+  for ( int c = 0; c < 2000; ++ c ) {
+    int n = rd_len(randgen);
+    vector<PackedVal> word_array2(n);
+    vector<PackedVal> word_array1(n);
+    for ( int wpos = 0; wpos < n; ++ wpos ) {
+      PackedVal pat2 = rd_kind(randgen) == 0 ? kPvAll0 : rd_pat(randgen);
+      word_array2[wpos] = pat2;
+      // ほとんどのワードは sig2 に含まれるようにする．
+      switch ( rd_kind(randgen) ) {
+      case 0: word_array1[wpos] = kPvAll0; break;
+      case 1: word_array1[wpos] = pat2; break;
+      case 2: word_array1[wpos] = pat2 & rd_pat(randgen); break;
+      case 3:
+	word_array1[wpos] = pat2 & rd_pat(randgen);
+	if ( rd_len(randgen) == 1 ) {
+	  word_array1[wpos] |= (1UL << (rd_pat(randgen) % kPvBitLen));
+	}
+	break;
+      }
+    }
+    FaultSig sig1 = make_sig(word_array1);
+    FaultSig sig2 = make_sig(word_array2);
+    EXPECT_EQ( is_contained(word_array1, word_array2), sig1.is_contained(sig2) );
+    EXPECT_EQ( is_contained(word_array2, word_array1), sig2.is_contained(sig1) );
+  }
+}
+
+END_NAMESPACE_SATPG
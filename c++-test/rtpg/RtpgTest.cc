@@ -0,0 +1,242 @@
+
+/// @file RtpgTest.cc
+/// @brief Rtpg のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+
+#include "Rtpg.h"
+#include "TpgNetwork.h"
+#include "TpgFault.h"
+#include "FaultStatusMgr.h"
+#include "Fsim.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class RtpgTest :
+public ::testing::TestWithParam<std::tuple<string, FaultType>>
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+  /// @brief 未検出の故障数を数える．
+  int
+  undet_num(const FaultStatusMgr& fmgr);
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+  // 故障の種類
+  FaultType mFaultType;
+
+};
+
+void
+RtpgTest::SetUp()
+{
+  string filename = DATAPATH + std::get<0>(GetParam());
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+
+  mFaultType = std::get<1>(GetParam());
+}
+
+int
+RtpgTest::undet_num(const FaultStatusMgr& fmgr)
+{
+  int n = 0;
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( fmgr.get(f) == FaultStatus::Undetected ) {
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// 検出された故障の状態が fmgr に反映されているか調べる．
+TEST_P(RtpgTest, status)
+{
+  // 半分の故障は最初から検出済みにしておく．
+  FaultStatusMgr fmgr(mNetwork);
+  int pos = 0;
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( pos ++ % 2 == 0 ) {
+      fmgr.set(f, FaultStatus::Detected);
+    }
+  }
+  FaultStatusMgr fmgr0(mNetwork);
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    fmgr0.set(f, fmgr.get(f));
+  }
+
+  Rtpg rtpg(mNetwork, mFaultType);
+  int det_num = rtpg.run(fmgr, 1, 4, 2000);
+  EXPECT_EQ( det_num, static_cast<int>(rtpg.det_fault_list().size()) );
+
+  // 検出された故障は元々未検出で，重複していない．
+  vector<bool> det_mark(mNetwork.max_fault_id(), false);
+  for ( auto f: rtpg.det_fault_list() ) {
+    EXPECT_EQ( FaultStatus::Undetected, fmgr0.get(f) ) << f->str();
+    EXPECT_EQ( FaultStatus::Detected, fmgr.get(f) ) << f->str();
+    EXPECT_FALSE( det_mark[f->id()] ) << f->str();
+    det_mark[f->id()] = true;
+  }
+
+  // それ以外の故障の状態は変わらない．
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    if ( !det_mark[f->id()] ) {
+      EXPECT_EQ( fmgr0.get(f), fmgr.get(f) ) << f->str();
+    }
+  }
+}
+
+// 残されたパタンがそれぞれある故障を最初に検出したパタンか調べる．
+TEST_P(RtpgTest, pattern)
+{
+  FaultStatusMgr fmgr(mNetwork);
+  Rtpg rtpg(mNetwork, mFaultType);
+  rtpg.run(fmgr, 1, 4, 2000);
+  EXPECT_GE( rtpg.sim_pat_num(), static_cast<int>(rtpg.pattern_list().size()) );
+
+  // 残されたパタンだけを順に故障ドロップつきでシミュレーションすると
+  // 各パタンは少なくとも一つの新しい故障を検出し，
+  // 検出される故障は run() で検出された故障と一致する．
+  Fsim fsim;
+  fsim.init_fsim2(mNetwork, mFaultType);
+  vector<bool> det_mark(mNetwork.max_fault_id(), false);
+  int det_num = 0;
+  for ( auto& tv: rtpg.pattern_list() ) {
+    int n = fsim.sppfp(tv);
+    EXPECT_LT( 0, n ) << tv.bin_str();
+    for ( auto f: fsim.det_fault_list() ) {
+      fsim.set_skip(f);
+      det_mark[f->id()] = true;
+      ++ det_num;
+    }
+  }
+  EXPECT_EQ( static_cast<int>(rtpg.det_fault_list().size()), det_num );
+  for ( auto f: rtpg.det_fault_list() ) {
+    EXPECT_TRUE( det_mark[f->id()] ) << f->str();
+  }
+}
+
+// max_pat で打ち切られるか調べる．
+TEST_P(RtpgTest, max_pat)
+{
+  FaultStatusMgr fmgr(mNetwork);
+  Rtpg rtpg(mNetwork, mFaultType);
+  int bitlen = Fsim().pv_bitlen();
+  int max_pat = bitlen * 3 + 5;
+
+  // min_f = 0 なら max_i = 0 でも打ち切られない．
+  int det_num = rtpg.run(fmgr, 0, 0, max_pat);
+  if ( det_num < mNetwork.rep_fault_num() ) {
+    EXPECT_EQ( max_pat, rtpg.sim_pat_num() );
+  }
+  else {
+    EXPECT_GE( max_pat, rtpg.sim_pat_num() );
+  }
+}
+
+// min_f を下回るブロックが max_i 回を越えて続くと打ち切られるか調べる．
+TEST_P(RtpgTest, min_f)
+{
+  FaultStatusMgr fmgr(mNetwork);
+  Rtpg rtpg(mNetwork, mFaultType);
+  int bitlen = Fsim().pv_bitlen();
+
+  // どのブロックも min_f を下回るので max_i + 1 ブロックで終わる．
+  int min_f = mNetwork.rep_fault_num() + 1;
+  for ( int max_i: { 0, 2 } ) {
+    int det_num = rtpg.run(fmgr, min_f, max_i, bitlen * 100);
+    if ( undet_num(fmgr) > 0 ) {
+      EXPECT_EQ( (max_i + 1) * bitlen, rtpg.sim_pat_num() ) << "max_i = " << max_i;
+    }
+    EXPECT_EQ( det_num, static_cast<int>(rtpg.det_fault_list().size()) );
+  }
+}
+
+// 全ての故障が検出済みなら何もしない．
+TEST_P(RtpgTest, all_detected)
+{
+  FaultStatusMgr fmgr(mNetwork);
+  for ( auto f: mNetwork.rep_fault_list() ) {
+    fmgr.set(f, FaultStatus::Detected);
+  }
+  Rtpg rtpg(mNetwork, mFaultType);
+  EXPECT_EQ( 0, rtpg.run(fmgr, 1, 4, 2000) );
+  EXPECT_EQ( 0, rtpg.sim_pat_num() );
+  EXPECT_TRUE( rtpg.pattern_list().empty() );
+}
+
+INSTANTIATE_TEST_CASE_P(RtpgTest, RtpgTest,
+			::testing::Combine(::testing::Values("s27.blif", "s1196.blif", "s5378.blif"),
+					   ::testing::Values(FaultType::StuckAt,
+							     FaultType::TransitionDelay)));
+
+
+// weight_from_cubes() で確率が [min_prob, 1 - min_prob] に丸められるか調べる．
+TEST(RtpgWeightTest, clamp)
+{
+  // 入力0 は常に 1，入力1 は常に 0，入力2 は常に X，
+  // 入力3 は 1 が 3回で 0 が 1回
+  int ni = 4;
+  vector<TestVector> cube_list;
+  for ( int c = 0; c < 100; ++ c ) {
+    TestVector tv(ni);
+    tv.set_input_val(0, Val3::_1);
+    tv.set_input_val(1, Val3::_0);
+    if ( c < 4 ) {
+      tv.set_input_val(3, c == 0 ? Val3::_0 : Val3::_1);
+    }
+    cube_list.push_back(tv);
+  }
+
+  auto prob_list = Rtpg::weight_from_cubes(cube_list, 0.05);
+  ASSERT_EQ( ni, static_cast<int>(prob_list.size()) );
+  EXPECT_DOUBLE_EQ( 0.95, prob_list[0] );
+  EXPECT_DOUBLE_EQ( 0.05, prob_list[1] );
+  EXPECT_DOUBLE_EQ( 0.5,  prob_list[2] );
+  EXPECT_DOUBLE_EQ( 4.0 / 6.0, prob_list[3] );
+
+  // 下限を上げると入力3 も丸められる．
+  prob_list = Rtpg::weight_from_cubes(cube_list, 0.4);
+  EXPECT_DOUBLE_EQ( 0.6, prob_list[0] );
+  EXPECT_DOUBLE_EQ( 0.4, prob_list[1] );
+  EXPECT_DOUBLE_EQ( 0.5, prob_list[2] );
+  EXPECT_DOUBLE_EQ( 0.6, prob_list[3] );
+
+  // 下限が 0 なら丸められない．
+  prob_list = Rtpg::weight_from_cubes(cube_list, 0.0);
+  EXPECT_DOUBLE_EQ( 101.0 / 102.0, prob_list[0] );
+  EXPECT_DOUBLE_EQ(   1.0 / 102.0, prob_list[1] );
+  EXPECT_DOUBLE_EQ( 0.5, prob_list[2] );
+  EXPECT_DOUBLE_EQ( 4.0 / 6.0, prob_list[3] );
+}
+
+// weight_from_cubes() に空のリストを与えた場合
+TEST(RtpgWeightTest, empty)
+{
+  auto prob_list = Rtpg::weight_from_cubes(vector<TestVector>());
+  EXPECT_TRUE( prob_list.empty() );
+
+  // そのまま set_weight() に渡すと一様なランダムパタンになる．
+  TpgNetwork network;
+  bool stat = network.read_blif(string(DATAPATH) + "s27.blif");
+  ASSERT_TRUE( stat );
+  Rtpg rtpg(network, FaultType::StuckAt);
+  rtpg.set_weight(vector<double>(network.input_num() + network.dff_num(), 0.5));
+  EXPECT_TRUE( rtpg.has_weight() );
+  rtpg.set_weight(prob_list);
+  EXPECT_FALSE( rtpg.has_weight() );
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,203 @@
+
+/// @file GvalProgTest.cc
+/// @brief GvalProg のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "satpg.h"
+#include "SimNode.h"
+#include "SimNodeArena.h"
+#include "SimEval.h"
+#include "GvalProg.h"
+#include "GateType.h"
+#include <random>
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_SATPG_FSIM
+
+class GvalProgTest :
+  public ::testing::Test
+{
+public:
+
+  /// @brief ランダムな回路を作る．
+  /// @param[in] ni 入力数
+  /// @param[in] ng ゲート数
+  ///
+  /// 多入力の AND/NAND/OR/NOR と 3, 4 入力の XOR/XNOR を必ず含める．
+  void
+  make_network(int ni,
+	       int ng);
+
+  /// @brief ゲートの種類から直接正常値を計算する．
+  /// @param[in] val_array ノード番号をキーにした値の配列
+  ///
+  /// calc_val() とは独立に計算した期待値を作る．
+  void
+  eval_by_type(vector<PackedVal>& val_array);
+
+
+protected:
+
+  // SimNode を確保するアリーナ
+  SimNodeArena mArena;
+
+  // 入力ノードのリスト
+  vector<SimNode*> mInputList;
+
+  // 論理ノードのリスト(トポロジカル順)
+  vector<const SimNode*> mLogicList;
+
+  // 乱数発生器
+  std::mt19937 mRandGen;
+
+};
+
+// @brief ランダムな回路を作る．
+void
+GvalProgTest::make_network(int ni,
+			   int ng)
+{
+  // (ゲートの種類, 入力数) のリスト
+  vector<pair<GateType, int>> gate_list;
+  for ( auto gate_type: { GateType::And, GateType::Nand,
+			  GateType::Or, GateType::Nor } ) {
+    for ( int n = 2; n <= 7; ++ n ) {
+      gate_list.push_back(make_pair(gate_type, n));
+    }
+  }
+  for ( auto gate_type: { GateType::Xor, GateType::Xnor } ) {
+    for ( int n = 2; n <= 4; ++ n ) {
+      gate_list.push_back(make_pair(gate_type, n));
+    }
+  }
+  gate_list.push_back(make_pair(GateType::Buff, 1));
+  gate_list.push_back(make_pair(GateType::Not, 1));
+
+  // 全ての種類を一度ずつ並べた後は乱数で選ぶ．
+  std::uniform_int_distribution<int> rd_gate(0, gate_list.size() - 1);
+  while ( static_cast<int>(gate_list.size()) < ng ) {
+    gate_list.push_back(gate_list[rd_gate(mRandGen)]);
+  }
+  std::shuffle(gate_list.begin(), gate_list.end(), mRandGen);
+
+  SizeType size = SimNodeArena::round_up(SimNode::node_size(0)) * ni;
+  for ( auto& p: gate_list ) {
+    size += SimNodeArena::round_up(SimNode::node_size(p.second));
+  }
+  mArena.init(size);
+
+  vector<SimNode*> node_list;
+  for ( int i = 0; i < ni; ++ i ) {
+    auto node = SimNode::new_input(mArena, i);
+    mInputList.push_back(node);
+    node_list.push_back(node);
+  }
+  for ( auto& p: gate_list ) {
+    // ファンインは作成済みのノードから重複しないように選ぶ．
+    int n = p.second;
+    vector<SimNode*> inputs;
+    vector<bool> used(node_list.size(), false);
+    std::uniform_int_distribution<int> rd_node(0, node_list.size() - 1);
+    while ( static_cast<int>(inputs.size()) < n ) {
+      int pos = rd_node(mRandGen);
+      if ( !used[pos] ) {
+	used[pos] = true;
+	inputs.push_back(node_list[pos]);
+      }
+    }
+    int id = node_list.size();
+    auto node = SimNode::new_gate(mArena, id, p.first, inputs);
+    EXPECT_EQ( SimNode::opcode(p.first, n), node->op() );
+    mLogicList.push_back(node);
+    node_list.push_back(node);
+  }
+}
+
+// @brief ゲートの種類から直接正常値を計算する．
+void
+GvalProgTest::eval_by_type(vector<PackedVal>& val_array)
+{
+  for ( auto node: mLogicList ) {
+    int ni = node->fanin_num();
+    PackedVal val = val_array[node->fanin_id(0)];
+    for ( int i = 1; i < ni; ++ i ) {
+      PackedVal ival = val_array[node->fanin_id(i)];
+      switch ( node->gate_type() ) {
+      case GateType::And:
+      case GateType::Nand: val &= ival; break;
+      case GateType::Or:
+      case GateType::Nor:  val |= ival; break;
+      case GateType::Xor:
+      case GateType::Xnor: val ^= ival; break;
+      default: ASSERT_NOT_REACHED;
+      }
+    }
+    switch ( node->gate_type() ) {
+    case GateType::Not:
+    case GateType::Nand:
+    case GateType::Nor:
+    case GateType::Xnor: val = ~val; break;
+    default: break;
+    }
+    val_array[node->id()] = val;
+  }
+}
+
+// コンパイルした命令列の結果が 1ノードずつの計算と一致するか調べる．
+TEST_F(GvalProgTest, compare)
+{
+  int ni = 10;
+  int ng = 200;
+  make_network(ni, ng);
+
+  // XorN, XnorN と 5入力以上の AndN などが含まれている．
+  vector<bool> op_used(static_cast<int>(SimOp::XnorN) + 1, false);
+  for ( auto node: mLogicList ) {
+    op_used[static_cast<int>(node->op())] = true;
+  }
+  for ( auto op: { SimOp::AndN, SimOp::NandN, SimOp::OrN, SimOp::NorN,
+		   SimOp::XorN, SimOp::XnorN, SimOp::And4, SimOp::Or3 } ) {
+    EXPECT_TRUE( op_used[static_cast<int>(op)] );
+  }
+
+  GvalProg prog;
+  prog.compile(mLogicList);
+
+  std::uniform_int_distribution<PackedVal> rd_val;
+  int nn = ni + ng;
+  for ( int c = 0; c < 100; ++ c ) {
+    vector<PackedVal> exp_array(nn, kPvAll0);
+    for ( int i = 0; i < ni; ++ i ) {
+      exp_array[i] = rd_val(mRandGen);
+    }
+    vector<PackedVal> val_array(exp_array);
+    eval_by_type(exp_array);
+
+    // イベントドリブン方式と同じく calc_val() で1ノードずつ計算する．
+    for ( auto node: mLogicList ) {
+      PackedVal val = calc_val(node, exp_array.data());
+      EXPECT_EQ( exp_array[node->id()], val ) << "Node#" << node->id();
+    }
+
+    prog.eval(val_array.data());
+    for ( int id = 0; id < nn; ++ id ) {
+      EXPECT_EQ( exp_array[id], val_array[id] ) << "Node#" << id;
+    }
+  }
+
+  for ( auto node: mLogicList ) {
+    node->~SimNode();
+  }
+  for ( auto node: mInputList ) {
+    node->~SimNode();
+  }
+  mArena.clear();
+}
+
+END_NAMESPACE_SATPG_FSIM
@@ -10,6 +10,8 @@
 #include "gtest/gtest.h"
 #include "satpg.h"
 #include "SimNode.h"
+#include "SimNodeArena.h"
+#include "SimEval.h"
 #include "GateType.h"
 
 
@@ -33,42 +35,29 @@ public:
 	    GateType gate_type,
 	    int vals[]);
 
-  /// @brief val の書き込み読み出しテスト
-  /// @param[in] node 対象のノード
-  /// @param[in] val 書き込む値
-  void
-  test_val(SimNode* node,
-	   PackedVal val);
 
-};
+protected:
 
-BEGIN_NONAMESPACE
+  // SimNode を確保するアリーナ
+  SimNodeArena mArena;
 
-// val を初期化する．
-void
-init_val(SimNode* node,
-	 PackedVal val)
-{
-  node->set_val(val);
-}
-
-END_NONAMESPACE
+};
 
 // @brief 入力ノードのテストを行う．
 void
 SimNodeTest::test_input()
 {
-  SimNode* node = SimNode::new_input(0);
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)));
+  SimNode* node = SimNode::new_input(mArena, 0);
 
-  // val の書き込み読み出しテスト
-  init_val(node, kPvAll1);
+  EXPECT_EQ( 0, node->id() );
+  EXPECT_EQ( SimOp::Input, node->op() );
+  EXPECT_EQ( 0, node->fanin_num() );
+  EXPECT_EQ( 0, node->level() );
 
-  test_val(node, kPvAll1);
-  test_val(node, 0x5555555555555555UL);
-  test_val(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_val(node, kPvAll0);
-
-  delete node;
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 // @brief 論理ノードのテストを行う．
@@ -81,36 +70,35 @@ SimNodeTest::test_gate(int ni,
 		       int vals[])
 {
   int np = 1 << ni;
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)) * ni +
+	      SimNodeArena::round_up(SimNode::node_size(ni)));
   vector<SimNode*> inputs(ni);
   for (int i = 0; i < ni; ++ i) {
-    inputs[i] = SimNode::new_input(i);
+    inputs[i] = SimNode::new_input(mArena, i);
   }
-  SimNode* node = SimNode::new_gate(ni, gate_type, inputs);
-
-  // val の書き込み読み出しテスト
-  init_val(node, kPvAll1);
+  SimNode* node = SimNode::new_gate(mArena, ni, gate_type, inputs);
 
-  test_val(node, kPvAll1);
-  test_val(node, 0x5555555555555555UL);
-  test_val(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_val(node, kPvAll0);
-
-  // _calc_val() のテスト
-  init_val(node, kPvAll0);
+  EXPECT_EQ( ni, node->fanin_num() );
+  EXPECT_EQ( gate_type, node->gate_type() );
+  EXPECT_EQ( 1, node->level() );
   for (int i = 0; i < ni; ++ i) {
-    init_val(inputs[i], kPvAll0);
+    EXPECT_EQ( i, node->fanin_id(i) );
   }
 
+  // 値はノード番号をキーにした配列で持つ．
+  vector<PackedVal> val_array(ni + 1, kPvAll0);
+
+  // calc_val() のテスト
   for (int p = 0; p < np; ++ p) {
     for (int i = 0; i < ni; ++ i) {
       if ( p & (1 << i) ) {
-	inputs[i]->set_val(kPvAll1);
+	val_array[i] = kPvAll1;
       }
       else {
-	inputs[i]->set_val(kPvAll0);
+	val_array[i] = kPvAll0;
       }
     }
-    PackedVal val = node->_calc_val();
+    PackedVal val = calc_val(node, val_array.data());
     if ( vals[p] ) {
       EXPECT_EQ( kPvAll1, val );
     }
@@ -121,22 +109,16 @@ SimNodeTest::test_gate(int ni,
 
   // calc_gobs() のテスト
   for (int ipos = 0; ipos < ni; ++ ipos) {
-    // ここで書き込む値に対して意味はない．
-    init_val(node, kPvAll0);
-    for (int i = 0; i < ni; ++ i) {
-      init_val(inputs[i], kPvAll0);
-    }
-
     for (int p = 0; p < np; ++ p) {
       for (int i = 0; i < ni; ++ i) {
 	if ( p & (1 << i) ) {
-	  inputs[i]->set_val(kPvAll1);
+	  val_array[i] = kPvAll1;
 	}
 	else {
-	  inputs[i]->set_val(kPvAll0);
+	  val_array[i] = kPvAll0;
 	}
       }
-      PackedVal val = node->_calc_gobs(ipos);
+      PackedVal val = calc_gobs(node, ipos, val_array.data());
       int q = p ^ (1 << ipos);
       if ( vals[p] != vals[q] ) {
 	EXPECT_EQ( kPvAll1, val );
@@ -148,20 +130,11 @@ SimNodeTest::test_gate(int ni,
   }
 
   for (int i = 0; i < ni; ++ i) {
-    delete inputs[i];
+    inputs[i]->~SimNode();
   }
-  delete node;
-}
-
-// @brief val の書き込み読み出しテスト
-// @param[in] node 対象のノード
-// @param[in] val 書き込む値
-void
-SimNodeTest::test_val(SimNode* node,
-		      PackedVal val)
-{
-  node->set_val(val);
-  EXPECT_EQ( val, node->val() );
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 TEST_F(SimNodeTest, INPUT)
@@ -10,6 +10,8 @@
 #include "gtest/gtest.h"
 #include "satpg.h"
 #include "SimNode.h"
+#include "SimNodeArena.h"
+#include "SimEval.h"
 #include "GateType.h"
 
 
@@ -33,17 +35,6 @@ public:
 	    GateType gate_type,
 	    int vals[]);
 
-  /// @brief fval の書き込み読み出しテスト
-  /// @param[in] node 対象のノード
-  /// @param[in] val0, val1 書き込む値
-  /// @param[in] exp_val0, exp_val1 期待値
-  void
-  test_val(SimNode* node,
-	   PackedVal val0,
-	   PackedVal val1,
-	   PackedVal exp_val0,
-	   PackedVal exp_val1);
-
   /// @brief 3値の検証を行う．
   /// @param[in] val0 0のワード
   /// @param[in] val1 1のワード
@@ -54,44 +45,30 @@ public:
   test_val3(PackedVal val0,
 	    PackedVal val1,
 	    int exp_val);
-};
 
-BEGIN_NONAMESPACE
 
-// gval/fval を初期化する．
-void
-init_val(SimNode* node,
-	 PackedVal val0,
-	 PackedVal val1)
-{
-  node->set_val(PackedVal3(val0, val1));
-}
+protected:
 
-END_NONAMESPACE
+  // SimNode を確保するアリーナ
+  SimNodeArena mArena;
+
+};
 
 // @brief 入力ノードのテストを行う．
 void
 SimNodeTest::test_input()
 {
-  SimNode* node = SimNode::new_input(0);
-
-  // val の書き込み読み出しテスト
-  init_val(node, kPvAll1, kPvAll1);
-
-  test_val(node,
-	   kPvAll1,              kPvAll0,
-	   kPvAll1,              kPvAll0);
-  test_val(node,
-	   0x5555555555555555UL, 0x5555555555555555UL,
-	   0x0000000000000000UL, 0x0000000000000000UL);
-  test_val(node,
-	   0xaaaaaaaaaaaaaaaaUL, 0xaaaaaaaaaaaaaaaaUL,
-	   0x0000000000000000UL, 0x0000000000000000UL);
-  test_val(node,
-	   kPvAll0,              kPvAll1,
-	   kPvAll0,              kPvAll1);
-
-  delete node;
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)));
+  SimNode* node = SimNode::new_input(mArena, 0);
+
+  EXPECT_EQ( 0, node->id() );
+  EXPECT_EQ( SimOp::Input, node->op() );
+  EXPECT_EQ( 0, node->fanin_num() );
+  EXPECT_EQ( 0, node->level() );
+
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 // @brief 論理ノードのテストを行う．
@@ -103,39 +80,29 @@ SimNodeTest::test_gate(int ni,
 		       GateType gate_type,
 		       int vals[])
 {
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)) * ni +
+	      SimNodeArena::round_up(SimNode::node_size(ni)));
   vector<SimNode*> inputs(ni);
   for (int i = 0; i < ni; ++ i) {
-    inputs[i] = SimNode::new_input(i);
+    inputs[i] = SimNode::new_input(mArena, i);
   }
-  SimNode* node = SimNode::new_gate(ni, gate_type, inputs);
-
-  // val の書き込み読み出しテスト
-  init_val(node, kPvAll1, kPvAll1);
-
-  test_val(node,
-	   kPvAll1,              kPvAll0,
-	   kPvAll1,              kPvAll0);
-  test_val(node,
-	   0x5555555555555555UL, 0x5555555555555555UL,
-	   0x0000000000000000UL, 0x0000000000000000UL);
-  test_val(node,
-	   0xaaaaaaaaaaaaaaaaUL, 0xaaaaaaaaaaaaaaaaUL,
-	   0x0000000000000000UL, 0x0000000000000000UL);
-  test_val(node,
-	   kPvAll0,              kPvAll1,
-	   kPvAll0,              kPvAll1);
+  SimNode* node = SimNode::new_gate(mArena, ni, gate_type, inputs);
 
-  int np = 1;
+  EXPECT_EQ( ni, node->fanin_num() );
+  EXPECT_EQ( gate_type, node->gate_type() );
+  EXPECT_EQ( 1, node->level() );
   for (int i = 0; i < ni; ++ i) {
-    np *= 3;
+    EXPECT_EQ( i, node->fanin_id(i) );
   }
-  // _calc_val() のテスト
-  // ここで書き込む値に対して意味はない．
-  init_val(node, kPvAll1, kPvAll1);
+
+  // 値はノード番号をキーにした配列で持つ．
+  vector<PackedVal3> val_array(ni + 1);
+
+  int np = 1;
   for (int i = 0; i < ni; ++ i) {
-    init_val(inputs[i], kPvAll1, kPvAll1);
+    np *= 3;
   }
-
+  // calc_val() のテスト
   for (int p = 0; p < np; ++ p) {
     int x = p;
     for (int i = 0; i < ni; ++ i) {
@@ -148,9 +115,9 @@ SimNodeTest::test_gate(int ni,
       case 1: val0 = kPvAll0; val1 = kPvAll1; break;
       case 2: val0 = kPvAll0; val1 = kPvAll0; break;
       }
-      init_val(inputs[i], val0, val1);
+      val_array[i] = PackedVal3(val0, val1);
     }
-    PackedVal3 val = node->_calc_val();
+    PackedVal3 val = calc_val(node, val_array.data());
     PackedVal val0 = val.val0();
     PackedVal val1 = val.val1();
     test_val3(val0, val1, vals[p]);
@@ -158,12 +125,6 @@ SimNodeTest::test_gate(int ni,
 
   // calc_gobs() のテスト
   for (int ipos = 0; ipos < ni; ++ ipos) {
-    // ここで書き込む値に対して意味はない．
-    init_val(node, kPvAll0, kPvAll1);
-    for (int i = 0; i < ni; ++ i) {
-      init_val(inputs[i], kPvAll0, kPvAll1);
-    }
-
     vector<int> ivals(ni, 0);
     for ( ; ; ) {
       int p = 0;
@@ -177,7 +138,7 @@ SimNodeTest::test_gate(int ni,
 	case 1: val0 = kPvAll0; val1 = kPvAll1; break;
 	case 2: val0 = kPvAll0; val1 = kPvAll0; break;
 	}
-	init_val(inputs[i], val0, val1);
+	val_array[i] = PackedVal3(val0, val1);
 	if ( i == ipos ) {
 	  p += 0 * w; // じつは効果なし．形式を合わせただけ
 	  q += 1 * w;
@@ -189,7 +150,7 @@ SimNodeTest::test_gate(int ni,
 	w *= 3;
       }
 
-      PackedVal val = node->_calc_gobs(ipos);
+      PackedVal val = calc_gobs(node, ipos, val_array.data());
       if ( vals[q] != vals[p] &&
 	   vals[q] != 2 &&
 	   vals[p] != 2 ) {
@@ -223,26 +184,11 @@ SimNodeTest::test_gate(int ni,
   }
 
   for (int i = 0; i < ni; ++ i) {
-    delete inputs[i];
+    inputs[i]->~SimNode();
   }
-  delete node;
-}
-
-// @brief val の書き込み読み出しテスト
-// @param[in] node 対象のノード
-// @param[in] val0, val1 書き込む値
-// @param[in] exp_val0, exp_val1 期待値
-void
-SimNodeTest::test_val(SimNode* node,
-		      PackedVal val0,
-		      PackedVal val1,
-		      PackedVal exp_val0,
-		      PackedVal exp_val1)
-{
-  // 書き込んだ値が読み出せるかテストする．
-  init_val(node, val0, val1);
-  EXPECT_EQ( exp_val0, node->val().val0() );
-  EXPECT_EQ( exp_val1, node->val().val1() );
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 // @brief 3値の検証を行う．
@@ -0,0 +1,103 @@
+
+/// @file LocalIndexMapTest.cc
+/// @brief LocalIndexMap のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "LocalIndexMap.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_SATPG
+
+// 空の状態のテスト
+TEST(LocalIndexMapTest, empty)
+{
+  LocalIndexMap index_map;
+
+  EXPECT_EQ( 0, index_map.size() );
+  for ( int key: { 0, 1, 15, 16, 1000000 } ) {
+    EXPECT_EQ( -1, index_map.find(key) );
+  }
+}
+
+// 登録した順に番号が振られるか調べる．
+TEST(LocalIndexMapTest, reg)
+{
+  LocalIndexMap index_map;
+
+  vector<int> key_list{ 10, 3, 1000000, 0, 42 };
+  int n = key_list.size();
+  for ( int i = 0; i < n; ++ i ) {
+    EXPECT_EQ( i, index_map.reg(key_list[i]) );
+  }
+  EXPECT_EQ( n, index_map.size() );
+
+  // 登録済みのキーは同じ番号を返す．
+  for ( int i = 0; i < n; ++ i ) {
+    EXPECT_EQ( i, index_map.reg(key_list[i]) );
+    EXPECT_EQ( i, index_map.find(key_list[i]) );
+  }
+  EXPECT_EQ( n, index_map.size() );
+  EXPECT_EQ( -1, index_map.find(11) );
+}
+
+// 拡大が起こっても番号が保たれるか調べる．
+TEST(LocalIndexMapTest, expand)
+{
+  LocalIndexMap index_map;
+
+  std::mt19937 randgen;
+  std::uniform_int_distribution<int> rd(0, 1000000);
+  vector<int> key_list;
+  vector<bool> used(1000001, false);
+  int n = 5000;
+  while ( static_cast<int>(key_list.size()) < n ) {
+    int key = rd(randgen);
+    if ( used[key] ) {
+      continue;
+    }
+    used[key] = true;
+    EXPECT_EQ( static_cast<int>(key_list.size()), index_map.reg(key) );
+    key_list.push_back(key);
+  }
+
+  for ( int i = 0; i < n; ++ i ) {
+    EXPECT_EQ( i, index_map.find(key_list[i]) );
+  }
+  for ( int key = 0; key < 1000; ++ key ) {
+    if ( !used[key] ) {
+      EXPECT_EQ( -1, index_map.find(key) );
+    }
+  }
+}
+
+// clear() の後で再利用できるか調べる．
+TEST(LocalIndexMapTest, clear)
+{
+  LocalIndexMap index_map(4);
+
+  for ( int key = 0; key < 100; ++ key ) {
+    index_map.reg(key * 16);
+  }
+  index_map.clear();
+
+  EXPECT_EQ( 0, index_map.size() );
+  for ( int key = 0; key < 100; ++ key ) {
+    EXPECT_EQ( -1, index_map.find(key * 16) );
+  }
+
+  // 番号は 0 から振り直される．
+  EXPECT_EQ( 0, index_map.reg(32) );
+  EXPECT_EQ( 1, index_map.reg(0) );
+  EXPECT_EQ( 0, index_map.find(32) );
+  EXPECT_EQ( 1, index_map.find(0) );
+  EXPECT_EQ( -1, index_map.find(16) );
+  EXPECT_EQ( 2, index_map.size() );
+}
+
+END_NAMESPACE_SATPG
@@ -0,0 +1,153 @@
+
+/// @file VidMapTest.cc
+/// @brief VidMap のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "VidMap.h"
+#include "TpgNetwork.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class VidMapTest :
+public ::testing::Test
+{
+public:
+
+  /// @brief ネットワークを読み込む．
+  void
+  SetUp();
+
+
+protected:
+
+  // 対象のネットワーク
+  TpgNetwork mNetwork;
+
+};
+
+void
+VidMapTest::SetUp()
+{
+  string filename = string(DATAPATH) + "s5378.blif";
+  bool stat = mNetwork.read_blif(filename);
+  ASSERT_TRUE( stat );
+}
+
+// 密なモードの初期値のテスト
+TEST_F(VidMapTest, dense_default)
+{
+  VidMap vid_map(mNetwork.node_num());
+
+  EXPECT_FALSE( vid_map.is_sparse() );
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( kSatVarIdIllegal, vid_map(node) );
+  }
+}
+
+// 疎なモードの初期値のテスト
+TEST_F(VidMapTest, sparse_default)
+{
+  VidMap vid_map;
+  vid_map.init_sparse();
+
+  EXPECT_TRUE( vid_map.is_sparse() );
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( kSatVarIdIllegal, vid_map(node) );
+  }
+}
+
+// 全てのノードに設定した場合に密なモードと疎なモードが一致することのテスト
+// 疎なモードはハッシュ表の拡大が何度も起こる．
+TEST_F(VidMapTest, dense_vs_sparse_all)
+{
+  VidMap dense_map(mNetwork.node_num());
+  VidMap sparse_map;
+  sparse_map.init_sparse();
+
+  for ( auto node: mNetwork.node_list() ) {
+    dense_map.set_vid(node, SatVarId(node->id()));
+    sparse_map.set_vid(node, SatVarId(node->id()));
+  }
+
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( SatVarId(node->id()), dense_map(node) );
+    EXPECT_EQ( dense_map(node), sparse_map(node) );
+  }
+}
+
+// 一部のノードにだけ設定した場合のテスト
+// 設定していないノードは kSatVarIdIllegal のままであること．
+TEST_F(VidMapTest, dense_vs_sparse_partial)
+{
+  VidMap dense_map(mNetwork.node_num());
+  VidMap sparse_map;
+  sparse_map.init_sparse(4);
+
+  for ( auto node: mNetwork.node_list() ) {
+    if ( node->id() % 3 == 0 ) {
+      dense_map.set_vid(node, SatVarId(node->id() * 2));
+      sparse_map.set_vid(node, SatVarId(node->id() * 2));
+    }
+  }
+
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( dense_map(node), sparse_map(node) );
+    if ( node->id() % 3 != 0 ) {
+      EXPECT_EQ( kSatVarIdIllegal, sparse_map(node) );
+    }
+  }
+}
+
+// 同じノードに再設定した場合のテスト
+TEST_F(VidMapTest, overwrite)
+{
+  VidMap dense_map(mNetwork.node_num());
+  VidMap sparse_map;
+  sparse_map.init_sparse();
+
+  for ( auto node: mNetwork.node_list() ) {
+    dense_map.set_vid(node, SatVarId(1));
+    sparse_map.set_vid(node, SatVarId(1));
+  }
+  for ( auto node: mNetwork.node_list() ) {
+    dense_map.set_vid(node, SatVarId(node->id() + 10));
+    sparse_map.set_vid(node, SatVarId(node->id() + 10));
+  }
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( SatVarId(node->id() + 10), dense_map(node) );
+    EXPECT_EQ( SatVarId(node->id() + 10), sparse_map(node) );
+  }
+}
+
+// 初期化し直した場合のテスト
+TEST_F(VidMapTest, reinit)
+{
+  VidMap vid_map;
+  vid_map.init_sparse();
+  for ( auto node: mNetwork.node_list() ) {
+    vid_map.set_vid(node, SatVarId(node->id()));
+  }
+
+  // 密なモードで初期化し直すと全て kSatVarIdIllegal になる．
+  vid_map.init(mNetwork.node_num());
+  EXPECT_FALSE( vid_map.is_sparse() );
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( kSatVarIdIllegal, vid_map(node) );
+    vid_map.set_vid(node, SatVarId(node->id()));
+  }
+
+  // 疎なモードで初期化し直すと全て kSatVarIdIllegal になる．
+  vid_map.init_sparse();
+  EXPECT_TRUE( vid_map.is_sparse() );
+  for ( auto node: mNetwork.node_list() ) {
+    EXPECT_EQ( kSatVarIdIllegal, vid_map(node) );
+  }
+}
+
+END_NAMESPACE_SATPG
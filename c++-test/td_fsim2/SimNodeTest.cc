@@ -1,6 +1,6 @@
 
-/// @file SimNodeTest.cc
-/// @brief SimNodeTest の実装ファイル
+/// @file SimNode2Test.cc
+/// @brief SimNode2Test の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
 /// Copyright (C) 2016 Yusuke Matsunaga
@@ -10,10 +10,12 @@
 #include "gtest/gtest.h"
 #include "satpg.h"
 #include "SimNode.h"
+#include "SimNodeArena.h"
+#include "SimEval.h"
 #include "GateType.h"
 
 
-BEGIN_NAMESPACE_SATPG_FSIM2
+BEGIN_NAMESPACE_SATPG_FSIM
 
 class SimNodeTest :
   public ::testing::Test
@@ -33,74 +35,29 @@ public:
 	    GateType gate_type,
 	    int vals[]);
 
-  /// @brief hval の書き込み読み出しテスト
-  /// @param[in] node 対象のノード
-  /// @param[in] val 書き込む値
-  void
-  test_hval(SimNode* node,
-	    PackedVal val);
 
-  /// @brief gval の書き込み読み出しテスト
-  /// @param[in] node 対象のノード
-  /// @param[in] val 書き込む値
-  void
-  test_gval(SimNode* node,
-	    PackedVal val);
+protected:
 
-  /// @brief fval の書き込み読み出しテスト
-  /// @param[in] node 対象のノード
-  /// @param[in] val 書き込む値
-  void
-  test_fval(SimNode* node,
-	    PackedVal val);
+  // SimNode を確保するアリーナ
+  SimNodeArena mArena;
 
 };
 
-BEGIN_NONAMESPACE
-
-// gval/fval を初期化する．
-void
-init_val(SimNode* node,
-	 PackedVal val)
-{
-  node->set_hval(val);
-  node->set_gval(val);
-  node->set_fval(val);
-}
-
-END_NONAMESPACE
-
 // @brief 入力ノードのテストを行う．
 void
 SimNodeTest::test_input()
 {
-  SimNode* node = SimNode::new_input(0);
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)));
+  SimNode* node = SimNode::new_input(mArena, 0);
 
-  // hval の書き込み読み出しテスト
-  init_val(node, kPvAll0);
+  EXPECT_EQ( 0, node->id() );
+  EXPECT_EQ( SimOp::Input, node->op() );
+  EXPECT_EQ( 0, node->fanin_num() );
+  EXPECT_EQ( 0, node->level() );
 
-  test_hval(node, kPvAll1);
-  test_hval(node, 0x5555555555555555UL);
-  test_hval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_hval(node, kPvAll0);
-
-  // gval の書き込み読み出しテスト
-  init_val(node, kPvAll0);
-
-  test_gval(node, kPvAll1);
-  test_gval(node, 0x5555555555555555UL);
-  test_gval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_gval(node, kPvAll0);
-
-  // fval の書き込み読み出しテスト
-  init_val(node, kPvAll1);
-
-  test_fval(node, kPvAll1);
-  test_fval(node, 0x5555555555555555UL);
-  test_fval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_fval(node, kPvAll0);
-
-  delete node;
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 // @brief 論理ノードのテストを行う．
@@ -112,178 +69,72 @@ SimNodeTest::test_gate(int ni,
 		       GateType gate_type,
 		       int vals[])
 {
+  int np = 1 << ni;
+  mArena.init(SimNodeArena::round_up(SimNode::node_size(0)) * ni +
+	      SimNodeArena::round_up(SimNode::node_size(ni)));
   vector<SimNode*> inputs(ni);
   for (int i = 0; i < ni; ++ i) {
-    inputs[i] = SimNode::new_input(i);
+    inputs[i] = SimNode::new_input(mArena, i);
   }
-  SimNode* node = SimNode::new_node(ni, gate_type, inputs);
-
-  int np = 1 << ni;
-
-  // hval の書き込み読み出しテスト
-  init_val(node, kPvAll0);
+  SimNode* node = SimNode::new_gate(mArena, ni, gate_type, inputs);
 
-  test_hval(node, kPvAll1);
-  test_hval(node, 0x5555555555555555UL);
-  test_hval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_hval(node, kPvAll0);
-
-  // gval の書き込み読み出しテスト
-  init_val(node, kPvAll0);
-
-  test_gval(node, kPvAll1);
-  test_gval(node, 0x5555555555555555UL);
-  test_gval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_gval(node, kPvAll0);
-
-  // fval の書き込み読み出しテスト
-  init_val(node, kPvAll1);
-
-  test_fval(node, kPvAll1);
-  test_fval(node, 0x5555555555555555UL);
-  test_fval(node, 0xaaaaaaaaaaaaaaaaUL);
-  test_fval(node, kPvAll0);
-
-  // _calc_hval() のテスト
-  // ここで書き込む値に対して意味はない．
-  init_val(node, kPvAll0);
+  EXPECT_EQ( ni, node->fanin_num() );
+  EXPECT_EQ( gate_type, node->gate_type() );
+  EXPECT_EQ( 1, node->level() );
   for (int i = 0; i < ni; ++ i) {
-    init_val(inputs[i], kPvAll0);
+    EXPECT_EQ( i, node->fanin_id(i) );
   }
 
-  for (int p = 0; p < np; ++ p) {
-    for (int i = 0; i < ni; ++ i) {
-      if ( p & (1 << i) ) {
-	inputs[i]->set_hval(kPvAll1);
-      }
-      else {
-	inputs[i]->set_hval(kPvAll0);
-      }
-    }
-    PackedVal val = node->_calc_hval();
-    if ( vals[p] ) {
-      EXPECT_EQ( val, kPvAll1 );
-    }
-    else {
-      EXPECT_EQ( val, kPvAll0 );
-    }
-  }
-
-  // _calc_gval() のテスト
-  // ここで書き込む値に対して意味はない．
-  init_val(node, kPvAll0);
-  for (int i = 0; i < ni; ++ i) {
-    init_val(inputs[i], kPvAll0);
-  }
-
-  for (int p = 0; p < np; ++ p) {
-    for (int i = 0; i < ni; ++ i) {
-      if ( p & (1 << i) ) {
-	inputs[i]->set_gval(kPvAll1);
-      }
-      else {
-	inputs[i]->set_gval(kPvAll0);
-      }
-    }
-    PackedVal val = node->_calc_gval();
-    if ( vals[p] ) {
-      EXPECT_EQ( val, kPvAll1 );
-    }
-    else {
-      EXPECT_EQ( val, kPvAll0 );
-    }
-  }
-
-  // _calc_fval() のテスト
-  // ここで書き込む値に対して意味はない．
-  init_val(node, kPvAll1);
-  for (int i = 0; i < ni; ++ i) {
-    init_val(inputs[i], kPvAll1);
-  }
+  // 値はノード番号をキーにした配列で持つ．
+  vector<PackedVal> val_array(ni + 1, kPvAll0);
 
+  // calc_val() のテスト
   for (int p = 0; p < np; ++ p) {
     for (int i = 0; i < ni; ++ i) {
       if ( p & (1 << i) ) {
-	inputs[i]->set_fval(kPvAll1);
+	val_array[i] = kPvAll1;
       }
       else {
-	inputs[i]->set_fval(kPvAll0);
+	val_array[i] = kPvAll0;
       }
     }
-    PackedVal val = node->_calc_fval();
+    PackedVal val = calc_val(node, val_array.data());
     if ( vals[p] ) {
-      EXPECT_EQ( val, kPvAll1 );
+      EXPECT_EQ( kPvAll1, val );
     }
     else {
-      EXPECT_EQ( val, kPvAll0 );
+      EXPECT_EQ( kPvAll0, val );
     }
   }
 
   // calc_gobs() のテスト
   for (int ipos = 0; ipos < ni; ++ ipos) {
-    // ここで書き込む値に対して意味はない．
-    init_val(node, kPvAll0);
-    for (int i = 0; i < ni; ++ i) {
-      init_val(inputs[i], kPvAll0);
-    }
-
     for (int p = 0; p < np; ++ p) {
       for (int i = 0; i < ni; ++ i) {
 	if ( p & (1 << i) ) {
-	  inputs[i]->set_gval(kPvAll1);
+	  val_array[i] = kPvAll1;
 	}
 	else {
-	  inputs[i]->set_gval(kPvAll0);
+	  val_array[i] = kPvAll0;
 	}
       }
-      PackedVal val = node->calc_gobs(ipos);
+      PackedVal val = calc_gobs(node, ipos, val_array.data());
       int q = p ^ (1 << ipos);
       if ( vals[p] != vals[q] ) {
-	EXPECT_EQ( val, kPvAll1 );
+	EXPECT_EQ( kPvAll1, val );
       }
       else {
-	EXPECT_EQ( val, kPvAll0 );
+	EXPECT_EQ( kPvAll0, val );
       }
     }
   }
 
   for (int i = 0; i < ni; ++ i) {
-    delete inputs[i];
+    inputs[i]->~SimNode();
   }
-  delete node;
-}
-
-// @brief hval の書き込み読み出しテスト
-// @param[in] node 対象のノード
-// @param[in] val 書き込む値
-void
-SimNodeTest::test_hval(SimNode* node,
-		       PackedVal val)
-{
-  node->set_hval(val);
-  EXPECT_EQ( node->hval(), val );
-}
-
-// @brief gval の書き込み読み出しテスト
-// @param[in] node 対象のノード
-// @param[in] val 書き込む値
-void
-SimNodeTest::test_gval(SimNode* node,
-		       PackedVal val)
-{
-  node->set_gval(val);
-  EXPECT_EQ( node->gval(), val );
-}
-
-// @brief fval の書き込み読み出しテスト
-// @param[in] node 対象のノード
-// @param[in] val 書き込む値
-void
-SimNodeTest::test_fval(SimNode* node,
-		       PackedVal val)
-{
-  node->set_fval(val);
-  EXPECT_EQ( node->fval(), val );
+  // 領域そのものは mArena がまとめて解放する．
+  node->~SimNode();
+  mArena.clear();
 }
 
 TEST_F(SimNodeTest, INPUT)
@@ -735,4 +586,4 @@ TEST_F(SimNodeTest, XNOR3)
   test_gate(3, GateType::Xnor, vals);
 }
 
-END_NAMESPACE_SATPG_FSIM2
+END_NAMESPACE_SATPG_FSIM
@@ -342,6 +342,59 @@ TEST(BitVectorTest, uniq_set_from_random)
   }
 }
 
+// 重み付きの set_from_random のテスト (確率 0.0 と 1.0)
+//
+// 最後のブロックが途中で終わる長さも調べる．
+TEST(BitVectorTest, set_from_random_weight)
+{
+  std::mt19937 rg;
+  for ( int len: { 1, 63, 64, 65, 100, 128, 130 } ) {
+    BitVector bv(len);
+
+    bv.set_from_random(rg, vector<double>(len, 0.0));
+    EXPECT_EQ( BitVector::from_bin_str(string(len, '0')), bv ) << "len = " << len;
+    EXPECT_EQ( 0, bv.x_count() );
+
+    bv.set_from_random(rg, vector<double>(len, 1.0));
+    EXPECT_EQ( BitVector::from_bin_str(string(len, '1')), bv ) << "len = " << len;
+    EXPECT_EQ( 0, bv.x_count() );
+
+    // 3ビットごとに1を置く．
+    vector<double> prob_list(len);
+    string exp_str(len, '0');
+    for ( int i = 0; i < len; ++ i ) {
+      if ( i % 3 == 1 ) {
+	prob_list[i] = 1.0;
+	exp_str[i] = '1';
+      }
+      else {
+	prob_list[i] = 0.0;
+      }
+    }
+    bv.set_from_random(rg, prob_list);
+    for ( int i = 0; i < len; ++ i ) {
+      EXPECT_EQ( i % 3 == 1 ? Val3::_1 : Val3::_0, bv.val(i) )
+	<< "len = " << len << ", i = " << i;
+    }
+    EXPECT_EQ( exp_str, bv.bin_str() );
+  }
+}
+
+// 重み付きの set_from_random で uniquefy されるかのテスト
+TEST(BitVectorTest, uniq_set_from_random_weight)
+{
+  int len = 70;
+  BitVector bv0(len);
+  BitVector bv1(bv0);
+
+  std::mt19937 rg;
+  bv1.set_from_random(rg, vector<double>(len, 1.0));
+
+  // bv0 が元のまま(全て X)であることを確認．
+  EXPECT_EQ( len, bv0.x_count() );
+  EXPECT_EQ( 0, bv1.x_count() );
+}
+
 // && のテスト
 TEST(BitVectorTest, compat)
 {
@@ -437,4 +490,208 @@ TEST(BitVectorTest, merge)
   EXPECT_EQ( bv3, bv4 );
 }
 
+BEGIN_NONAMESPACE
+
+// 64 の倍数でない長さを含むテスト用のベクタ長
+const int kLenList[] = { 1, 4, 63, 64, 65, 100, 128, 130, 257, 520 };
+
+// 0, 1, X をランダムに設定したベクタを作る．
+BitVector
+random_vector(int len,
+	      std::mt19937& rg)
+{
+  std::uniform_int_distribution<int> rd(0, 2);
+  BitVector bv(len);
+  for ( int i = 0; i < len; ++ i ) {
+    switch ( rd(rg) ) {
+    case 0: bv.set_val(i, Val3::_0); break;
+    case 1: bv.set_val(i, Val3::_1); break;
+    case 2: bv.set_val(i, Val3::_X); break;
+    }
+  }
+  return bv;
+}
+
+// val() を用いて BIN 形式の文字列を作る．
+string
+ref_bin_str(const BitVector& bv)
+{
+  string ans;
+  for ( int i = 0; i < bv.len(); ++ i ) {
+    switch ( bv.val(i) ) {
+    case Val3::_0: ans += '0'; break;
+    case Val3::_1: ans += '1'; break;
+    case Val3::_X: ans += 'X'; break;
+    }
+  }
+  return ans;
+}
+
+// val() を用いて HEX 形式の文字列を作る．
+// X は 0 とみなす．
+string
+ref_hex_str(const BitVector& bv)
+{
+  static const char kHexChar[] = "0123456789ABCDEF";
+  string ans;
+  for ( int i = 0; i < bv.len(); i += 4 ) {
+    int v = 0;
+    for ( int k = 0; k < 4 && i + k < bv.len(); ++ k ) {
+      if ( bv.val(i + k) == Val3::_1 ) {
+	v |= (1 << k);
+      }
+    }
+    ans += kHexChar[v];
+  }
+  return ans;
+}
+
+// val() を用いて両立関係を調べる．
+bool
+ref_compat(const BitVector& bv1,
+	   const BitVector& bv2)
+{
+  for ( int i = 0; i < bv1.len(); ++ i ) {
+    auto v1 = bv1.val(i);
+    auto v2 = bv2.val(i);
+    if ( v1 != Val3::_X && v2 != Val3::_X && v1 != v2 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// val() を用いて bv1 が bv2 に含まれるか調べる．
+bool
+ref_le(const BitVector& bv1,
+       const BitVector& bv2)
+{
+  for ( int i = 0; i < bv1.len(); ++ i ) {
+    auto v2 = bv2.val(i);
+    if ( v2 != Val3::_X && bv1.val(i) != v2 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+// 様々な長さの bin_str() のテスト
+TEST(BitVectorTest, bin_str_long)
+{
+  std::mt19937 rg(1);
+  for ( int len: kLenList ) {
+    for ( int c = 0; c < 10; ++ c ) {
+      auto bv = random_vector(len, rg);
+      EXPECT_EQ( ref_bin_str(bv), bv.bin_str() ) << "len = " << len;
+
+      // from_bin_str() で元に戻ること
+      auto bv2 = BitVector::from_bin_str(bv.bin_str());
+      EXPECT_EQ( bv, bv2 ) << "len = " << len;
+    }
+  }
+}
+
+// 様々な長さの hex_str() のテスト
+// X を含む場合も X を 0 とみなした値が出力される．
+TEST(BitVectorTest, hex_str_long)
+{
+  std::mt19937 rg(2);
+  for ( int len: kLenList ) {
+    for ( int c = 0; c < 10; ++ c ) {
+      auto bv = random_vector(len, rg);
+      EXPECT_EQ( ref_hex_str(bv), bv.hex_str() ) << "len = " << len;
+    }
+
+    // 全て 1 の場合は最後のブロックの余分なビットが出力されないこと
+    BitVector bv1(len);
+    for ( int i = 0; i < len; ++ i ) {
+      bv1.set_val(i, Val3::_1);
+    }
+    EXPECT_EQ( ref_hex_str(bv1), bv1.hex_str() ) << "len = " << len;
+
+    // X を含まない場合は from_hex_str() で元に戻ること
+    auto bv2 = BitVector::from_hex_str(len, bv1.hex_str());
+    EXPECT_EQ( bv1, bv2 ) << "len = " << len;
+  }
+}
+
+// 様々な長さの < と <= のテスト
+TEST(BitVectorTest, less_than_long)
+{
+  std::mt19937 rg(3);
+  std::uniform_int_distribution<int> rd(0, 3);
+  for ( int len: kLenList ) {
+    for ( int c = 0; c < 20; ++ c ) {
+      // bv2 は bv1 のいくつかのビットを X にしたもの
+      auto bv1 = random_vector(len, rg);
+      BitVector bv2(bv1);
+      for ( int i = 0; i < len; ++ i ) {
+	if ( rd(rg) == 0 ) {
+	  bv2.set_val(i, Val3::_X);
+	}
+      }
+      bool eq = (ref_bin_str(bv1) == ref_bin_str(bv2));
+      EXPECT_TRUE( bv1 <= bv2 ) << "len = " << len;
+      EXPECT_EQ( !eq, bv1 < bv2 ) << "len = " << len;
+      EXPECT_EQ( eq, bv2 <= bv1 ) << "len = " << len;
+      EXPECT_FALSE( bv2 < bv1 ) << "len = " << len;
+
+      // 最後のビットだけを反転して包含関係を壊す．
+      BitVector bv3(bv1);
+      int pos = len - 1;
+      bv3.set_val(pos, bv1.val(pos) == Val3::_0 ? Val3::_1 : Val3::_0);
+      EXPECT_EQ( ref_le(bv3, bv2), bv3 <= bv2 ) << "len = " << len;
+      EXPECT_EQ( ref_le(bv3, bv2) && !(bv3 == bv2), bv3 < bv2 ) << "len = " << len;
+    }
+  }
+}
+
+// 様々な長さの && と一括版 is_compat() のテスト
+TEST(BitVectorTest, compat_long)
+{
+  std::mt19937 rg(4);
+  std::uniform_int_distribution<int> rd(0, 7);
+  for ( int len: kLenList ) {
+    auto bv0 = random_vector(len, rg);
+    vector<BitVector> bv_list;
+    for ( int c = 0; c < 30; ++ c ) {
+      // 半分程度が両立するように bv0 の一部を X にしたものを混ぜる．
+      if ( c % 2 == 0 ) {
+	BitVector bv(bv0);
+	for ( int i = 0; i < len; ++ i ) {
+	  if ( rd(rg) == 0 ) {
+	    bv.set_val(i, Val3::_X);
+	  }
+	}
+	bv_list.push_back(bv);
+      }
+      else {
+	bv_list.push_back(random_vector(len, rg));
+      }
+    }
+    // 最後のビットだけが衝突するベクタ
+    {
+      BitVector bv(len);
+      auto v = bv0.val(len - 1);
+      bv.set_val(len - 1, v == Val3::_0 ? Val3::_1 : Val3::_0);
+      bv_list.push_back(bv);
+    }
+
+    vector<const BitVector*> ptr_list;
+    for ( auto& bv: bv_list ) {
+      ptr_list.push_back(&bv);
+    }
+    vector<bool> result;
+    is_compat(bv0, ptr_list, result);
+    ASSERT_EQ( bv_list.size(), result.size() );
+    for ( int i = 0; i < static_cast<int>(bv_list.size()); ++ i ) {
+      bool exp = ref_compat(bv0, bv_list[i]);
+      EXPECT_EQ( exp, (bv0 && bv_list[i]) ) << "len = " << len << ", i = " << i;
+      EXPECT_EQ( exp, result[i] ) << "len = " << len << ", i = " << i;
+    }
+  }
+}
+
 END_NAMESPACE_SATPG
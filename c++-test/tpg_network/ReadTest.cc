@@ -0,0 +1,213 @@
+
+/// @file ReadTest.cc
+/// @brief TpgNetwork の読み込みのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "TpgDff.h"
+#include "ym/BnNetwork.h"
+#include "ym/ClibCellLibrary.h"
+#include "ym/Range.h"
+#include <fstream>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class ReadTest :
+  public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief 2つのネットワークの PPI/PPO の順序と各ゲートのファンインが等しいか調べる．
+  static
+  void
+  check_network(const TpgNetwork& network1,
+		const TpgNetwork& network2);
+
+  /// @brief node1 と node2 を根とするファンインコーンが等しいか調べる．
+  /// @param[inout] id_map network1 のノード番号をキーにして対応する
+  /// network2 のノード番号を入れる配列
+  static
+  void
+  check_node(const TpgNode* node1,
+	     const TpgNode* node2,
+	     vector<int>& id_map);
+
+};
+
+// @brief 2つのネットワークの PPI/PPO の順序と各ゲートのファンインが等しいか調べる．
+void
+ReadTest::check_network(const TpgNetwork& network1,
+			const TpgNetwork& network2)
+{
+  ASSERT_EQ( network1.node_num(), network2.node_num() );
+  ASSERT_EQ( network1.ppi_num(), network2.ppi_num() );
+  ASSERT_EQ( network1.ppo_num(), network2.ppo_num() );
+
+  // PPI は名前と順序が一致する．
+  vector<int> id_map(network1.node_num(), -1);
+  for ( auto i: Range(network1.ppi_num()) ) {
+    auto node1 = network1.ppi(i);
+    auto node2 = network2.ppi(i);
+    EXPECT_STREQ( network1.node_name(node1->id()), network2.node_name(node2->id()) )
+      << "ppi(" << i << ")";
+    EXPECT_EQ( node1->is_primary_input(), node2->is_primary_input() );
+    id_map[node1->id()] = node2->id();
+  }
+
+  // PPO は順序が一致し，ファンインコーンの構造が等しい．
+  for ( auto i: Range(network1.ppo_num()) ) {
+    auto node1 = network1.ppo(i);
+    auto node2 = network2.ppo(i);
+    EXPECT_EQ( node1->is_primary_output(), node2->is_primary_output() )
+      << "ppo(" << i << ")";
+    if ( node1->is_dff_input() && node2->is_dff_input() ) {
+      EXPECT_EQ( node1->dff()->id(), node2->dff()->id() ) << "ppo(" << i << ")";
+    }
+    check_node(node1, node2, id_map);
+  }
+}
+
+// @brief node1 と node2 を根とするファンインコーンが等しいか調べる．
+void
+ReadTest::check_node(const TpgNode* node1,
+		     const TpgNode* node2,
+		     vector<int>& id_map)
+{
+  if ( id_map[node1->id()] != -1 ) {
+    // 既に対応がついている．
+    EXPECT_EQ( id_map[node1->id()], node2->id() );
+    return;
+  }
+  id_map[node1->id()] = node2->id();
+
+  ASSERT_EQ( node1->is_logic(), node2->is_logic() );
+  if ( node1->is_logic() ) {
+    EXPECT_EQ( node1->gate_type(), node2->gate_type() )
+      << "Node#" << node1->id() << " and Node#" << node2->id();
+  }
+  ASSERT_EQ( node1->fanin_num(), node2->fanin_num() )
+    << "Node#" << node1->id() << " and Node#" << node2->id();
+  for ( auto i: Range(node1->fanin_num()) ) {
+    check_node(node1->fanin(i), node2->fanin(i), id_map);
+  }
+}
+
+// BnNetwork を経由して読み込んだ結果と直接読み込んだ結果が等しいか調べる．
+TEST_P(ReadTest, read_blif)
+{
+  string filename = DATAPATH + GetParam();
+
+  TpgNetwork network1;
+  bool stat1 = network1.read_blif(filename);
+  ASSERT_TRUE( stat1 );
+
+  BnNetwork src_network = BnNetwork::read_blif(filename, ClibCellLibrary());
+  ASSERT_NE( 0, src_network.node_num() );
+  TpgNetwork network2;
+  network2.set(src_network);
+
+  EXPECT_EQ( network2.node_num(), network1.node_num() );
+  EXPECT_EQ( network2.input_num(), network1.input_num() );
+  EXPECT_EQ( network2.output_num(), network1.output_num() );
+  EXPECT_EQ( network2.dff_num(), network1.dff_num() );
+  EXPECT_EQ( network2.max_fault_id(), network1.max_fault_id() );
+  EXPECT_EQ( network2.rep_fault_num(), network1.rep_fault_num() );
+  EXPECT_EQ( network2.ffr_num(), network1.ffr_num() );
+  EXPECT_EQ( network2.mffc_num(), network1.mffc_num() );
+  for ( auto i: Range(network1.output_num()) ) {
+    EXPECT_STREQ( network2.node_name(network2.output(i)->id()),
+		  network1.node_name(network1.output(i)->id()) );
+  }
+
+  check_network(network2, network1);
+}
+
+// iscas89 形式でも BnNetwork を経由した結果と等しいか調べる．
+TEST(ReadTest, read_iscas89)
+{
+  string filename = DATAPATH + string("s27.bench");
+
+  TpgNetwork network1;
+  bool stat1 = network1.read_iscas89(filename);
+  ASSERT_TRUE( stat1 );
+
+  BnNetwork src_network = BnNetwork::read_iscas89(filename);
+  ASSERT_NE( 0, src_network.node_num() );
+  TpgNetwork network2;
+  network2.set(src_network);
+
+  EXPECT_EQ( network2.node_num(), network1.node_num() );
+  EXPECT_EQ( network2.ppi_num(), network1.ppi_num() );
+  EXPECT_EQ( network2.ppo_num(), network1.ppo_num() );
+  EXPECT_EQ( network2.input_num(), network1.input_num() );
+  EXPECT_EQ( network2.output_num(), network1.output_num() );
+  EXPECT_EQ( network2.dff_num(), network1.dff_num() );
+  EXPECT_EQ( network2.max_fault_id(), network1.max_fault_id() );
+  EXPECT_EQ( network2.rep_fault_num(), network1.rep_fault_num() );
+
+  // s27 は 3 FF
+  EXPECT_EQ( 3, network1.dff_num() );
+  EXPECT_EQ( network1.input_num() + network1.dff_num(), network1.ppi_num() );
+  EXPECT_EQ( network1.output_num() + network1.dff_num(), network1.ppo_num() );
+
+  ReadTest::check_network(network2, network1);
+}
+
+// iscas89 形式のゲート名は大文字小文字を区別しない．
+TEST(ReadTest, read_iscas89_case)
+{
+  string filename = "ReadTest_case.bench";
+  {
+    std::ofstream s(filename);
+    ASSERT_TRUE( s );
+    s << "INPUT(G0)" << endl
+      << "input(G1)" << endl
+      << "INPUT(G2)" << endl
+      << "INPUT(G3)" << endl
+      << "output(G17)" << endl
+      << "G5 = DFF(G10)" << endl
+      << "G6 = dff(G11)" << endl
+      << "G7 = Dff(G13)" << endl
+      << "G14 = not(G0)" << endl
+      << "G17 = NOT(G11)" << endl
+      << "G8 = And(G14, G6)" << endl
+      << "G15 = or(G12, G8)" << endl
+      << "G16 = OR(G3, G8)" << endl
+      << "G9 = nand(G16, G15)" << endl
+      << "G10 = NOR(G14, G11)" << endl
+      << "G11 = nor(G5, G9)" << endl
+      << "G12 = Nor(G1, G7)" << endl
+      << "G13 = NOR(G2, G12)" << endl;
+  }
+
+  TpgNetwork network1;
+  bool stat1 = network1.read_iscas89(filename);
+  std::remove(filename.c_str());
+  ASSERT_TRUE( stat1 );
+
+  TpgNetwork network2;
+  bool stat2 = network2.read_iscas89(DATAPATH + string("s27.bench"));
+  ASSERT_TRUE( stat2 );
+
+  EXPECT_EQ( 3, network1.dff_num() );
+  ReadTest::check_network(network2, network1);
+}
+
+TEST(ReadTest, bad_file)
+{
+  TpgNetwork network;
+  bool stat = network.read_blif(DATAPATH + string("no_such_file.blif"));
+  EXPECT_FALSE( stat );
+}
+
+INSTANTIATE_TEST_CASE_P(ReadTest, ReadTest,
+			::testing::Values("s27.blif", "s1196.blif", "s5378.blif"));
+
+END_NAMESPACE_SATPG
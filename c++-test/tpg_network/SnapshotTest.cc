@@ -0,0 +1,178 @@
+
+/// @file SnapshotTest.cc
+/// @brief TpgNetwork のスナップショットのテスト
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "TpgFault.h"
+#include "TpgFFR.h"
+#include "TpgMFFC.h"
+#include "ym/Range.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+
+BEGIN_NAMESPACE_SATPG
+
+class SnapshotTest :
+  public ::testing::TestWithParam<string>
+{
+public:
+
+  /// @brief 2つのネットワークが等しいか調べる．
+  void
+  check_network(const TpgNetwork& network1,
+		const TpgNetwork& network2);
+
+  /// @brief 作業用のファイル名
+  string
+  tmp_filename() const;
+
+};
+
+// @brief 2つのネットワークが等しいか調べる．
+void
+SnapshotTest::check_network(const TpgNetwork& network1,
+			    const TpgNetwork& network2)
+{
+  ASSERT_EQ( network1.node_num(), network2.node_num() );
+  ASSERT_EQ( network1.input_num(), network2.input_num() );
+  ASSERT_EQ( network1.output_num(), network2.output_num() );
+  ASSERT_EQ( network1.dff_num(), network2.dff_num() );
+  for ( auto id: Range(network1.node_num()) ) {
+    auto node1 = network1.node(id);
+    auto node2 = network2.node(id);
+    EXPECT_STREQ( network1.node_name(id), network2.node_name(id) );
+    EXPECT_EQ( node1->is_primary_input(), node2->is_primary_input() );
+    EXPECT_EQ( node1->is_primary_output(), node2->is_primary_output() );
+    EXPECT_EQ( node1->is_dff_input(), node2->is_dff_input() );
+    EXPECT_EQ( node1->is_dff_output(), node2->is_dff_output() );
+    EXPECT_EQ( node1->is_logic(), node2->is_logic() );
+    if ( node1->is_logic() ) {
+      EXPECT_EQ( node1->gate_type(), node2->gate_type() );
+    }
+    ASSERT_EQ( node1->fanin_num(), node2->fanin_num() );
+    for ( auto i: Range(node1->fanin_num()) ) {
+      EXPECT_EQ( node1->fanin(i)->id(), node2->fanin(i)->id() );
+    }
+    ASSERT_EQ( node1->fanout_num(), node2->fanout_num() );
+    for ( auto i: Range(node1->fanout_num()) ) {
+      EXPECT_EQ( node1->fanout(i)->id(), node2->fanout(i)->id() );
+    }
+    if ( node1->imm_dom() == nullptr ) {
+      EXPECT_EQ( nullptr, node2->imm_dom() );
+    }
+    else {
+      ASSERT_NE( nullptr, node2->imm_dom() );
+      EXPECT_EQ( node1->imm_dom()->id(), node2->imm_dom()->id() );
+    }
+  }
+  // output2() は外部出力しか扱えないので output_id2() で PPO 全体の順序を比べる．
+  for ( auto i: Range(network1.ppo_num()) ) {
+    auto onode1 = network1.ppo(i);
+    auto onode2 = network2.ppo(i);
+    EXPECT_EQ( onode1->id(), onode2->id() );
+    EXPECT_EQ( onode1->output_id2(), onode2->output_id2() );
+  }
+
+  EXPECT_EQ( network1.max_fault_id(), network2.max_fault_id() );
+  ASSERT_EQ( network1.rep_fault_num(), network2.rep_fault_num() );
+  for ( auto i: Range(network1.rep_fault_num()) ) {
+    auto f1 = network1.rep_fault(i);
+    auto f2 = network2.rep_fault(i);
+    EXPECT_EQ( f1->id(), f2->id() );
+    EXPECT_EQ( f1->str(), f2->str() );
+    EXPECT_EQ( f1->rep_fault()->id(), f2->rep_fault()->id() );
+  }
+
+  ASSERT_EQ( network1.ffr_num(), network2.ffr_num() );
+  for ( auto i: Range(network1.ffr_num()) ) {
+    auto& ffr1 = network1.ffr(i);
+    auto& ffr2 = network2.ffr(i);
+    EXPECT_EQ( ffr1.root()->id(), ffr2.root()->id() );
+    ASSERT_EQ( ffr1.fault_num(), ffr2.fault_num() );
+    for ( auto j: Range(ffr1.fault_num()) ) {
+      EXPECT_EQ( ffr1.fault(j)->id(), ffr2.fault(j)->id() );
+    }
+  }
+
+  ASSERT_EQ( network1.mffc_num(), network2.mffc_num() );
+  for ( auto i: Range(network1.mffc_num()) ) {
+    auto& mffc1 = network1.mffc(i);
+    auto& mffc2 = network2.mffc(i);
+    EXPECT_EQ( mffc1.root()->id(), mffc2.root()->id() );
+    ASSERT_EQ( mffc1.ffr_num(), mffc2.ffr_num() );
+    for ( auto j: Range(mffc1.ffr_num()) ) {
+      EXPECT_EQ( mffc1.ffr(j)->root()->id(), mffc2.ffr(j)->root()->id() );
+    }
+    ASSERT_EQ( mffc1.fault_num(), mffc2.fault_num() );
+    for ( auto j: Range(mffc1.fault_num()) ) {
+      EXPECT_EQ( mffc1.fault(j)->id(), mffc2.fault(j)->id() );
+    }
+  }
+}
+
+// @brief 作業用のファイル名
+string
+SnapshotTest::tmp_filename() const
+{
+  return string("snapshot_") + GetParam() + ".bin";
+}
+
+TEST_P(SnapshotTest, save_load)
+{
+  TpgNetwork network1;
+  bool stat1 = network1.read_blif(DATAPATH + GetParam());
+  ASSERT_TRUE( stat1 );
+
+  string filename = tmp_filename();
+  bool stat2 = network1.save_snapshot(filename);
+  ASSERT_TRUE( stat2 );
+
+  TpgNetwork network2;
+  bool stat3 = network2.load_snapshot(filename);
+  std::remove(filename.c_str());
+  ASSERT_TRUE( stat3 );
+
+  check_network(network1, network2);
+}
+
+TEST_P(SnapshotTest, bad_file)
+{
+  TpgNetwork network1;
+  bool stat1 = network1.read_blif(DATAPATH + GetParam());
+  ASSERT_TRUE( stat1 );
+
+  string filename = tmp_filename();
+  bool stat2 = network1.save_snapshot(filename);
+  ASSERT_TRUE( stat2 );
+
+  // 末尾を切り詰めたファイルは読み込めない．
+  string body;
+  {
+    std::ifstream s(filename, std::ios::binary);
+    body.assign(std::istreambuf_iterator<char>(s), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream s(filename, std::ios::binary);
+    s.write(body.data(), body.size() / 2);
+  }
+
+  TpgNetwork network2;
+  bool stat3 = network2.load_snapshot(filename);
+  std::remove(filename.c_str());
+  EXPECT_FALSE( stat3 );
+}
+
+INSTANTIATE_TEST_CASE_P(SnapshotTest, SnapshotTest,
+			::testing::Values("s27.blif", "s1196.blif", "s5378.blif"));
+
+END_NAMESPACE_SATPG
@@ -40,3 +40,12 @@ cdef extern from "DtpgMFFC.h" namespace "nsYm::nsSatpg" :
         DtpgMFFC(const TpgNetwork&, FaultType, const TpgMFFC&, const string&, const SatSolverType)
         DtpgResult gen_pattern(const TpgFault*)
         const DtpgStats& stats()
+
+
+cdef extern from "DtpgInc.h" namespace "nsYm::nsSatpg" :
+
+    ## @brief DtpgInc の Cython バージョン
+    cdef cppclass DtpgInc :
+        DtpgInc(const TpgNetwork&, FaultType, const string&, const SatSolverType)
+        DtpgResult gen_pattern(const TpgFault*)
+        const DtpgStats& stats()
@@ -0,0 +1,35 @@
+
+### @file CXX_DtpgMgr.pxd
+### @brief DtpgMgr 用の pxd ファイル
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2018 Yusuke Matsunaga
+### All rights reserved.
+
+
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+from CXX_FaultType cimport FaultType
+from CXX_TpgNetwork cimport TpgNetwork
+from CXX_TpgFault cimport TpgFault
+from CXX_FaultStatusMgr cimport FaultStatusMgr
+from CXX_DtpgStats cimport DtpgStats
+from CXX_SatSolverType cimport SatSolverType
+from CXX_TestVector cimport TestVector
+
+cdef extern from "DtpgMgr.h" namespace "nsYm::nsSatpg" :
+
+    ## @brief DtpgMgr の Cython バージョン
+    cdef cppclass DtpgMgr :
+        DtpgMgr(const TpgNetwork&, FaultType, const string&, const SatSolverType)
+        void set_thread_num(int)
+        int thread_num()
+        void ffr_mode(FaultStatusMgr&, bool)
+        void mffc_mode(FaultStatusMgr&, bool)
+        int det_count()
+        int untest_count()
+        int abort_count()
+        const vector[const TpgFault*]& fault_list()
+        const vector[TestVector]& tv_list()
+        const DtpgStats& stats()
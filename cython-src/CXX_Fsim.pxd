@@ -9,6 +9,7 @@
 
 from libcpp cimport bool
 from libcpp.vector cimport vector
+from libcpp.pair cimport pair
 from CXX_TpgNetwork cimport TpgNetwork
 from CXX_TpgFault cimport TpgFault
 from CXX_TestVector cimport TestVector
@@ -23,23 +24,36 @@ cdef extern from "Fsim.h" namespace "nsYm::nsSatpg" :
     ## @brief Fsim の cython バージョン
     cdef cppclass Fsim :
         Fsim()
-        void init_fsim2(const TpgNetwork& network, FaultType ftype)
-        void init_fsim3(const TpgNetwork& network, FaultType ftype)
+        void init_fsim2(const TpgNetwork& network, FaultType ftype, bool compiled_gval)
+        void init_fsim3(const TpgNetwork& network, FaultType ftype, bool compiled_gval)
         void set_skip_all()
         void set_skip(const TpgFault* f)
         void set_skip(const vector[const TpgFault*]& fault_list)
         void clear_skip_all()
         void clear_skip(const TpgFault* f)
         void clear_skip(const vector[const TpgFault*]& fault_list)
+        void set_thread_num(int num)
+        int thread_num()
+        void set_concurrent(bool flag)
+        bool concurrent()
+        void set_det_target(int target)
+        void set_det_target(const TpgFault* f, int target)
+        void clear_det_count()
+        int det_count(const TpgFault* f)
+        vector[int] det_count_histogram()
         bool spsfp(const TestVector& tv, const TpgFault* f)
         bool spsfp(const NodeValList& assign_list, const TpgFault* f)
         int sppfp(const TestVector& tv)
         int sppfp(const NodeValList& assign_list)
         int ppsfp()
+        int grade(const vector[TestVector]& tv_list, vector[pair[const TpgFault*, int]]& det_list, int ndet)
         int calc_wsa(const TestVector& tv, bool weighted)
+        void calc_wsa(const vector[TestVector]& tv_list, bool weighted, vector[int]& wsa_list)
+        int pv_bitlen()
         void clear_patterns()
         void set_pattern(int pos, const TestVector& tv)
         TestVector get_pattern(int pos)
         int det_fault_num()
         const TpgFault* det_fault(int pos)
         PackedVal det_fault_pat(int pos)
+        PackedVal det_fault_pat(int pos, int wpos)
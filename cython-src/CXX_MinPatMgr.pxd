@@ -33,4 +33,5 @@ cdef extern from "MinPatMgr.h" namespace "nsYm::nsSatpg" :
                      const vector[TestVector]& tv_list,
                      const TpgNetwork& network,
                      FaultType fault_type,
+                     const string& algorithm,
                      vector[TestVector]& new_tv_list)
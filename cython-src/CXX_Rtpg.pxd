@@ -0,0 +1,33 @@
+
+### @file CXX_Rtpg.pxd
+### @brief Rtpg 用の pxd ファイル
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2018 Yusuke Matsunaga
+### All rights reserved.
+
+
+from libcpp cimport bool
+from libcpp.vector cimport vector
+from CXX_FaultType cimport FaultType
+from CXX_TpgNetwork cimport TpgNetwork
+from CXX_TpgFault cimport TpgFault
+from CXX_FaultStatusMgr cimport FaultStatusMgr
+from CXX_TestVector cimport TestVector
+
+cdef extern from "Rtpg.h" namespace "nsYm::nsSatpg" :
+
+    ## @brief Rtpg の Cython バージョン
+    cdef cppclass Rtpg :
+        Rtpg(const TpgNetwork&, FaultType)
+        FaultType fault_type()
+        void randgen_init(unsigned int)
+        void set_weight(const vector[double]&)
+        void clear_weight()
+        bool has_weight()
+        int run(FaultStatusMgr&, int, int, int)
+        const vector[const TpgFault*]& det_fault_list()
+        const vector[TestVector]& pattern_list()
+        int sim_pat_num()
+
+    vector[double] Rtpg_weight_from_cubes "nsYm::nsSatpg::Rtpg::weight_from_cubes"(const vector[TestVector]&, double)
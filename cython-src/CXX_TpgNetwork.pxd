@@ -23,6 +23,8 @@ cdef extern from "TpgNetwork.h" namespace "nsYm::nsSatpg" :
         bool read_blif(const string& filename)
         bool read_blif(const string& filename, const ClibCellLibrary& cell_library)
         bool read_iscas89(const string& filename)
+        bool save_snapshot(const string& filename)
+        bool load_snapshot(const string& filename)
         int node_num()
         const TpgNode* node(int)
         int input_num()
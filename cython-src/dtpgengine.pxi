@@ -10,6 +10,7 @@ from libcpp.pair cimport pair
 from libcpp.vector cimport vector
 from CXX_DtpgEngine cimport DtpgFFR as CXX_DtpgFFR
 from CXX_DtpgEngine cimport DtpgMFFC as CXX_DtpgMFFC
+from CXX_DtpgEngine cimport DtpgInc as CXX_DtpgInc
 from CXX_TpgFault cimport TpgFault as CXX_TpgFault
 from CXX_NodeValList cimport NodeValList as CXX_NodeValList
 from CXX_SatBool3 cimport SatBool3 as CXX_SatBool3
@@ -83,3 +84,33 @@ cdef class DtpgMFFC :
     def stats(DtpgMFFC self) :
         cdef CXX_DtpgStats c_stats = self._thisptr.stats()
         return to_DtpgStats(c_stats)
+
+
+### @brief DtpgInc の Python バージョン
+cdef class DtpgInc :
+    cdef CXX_DtpgInc* _thisptr
+
+    ### @brief 初期化
+    def __cinit__(DtpgInc self, TpgNetwork network, fault_type, **kwargs) :
+        cdef CXX_FaultType c_ftype = from_FaultType(fault_type)
+        cdef SatSolverType solver_type = kwargs.get('solver_type', SatSolverType())
+        cdef string c_jt = kwargs.get('just_type', 'Just2').encode('UTF-8')
+        self._thisptr = new CXX_DtpgInc(network._this, c_ftype, c_jt,
+                                        solver_type._this)
+
+    ### @brief 終了処理
+    def __dealloc__(DtpgInc self) :
+        if self._thisptr != NULL :
+            del self._thisptr
+
+    ### @brief パタン生成を行う．
+    def __call__(DtpgInc self, TpgFault fault) :
+        cdef const CXX_TpgFault* c_fault = from_TpgFault(fault)
+        cdef CXX_DtpgResult c_result = self._thisptr.gen_pattern(c_fault)
+        return to_FaultStatus(c_result.status()), to_TestVector(c_result.testvector())
+
+    ### @brief 統計情報を得る．
+    @property
+    def stats(DtpgInc self) :
+        cdef CXX_DtpgStats c_stats = self._thisptr.stats()
+        return to_DtpgStats(c_stats)
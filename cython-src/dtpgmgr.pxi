@@ -0,0 +1,84 @@
+
+### @file dtpgmgr.pxi
+### @brief DtpgMgr の cython インターフェイス
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2018 Yusuke Matsunaga
+### All rights reserved.
+
+from libcpp.vector cimport vector
+from CXX_DtpgMgr cimport DtpgMgr as CXX_DtpgMgr
+from CXX_TpgFault cimport TpgFault as CXX_TpgFault
+from CXX_TestVector cimport TestVector as CXX_TestVector
+from cython.operator cimport dereference as deref
+
+
+### @brief DtpgMgr の Python バージョン
+cdef class DtpgMgr :
+    cdef CXX_DtpgMgr* _thisptr
+
+    ### @brief 初期化
+    def __cinit__(DtpgMgr self, TpgNetwork network, fault_type, **kwargs) :
+        cdef CXX_FaultType c_ftype = from_FaultType(fault_type)
+        cdef SatSolverType solver_type = kwargs.get('solver_type', SatSolverType())
+        cdef string c_jt = kwargs.get('just_type', 'Just2').encode('UTF-8')
+        self._thisptr = new CXX_DtpgMgr(network._this, c_ftype, c_jt,
+                                        solver_type._this)
+        self._thisptr.set_thread_num(kwargs.get('thread_num', 0))
+
+    ### @brief 終了処理
+    def __dealloc__(DtpgMgr self) :
+        if self._thisptr != NULL :
+            del self._thisptr
+
+    ### @brief スレッド数
+    @property
+    def thread_num(DtpgMgr self) :
+        return self._thisptr.thread_num()
+
+    @thread_num.setter
+    def thread_num(DtpgMgr self, int num) :
+        self._thisptr.set_thread_num(num)
+
+    ### @brief FFR 単位でテスト生成を行う．
+    def ffr_mode(DtpgMgr self, FaultStatusMgr fmgr, drop) :
+        self._thisptr.ffr_mode(deref(fmgr._thisptr), drop)
+        return self.det_count, self.untest_count, self.abort_count
+
+    ### @brief MFFC 単位でテスト生成を行う．
+    def mffc_mode(DtpgMgr self, FaultStatusMgr fmgr, drop) :
+        self._thisptr.mffc_mode(deref(fmgr._thisptr), drop)
+        return self.det_count, self.untest_count, self.abort_count
+
+    ### @brief 検出された故障数
+    @property
+    def det_count(DtpgMgr self) :
+        return self._thisptr.det_count()
+
+    ### @brief 検出不能と判定された故障数
+    @property
+    def untest_count(DtpgMgr self) :
+        return self._thisptr.untest_count()
+
+    ### @brief アボートした故障数
+    @property
+    def abort_count(DtpgMgr self) :
+        return self._thisptr.abort_count()
+
+    ### @brief 検出された故障のリスト
+    @property
+    def fault_list(DtpgMgr self) :
+        cdef const CXX_TpgFault* c_fault
+        return [ to_TpgFault(c_fault) for c_fault in self._thisptr.fault_list() ]
+
+    ### @brief 生成されたテストベクタのリスト
+    @property
+    def tv_list(DtpgMgr self) :
+        cdef CXX_TestVector c_tv
+        return [ to_TestVector(c_tv) for c_tv in self._thisptr.tv_list() ]
+
+    ### @brief 統計情報を得る．
+    @property
+    def stats(DtpgMgr self) :
+        cdef CXX_DtpgStats c_stats = self._thisptr.stats()
+        return to_DtpgStats(c_stats)
@@ -19,12 +19,13 @@ cdef class Fsim :
     ### @param[in] name シミュレータの種類 ('Fsim2' or 'Fsim3')
     ### @param[in] network 対象のネットワーク
     ### @param[in] fault_type 故障の種類
-    def __cinit__(Fsim self, name, TpgNetwork network, fault_type) :
+    ### @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 True にする．
+    def __cinit__(Fsim self, name, TpgNetwork network, fault_type, compiled_gval = False) :
         cdef CXX_FaultType c_ftype = from_FaultType(fault_type)
         if name == 'Fsim2' :
-            self._this.init_fsim2(network._this, c_ftype)
+            self._this.init_fsim2(network._this, c_ftype, compiled_gval)
         elif name == 'Fsim3' :
-            self._this.init_fsim3(network._this, c_ftype)
+            self._this.init_fsim3(network._this, c_ftype, compiled_gval)
         else :
             assert False
 
@@ -67,6 +68,46 @@ cdef class Fsim :
             c_fault_list.push_back(fault._thisptr)
         self._this.clear_skip(c_fault_list)
 
+    ### @brief ppsfp で用いるスレッド数
+    @property
+    def thread_num(Fsim self) :
+        return self._this.thread_num()
+
+    @thread_num.setter
+    def thread_num(Fsim self, int num) :
+        self._this.set_thread_num(num)
+
+    ### @brief sppfp を並行故障シミュレーションで行う時 True
+    @property
+    def concurrent(Fsim self) :
+        return self._this.concurrent()
+
+    @concurrent.setter
+    def concurrent(Fsim self, bool flag) :
+        self._this.set_concurrent(flag)
+
+    ### @brief 目標検出回数を設定する．
+    ### @param[in] target 目標検出回数
+    ### @param[in] f 対象の故障(None の場合は全ての故障)
+    def set_det_target(Fsim self, int target, TpgFault f = None) :
+        if f is None :
+            self._this.set_det_target(target)
+        else :
+            self._this.set_det_target(f._thisptr, target)
+
+    ### @brief 全ての故障の検出回数を0にする．
+    def clear_det_count(Fsim self) :
+        self._this.clear_det_count()
+
+    ### @brief 故障の検出回数を返す．
+    ### @param[in] f 対象の故障
+    def det_count(Fsim self, TpgFault f) :
+        return self._this.det_count(f._thisptr)
+
+    ### @brief 検出回数のヒストグラムを返す．
+    def det_count_histogram(Fsim self) :
+        return self._this.det_count_histogram()
+
     ### @brief SPSFP シミュレーションを行う．
     ### @param[in] tv テストベクタ
     ### @param[in] f 対象の故障
@@ -120,15 +161,46 @@ cdef class Fsim :
         fault_patid_list = []
         for i in range(n_det) :
             c_fault = self._this.det_fault(i)
-            c_pat = self._this.det_fault_pat(i)
             fault = to_TpgFault(c_fault)
             patid_list = []
             for j in range(pos) :
-                if c_pat & (1 << j) :
+                if j % 64 == 0 :
+                    c_pat = self._this.det_fault_pat(i, j // 64)
+                if c_pat & (1 << (j % 64)) :
                     patid_list.append(j)
             fault_patid_list.append( (fault, patid_list) )
         return fault_patid_list
 
+    ### @brief 複数のパタンで故障シミュレーションを行う．
+    ### @param[in] tv_list テストベクタのリスト
+    ### @param[in] ndet 故障をドロップするまでの検出回数(0 の時はドロップしない)
+    ### @return 検出された故障と検出したパタン番号の組のリスト
+    ###
+    ### tv_list の長さに制限はない．パタン番号は tv_list 中の位置
+    def grade(Fsim self, tv_list, int ndet = 0) :
+        cdef int n = len(tv_list)
+        cdef vector[CXX_TestVector] c_tv_list
+        cdef vector[pair[const CXX_TpgFault*, int]] c_det_list
+        cdef TestVector tv
+        c_tv_list.reserve(n)
+        for tv in tv_list :
+            c_tv_list.push_back(tv._this)
+        self._this.grade(c_tv_list, c_det_list, ndet)
+        return [ (to_TpgFault(c_det_list[i].first), c_det_list[i].second) for i in range(c_det_list.size()) ]
+
     ### @brief 遷移故障モードで信号遷移回数を数える．
     def calc_wsa(Fsim self, TestVector tv, bool weighted = False) :
         return self._this.calc_wsa(tv._this, weighted)
+
+    ### @brief 複数のテストベクタの信号遷移回数をまとめて数える．
+    ### @return 各テストベクタの信号遷移回数のリストを返す．
+    def calc_wsa_list(Fsim self, tv_list, bool weighted = False) :
+        cdef int n = len(tv_list)
+        cdef vector[CXX_TestVector] c_tv_list
+        cdef vector[int] c_wsa_list
+        cdef TestVector tv
+        c_tv_list.reserve(n)
+        for tv in tv_list :
+            c_tv_list.push_back(tv._this)
+        self._this.calc_wsa(c_tv_list, weighted, c_wsa_list)
+        return [ c_wsa_list[i] for i in range(n) ]
@@ -0,0 +1,89 @@
+
+### @file rtpg.pxi
+### @brief Rtpg の cython インターフェイス
+### @author Yusuke Matsunaga (松永 裕介)
+###
+### Copyright (C) 2018 Yusuke Matsunaga
+### All rights reserved.
+
+from libcpp.vector cimport vector
+from CXX_Rtpg cimport Rtpg as CXX_Rtpg
+from CXX_Rtpg cimport Rtpg_weight_from_cubes
+from CXX_TpgFault cimport TpgFault as CXX_TpgFault
+from CXX_TestVector cimport TestVector as CXX_TestVector
+from cython.operator cimport dereference as deref
+
+
+### @brief Rtpg の Python バージョン
+cdef class Rtpg :
+    cdef CXX_Rtpg* _thisptr
+
+    ### @brief 初期化
+    def __cinit__(Rtpg self, TpgNetwork network, fault_type, **kwargs) :
+        cdef CXX_FaultType c_ftype = from_FaultType(fault_type)
+        self._thisptr = new CXX_Rtpg(network._this, c_ftype)
+        if 'seed' in kwargs :
+            self._thisptr.randgen_init(kwargs['seed'])
+
+    ### @brief 終了処理
+    def __dealloc__(Rtpg self) :
+        if self._thisptr != NULL :
+            del self._thisptr
+
+    ### @brief 乱数生成器を初期化する．
+    def randgen_init(Rtpg self, seed) :
+        self._thisptr.randgen_init(seed)
+
+    ### @brief 重み付きランダムパタン用の重みを設定する．
+    ### @param[in] prob_list 各入力が 1 になる確率のリスト
+    def set_weight(Rtpg self, prob_list) :
+        cdef vector[double] c_prob_list
+        for p in prob_list :
+            c_prob_list.push_back(p)
+        self._thisptr.set_weight(c_prob_list)
+
+    ### @brief 重みをクリアして一様なランダムパタンに戻す．
+    def clear_weight(Rtpg self) :
+        self._thisptr.clear_weight()
+
+    ### @brief 重みが設定されている時 True
+    @property
+    def has_weight(Rtpg self) :
+        return self._thisptr.has_weight()
+
+    ### @brief テストキューブのリストから重みを求める．
+    ### @param[in] cube_list テストキューブのリスト
+    ### @param[in] min_prob 確率の下限
+    @staticmethod
+    def weight_from_cubes(cube_list, double min_prob = 0.05) :
+        cdef vector[CXX_TestVector] c_cube_list
+        cdef TestVector tv
+        for tv in cube_list :
+            c_cube_list.push_back(tv._this)
+        return Rtpg_weight_from_cubes(c_cube_list, min_prob)
+
+    ### @brief ランダムパタンによるテスト生成を行う．
+    ### @param[in] fmgr 故障の状態を保持するオブジェクト
+    ### @param[in] min_f 1ブロックで検出する故障数の下限
+    ### @param[in] max_i min_f を下回るブロックの連続回数の上限
+    ### @param[in] max_pat シミュレーションするパタン数の上限
+    ### @return 検出された故障数を返す．
+    def run(Rtpg self, FaultStatusMgr fmgr, int min_f = 1, int max_i = 4, int max_pat = 100000) :
+        return self._thisptr.run(deref(fmgr._thisptr), min_f, max_i, max_pat)
+
+    ### @brief 検出された故障のリスト
+    @property
+    def det_fault_list(Rtpg self) :
+        cdef const CXX_TpgFault* c_fault
+        return [ to_TpgFault(c_fault) for c_fault in self._thisptr.det_fault_list() ]
+
+    ### @brief 故障を検出したパタンのリスト
+    @property
+    def pattern_list(Rtpg self) :
+        cdef CXX_TestVector c_tv
+        return [ to_TestVector(c_tv) for c_tv in self._thisptr.pattern_list() ]
+
+    ### @brief シミュレーションしたパタン数
+    @property
+    def sim_pat_num(Rtpg self) :
+        return self._thisptr.sim_pat_num()
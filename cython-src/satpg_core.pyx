@@ -28,6 +28,8 @@ include "nodevallist.pxi"
 include "fsim.pxi"
 include "dtpgengine.pxi"
 include "dtpgstats.pxi"
+include "dtpgmgr.pxi"
+include "rtpg.pxi"
 include "mincov.pxi"
 include "udgraph.pxi"
 include "minpatmgr.pxi"
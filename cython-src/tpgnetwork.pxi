@@ -54,6 +54,29 @@ cdef class TpgNetwork :
         else :
             return None
 
+    ### @brief スナップショットファイルを読み込む．
+    ### @param[in] filename ファイル名
+    ### @return 結果のネットワークを返す．
+    ###
+    ### エラーが起きたら None を返す．
+    @staticmethod
+    def load_snapshot(str filename) :
+        cdef string c_filename = filename.encode('UTF-8')
+        cdef bool stat
+        network = TpgNetwork()
+        stat = network._this.load_snapshot(c_filename)
+        if stat :
+            return network
+        else :
+            return None
+
+    ### @brief 内容をスナップショットファイルに書き出す．
+    ### @param[in] filename ファイル名
+    ### @return 書き出しが成功したら True を返す．
+    def save_snapshot(TpgNetwork self, str filename) :
+        cdef string c_filename = filename.encode('UTF-8')
+        return self._this.save_snapshot(c_filename)
+
     ### @brief ノード数を返す．
     @property
     def node_num(TpgNetwork self) :
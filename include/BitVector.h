@@ -148,6 +148,17 @@ public:
   void
   set_from_random(URNG& randgen);
 
+  /// @brief 重み付きの乱数パタンを設定する．
+  /// @param[in] randgen 乱数生成器
+  /// @param[in] prob_list 各ビットが 1 になる確率のリスト
+  ///
+  /// - prob_list のサイズは len() と等しくなければならない．
+  /// - 結果はかならず 0 か 1 になる．(Xは含まれない)
+  template<class URNG>
+  void
+  set_from_random(URNG& randgen,
+		  const vector<double>& prob_list);
+
   /// @brief X の部分を乱数で 0/1 に設定する．
   /// @param[in] randgen 乱数生成器
   template<class URNG>
@@ -168,6 +179,18 @@ public:
   operator&&(const BitVector& left,
 	     const BitVector& right);
 
+  /// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+  /// @param[in] bv 基準となるビットベクタ
+  /// @param[in] bv_list 比較対象のビットベクタのリスト
+  /// @param[out] result 結果を格納するリスト
+  ///
+  /// result[i] に bv と *bv_list[i] が両立する時 true が入る．
+  friend
+  void
+  is_compat(const BitVector& bv,
+	    const vector<const BitVector*>& bv_list,
+	    vector<bool>& result);
+
   /// @brief 等価関係の比較を行なう．
   /// @param[in] left, right オペランド
   /// @return left と right が等しいとき true を返す．
@@ -426,6 +449,24 @@ operator&&(const BitVector& left,
   return BitVectorRep::is_compat(*left.mPtr, *right.mPtr);
 }
 
+// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+// @param[in] bv 基準となるビットベクタ
+// @param[in] bv_list 比較対象のビットベクタのリスト
+// @param[out] result 結果を格納するリスト
+inline
+void
+is_compat(const BitVector& bv,
+	  const vector<const BitVector*>& bv_list,
+	  vector<bool>& result)
+{
+  vector<const BitVectorRep*> rep_list;
+  rep_list.reserve(bv_list.size());
+  for ( auto bv1: bv_list ) {
+    rep_list.push_back(bv1->mPtr.get());
+  }
+  BitVectorRep::is_compat(*bv.mPtr, rep_list, result);
+}
+
 // @brief 等価関係の比較を行なう．
 // @param[in] left, right オペランド
 // @return left と right が等しいとき true を返す．
@@ -603,6 +644,20 @@ BitVector::set_from_random(URNG& randgen)
   mPtr->set_from_random(randgen);
 }
 
+// @brief 重み付きの乱数パタンを設定する．
+// @param[in] randgen 乱数生成器
+// @param[in] prob_list 各ビットが 1 になる確率のリスト
+template<class URNG>
+inline
+void
+BitVector::set_from_random(URNG& randgen,
+			   const vector<double>& prob_list)
+{
+  uniquefy();
+
+  mPtr->set_from_random(randgen, prob_list);
+}
+
 // @brief X の部分を乱数で 0/1 に設定する．
 // @param[in] randgen 乱数生成器
 template<class URNG>
@@ -116,6 +116,18 @@ public:
   is_compat(const BitVectorRep& bv1,
 	    const BitVectorRep& bv2);
 
+  /// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+  /// @param[in] bv 基準となるビットベクタ
+  /// @param[in] bv_list 比較対象のビットベクタのリスト
+  /// @param[out] result 結果を格納するリスト
+  ///
+  /// result[i] に bv と bv_list[i] が両立する時 true が入る．
+  static
+  void
+  is_compat(const BitVectorRep& bv,
+	    const vector<const BitVectorRep*>& bv_list,
+	    vector<bool>& result);
+
   /// @brief 内容を BIN 形式で表す．
   string
   bin_str() const;
@@ -173,6 +185,17 @@ public:
   void
   set_from_random(URNG& randgen);
 
+  /// @brief 重み付きの乱数パタンを設定する．
+  /// @param[in] randgen 乱数生成器
+  /// @param[in] prob_list 各ビットが 1 になる確率のリスト
+  ///
+  /// - prob_list のサイズは len() と等しくなければならない．
+  /// - 結果はかならず 0 か 1 になる．(Xは含まれない)
+  template<class URNG>
+  void
+  set_from_random(URNG& randgen,
+		  const vector<double>& prob_list);
+
   /// @brief X の部分を乱数で 0/1 に設定する．
   /// @param[in] randgen 乱数生成器
   template<class URNG>
@@ -353,6 +376,40 @@ BitVectorRep::set_from_random(URNG& randgen)
   }
 }
 
+// @brief 重み付きの乱数パタンを設定する．
+// @param[in] randgen 乱数生成器
+// @param[in] prob_list 各ビットが 1 になる確率のリスト
+template<class URNG>
+inline
+void
+BitVectorRep::set_from_random(URNG& randgen,
+			      const vector<double>& prob_list)
+{
+  ASSERT_COND( static_cast<int>(prob_list.size()) == len() );
+
+  std::uniform_real_distribution<double> rd(0.0, 1.0);
+  int nb = block_num(len());
+  int pos = 0;
+  for ( int i = 0; i < nb; i += 2 ) {
+    PackedVal v = kPvAll0;
+    for ( int b = 0; b < kPvBitLen && pos < len(); ++ b, ++ pos ) {
+      if ( rd(randgen) < prob_list[pos] ) {
+	v |= 1UL << b;
+      }
+    }
+    int i0 = i;
+    int i1 = i + 1;
+    if ( i == nb - 2 ) {
+      mPat[i0] = ~v & mMask;
+      mPat[i1] =  v & mMask;
+    }
+    else {
+      mPat[i0] = ~v;
+      mPat[i1] =  v;
+    }
+  }
+}
+
 // @brief X の部分を乱数で 0/1 に設定する．
 // @param[in] randgen 乱数生成器
 template<class URNG>
@@ -27,6 +27,7 @@
 #include "ym/StopWatch.h"
 
 #include "VidMap.h"
+#include "LocalIndexMap.h"
 
 
 BEGIN_NAMESPACE_SATPG
@@ -336,6 +337,13 @@ private:
   void
   set_tfi2_mark(const TpgNode* node);
 
+  /// @brief ノードの印の格納場所を得る．
+  /// @param[in] node 対象のノード
+  ///
+  /// 登録されていない場合は 0 で登録する．
+  ymuint8&
+  _mark_ref(const TpgNode* node);
+
   /// @brief SATモデルから値を取り出す．
   /// @param[in] var 変数番号
   Val3
@@ -383,8 +391,14 @@ private:
   // 関係する擬似外部入力ノードを入れておくリスト
   vector<const TpgNode*> mPPIList;
 
-  // 作業用のマークを入れておく配列
-  // サイズは mMaxNodeId
+  // 作業用のマークを持つノードの局所的な番号
+  // キーはノード番号
+  // ネットワーク全体の大きさの配列を確保しないように
+  // マークをつけたノードだけに番号を振る．
+  LocalIndexMap mMarkIndex;
+
+  // 作業用のマーク
+  // インデックスは mMarkIndex の値
   vector<ymuint8> mMarkArray;
 
   // 1時刻前の正常値を表す変数のマップ
@@ -657,9 +671,9 @@ inline
 void
 DtpgEngine::set_tfo_mark(const TpgNode* node)
 {
-  int id = node->id();
-  if ( ((mMarkArray[id] >> 0) & 1U) == 0U ) {
-    mMarkArray[id] |= 1U;
+  auto& mark = _mark_ref(node);
+  if ( ((mark >> 0) & 1U) == 0U ) {
+    mark |= 1U;
     mTfoList.push_back(node);
     if ( node->is_ppo() ) {
       mOutputList.push_back(node);
@@ -682,9 +696,9 @@ inline
 void
 DtpgEngine::set_tfi_mark(const TpgNode* node)
 {
-  int id = node->id();
-  if ( (mMarkArray[id] & 3U) == 0U ) {
-    mMarkArray[id] |= 2U;
+  auto& mark = _mark_ref(node);
+  if ( (mark & 3U) == 0U ) {
+    mark |= 2U;
     mTfiList.push_back(node);
     if ( mFaultType == FaultType::TransitionDelay ) {
       if ( node->is_dff_output() ) {
@@ -707,9 +721,9 @@ inline
 void
 DtpgEngine::set_tfi2_mark(const TpgNode* node)
 {
-  int id = node->id();
-  if ( ((mMarkArray[id] >> 2) & 1U) == 0U ) {
-    mMarkArray[id] |= 4U;
+  auto& mark = _mark_ref(node);
+  if ( ((mark >> 2) & 1U) == 0U ) {
+    mark |= 4U;
     mTfi2List.push_back(node);
     if ( node->is_ppi() ) {
       mPPIList.push_back(node);
@@ -717,6 +731,21 @@ DtpgEngine::set_tfi2_mark(const TpgNode* node)
   }
 }
 
+// @brief ノードの印の格納場所を得る．
+// @param[in] node 対象のノード
+//
+// 登録されていない場合は 0 で登録する．
+inline
+ymuint8&
+DtpgEngine::_mark_ref(const TpgNode* node)
+{
+  int index = mMarkIndex.reg(node->id());
+  if ( index == static_cast<int>(mMarkArray.size()) ) {
+    mMarkArray.push_back(0U);
+  }
+  return mMarkArray[index];
+}
+
 END_NAMESPACE_SATPG
 
 #endif // DTPGENGINE_H
@@ -0,0 +1,229 @@
+#ifndef DTPGINC_H
+#define DTPGINC_H
+
+/// @file DtpgInc.h
+/// @brief DtpgInc のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "DtpgResult.h"
+#include "DtpgStats.h"
+#include "FaultType.h"
+#include "Justifier.h"
+#include "NodeValList.h"
+
+#include "ym/sat.h"
+#include "ym/SatBool3.h"
+#include "ym/SatLiteral.h"
+#include "ym/SatSolver.h"
+#include "ym/StopWatch.h"
+
+#include "VidMap.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class DtpgInc DtpgInc.h "DtpgInc.h"
+/// @brief 一つの SAT ソルバを使い回す DTPG エンジン
+///
+/// DtpgFFR は FFR ごとに SAT ソルバを作り直して TFI/TFO の CNF を
+/// 生成するが，このクラスはネットワーク全体の正常回路の CNF を
+/// コンストラクタで一度だけ作る．<br>
+/// 故障回路の CNF は FFR の根の TFO 部分だけを必要になった時点で追加する．
+/// コーンの節(故障回路，故障伝搬条件，検出条件)は全てコーンごとの
+/// 活性化リテラルで制御する．
+/// 別の FFR に移る時には直前の活性化リテラルを否定する単位節を加えて
+/// そのコーンの節を全て充足させる．充足された節と凍結していない
+/// コーンの変数は SAT ソルバの簡単化で取り除かれるので，
+/// ソルバの大きさは現在のコーンの分しか増えない．<br>
+/// そのため故障は FFR ごとにまとめて与えた方が効率がよい．
+//////////////////////////////////////////////////////////////////////
+class DtpgInc
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] fault_type 故障の種類
+  /// @param[in] just_type Justifier の種類を表す文字列
+  /// @param[in] solver_type SATソルバの実装タイプ
+  DtpgInc(const TpgNetwork& network,
+	  FaultType fault_type,
+	  const string& just_type,
+	  const SatSolverType& solver_type = SatSolverType());
+
+  /// @brief デストラクタ
+  ~DtpgInc();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テスト生成を行なう．
+  /// @param[in] fault 対象の故障
+  /// @return 結果を返す．
+  ///
+  /// fault を含む FFR のコーンが作られていなければ作る．
+  DtpgResult
+  gen_pattern(const TpgFault* fault);
+
+  /// @brief 統計情報を得る．
+  const DtpgStats&
+  stats() const;
+
+  /// @brief これまでに作ったコーンの数を返す．
+  int
+  cone_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ネットワーク全体の正常回路の CNF を作る．
+  void
+  make_good_cnf();
+
+  /// @brief root の TFO の故障回路の CNF を作る．
+  /// @param[in] root FFR の根のノード
+  ///
+  /// 直前のコーンは無効化される．
+  void
+  make_cone(const TpgNode* root);
+
+  /// @brief 故障伝搬条件を表すCNF式を生成する．
+  /// @param[in] node 対象のノード
+  void
+  make_dchain_cnf(const TpgNode* node);
+
+  /// @brief 現在のコーンの節を追加する．
+  /// @param[in] lits 節のリテラルのリスト
+  ///
+  /// 活性化リテラルの否定を加えて追加する．
+  void
+  add_cone_clause(vector<SatLiteral> lits);
+
+  /// @brief 値割り当てをリテラルのリストに変換する．
+  /// @param[in] assign_list 値の割り当てリスト
+  /// @param[out] assumptions 変換したリテラルを追加するリスト
+  void
+  conv_to_assumptions(const NodeValList& assign_list,
+		      vector<SatLiteral>& assumptions);
+
+  /// @brief 一つの SAT問題を解く．
+  /// @param[in] assumptions 値の決まっている変数のリスト
+  /// @return 結果を返す．
+  SatBool3
+  solve(const vector<SatLiteral>& assumptions);
+
+  /// @brief バックトレースを行う．
+  /// @param[in] suf_cond 十分条件の割り当て
+  /// @return テストパタンを返す．
+  TestVector
+  backtrace(const NodeValList& suf_cond);
+
+  /// @brief CNF 作成を開始する．
+  void
+  cnf_begin();
+
+  /// @brief CNF 作成を終了する．
+  void
+  cnf_end();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 統計情報
+  DtpgStats mStats;
+
+  // SATソルバ
+  SatSolver mSolver;
+
+  // 対象のネットワーク
+  const TpgNetwork& mNetwork;
+
+  // 故障の種類
+  FaultType mFaultType;
+
+  // 現在のコーンの根のノード
+  const TpgNode* mRoot;
+
+  // 現在のコーンの活性化リテラル
+  SatLiteral mActLit;
+
+  // これまでに作ったコーンの数
+  int mConeNum;
+
+  // 現在のコーンの TFO のノードのリスト
+  vector<const TpgNode*> mTfoList;
+
+  // 現在のコーンに含まれる出力ノードのリスト
+  vector<const TpgNode*> mOutputList;
+
+  // TFO の印
+  // サイズは mNetwork.node_num()
+  vector<bool> mTfoMark;
+
+  // 1時刻前の正常値を表す変数のマップ
+  VidMap mHvarMap;
+
+  // 正常値を表す変数のマップ
+  VidMap mGvarMap;
+
+  // 故障値を表す変数のマップ
+  // 現在のコーン以外のノードは gvar と同じ
+  VidMap mFvarMap;
+
+  // 故障伝搬条件を表す変数のマップ
+  VidMap mDvarMap;
+
+  // SATの解を保持する配列
+  vector<SatBool3> mSatModel;
+
+  // バックトレーサー
+  Justifier mJustifier;
+
+  // 時間計測用のタイマー
+  StopWatch mTimer;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 統計情報を得る．
+inline
+const DtpgStats&
+DtpgInc::stats() const
+{
+  return mStats;
+}
+
+// @brief これまでに作ったコーンの数を返す．
+inline
+int
+DtpgInc::cone_num() const
+{
+  return mConeNum;
+}
+
+END_NAMESPACE_SATPG
+
+#endif // DTPGINC_H
@@ -0,0 +1,241 @@
+#ifndef DTPGMGR_H
+#define DTPGMGR_H
+
+/// @file DtpgMgr.h
+/// @brief DtpgMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+#include "TpgNetwork.h"
+#include "FaultType.h"
+#include "FaultStatus.h"
+#include "DtpgStats.h"
+#include "TestVector.h"
+#include "Fsim.h"
+#include "ym/SatSolverType.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+class FaultStatusMgr;
+
+//////////////////////////////////////////////////////////////////////
+/// @class DtpgMgr DtpgMgr.h "DtpgMgr.h"
+/// @brief 複数のスレッドでテスト生成を行うクラス
+///
+/// FFR(MFFC) を単位として仕事を各スレッドに割り振る．
+/// 各スレッドは自分専用の DtpgFFR(DtpgMFFC) を作るので
+/// SAT ソルバは共有されない．<br>
+/// 故障の状態は FaultStatusMgr で共有する．
+/// 生成されたテストベクタはキューを通して一つの故障シミュレーション用の
+/// スレッドに送られ，故障ドロップが行われる．<br>
+/// 生成されるテストベクタの順序はスレッドのスケジューリングに依存する．
+//////////////////////////////////////////////////////////////////////
+class DtpgMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] fault_type 故障の種類
+  /// @param[in] just_type Justifier の種類を表す文字列
+  /// @param[in] solver_type SATソルバの実装タイプ
+  DtpgMgr(const TpgNetwork& network,
+	  FaultType fault_type,
+	  const string& just_type = string(),
+	  const SatSolverType& solver_type = SatSolverType());
+
+  /// @brief デストラクタ
+  ~DtpgMgr();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テスト生成を行うスレッド数を設定する．
+  /// @param[in] num スレッド数
+  ///
+  /// num が 0 以下の場合にはハードウェアのスレッド数を用いる．
+  void
+  set_thread_num(int num);
+
+  /// @brief テスト生成を行うスレッド数を返す．
+  int
+  thread_num() const;
+
+  /// @brief FFR 単位でテスト生成を行う．
+  /// @param[in] fmgr 故障の状態を保持するオブジェクト
+  /// @param[in] drop 故障シミュレーションによる故障ドロップを行う時 true
+  ///
+  /// fmgr で未検出となっている故障のみを対象とする．
+  void
+  ffr_mode(FaultStatusMgr& fmgr,
+	   bool drop);
+
+  /// @brief MFFC 単位でテスト生成を行う．
+  /// @param[in] fmgr 故障の状態を保持するオブジェクト
+  /// @param[in] drop 故障シミュレーションによる故障ドロップを行う時 true
+  ///
+  /// fmgr で未検出となっている故障のみを対象とする．
+  void
+  mffc_mode(FaultStatusMgr& fmgr,
+	    bool drop);
+
+  /// @brief 直前の実行で検出された故障数を返す．
+  int
+  det_count() const;
+
+  /// @brief 直前の実行で検出不能と判定された故障数を返す．
+  int
+  untest_count() const;
+
+  /// @brief 直前の実行でアボートした故障数を返す．
+  int
+  abort_count() const;
+
+  /// @brief 直前の実行で検出された故障のリストを返す．
+  ///
+  /// 故障ドロップで検出されたものも含む．
+  const vector<const TpgFault*>&
+  fault_list() const;
+
+  /// @brief 直前の実行で生成されたテストベクタのリストを返す．
+  const vector<TestVector>&
+  tv_list() const;
+
+  /// @brief 直前の実行の統計情報を返す．
+  ///
+  /// 全スレッドの統計情報をマージしたもの
+  const DtpgStats&
+  stats() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テスト生成を行う．
+  /// @param[in] unit_list 仕事の単位(FFR or MFFC)のリスト
+  /// @param[in] fmgr 故障の状態を保持するオブジェクト
+  /// @param[in] drop 故障ドロップを行う時 true
+  ///
+  /// DtpgT は DtpgFFR か DtpgMFFC
+  template<class DtpgT,
+	   class UnitT>
+  void
+  _run(const Array<const UnitT>& unit_list,
+       FaultStatusMgr& fmgr,
+       bool drop);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象のネットワーク
+  const TpgNetwork& mNetwork;
+
+  // 故障の種類
+  FaultType mFaultType;
+
+  // Justifier の種類
+  string mJustType;
+
+  // SATソルバの実装タイプ
+  SatSolverType mSolverType;
+
+  // スレッド数
+  int mThreadNum;
+
+  // 故障ドロップ用の故障シミュレータ
+  Fsim mFsim;
+
+  // 検出された故障のリスト
+  vector<const TpgFault*> mFaultList;
+
+  // 生成されたテストベクタのリスト
+  vector<TestVector> mTvList;
+
+  // 検出不能と判定された故障数
+  int mUntestNum;
+
+  // アボートした故障数
+  int mAbortNum;
+
+  // 統計情報
+  DtpgStats mStats;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief テスト生成を行うスレッド数を返す．
+inline
+int
+DtpgMgr::thread_num() const
+{
+  return mThreadNum;
+}
+
+// @brief 直前の実行で検出された故障数を返す．
+inline
+int
+DtpgMgr::det_count() const
+{
+  return mFaultList.size();
+}
+
+// @brief 直前の実行で検出不能と判定された故障数を返す．
+inline
+int
+DtpgMgr::untest_count() const
+{
+  return mUntestNum;
+}
+
+// @brief 直前の実行でアボートした故障数を返す．
+inline
+int
+DtpgMgr::abort_count() const
+{
+  return mAbortNum;
+}
+
+// @brief 直前の実行で検出された故障のリストを返す．
+inline
+const vector<const TpgFault*>&
+DtpgMgr::fault_list() const
+{
+  return mFaultList;
+}
+
+// @brief 直前の実行で生成されたテストベクタのリストを返す．
+inline
+const vector<TestVector>&
+DtpgMgr::tv_list() const
+{
+  return mTvList;
+}
+
+// @brief 直前の実行の統計情報を返す．
+inline
+const DtpgStats&
+DtpgMgr::stats() const
+{
+  return mStats;
+}
+
+END_NAMESPACE_SATPG
+
+#endif // DTPGMGR_H
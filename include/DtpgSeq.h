@@ -0,0 +1,230 @@
+#ifndef DTPGSEQ_H
+#define DTPGSEQ_H
+
+/// @file DtpgSeq.h
+/// @brief DtpgSeq のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+
+#include "TpgNetwork.h"
+#include "TpgNode.h"
+#include "DtpgStats.h"
+#include "Justifier.h"
+#include "Val3.h"
+
+#include "ym/sat.h"
+#include "ym/SatBool3.h"
+#include "ym/SatLiteral.h"
+#include "ym/SatSolver.h"
+
+#include "VidMap.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class DtpgSeq DtpgSeq.h "DtpgSeq.h"
+/// @brief 時間展開を用いて順序回路の縮退故障のテスト系列を求めるクラス
+///
+/// DtpgEngine は1時刻前(hvar)と現時刻(gvar)の2時刻分しか考えないが，
+/// このクラスは TpgDff の入出力をつないでネットワークを時間方向に
+/// 展開し，複数時刻にわたって故障の影響を伝搬させる．
+/// - 時刻 0 の FF の値(初期状態)は自由に設定できるものとする．
+/// - 故障の影響は各時刻の外部出力でのみ観測できるものとする．
+///   (最終時刻の FF の値は観測しない)
+/// - 故障は全ての時刻に存在する．
+///
+/// 時間フレームは add_frame() で一つずつ追加される．
+/// 一つの SAT ソルバに CNF 式を追加していくので，前の時刻までで
+/// 得られた学習節はそのまま引き継がれる．
+/// 各時刻の検出条件は活性化リテラルとして表され，その時刻で
+/// 検出できないことがわかったら否定の単位節を加えてから
+/// 次の時刻を追加する．
+//////////////////////////////////////////////////////////////////////
+class DtpgSeq
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] fault 対象の故障
+  /// @param[in] just_type Justifier の種類を表す文字列
+  /// @param[in] solver_type SATソルバの実装タイプ
+  DtpgSeq(const TpgNetwork& network,
+	  const TpgFault* fault,
+	  const string& just_type,
+	  const SatSolverType& solver_type = SatSolverType());
+
+  /// @brief デストラクタ
+  ~DtpgSeq();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テスト系列の生成を行なう．
+  /// @param[in] max_frame 時間展開数の上限
+  /// @param[out] init_state FFの初期値
+  /// @param[out] input_list 時刻ごとの外部入力の値のリスト
+  /// @retval SatBool3::True テスト系列が求まった．
+  /// @retval SatBool3::False max_frame 時刻以内では検出できない．
+  /// @retval SatBool3::X アボートした．
+  ///
+  /// 展開済みの時刻から1時刻ずつ追加しながら SAT 問題を解く．
+  /// SatBool3::False の場合にはより大きな max_frame で
+  /// 再度呼び出すと続きの時刻から処理を行う．<br>
+  /// input_list の要素数は故障を検出した時刻 + 1 となる．
+  SatBool3
+  dtpg(int max_frame,
+       DffVector& init_state,
+       vector<InputVector>& input_list);
+
+  /// @brief 展開済みの時間フレーム数を返す．
+  int
+  frame_num() const;
+
+  /// @brief 時間フレームを一つ追加する．
+  void
+  add_frame();
+
+  /// @brief 統計情報を得る．
+  const DtpgStats&
+  stats() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 正常回路の CNF を作る．
+  /// @param[in] node 対象のノード
+  /// @param[in] time 時刻
+  ///
+  /// node の TFI の CNF も作る．
+  /// 時刻 1 以降の DFF の出力は1時刻前の DFF の入力と同じ変数を用いる．
+  void
+  make_good_cnf(const TpgNode* node,
+		int time);
+
+  /// @brief 故障の影響が及ぶ可能性のあるノードのリストを作る．
+  /// @param[in] time 時刻
+  /// @param[out] tfo_list 結果を格納するリスト
+  ///
+  /// 故障のあるノードと，1時刻前に故障の影響が及んでいた DFF の出力の
+  /// TFO となる．
+  void
+  make_tfo_list(int time,
+		vector<const TpgNode*>& tfo_list);
+
+  /// @brief 一つの SAT問題を解く．
+  /// @param[in] assumptions 値の決まっている変数のリスト
+  /// @return 結果を返す．
+  SatBool3
+  solve(const vector<SatLiteral>& assumptions);
+
+  /// @brief 直前の solve() の結果からテスト系列を作る．
+  /// @param[in] det_time 故障を検出した時刻
+  /// @param[out] init_state FFの初期値
+  /// @param[out] input_list 時刻ごとの外部入力の値のリスト
+  void
+  backtrace(int det_time,
+	    DffVector& init_state,
+	    vector<InputVector>& input_list);
+
+  /// @brief 正常値を得る．
+  /// @param[in] node 対象のノード
+  /// @param[in] time 時刻
+  Val3
+  gval(const TpgNode* node,
+       int time) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 統計情報
+  DtpgStats mStats;
+
+  // SATソルバ
+  SatSolver mSolver;
+
+  // 対象のネットワーク
+  const TpgNetwork& mNetwork;
+
+  // 対象の故障
+  const TpgFault* mFault;
+
+  // 時刻ごとの正常値を表す変数のマップ
+  vector<VidMap> mGvarMapList;
+
+  // 時刻ごとの故障値を表す変数のマップ
+  vector<VidMap> mFvarMapList;
+
+  // 時刻ごとの故障の影響が及ぶ可能性のあるノードのリスト
+  vector<vector<const TpgNode*> > mTfoListArray;
+
+  // 時刻ごとの故障を検出する条件を表すリテラル
+  vector<SatLiteral> mDetLitList;
+
+  // 検出できないことが確定した時刻数
+  int mCheckedNum;
+
+  // 作業用のマーク
+  // サイズは mNetwork.node_num()
+  vector<bool> mMarkArray;
+
+  // SATの解を保持する配列
+  vector<SatBool3> mSatModel;
+
+  // バックトレーサー
+  Justifier mJustifier;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 展開済みの時間フレーム数を返す．
+inline
+int
+DtpgSeq::frame_num() const
+{
+  return mGvarMapList.size();
+}
+
+// @brief 統計情報を得る．
+inline
+const DtpgStats&
+DtpgSeq::stats() const
+{
+  return mStats;
+}
+
+// @brief 正常値を得る．
+// @param[in] node 対象のノード
+// @param[in] time 時刻
+inline
+Val3
+DtpgSeq::gval(const TpgNode* node,
+	      int time) const
+{
+  SatVarId var = mGvarMapList[time](node);
+  return bool3_to_val3(mSatModel[var.val()]);
+}
+
+END_NAMESPACE_SATPG
+
+#endif // DTPGSEQ_H
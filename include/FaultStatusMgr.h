@@ -11,6 +11,7 @@
 
 #include "satpg.h"
 #include "FaultStatus.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_SATPG
@@ -18,6 +19,9 @@ BEGIN_NAMESPACE_SATPG
 //////////////////////////////////////////////////////////////////////
 /// @class FaultStatusMgr FaultStatusMgr.h "FaultStatusMgr.h"
 /// @brief 故障の状態を保持するクラス
+///
+/// 状態は std::atomic で保持しているので，複数のスレッドから
+/// 同時に set()/get() を呼んでもよい．
 //////////////////////////////////////////////////////////////////////
 class FaultStatusMgr
 {
@@ -43,6 +47,17 @@ public:
   set(const TpgFault* fault,
       FaultStatus status);
 
+  /// @brief 故障が未検出の場合のみ状態をセットする．
+  /// @param[in] fault 故障
+  /// @param[in] status 故障の状態
+  /// @return 状態を変更した場合に true を返す．
+  ///
+  /// 複数のスレッドが同じ故障に対して呼び出しても
+  /// true を返すのは一つだけとなる．
+  bool
+  set_if_undetected(const TpgFault* fault,
+		    FaultStatus status);
+
   /// @brief 故障の状態を得る．
   FaultStatus
   get(const TpgFault* fault) const;
@@ -61,7 +76,7 @@ private:
 
   // 各故障の状態を保持する配列
   // サイズは max_fault_id
-  vector<FaultStatus> mStatusArray;
+  vector<std::atomic<FaultStatus>> mStatusArray;
 
 };
 
@@ -14,11 +14,14 @@
 #include "FaultType.h"
 #include "PackedVal.h"
 #include "ym/Array.h"
+#include <functional>
+#include <memory>
 
 
 BEGIN_NAMESPACE_SATPG
 
 class FsimImpl;
+class SimTopology;
 
 //////////////////////////////////////////////////////////////////////
 /// @class Fsim Fsim.h "Fsim.h"
@@ -67,16 +70,53 @@ public:
   /// @brief 2値の故障シミュレータとして初期化する．
   /// @param[in] network ネットワーク
   /// @param[in] fault_type 故障の型
+  /// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+  ///
+  /// compiled_gval が true の場合，正常値の計算はネットワークを
+  /// レベル順の命令列に変換したもので行う．結果は変わらない．
   void
   init_fsim2(const TpgNetwork& network,
-	     FaultType fault_type);
+	     FaultType fault_type,
+	     bool compiled_gval = false);
 
   /// @brief 3値の故障シミュレータとして初期化する．
   /// @param[in] network ネットワーク
   /// @param[in] fault_type 故障の型
+  /// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+  ///
+  /// compiled_gval が true の場合，正常値の計算はネットワークを
+  /// レベル順の命令列に変換したもので行う．結果は変わらない．
   void
   init_fsim3(const TpgNetwork& network,
-	     FaultType fault_type);
+	     FaultType fault_type,
+	     bool compiled_gval = false);
+
+  /// @brief 故障シミュレータ用の回路構造を作る．
+  /// @param[in] network ネットワーク
+  ///
+  /// 結果は同じネットワークに対する init_fsim2()/init_fsim3() の間で
+  /// 共有できる．network より長く使ってはならない．
+  static
+  std::shared_ptr<const SimTopology>
+  make_topology(const TpgNetwork& network);
+
+  /// @brief 共有された回路構造を用いて2値の故障シミュレータとして初期化する．
+  /// @param[in] topology make_topology() で作った回路構造
+  /// @param[in] fault_type 故障の型
+  /// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+  void
+  init_fsim2(const std::shared_ptr<const SimTopology>& topology,
+	     FaultType fault_type,
+	     bool compiled_gval = false);
+
+  /// @brief 共有された回路構造を用いて3値の故障シミュレータとして初期化する．
+  /// @param[in] topology make_topology() で作った回路構造
+  /// @param[in] fault_type 故障の型
+  /// @param[in] compiled_gval 正常値計算をコンパイル方式で行う時 true にする．
+  void
+  init_fsim3(const std::shared_ptr<const SimTopology>& topology,
+	     FaultType fault_type,
+	     bool compiled_gval = false);
 
 
 public:
@@ -116,6 +156,73 @@ public:
   void
   clear_skip(const vector<const TpgFault*>& fault_list);
 
+  /// @brief ppsfp で用いるスレッド数を設定する．
+  /// @param[in] num スレッド数 ( num >= 1 )
+  ///
+  /// 2以上の場合は FFR を複数のスレッドに振り分けて故障伝搬を行う．
+  /// 結果(det_fault() の順序も含む)は1スレッドの場合と同一になる．<br>
+  /// 設定値は init_fsim2()/init_fsim3() の後も引き継がれる．
+  void
+  set_thread_num(int num);
+
+  /// @brief ppsfp で用いるスレッド数を返す．
+  int
+  thread_num() const;
+
+  /// @brief sppfp を並行故障シミュレーションで行うかどうかを設定する．
+  /// @param[in] flag true の時並行故障シミュレーションを用いる．
+  ///
+  /// 並行故障シミュレーションではノードごとに正常値と異なる値を持つ
+  /// 故障のリストを作って伝搬させるので，FFR ごとにイベントを伝搬させる
+  /// 通常の sppfp よりも生き残っている故障が少ない時に有利になる．
+  /// 検出される故障は同一だが det_fault() の順序は異なる．<br>
+  /// 設定値は init_fsim2()/init_fsim3() の後も引き継がれる．
+  void
+  set_concurrent(bool flag);
+
+  /// @brief sppfp を並行故障シミュレーションで行う時 true を返す．
+  bool
+  concurrent() const;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // N検出用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 全ての故障の目標検出回数を設定する．
+  /// @param[in] target 目標検出回数
+  ///
+  /// 検出回数が target に達した故障には自動的にスキップマークがつけられる．
+  /// target = 0 の場合は自動的にスキップマークをつけない．
+  void
+  set_det_target(int target);
+
+  /// @brief 故障の目標検出回数を設定する．
+  /// @param[in] f 対象の故障
+  /// @param[in] target 目標検出回数
+  void
+  set_det_target(const TpgFault* f,
+		 int target);
+
+  /// @brief 全ての故障の検出回数を0にする．
+  void
+  clear_det_count();
+
+  /// @brief 故障の検出回数を返す．
+  /// @param[in] f 対象の故障
+  ///
+  /// sppfp() では1回，ppsfp() では検出したパタン数だけ加算される．
+  int
+  det_count(const TpgFault* f);
+
+  /// @brief 検出回数のヒストグラムを返す．
+  ///
+  /// 返り値の k 番目の要素は検出回数が k の故障数となる．
+  /// スキップマークのついている故障も含む．
+  vector<int>
+  det_count_histogram();
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -164,6 +271,39 @@ public:
   int
   ppsfp();
 
+  /// @brief 複数のパタンで故障シミュレーションを行い結果を sink に送る．
+  /// @param[in] tv_list テストベクタのリスト
+  /// @param[in] sink 故障とそれを検出したパタン番号を受け取る関数
+  /// @param[in] ndet 故障をドロップするまでの検出回数
+  /// @return sink に送った (故障, パタン番号) の組の数を返す．
+  ///
+  /// tv_list は pv_bitlen() 個ずつ ppsfp() で処理される．
+  /// パタン番号は tv_list 中の位置で，同じ故障に対しては昇順に送られる．<br>
+  /// ndet > 0 の場合，ndet 回検出された故障は以降 sink に送られない．
+  /// ndet = 0 の場合はドロップしない．
+  /// 呼ぶ前にスキップマークのついていた故障は対象外となる．<br>
+  /// 検出回数は det_count() と共通のカウンタで数えるので，
+  /// 開始時に clear_det_count() が行われる．
+  /// スキップマークと故障ごとの目標検出回数は終了時に呼ぶ前の状態に戻る．<br>
+  /// ppsfp 用のパタンバッファの内容は失われる．
+  int
+  grade(const vector<TestVector>& tv_list,
+	const std::function<void(const TpgFault*, int)>& sink,
+	int ndet = 0);
+
+  /// @brief 複数のパタンで故障シミュレーションを行い結果をリストに追加する．
+  /// @param[in] tv_list テストベクタのリスト
+  /// @param[out] det_list 故障とそれを検出したパタン番号の組を追加するリスト
+  /// @param[in] ndet 故障をドロップするまでの検出回数
+  /// @return det_list に追加した要素数を返す．
+  ///
+  /// sink の代わりにリストに結果を追加する他は上と同じ．
+  /// 関数オブジェクトを渡せない python 用のインターフェイス．
+  int
+  grade(const vector<TestVector>& tv_list,
+	vector<pair<const TpgFault*, int>>& det_list,
+	int ndet = 0);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -173,15 +313,34 @@ public:
   /// @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
   /// @param[in] tv テストベクタ
   ///
-  /// - 外部入力以外は無視する．
-  /// - 時刻1の割り当ても無視する
+  /// tv の1時刻目(ppi_val())から2時刻目への遷移回数を数える．
+  /// 2時刻目の外部入力の値は遷移故障用の場合は aux_input_val() を用い，
+  /// 縮退故障用の場合は1時刻目と同じとする．<br>
   /// weightedの意味は以下の通り
   /// - false: ゲートの出力の遷移回数の和
   /// - true : ゲートの出力の遷移回数に(ファンアウト数＋１)を掛けたものの和
+  ///
+  /// 3値のシミュレータでは 0 と 1 の間の変化のみを遷移として数え，
+  /// X を含む変化は数えない．<br>
+  /// set_state() で設定した状態は失われる．
   int
   calc_wsa(const TestVector& tv,
 	   bool weighted);
 
+  /// @brief 複数のテストベクタの遷移回数をまとめて数える．
+  /// @param[in] tv_list テストベクタのリスト
+  /// @param[in] weighted 重み付きの遷移回数を求める時 true にする．
+  /// @param[out] wsa_list tv_list の各要素の遷移回数を納めるリスト
+  ///
+  /// 個々のテストベクタに対する結果は calc_wsa(tv, weighted) と同じだが，
+  /// FSIM_PV_BITLEN 個ずつビット並列にシミュレーションを行い，
+  /// 遷移回数もビットスライスのカウンタでまとめて数える．<br>
+  /// set_state() で設定した状態は失われる．
+  void
+  calc_wsa(const vector<TestVector>& tv_list,
+	   bool weighted,
+	   vector<int>& wsa_list);
+
   /// @brief 状態を設定する．
   /// @param[in] i_vect 外部入力のビットベクタ
   /// @param[in] f_vect FFの値のビットベクタ
@@ -198,29 +357,56 @@ public:
 
   /// @brief 1クロック分のシミュレーションを行い，遷移回数を数える．
   /// @param[in] i_vect 外部入力のビットベクタ
+  ///
+  /// X の扱いは calc_wsa(tv, weighted) と同じ．
   int
   calc_wsa(const InputVector& i_vect,
 	   bool weighted);
 
+  /// @brief 順序回路の故障シミュレーションを行う．
+  /// @param[in] init_state FFの初期値のビットベクタ
+  /// @param[in] input_list 各時刻の外部入力のビットベクタのリスト
+  /// @return 検出された故障数を返す．
+  ///
+  /// init_state から始めて input_list の長さ分のクロックを
+  /// シミュレーションし，いずれかの時刻で外部出力に故障の影響が
+  /// 現れた故障を検出されたとみなす．故障回路の FF の状態は時刻を
+  /// またがって引き継がれる．<br>
+  /// 故障は FSIM_PV_BITLEN 個ずつビット並列に処理される．<br>
+  /// 検出された故障は det_fault() で取得する．<br>
+  /// 縮退故障用のシミュレータでのみ意味を持つ．<br>
+  /// set_state() で設定した状態は失われる．
+  int
+  seqsim(const DffVector& init_state,
+	 const vector<InputVector>& input_list);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
   // ppsfp のテストパタンを設定する関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ppsfp で同時に扱えるパタン数を返す．
+  ///
+  /// kPvBitLen の倍数となる．
+  /// fsim のライブラリを FSIM_PV_WORDS を指定してコンパイルした場合には
+  /// kPvBitLen * FSIM_PV_WORDS となる．
+  int
+  pv_bitlen() const;
+
   /// @brief ppsfp 用のパタンバッファをクリアする．
   void
   clear_patterns();
 
   /// @brief ppsfp 用のパタンを設定する．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
   /// @param[in] tv テストベクタ
   void
   set_pattern(int pos,
 	      const TestVector& tv);
 
   /// @brief 設定した ppsfp 用のパタンを読み出す．
-  /// @param[in] pos 位置番号 ( 0 <= pos < kPvBitLen )
+  /// @param[in] pos 位置番号 ( 0 <= pos < pv_bitlen() )
   TestVector
   get_pattern(int pos);
 
@@ -245,10 +431,17 @@ public:
 
   /// @brief 直前の ppsfp で検出された故障の検出ビットパタンを返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < det_fault_num() )
+  /// @param[in] wpos ワード位置 ( 0 <= wpos < pv_bitlen() / kPvBitLen )
+  ///
+  /// pv_bitlen() が kPvBitLen より大きい場合には wpos 番目の
+  /// kPvBitLen ビット分を返す．
   PackedVal
-  det_fault_pat(int pos);
+  det_fault_pat(int pos,
+		int wpos = 0);
 
   /// @brief 直前の ppsfp で検出された故障に対する検出パタンのリストを返す．
+  ///
+  /// 1つの故障につき pv_bitlen() / kPvBitLen ワードずつ並んでいる．
   Array<PackedVal>
   det_fault_pat_list();
 
@@ -258,6 +451,12 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // ppsfp で用いるスレッド数
+  int mThreadNum;
+
+  // sppfp を並行故障シミュレーションで行う時 true にするフラグ
+  bool mConcurrent;
+
   // 実装クラス
   std::unique_ptr<FsimImpl> mImpl;
 
@@ -17,6 +17,9 @@ BEGIN_NAMESPACE_SATPG
 //////////////////////////////////////////////////////////////////////
 /// @class GateEnc GateEnc.h "GateEnc.h"
 /// @brief TpgNode の入出力の関係を表す CNF 式を作るクラス
+///
+/// 条件リテラルを指定した場合には生成する全ての節にその否定を加える．
+/// つまり条件リテラルが真の時のみ入出力の関係が成り立つ．
 //////////////////////////////////////////////////////////////////////
 class GateEnc
 {
@@ -28,6 +31,16 @@ public:
   GateEnc(SatSolver& solver,
 	  const VidMap& varmap);
 
+  /// @brief 条件リテラル付きのコンストラクタ
+  /// @param[in] solver SATソルバ
+  /// @param[in] varmap 変数番号のマップ
+  /// @param[in] cond_lit 条件リテラル
+  ///
+  /// cond_lit が偽になると生成した節は全て充足される．
+  GateEnc(SatSolver& solver,
+	  const VidMap& varmap,
+	  SatLiteral cond_lit);
+
   /// @brief デストラクタ
   ~GateEnc();
 
@@ -57,6 +70,18 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 条件リテラル付きで入出力の関係を表すCNF式を作る．
+  /// @param[in] node 対象のノード
+  /// @param[in] olit 出力のリテラル
+  void
+  make_cond_cnf(const TpgNode* node,
+		SatLiteral olit);
+
+  /// @brief 条件リテラルの否定を加えて節を追加する．
+  /// @param[in] lits 節のリテラルのリスト
+  void
+  add_cond_clause(vector<SatLiteral> lits);
+
   /// @brief ノードに対応するリテラルを返す．
   SatLiteral
   lit(const TpgNode* node);
@@ -73,6 +98,12 @@ private:
   // 変数番号のマップ
   const VidMap& mVarMap;
 
+  // 条件リテラルを持つ時 true にするフラグ
+  bool mHasCond;
+
+  // 条件リテラル
+  SatLiteral mCondLit;
+
 };
 
 END_NAMESPACE_SATPG
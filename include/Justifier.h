@@ -62,6 +62,25 @@ public:
 	     const VidMap& var2_map,
 	     const vector<SatBool3>& model);
 
+  /// @brief 正当化に必要な割当を求める(時間展開用)．
+  /// @param[in] assign_array 時刻ごとの値の割り当てリストの配列
+  /// @param[in] var_map_list 時刻ごとの変数番号のマップのリスト
+  /// @param[in] model SAT問題の解
+  /// @param[out] init_state FFの初期値
+  /// @param[out] input_list 時刻ごとの外部入力の値のリスト
+  ///
+  /// assign_array[t] は時刻 t で正当化する値の割り当てを表す．
+  /// 要素の時刻(NodeVal::time())は無視される．<br>
+  /// 時刻 t(> 0) の DFF の出力の値は時刻 t - 1 の DFF の入力に遡って
+  /// 正当化される．時刻 0 の DFF の出力の値は init_state に記録される．<br>
+  /// 値の決まらなかったビットは X となる．
+  void
+  operator()(const vector<NodeValList>& assign_array,
+	     const vector<VidMap>& var_map_list,
+	     const vector<SatBool3>& model,
+	     DffVector& init_state,
+	     vector<InputVector>& input_list);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
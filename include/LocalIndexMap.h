@@ -0,0 +1,206 @@
+#ifndef LOCALINDEXMAP_H
+#define LOCALINDEXMAP_H
+
+/// @file LocalIndexMap.h
+/// @brief LocalIndexMap のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "satpg.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class LocalIndexMap LocalIndexMap.h "LocalIndexMap.h"
+/// @brief ノード番号などのキーを局所的な連番に付け替えるクラス
+///
+/// 登録された順に 0 から始まる番号(ローカルインデックス)を割り当てる．
+/// 利用側はローカルインデックスをキーにした配列に値を持てばよいので，
+/// コーンに含まれるノードだけを扱う場合にネットワーク全体の大きさの
+/// 配列を確保しなくて済む．<br>
+/// 実装は VidMap の疎なモードと同じくオープンアドレス法のハッシュ表で，
+/// clear() のコストも登録されたキーの数に比例する．<br>
+/// キーは非負の整数でなければならない．
+//////////////////////////////////////////////////////////////////////
+class LocalIndexMap
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] size_hint 登録されるキー数の見積もり
+  ///
+  /// size_hint を越えて登録しても構わない．
+  LocalIndexMap(int size_hint = 0);
+
+  /// @brief デストラクタ
+  ~LocalIndexMap();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 登録されているキー数を返す．
+  ///
+  /// ローカルインデックスは 0 から size() - 1 の範囲となる．
+  int
+  size() const;
+
+  /// @brief キーに対応するローカルインデックスを返す．
+  /// @param[in] key キー ( key >= 0 )
+  ///
+  /// 登録されていない場合は -1 を返す．
+  int
+  find(int key) const;
+
+  /// @brief キーを登録してローカルインデックスを返す．
+  /// @param[in] key キー ( key >= 0 )
+  ///
+  /// すでに登録されている場合はそのローカルインデックスを返す．
+  /// そうでなければ size() を割り当てる．
+  int
+  reg(int key);
+
+  /// @brief 全ての登録を消す．
+  ///
+  /// 確保した領域はそのまま再利用する．
+  void
+  clear();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ表の中の位置を返す．
+  /// @param[in] key キー
+  ///
+  /// key が登録されていない場合には空きの位置を返す．
+  int
+  _find(int key) const;
+
+  /// @brief ハッシュ表を拡大する．
+  /// @param[in] req_size 必要な要素数
+  void
+  _expand(int req_size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ハッシュ表のマスク
+  // ハッシュ表のサイズは mHashMask + 1 (2のべき乗)
+  int mHashMask;
+
+  // キーの配列
+  // 空きは -1
+  vector<int> mKeyArray;
+
+  // ローカルインデックスの配列
+  // mKeyArray と同じ位置に値を格納する．
+  vector<int> mIndexArray;
+
+  // ローカルインデックスをキーにしてハッシュ表の中の位置を納める配列
+  // clear() で用いる．
+  vector<int> mPosArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] size_hint 登録されるキー数の見積もり
+inline
+LocalIndexMap::LocalIndexMap(int size_hint) :
+  mHashMask(0)
+{
+  _expand(size_hint);
+}
+
+// @brief デストラクタ
+inline
+LocalIndexMap::~LocalIndexMap()
+{
+}
+
+// @brief 登録されているキー数を返す．
+inline
+int
+LocalIndexMap::size() const
+{
+  return mPosArray.size();
+}
+
+// @brief キーに対応するローカルインデックスを返す．
+// @param[in] key キー ( key >= 0 )
+inline
+int
+LocalIndexMap::find(int key) const
+{
+  ASSERT_COND( key >= 0 );
+
+  int pos = _find(key);
+  if ( mKeyArray[pos] == -1 ) {
+    return -1;
+  }
+  return mIndexArray[pos];
+}
+
+// @brief キーを登録してローカルインデックスを返す．
+// @param[in] key キー ( key >= 0 )
+inline
+int
+LocalIndexMap::reg(int key)
+{
+  ASSERT_COND( key >= 0 );
+
+  int pos = _find(key);
+  if ( mKeyArray[pos] != -1 ) {
+    return mIndexArray[pos];
+  }
+  int index = size();
+  if ( (index + 1) * 2 > mHashMask + 1 ) {
+    _expand(index + 1);
+    pos = _find(key);
+  }
+  mKeyArray[pos] = key;
+  mIndexArray[pos] = index;
+  mPosArray.push_back(pos);
+  return index;
+}
+
+// @brief ハッシュ表の中の位置を返す．
+// @param[in] key キー
+//
+// key が登録されていない場合には空きの位置を返す．
+inline
+int
+LocalIndexMap::_find(int key) const
+{
+  // 線形探査を行う．
+  // 充填率は 1/2 以下に保たれているので必ず空きがある．
+  ymuint32 h = static_cast<ymuint32>(key) * 2654435769U;
+  int pos = static_cast<int>(h ^ (h >> 16)) & mHashMask;
+  for ( ; ; ) {
+    int key1 = mKeyArray[pos];
+    if ( key1 == key || key1 == -1 ) {
+      return pos;
+    }
+    pos = (pos + 1) & mHashMask;
+  }
+}
+
+END_NAMESPACE_SATPG
+
+#endif // LOCALINDEXMAP_H
@@ -54,14 +54,20 @@ public:
 
   /// @brief 彩色問題でパタン圧縮を行う．
   /// @param[in] tv_list 初期テストパタンのリスト
+  /// @param[in] algorithm 彩色アルゴリズム
   /// @param[out] new_tv_list 圧縮結果のテストパタンのリスト
   /// @return 結果のパタン数を返す．
+  ///
+  /// algorithm は以下のいずれか
+  /// - "dsatur" : 縮約後に残ったパタンを Dsatur で彩色する．
+  /// - それ以外 : heuristic1 を用いる．
   static
   int
   coloring(const vector<const TpgFault*>& fault_list,
 	   const vector<TestVector>& tv_list,
 	   const TpgNetwork& network,
 	   FaultType fault_type,
+	   const string& algorithm,
 	   vector<TestVector>& new_tv_list);
 
 
@@ -87,6 +93,18 @@ private:
 	     MpColGraph& graph,
 	     vector<int>& selected_cols);
 
+  /// @brief Dsatur を用いて彩色する．
+  /// @param[in] matrix 対象の被覆行列
+  /// @param[in] graph 衝突グラフ
+  /// @param[in] selected_cols 縮約で選択された列のリスト
+  ///
+  /// selected_cols と matrix に残っている列を全て彩色する．
+  static
+  void
+  dsatur(const McMatrix& matrix,
+	 MpColGraph& graph,
+	 const vector<int>& selected_cols);
+
   /// @brief 両立集合を取り出す．
   /// @param[in] graph 衝突グラフ
   /// @param[in] matrix 被覆行列
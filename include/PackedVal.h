@@ -64,6 +64,43 @@ count_ones(PackedVal word)
   return word;
 }
 
+/// @brief pos 番目のビットが1の時 true を返す．
+/// @param[in] word 対象のワード
+/// @param[in] pos ビット位置 ( 0 <= pos < kPvBitLen )
+inline
+bool
+get_bit(PackedVal word,
+	int pos)
+{
+  return static_cast<bool>((word >> pos) & 1UL);
+}
+
+/// @brief pos 番目のビットを1にする．
+/// @param[in] word 対象のワード
+/// @param[in] pos ビット位置 ( 0 <= pos < kPvBitLen )
+inline
+void
+set_bit(PackedVal& word,
+	int pos)
+{
+  word |= (1UL << pos);
+}
+
+/// @brief wpos 番目のワードを取り出す．
+/// @param[in] word 対象のワード
+/// @param[in] wpos ワード位置 ( wpos == 0 )
+///
+/// PackedValW と同じ形で扱うための関数
+inline
+PackedVal
+get_word(PackedVal word,
+	 int wpos)
+{
+  ASSERT_COND( wpos == 0 );
+
+  return word;
+}
+
 END_NAMESPACE_SATPG
 
 #endif // PACKEDVAL_H
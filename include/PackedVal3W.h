@@ -0,0 +1,502 @@
+#ifndef PACKEDVAL3W_H
+#define PACKEDVAL3W_H
+
+/// @file PackedVal3W.h
+/// @brief 複数ワードにパックした3値のビットベクタ型の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "satpg.h"
+#include "PackedValW.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class PackedVal3W PackedVal3W.h "PackedVal3W.h"
+/// @brief PackedValW<N> 2つで3値のビットベクタを表すクラス
+///
+/// 中身は PackedVal3 の PackedVal を PackedValW<N> に置き換えたもの．
+//////////////////////////////////////////////////////////////////////
+template<int N>
+class PackedVal3W
+{
+public:
+
+  /// @brief ワードの型
+  using WordType = PackedValW<N>;
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 不定値になる．
+  PackedVal3W();
+
+  /// @brief コピーコンストラクタ
+  PackedVal3W(const PackedVal3W& src) = default;
+
+  /// @brief コンストラクタ
+  /// @param[in] val0 0を表すビットベクタ
+  /// @param[in] val1 1を表すビットベクタ
+  ///
+  /// val0 と val1 の両方のビットが1になったら不正
+  PackedVal3W(const WordType& val0,
+	      const WordType& val1);
+
+  /// @brief 2値のビットベクタからの変換コンストラクタ
+  /// @param[in] val 値
+  explicit
+  PackedVal3W(const WordType& val);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @grief 0 のワードを取り出す．
+  WordType
+  val0() const;
+
+  /// @brief 1 のワードを取り出す．
+  WordType
+  val1() const;
+
+  /// @brief 0|1 か X かを区別するワードを取り出す．
+  ///
+  /// 1のビットはもとの値が0か1
+  WordType
+  val01() const;
+
+  /// @brief 普通の代入演算子
+  PackedVal3W&
+  operator=(const PackedVal3W& val) = default;
+
+  /// @brief 値をセットする．
+  /// @param[in] val0, val1 値
+  void
+  set(const WordType& val0,
+      const WordType& val1);
+
+  /// @brief マスク付きで値をセットする．
+  /// @param[in] val 値
+  /// @param[in] mask
+  void
+  set_with_mask(const PackedVal3W& val,
+		const WordType& mask);
+
+  /// @brief マスク付きで値をセットする．
+  /// @param[in] val 値
+  /// @param[in] mask
+  void
+  set_with_mask(const WordType& val,
+		const WordType& mask);
+
+  /// @brief 自身を否定する演算
+  /// @return 演算後の自身の参照を返す．
+  const PackedVal3W&
+  negate();
+
+  /// @brief AND付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  const PackedVal3W&
+  operator&=(const PackedVal3W& right);
+
+  /// @brief OR付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  const PackedVal3W&
+  operator|=(const PackedVal3W& right);
+
+  /// @brief XOR付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  const PackedVal3W&
+  operator^=(const PackedVal3W& right);
+
+  /// @brief XOR付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  ///
+  /// right が2値のバージョン
+  const PackedVal3W&
+  operator^=(const WordType& right);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 0のワード
+  WordType mVal0;
+
+  // 1のワード
+  WordType mVal1;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// PackedVal3W の演算
+//////////////////////////////////////////////////////////////////////
+
+/// @relates PackedVal3W
+/// @brief 比較演算子 (EQ)
+/// @param[in] left, right オペランド
+template<int N>
+bool
+operator==(const PackedVal3W<N>& left,
+	   const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief 比較演算子 (NE)
+/// @param[in] left, right オペランド
+template<int N>
+bool
+operator!=(const PackedVal3W<N>& left,
+	   const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief 否定演算
+/// @param[in] right オペランド
+template<int N>
+PackedVal3W<N>
+operator~(const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief AND演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedVal3W<N>
+operator&(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief OR演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedVal3W<N>
+operator|(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief XOR演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedVal3W<N>
+operator^(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right);
+
+/// @relates PackedVal3W
+/// @brief XOR演算
+/// @param[in] left, right オペランド
+///
+/// right が2値のバージョン
+template<int N>
+PackedVal3W<N>
+operator^(const PackedVal3W<N>& left,
+	  const PackedValW<N>& right);
+
+/// @relates PackedVal3W
+/// @brief DIFF演算
+/// @param[in] left, right オペランド
+///
+/// どちらかが 0 で他方が 1 のビットに1を立てたビットベクタを返す．
+template<int N>
+PackedValW<N>
+diff(const PackedVal3W<N>& left,
+     const PackedVal3W<N>& right);
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+//
+// 不定値になる．
+template<int N>
+inline
+PackedVal3W<N>::PackedVal3W() :
+  mVal0(kPvAll0),
+  mVal1(kPvAll0)
+{
+}
+
+// @brief 2値のコンストラクタ
+// @param[in] val 値
+template<int N>
+inline
+PackedVal3W<N>::PackedVal3W(const WordType& val) :
+  mVal0(~val),
+  mVal1( val)
+{
+}
+
+// @brief コンストラクタ
+// @param[in] val0, val1 値
+template<int N>
+inline
+PackedVal3W<N>::PackedVal3W(const WordType& val0,
+			    const WordType& val1)
+{
+  set(val0, val1);
+}
+
+// @grief 0 のワードを取り出す．
+template<int N>
+inline
+PackedValW<N>
+PackedVal3W<N>::val0() const
+{
+  return mVal0;
+}
+
+// @brief 1 のワードを取り出す．
+template<int N>
+inline
+PackedValW<N>
+PackedVal3W<N>::val1() const
+{
+  return mVal1;
+}
+
+// @brief 0|1 か X かを区別するワードを取り出す．
+//
+// 1のビットはもとの値が0か1
+template<int N>
+inline
+PackedValW<N>
+PackedVal3W<N>::val01() const
+{
+  return mVal0 | mVal1;
+}
+
+// @brief 値をセットする．
+// @param[in] val0, val1 値
+template<int N>
+inline
+void
+PackedVal3W<N>::set(const WordType& val0,
+		    const WordType& val1)
+{
+  // 両方が1のビットは不定値(X)にする．
+  mVal0 = val0 & ~val1;
+  mVal1 = val1 & ~val0;
+}
+
+// @brief マスク付きで値をセットする．
+// @param[in] val 値
+// @param[in] mask
+template<int N>
+inline
+void
+PackedVal3W<N>::set_with_mask(const PackedVal3W& val,
+			      const WordType& mask)
+{
+  mVal0 &= ~mask;
+  mVal0 |= val.mVal0 & mask;
+  mVal1 &= ~mask;
+  mVal1 |= val.mVal1 & mask;
+}
+
+// @brief マスク付きで値をセットする．
+// @param[in] val 値
+// @param[in] mask
+template<int N>
+inline
+void
+PackedVal3W<N>::set_with_mask(const WordType& val,
+			      const WordType& mask)
+{
+  mVal0 &= ~mask;
+  mVal0 |= (~val & mask);
+  mVal1 &= ~mask;
+  mVal1 |= ( val & mask);
+}
+
+// @brief 自身を否定する演算
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+const PackedVal3W<N>&
+PackedVal3W<N>::negate()
+{
+  WordType tmp = mVal0;
+  mVal0 = mVal1;
+  mVal1 = tmp;
+
+  return *this;
+}
+
+// @brief AND付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+const PackedVal3W<N>&
+PackedVal3W<N>::operator&=(const PackedVal3W& right)
+{
+  mVal0 |= right.mVal0;
+  mVal1 &= right.mVal1;
+
+  return *this;
+}
+
+// @brief OR付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+const PackedVal3W<N>&
+PackedVal3W<N>::operator|=(const PackedVal3W& right)
+{
+  mVal0 &= right.mVal0;
+  mVal1 |= right.mVal1;
+
+  return *this;
+}
+
+// @brief XOR付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+const PackedVal3W<N>&
+PackedVal3W<N>::operator^=(const PackedVal3W& right)
+{
+  WordType tmp0_0 = mVal0 | right.mVal1;
+  WordType tmp0_1 = mVal1 & right.mVal0;
+
+  WordType tmp1_0 = mVal1 | right.mVal0;
+  WordType tmp1_1 = mVal0 & right.mVal1;
+
+  mVal0 = tmp0_0 & tmp1_0;
+  mVal1 = tmp0_1 | tmp1_1;
+
+  return *this;
+}
+
+// @brief XOR付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+//
+// right が2値のバージョン
+template<int N>
+inline
+const PackedVal3W<N>&
+PackedVal3W<N>::operator^=(const WordType& right)
+{
+  WordType tmp_val0 = mVal0;
+  WordType tmp_val1 = mVal1;
+
+  mVal0 &= ~right;
+  mVal0 |= tmp_val1 & right;
+  mVal1 &= ~right;
+  mVal1 |= tmp_val0 & right;
+
+  return *this;
+}
+
+// @brief 比較演算子 (EQ)
+// @param[in] left, right オペランド
+template<int N>
+inline
+bool
+operator==(const PackedVal3W<N>& left,
+	   const PackedVal3W<N>& right)
+{
+  return left.val0() == right.val0() && left.val1() == right.val1();
+}
+
+// @brief 比較演算子 (NE)
+// @param[in] left, right オペランド
+template<int N>
+inline
+bool
+operator!=(const PackedVal3W<N>& left,
+	   const PackedVal3W<N>& right)
+{
+  return !operator==(left, right);
+}
+
+// @brief 否定演算
+// @param[in] right オペランド
+template<int N>
+inline
+PackedVal3W<N>
+operator~(const PackedVal3W<N>& right)
+{
+  return PackedVal3W<N>(right.val1(), right.val0());
+}
+
+// @brief AND演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedVal3W<N>
+operator&(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right)
+{
+  return PackedVal3W<N>(left).operator&=(right);
+}
+
+// @brief OR演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedVal3W<N>
+operator|(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right)
+{
+  return PackedVal3W<N>(left).operator|=(right);
+}
+
+// @brief XOR演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedVal3W<N>
+operator^(const PackedVal3W<N>& left,
+	  const PackedVal3W<N>& right)
+{
+  return PackedVal3W<N>(left).operator^=(right);
+}
+
+// @brief XOR演算
+// @param[in] left, right オペランド
+//
+// right が2値のバージョン
+template<int N>
+inline
+PackedVal3W<N>
+operator^(const PackedVal3W<N>& left,
+	  const PackedValW<N>& right)
+{
+  return PackedVal3W<N>(left).operator^=(right);
+}
+
+// @brief DIFF演算
+// @param[in] left, right オペランド
+//
+// どちらかが 0 で他方が 1 のビットに1を立てたビットベクタを返す．
+template<int N>
+inline
+PackedValW<N>
+diff(const PackedVal3W<N>& left,
+     const PackedVal3W<N>& right)
+{
+  auto val0_0 = left.val0();
+  auto val0_1 = left.val1();
+  auto val1_0 = right.val0();
+  auto val1_1 = right.val1();
+
+  return (val0_0 & ~val0_1 & ~val1_0 & val1_1) | (~val0_0 & val0_1 & val1_0 & ~val1_1);
+}
+
+END_NAMESPACE_SATPG
+
+#endif // PACKEDVAL3W_H
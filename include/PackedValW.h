@@ -0,0 +1,418 @@
+#ifndef PACKEDVALW_H
+#define PACKEDVALW_H
+
+/// @file PackedValW.h
+/// @brief 複数ワードにパックしたビットベクタ型の定義ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2018 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "satpg.h"
+#include "PackedVal.h"
+
+
+BEGIN_NAMESPACE_SATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class PackedValW PackedValW.h "PackedValW.h"
+/// @brief N ワードのビットベクタを表すクラス
+///
+/// PackedVal と同じ演算子を持つので故障シミュレータの値の型として
+/// そのまま置き換えて使うことができる．<br>
+/// 各演算はワード数 N の固定長ループになっているので，
+/// N = 4 (256ビット) や N = 8 (512ビット) の時には -mavx2 や -mavx512f
+/// を指定してコンパイルすればコンパイラがベクタ命令に変換する．
+//////////////////////////////////////////////////////////////////////
+template<int N>
+class PackedValW
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ///
+  /// 内容は不定
+  PackedValW() = default;
+
+  /// @brief 1ワードの値からの変換コンストラクタ
+  /// @param[in] val 値
+  ///
+  /// 全てのワードに val をセットする．
+  explicit
+  PackedValW(PackedVal val);
+
+  /// @brief コピーコンストラクタ
+  PackedValW(const PackedValW& src) = default;
+
+  /// @brief 代入演算子
+  PackedValW&
+  operator=(const PackedValW& src) = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ワードを取り出す．
+  /// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+  PackedVal
+  word(int wpos) const;
+
+  /// @brief ワードを設定する．
+  /// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+  /// @param[in] val 値
+  void
+  set_word(int wpos,
+	   PackedVal val);
+
+  /// @brief AND付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  PackedValW&
+  operator&=(const PackedValW& right);
+
+  /// @brief OR付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  PackedValW&
+  operator|=(const PackedValW& right);
+
+  /// @brief XOR付き代入
+  /// @param[in] right オペランド
+  /// @return 演算後の自身の参照を返す．
+  PackedValW&
+  operator^=(const PackedValW& right);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 本体
+  // ベクタ命令でロードできるようにアラインメントをそろえておく．
+  // new や vector で確保した領域がこれに従うのは C++17 以降．
+  alignas(N * sizeof(PackedVal)) PackedVal mWord[N];
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// PackedValW の演算
+//////////////////////////////////////////////////////////////////////
+
+/// @relates PackedValW
+/// @brief 比較演算子 (EQ)
+/// @param[in] left, right オペランド
+template<int N>
+bool
+operator==(const PackedValW<N>& left,
+	   const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief 比較演算子 (NE)
+/// @param[in] left, right オペランド
+template<int N>
+bool
+operator!=(const PackedValW<N>& left,
+	   const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief 否定演算
+/// @param[in] right オペランド
+template<int N>
+PackedValW<N>
+operator~(const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief AND演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedValW<N>
+operator&(const PackedValW<N>& left,
+	  const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief OR演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedValW<N>
+operator|(const PackedValW<N>& left,
+	  const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief XOR演算
+/// @param[in] left, right オペランド
+template<int N>
+PackedValW<N>
+operator^(const PackedValW<N>& left,
+	  const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief 2つのビットベクタの差分を求める．
+/// @param[in] left, right オペランド
+template<int N>
+PackedValW<N>
+diff(const PackedValW<N>& left,
+     const PackedValW<N>& right);
+
+/// @relates PackedValW
+/// @brief 1のビット数を数える．
+/// @param[in] val 対象のビットベクタ
+template<int N>
+int
+count_ones(const PackedValW<N>& val);
+
+/// @relates PackedValW
+/// @brief pos 番目のビットが1の時 true を返す．
+/// @param[in] val 対象のビットベクタ
+/// @param[in] pos ビット位置 ( 0 <= pos < N * kPvBitLen )
+template<int N>
+bool
+get_bit(const PackedValW<N>& val,
+	int pos);
+
+/// @relates PackedValW
+/// @brief pos 番目のビットを1にする．
+/// @param[in] val 対象のビットベクタ
+/// @param[in] pos ビット位置 ( 0 <= pos < N * kPvBitLen )
+template<int N>
+void
+set_bit(PackedValW<N>& val,
+	int pos);
+
+/// @relates PackedValW
+/// @brief wpos 番目のワードを取り出す．
+/// @param[in] val 対象のビットベクタ
+/// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+template<int N>
+PackedVal
+get_word(const PackedValW<N>& val,
+	 int wpos);
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 1ワードの値からの変換コンストラクタ
+// @param[in] val 値
+template<int N>
+inline
+PackedValW<N>::PackedValW(PackedVal val)
+{
+  for ( int i = 0; i < N; ++ i ) {
+    mWord[i] = val;
+  }
+}
+
+// @brief ワードを取り出す．
+// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+template<int N>
+inline
+PackedVal
+PackedValW<N>::word(int wpos) const
+{
+  ASSERT_COND( wpos >= 0 && wpos < N );
+
+  return mWord[wpos];
+}
+
+// @brief ワードを設定する．
+// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+// @param[in] val 値
+template<int N>
+inline
+void
+PackedValW<N>::set_word(int wpos,
+			PackedVal val)
+{
+  ASSERT_COND( wpos >= 0 && wpos < N );
+
+  mWord[wpos] = val;
+}
+
+// @brief AND付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+PackedValW<N>&
+PackedValW<N>::operator&=(const PackedValW& right)
+{
+  for ( int i = 0; i < N; ++ i ) {
+    mWord[i] &= right.mWord[i];
+  }
+  return *this;
+}
+
+// @brief OR付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+PackedValW<N>&
+PackedValW<N>::operator|=(const PackedValW& right)
+{
+  for ( int i = 0; i < N; ++ i ) {
+    mWord[i] |= right.mWord[i];
+  }
+  return *this;
+}
+
+// @brief XOR付き代入
+// @param[in] right オペランド
+// @return 演算後の自身の参照を返す．
+template<int N>
+inline
+PackedValW<N>&
+PackedValW<N>::operator^=(const PackedValW& right)
+{
+  for ( int i = 0; i < N; ++ i ) {
+    mWord[i] ^= right.mWord[i];
+  }
+  return *this;
+}
+
+// @brief 比較演算子 (EQ)
+// @param[in] left, right オペランド
+template<int N>
+inline
+bool
+operator==(const PackedValW<N>& left,
+	   const PackedValW<N>& right)
+{
+  // 途中で抜けるとベクタ化されないので全ワードの差分を OR する．
+  PackedVal tmp = kPvAll0;
+  for ( int i = 0; i < N; ++ i ) {
+    tmp |= left.word(i) ^ right.word(i);
+  }
+  return tmp == kPvAll0;
+}
+
+// @brief 比較演算子 (NE)
+// @param[in] left, right オペランド
+template<int N>
+inline
+bool
+operator!=(const PackedValW<N>& left,
+	   const PackedValW<N>& right)
+{
+  return !operator==(left, right);
+}
+
+// @brief 否定演算
+// @param[in] right オペランド
+template<int N>
+inline
+PackedValW<N>
+operator~(const PackedValW<N>& right)
+{
+  PackedValW<N> ans;
+  for ( int i = 0; i < N; ++ i ) {
+    ans.set_word(i, ~right.word(i));
+  }
+  return ans;
+}
+
+// @brief AND演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedValW<N>
+operator&(const PackedValW<N>& left,
+	  const PackedValW<N>& right)
+{
+  return PackedValW<N>(left).operator&=(right);
+}
+
+// @brief OR演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedValW<N>
+operator|(const PackedValW<N>& left,
+	  const PackedValW<N>& right)
+{
+  return PackedValW<N>(left).operator|=(right);
+}
+
+// @brief XOR演算
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedValW<N>
+operator^(const PackedValW<N>& left,
+	  const PackedValW<N>& right)
+{
+  return PackedValW<N>(left).operator^=(right);
+}
+
+// @brief 2つのビットベクタの差分を求める．
+// @param[in] left, right オペランド
+template<int N>
+inline
+PackedValW<N>
+diff(const PackedValW<N>& left,
+     const PackedValW<N>& right)
+{
+  return left ^ right;
+}
+
+// @brief 1のビット数を数える．
+// @param[in] val 対象のビットベクタ
+template<int N>
+inline
+int
+count_ones(const PackedValW<N>& val)
+{
+  int n = 0;
+  for ( int i = 0; i < N; ++ i ) {
+    n += count_ones(val.word(i));
+  }
+  return n;
+}
+
+// @brief pos 番目のビットが1の時 true を返す．
+// @param[in] val 対象のビットベクタ
+// @param[in] pos ビット位置 ( 0 <= pos < N * kPvBitLen )
+template<int N>
+inline
+bool
+get_bit(const PackedValW<N>& val,
+	int pos)
+{
+  return get_bit(val.word(pos / kPvBitLen), pos % kPvBitLen);
+}
+
+// @brief pos 番目のビットを1にする．
+// @param[in] val 対象のビットベクタ
+// @param[in] pos ビット位置 ( 0 <= pos < N * kPvBitLen )
+template<int N>
+inline
+void
+set_bit(PackedValW<N>& val,
+	int pos)
+{
+  int wpos = pos / kPvBitLen;
+  auto word = val.word(wpos);
+  set_bit(word, pos % kPvBitLen);
+  val.set_word(wpos, word);
+}
+
+// @brief wpos 番目のワードを取り出す．
+// @param[in] val 対象のビットベクタ
+// @param[in] wpos ワード位置 ( 0 <= wpos < N )
+template<int N>
+inline
+PackedVal
+get_word(const PackedValW<N>& val,
+	 int wpos)
+{
+  return val.word(wpos);
+}
+
+END_NAMESPACE_SATPG
+
+#endif // PACKEDVALW_H
@@ -10,14 +10,29 @@
 
 
 #include "satpg.h"
-#include "ym/RandGen.h"
+#include "TpgNetwork.h"
+#include "FaultType.h"
+#include "TestVector.h"
+#include "Fsim.h"
+#include <random>
 
 
 BEGIN_NAMESPACE_SATPG
 
+class FaultStatusMgr;
+
 //////////////////////////////////////////////////////////////////////
 /// @class Rtpg Rtpg.h "Rtpg.h"
 /// @brief ランダムパタンによる故障シミュレーションでテストパタンを求めるクラス
+///
+/// Fsim::pv_bitlen() 個のランダムパタンをまとめて ppsfp で
+/// 故障シミュレーションし，検出された故障はドロップする．<br>
+/// 新たに故障を検出したパタンのみを残す．<br>
+/// 1ブロックあたりの新規検出故障数が min_f を下回るブロックが
+/// max_i 回連続したら打ち切る．<br>
+/// set_weight() で各入力が 1 になる確率を指定すると重み付きランダム
+/// パタンを用いる．重みは weight_from_cubes() で既存のテストキューブ
+/// から求めることができる．
 //////////////////////////////////////////////////////////////////////
 class Rtpg
 {
@@ -25,10 +40,8 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] network 対象のネットワーク
-  /// @param[in] tvmgr TvMgr
   /// @param[in] fault_type 故障の種類
   Rtpg(const TpgNetwork& network,
-       TvMgr& tvmgr,
        FaultType fault_type);
 
   /// @brief デストラクタ
@@ -49,25 +62,78 @@ public:
   void
   randgen_init(ymuint32 seed);
 
-  /// @brief 1セット(kPvBitLen個)のパタンで故障シミュレーションを行う．
-  /// @return 新たに検出された故障数を返す．
+  /// @brief 重み付きランダムパタン用の重みを設定する．
+  /// @param[in] prob_list 各入力が 1 になる確率のリスト
+  ///
+  /// prob_list のサイズは TestVector::vector_size() と等しくなければならない．
+  /// 空のリストを与えた場合は clear_weight() と同じ．
+  void
+  set_weight(const vector<double>& prob_list);
+
+  /// @brief 重みをクリアして一様なランダムパタンに戻す．
+  void
+  clear_weight();
+
+  /// @brief 重みが設定されている時 true を返す．
+  bool
+  has_weight() const;
+
+  /// @brief テストキューブのリストから重みを求める．
+  /// @param[in] cube_list テストキューブ(X を含むテストベクタ)のリスト
+  /// @param[in] min_prob 確率の下限
+  /// @return 各入力が 1 になる確率のリスト
+  ///
+  /// 各入力ごとに X 以外の値の出現数から (n1 + 1) / (n0 + n1 + 2) を
+  /// 求め，[min_prob, 1 - min_prob] の範囲に丸める．<br>
+  /// cube_list の要素は全て同じサイズでなければならない．<br>
+  /// cube_list が空の場合は空のリストを返すので，そのまま set_weight()
+  /// に渡すと一様なランダムパタンとなる．
+  static
+  vector<double>
+  weight_from_cubes(const vector<TestVector>& cube_list,
+		    double min_prob = 0.05);
+
+  /// @brief ランダムパタンによるテスト生成を行う．
+  /// @param[in] fmgr 故障の状態を保持するオブジェクト
+  /// @param[in] min_f 1ブロックで検出する故障数の下限
+  /// @param[in] max_i min_f を下回るブロックの連続回数の上限
+  /// @param[in] max_pat シミュレーションするパタン数の上限
+  /// @return 検出された故障数を返す．
+  ///
+  /// fmgr で未検出となっている故障のみを対象とする．<br>
+  /// 検出された故障は fmgr 上で検出済みとなる．
   int
-  do_fsim();
+  run(FaultStatusMgr& fmgr,
+      int min_f,
+      int max_i,
+      int max_pat);
 
-  /// @brief 検出された故障のリストを返す．
+  /// @brief 直前の run() で検出された故障のリストを返す．
   const vector<const TpgFault*>&
   det_fault_list() const;
 
-  /// @brief 故障を検出したパタンのリストを返す．
-  const vector<const TestVector*>&
+  /// @brief 直前の run() で故障を検出したパタンのリストを返す．
+  const vector<TestVector>&
   pattern_list() const;
 
+  /// @brief 直前の run() でシミュレーションしたパタン数を返す．
+  int
+  sim_pat_num() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 1ブロック分のパタンで故障シミュレーションを行う．
+  /// @param[in] fmgr 故障の状態を保持するオブジェクト
+  /// @param[in] num パタン数 ( 1 <= num <= mFsim.pv_bitlen() )
+  /// @return 新たに検出された故障数を返す．
+  int
+  do_fsim(FaultStatusMgr& fmgr,
+	  int num);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -77,26 +143,87 @@ private:
   // 故障の種類
   FaultType mFaultType;
 
-  // 乱数発生器
-  RandGen mRandGen;
+  // 対象のネットワーク
+  const TpgNetwork& mNetwork;
 
-  // TvMgr
-  TvMgr& mTvMgr;
+  // 乱数発生器
+  std::mt19937 mRandGen;
 
   // 故障シミュレータ
-  Fsim* mFsim;
+  Fsim mFsim;
 
   // 現在のパタンを入れておくバッファ
-  TestVector* tv_array[kPvBitLen];
+  // サイズは mFsim.pv_bitlen()
+  vector<TestVector> mTvArray;
+
+  // 重み付きランダムパタン用の重み
+  // 空の時は一様なランダムパタンを用いる．
+  vector<double> mWeight;
 
   // 検出された故障のリスト
   vector<const TpgFault*> mDetFaultList;
 
   // 故障を検出したパタンのリスト
-  vector<const TestVector*> mPatternList;
+  vector<TestVector> mPatternList;
+
+  // シミュレーションしたパタン数
+  int mSimPatNum;
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 故障の種類を返す．
+inline
+FaultType
+Rtpg::fault_type() const
+{
+  return mFaultType;
+}
+
+// @brief 重みをクリアして一様なランダムパタンに戻す．
+inline
+void
+Rtpg::clear_weight()
+{
+  mWeight.clear();
+}
+
+// @brief 重みが設定されている時 true を返す．
+inline
+bool
+Rtpg::has_weight() const
+{
+  return !mWeight.empty();
+}
+
+// @brief 直前の run() で検出された故障のリストを返す．
+inline
+const vector<const TpgFault*>&
+Rtpg::det_fault_list() const
+{
+  return mDetFaultList;
+}
+
+// @brief 直前の run() で故障を検出したパタンのリストを返す．
+inline
+const vector<TestVector>&
+Rtpg::pattern_list() const
+{
+  return mPatternList;
+}
+
+// @brief 直前の run() でシミュレーションしたパタン数を返す．
+inline
+int
+Rtpg::sim_pat_num() const
+{
+  return mSimPatNum;
+}
+
 END_NAMESPACE_SATPG
 
 #endif // RTPG_H
@@ -12,6 +12,7 @@
 #include "structenc_nsdef.h"
 #include "FaultType.h"
 #include "VidMap.h"
+#include "LocalIndexMap.h"
 #include "TpgNode.h"
 #include "NodeValList.h"
 #include "ym/SatSolver.h"
@@ -383,6 +384,20 @@ private:
   void
   add_prev_node(const TpgNode* node);
 
+  /// @brief ノードの印を得る．
+  /// @param[in] node ノード
+  ///
+  /// 登録されていない場合は 0 を返す．
+  ymuint8
+  _mark(const TpgNode* node) const;
+
+  /// @brief ノードの印の格納場所を得る．
+  /// @param[in] node 対象のノード
+  ///
+  /// 登録されていない場合は 0 で登録する．
+  ymuint8&
+  _mark_ref(const TpgNode* node);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -408,7 +423,14 @@ private:
   // 3: 1時刻前の CNF 作成済み
   // 4: mCurNodeList に登録済み
   // 5: mPrevNodeList に登録済み
-  vector<ymuint8> mMark;
+  // インデックスは mMarkIndex の値
+  vector<ymuint8> mMarkArray;
+
+  // 印を持つノードの局所的な番号
+  // キーはノード番号
+  // ネットワーク全体の大きさの配列を確保しないように
+  // 印をつけたノードだけに番号を振る．
+  LocalIndexMap mMarkIndex;
 
   // 関係するノードのリスト
   vector<const TpgNode*> mCurNodeList;
@@ -532,7 +554,7 @@ StructEnc::var_mark(const TpgNode* node,
 		    int time) const
 {
   int sft = time ? 0 : 1;
-  return static_cast<bool>((mMark[node->id()] >> sft) & 1U);
+  return static_cast<bool>((_mark(node) >> sft) & 1U);
 }
 
 // @brief ノードに新しい変数番号を割り当てる．
@@ -563,7 +585,7 @@ StructEnc::_set_var(const TpgNode* node,
 {
   var_map(time).set_vid(node, var);
   int sft = time ? 0 : 1;
-  mMark[node->id()] |= (1U << sft);
+  _mark_ref(node) |= (1U << sft);
 }
 
 // @brief ノードの CNF が作成済みか調べる．
@@ -577,7 +599,7 @@ StructEnc::cnf_mark(const TpgNode* node,
 		    int time) const
 {
   int sft = time ? 2 : 3;
-  return static_cast<bool>((mMark[node->id()] >> sft) & 1U);
+  return static_cast<bool>((_mark(node) >> sft) & 1U);
 }
 
 // @brief ノードに CNF マークをつける．
@@ -591,7 +613,7 @@ StructEnc::set_cnf_mark(const TpgNode* node,
 			int time)
 {
   int sft = time ? 2 : 3;
-  mMark[node->id()] |= (1U << sft);
+  _mark_ref(node) |= (1U << sft);
 }
 
 // @brief mCurNodeList に登録済みのマークを得る．
@@ -600,7 +622,7 @@ inline
 bool
 StructEnc::cur_mark(const TpgNode* node) const
 {
-  return static_cast<bool>((mMark[node->id()] >> 4) & 1U);
+  return static_cast<bool>((_mark(node) >> 4) & 1U);
 }
 
 // @brief mCurNodeList に登録する．
@@ -610,7 +632,7 @@ void
 StructEnc::add_cur_node(const TpgNode* node)
 {
   mCurNodeList.push_back(node);
-  mMark[node->id()] |= (1U << 4);
+  _mark_ref(node) |= (1U << 4);
 }
 
 // @brief mPrevNodeList に登録する．
@@ -619,7 +641,7 @@ inline
 bool
 StructEnc::prev_mark(const TpgNode* node) const
 {
-  return static_cast<bool>((mMark[node->id()] >> 5) & 1U);
+  return static_cast<bool>((_mark(node) >> 5) & 1U);
 }
 
 // @brief mPrevNodeList に登録する．
@@ -629,7 +651,37 @@ void
 StructEnc::add_prev_node(const TpgNode* node)
 {
   mPrevNodeList.push_back(node);
-  mMark[node->id()] |= (1U << 5);
+  _mark_ref(node) |= (1U << 5);
+}
+
+// @brief ノードの印を得る．
+// @param[in] node ノード
+//
+// 登録されていない場合は 0 を返す．
+inline
+ymuint8
+StructEnc::_mark(const TpgNode* node) const
+{
+  int index = mMarkIndex.find(node->id());
+  if ( index < 0 ) {
+    return 0U;
+  }
+  return mMarkArray[index];
+}
+
+// @brief ノードの印の格納場所を得る．
+// @param[in] node 対象のノード
+//
+// 登録されていない場合は 0 で登録する．
+inline
+ymuint8&
+StructEnc::_mark_ref(const TpgNode* node)
+{
+  int index = mMarkIndex.reg(node->id());
+  if ( index == static_cast<int>(mMarkArray.size()) ) {
+    mMarkArray.push_back(0U);
+  }
+  return mMarkArray[index];
 }
 
 // @brief チェックを行う．
@@ -247,6 +247,18 @@ public:
   void
   set_from_random(URNG& randgen);
 
+  /// @brief 重み付きの乱数パタンを設定する．
+  /// @param[in] randgen 乱数生成器
+  /// @param[in] prob_list 各ビットが 1 になる確率のリスト
+  ///
+  /// prob_list のサイズは vector_size() と等しくなければならない．
+  /// 並びは ppi_val(), aux_input_val() の順
+  /// @note 結果はかならず 0 か 1 になる．(Xは含まれない)
+  template<class URNG>
+  void
+  set_from_random(URNG& randgen,
+		  const vector<double>& prob_list);
+
   /// @brief X の部分を乱数で 0/1 に設定する．
   /// @param[in] randgen 乱数生成器
   template<class URNG>
@@ -267,6 +279,19 @@ public:
   operator&&(const TestVector& left,
 	     const TestVector& right);
 
+  /// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+  /// @param[in] tv 基準となるテストベクタ
+  /// @param[in] tv_list 比較対象のテストベクタのリスト
+  /// @param[out] result 結果を格納するリスト
+  ///
+  /// result[i] に tv と tv_list[i] が両立する時 true が入る．<br>
+  /// is_compatible(tv, tv_list[i]) を繰り返すよりも効率がよい．
+  friend
+  void
+  is_compatible(const TestVector& tv,
+		const vector<TestVector>& tv_list,
+		vector<bool>& result);
+
   /// @brief 等価関係の比較を行なう．
   /// @param[in] left, right オペランド
   /// @return left と right が等しいとき true を返す．
@@ -347,6 +372,18 @@ bool
 is_compatible(const TestVector& tv1,
 	      const TestVector& tv2);
 
+/// @relates TestVector
+/// @brief 一つのベクタと複数のベクタの両立関係をまとめて調べる．
+/// @param[in] tv 基準となるテストベクタ
+/// @param[in] tv_list 比較対象のテストベクタのリスト
+/// @param[out] result 結果を格納するリスト
+///
+/// result[i] に tv と tv_list[i] が両立する時 true が入る．
+void
+is_compatible(const TestVector& tv,
+	      const vector<TestVector>& tv_list,
+	      vector<bool>& result);
+
 /// @relates TestVector
 /// @brief 等価関係の比較を行なう．
 /// @param[in] left, right オペランド
@@ -824,6 +861,18 @@ TestVector::set_from_random(URNG& randgen)
   mVector.set_from_random(randgen);
 }
 
+// @brief 重み付きの乱数パタンを設定する．
+// @param[in] randgen 乱数生成器
+// @param[in] prob_list 各ビットが 1 になる確率のリスト
+template<class URNG>
+inline
+void
+TestVector::set_from_random(URNG& randgen,
+			    const vector<double>& prob_list)
+{
+  mVector.set_from_random(randgen, prob_list);
+}
+
 // @brief X の部分を乱数で 0/1 に設定する．
 // @param[in] randgen 乱数生成器
 template<class URNG>
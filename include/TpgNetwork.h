@@ -270,6 +270,8 @@ public:
   /// @brief blif ファイルを読み込む．
   /// @param[in] filename ファイル名
   /// @return 読み込みが成功したら true を返す．
+  ///
+  /// BnNetwork を作らずに直接読み込むので .gate は使えない．
   bool
   read_blif(const string& filename);
 
@@ -284,9 +286,28 @@ public:
   /// @brief iscas89 形式のファイルを読み込む．
   /// @param[in] filename ファイル名
   /// @return 読み込みが成功したら true を返す．
+  ///
+  /// BnNetwork を作らずに直接読み込む．
   bool
   read_iscas89(const string& filename);
 
+  /// @brief 内容をスナップショットファイルに書き出す．
+  /// @param[in] filename ファイル名
+  /// @return 書き出しが成功したら true を返す．
+  ///
+  /// スナップショットはポインタを含まないバイナリ形式で，
+  /// 同じバイトオーダーの計算機なら load_snapshot() で読み込める．
+  bool
+  save_snapshot(const string& filename) const;
+
+  /// @brief スナップショットファイルを読み込む．
+  /// @param[in] filename ファイル名
+  /// @return 読み込みが成功したら true を返す．
+  ///
+  /// ファイルの形式やバージョンが異なる場合は false を返す．
+  bool
+  load_snapshot(const string& filename);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
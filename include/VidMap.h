@@ -5,7 +5,7 @@
 /// @brief VidMap のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2017 Yusuke Matsunaga
+/// Copyright (C) 2017, 2018 Yusuke Matsunaga
 /// All rights reserved.
 
 
@@ -20,8 +20,14 @@ BEGIN_NAMESPACE_SATPG
 /// @class VidMap VidMap.h "VidMap.h"
 /// @brief ノードに関連した変数番号を返すクラス
 ///
-/// 機能的にはノード番号をキーにした連想配列だが
-/// ノード番号は連続しているのでただの配列で実装する．
+/// 機能的にはノード番号をキーにした連想配列で，以下の2通りの実装を持つ．
+/// - 密なモード: ノード番号は連続しているのでただの配列で実装する．
+/// - 疎なモード: オープンアドレス法のハッシュ表で実装する．<br>
+///   コーンに含まれるノードだけを登録する場合に用いる．
+///   サイズは登録されたノード数に比例するのでネットワークが
+///   大きくても確保と初期化のコストがかからない．
+///
+/// 登録されていないノードに対しては kSatVarIdIllegal を返す．
 //////////////////////////////////////////////////////////////////////
 class VidMap
 {
@@ -29,6 +35,8 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] max_id ノード番号の最大値
+  ///
+  /// 密なモードで初期化される．
   VidMap(int max_id = 0);
 
   /// @brief デストラクタ
@@ -45,11 +53,22 @@ public:
   SatVarId
   operator()(const TpgNode* node) const;
 
-  /// @brief 初期化する．
+  /// @brief 密なモードで初期化する．
   /// @param[in] max_id ノード番号の最大値
   void
   init(int max_id);
 
+  /// @brief 疎なモードで初期化する．
+  /// @param[in] size_hint 登録されるノード数の見積もり
+  ///
+  /// size_hint を越えて登録しても構わない．
+  void
+  init_sparse(int size_hint = 0);
+
+  /// @brief 疎なモードの時 true を返す．
+  bool
+  is_sparse() const;
+
   /// @brief ノードに関連した変数番号を設定する．
   /// @param[in] node 対象のノード
   /// @param[in] vid 変数番号
@@ -63,13 +82,40 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ハッシュ表の中の位置を返す．
+  /// @param[in] id ノード番号
+  ///
+  /// id が登録されていない場合には空きの位置を返す．
+  int
+  _find(int id) const;
+
+  /// @brief ハッシュ表を拡大する．
+  /// @param[in] req_size 必要な要素数
+  void
+  _expand(int req_size);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // 疎なモードの時 true
+  bool mSparse;
+
+  // 疎なモードの時の登録された要素数
+  int mNum;
+
+  // 疎なモードの時のハッシュ表のマスク
+  // ハッシュ表のサイズは mHashMask + 1 (2のべき乗)
+  int mHashMask;
+
+  // 疎なモードの時のキー(ノード番号)の配列
+  // 空きは -1
+  vector<int> mKeyArray;
+
   // 変数番号を格納する配列
+  // 疎なモードの時は mKeyArray と同じ位置に値を格納する．
   vector<SatVarId> mVidArray;
 
 };
@@ -83,6 +129,9 @@ private:
 // @param[in] max_id ノード番号の最大値
 inline
 VidMap::VidMap(int max_id) :
+  mSparse(false),
+  mNum(0),
+  mHashMask(0),
   mVidArray(max_id, kSatVarIdIllegal)
 {
 }
@@ -99,18 +148,34 @@ inline
 SatVarId
 VidMap::operator()(const TpgNode* node) const
 {
-  ASSERT_COND( node->id() < mVidArray.size() );
+  if ( mSparse ) {
+    int pos = _find(node->id());
+    return mVidArray[pos];
+  }
+  ASSERT_COND( node->id() < static_cast<int>(mVidArray.size()) );
   return mVidArray[node->id()];
 }
 
-// @brief 初期化する．
+// @brief 密なモードで初期化する．
 // @param[in] max_id ノード番号の最大値
 inline
 void
 VidMap::init(int max_id)
 {
+  mSparse = false;
+  mNum = 0;
+  mHashMask = 0;
+  mKeyArray.clear();
   mVidArray.clear();
-  mVidArray.resize(max_id);
+  mVidArray.resize(max_id, kSatVarIdIllegal);
+}
+
+// @brief 疎なモードの時 true を返す．
+inline
+bool
+VidMap::is_sparse() const
+{
+  return mSparse;
 }
 
 // @brief ノードに関連した変数番号を設定する．
@@ -121,8 +186,43 @@ void
 VidMap::set_vid(const TpgNode* node,
 		SatVarId vid)
 {
-  ASSERT_COND( node->id() < mVidArray.size() );
-  mVidArray[node->id()] = vid;
+  int id = node->id();
+  if ( mSparse ) {
+    int pos = _find(id);
+    if ( mKeyArray[pos] == -1 ) {
+      if ( (mNum + 1) * 2 > mHashMask + 1 ) {
+	_expand(mNum + 1);
+	pos = _find(id);
+      }
+      mKeyArray[pos] = id;
+      ++ mNum;
+    }
+    mVidArray[pos] = vid;
+    return;
+  }
+  ASSERT_COND( id < static_cast<int>(mVidArray.size()) );
+  mVidArray[id] = vid;
+}
+
+// @brief ハッシュ表の中の位置を返す．
+// @param[in] id ノード番号
+//
+// id が登録されていない場合には空きの位置を返す．
+inline
+int
+VidMap::_find(int id) const
+{
+  // 線形探査を行う．
+  // 充填率は 1/2 以下に保たれているので必ず空きがある．
+  ymuint32 h = static_cast<ymuint32>(id) * 2654435769U;
+  int pos = static_cast<int>(h ^ (h >> 16)) & mHashMask;
+  for ( ; ; ) {
+    int key = mKeyArray[pos];
+    if ( key == id || key == -1 ) {
+      return pos;
+    }
+    pos = (pos + 1) & mHashMask;
+  }
 }
 
 END_NAMESPACE_SATPG
@@ -56,15 +56,6 @@ def mincov(fault_list, tv_list, network, fault_type, algorithm = '', debug = Fal
         print('*** Minimum Covering ***')
         print('# of initial patterns: {:8d}'.format(len(tv_list)))
 
-    def do_fsim(fsim, tv_buff, fid_dict, tid_base, mincov) :
-        assert len(tv_buff) <= 64
-
-        fp_list = fsim.ppsfp(tv_buff)
-        for fault, patid_list in fp_list :
-            fid = fid_dict[fault.id]
-            for patid in patid_list :
-                mincov.insert_elem(fid, tid_base + patid)
-
     nf = len(fault_list)
     mincov = MinCov(nf, len(tv_list))
     fsim = Fsim('Fsim3', network, fault_type)
@@ -78,17 +69,8 @@ def mincov(fault_list, tv_list, network, fault_type, algorithm = '', debug = Fal
         fid += 1
     assert fid == nf
 
-    tv_buff = []
-    wpos = 0
-    tid_base = 0
-    for tv in tv_list :
-        tv_buff.append(tv)
-        if len(tv_buff) == 64 :
-            do_fsim(fsim, tv_buff, fid_dict, tid_base, mincov)
-            tv_buff = []
-            tid_base += 64
-    if len(tv_buff) > 0 :
-        do_fsim(fsim, tv_buff, fid_dict, tid_base, mincov)
+    for fault, patid in fsim.grade(tv_list) :
+        mincov.insert_elem(fid_dict[fault.id], patid)
 
     cost, solution = mincov.heuristic()
 
@@ -7,7 +7,9 @@
 ### Copyright (C) 2018 Yusuke Matsunaga
 ### All rights reserved.
 
-from satpg_core import DtpgFFR, DtpgMFFC
+from satpg_core import DtpgFFR, DtpgMFFC, DtpgInc
+from satpg_core import DtpgMgr
+from satpg_core import FaultStatusMgr
 from satpg_core import Fsim
 from satpg_core import FaultStatus
 from satpg_core import TestVector
@@ -58,6 +60,23 @@ class Dtpg :
                     self.__call_dtpg(dtpg, fault)
         return self.__ndet, self.__nunt, self.__nabt
 
+    ### @brief インクリメンタルな FFR mode でパタン生成を行う．
+    ###
+    ### ffr_mode() と異なり，一つの DtpgInc を全ての FFR で使い回す．
+    def ffr_inc_mode(self, drop) :
+        self.__ndet = 0
+        self.__nunt = 0
+        self.__nabt = 0
+        self.__fault_drop = drop
+        self.__fault_list = []
+        self.__tv_list = []
+        dtpg = DtpgInc(self.__network, self.__fault_type)
+        for ffr in self.__network.ffr_list() :
+            for fault in ffr.fault_list() :
+                if self.__fault_mark[fault.id] :
+                    self.__call_dtpg(dtpg, fault)
+        return self.__ndet, self.__nunt, self.__nabt
+
     ### @brief FFR mode でパタン生成を行う．
     def k_ffr_mode(self, k) :
         self.__ndet = 0
@@ -85,6 +104,29 @@ class Dtpg :
                     self.__call_dtpg(dtpg, fault)
         return self.__ndet, self.__nunt, self.__nabt
 
+    ### @brief 複数のスレッドでパタン生成を行う．
+    ###
+    ### thread_num が 0 の時はハードウェアのスレッド数を用いる．
+    ### mffc が True の時は MFFC 単位，そうでなければ FFR 単位で処理する．
+    def parallel_mode(self, drop, thread_num = 0, mffc = False) :
+        fmgr = FaultStatusMgr(self.__network)
+        for fault in self.__network.rep_fault_list() :
+            if not self.__fault_mark[fault.id] :
+                # 対象外の故障は処理済みとしておく．
+                fmgr.set(fault, FaultStatus.Detected)
+        mgr = DtpgMgr(self.__network, self.__fault_type, thread_num = thread_num)
+        if mffc :
+            self.__ndet, self.__nunt, self.__nabt = mgr.mffc_mode(fmgr, drop)
+        else :
+            self.__ndet, self.__nunt, self.__nabt = mgr.ffr_mode(fmgr, drop)
+        self.__fault_list = mgr.fault_list
+        self.__tv_list = mgr.tv_list
+        for fault in self.__network.rep_fault_list() :
+            if self.__fault_mark[fault.id] and fmgr.get(fault) != FaultStatus.Undetected :
+                self.__fsim3.set_skip(fault)
+                self.__fault_mark[fault.id] = False
+        return self.__ndet, self.__nunt, self.__nabt
+
     ### @brief 全モードで共通な処理
     def __call_dtpg(self, dtpg, fault) :
         stat, testvect = dtpg(fault)
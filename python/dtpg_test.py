@@ -32,27 +32,9 @@ def gen_covering_matrix(fault_list, tv_list, network, fault_type) :
     mincov = MinCov(nf, len(tv_list))
     #print('MinCov: {} x {}'.format(nf, len(tv_list)))
     fsim = Fsim('Fsim3', network, fault_type)
-    tv_buff = []
-    wpos = 0
-    tid_base = 0
-    for tv in tv_list :
-        tv_buff.append(tv)
-        if len(tv_buff) == 64 :
-            fp_list = fsim.ppsfp(tv_buff)
-            for fault, patid_list in fp_list :
-                fid = fid_dict[fault.id]
-                for patid in patid_list :
-                    #print('  insert({}, {})'.format(fid, tid_base + patid))
-                    mincov.insert_elem(fid, tid_base + patid)
-            tv_buff = []
-            tid_base += 64
-    if len(tv_buff) > 0 :
-        fp_list = fsim.ppsfp(tv_buff)
-        for fault, patid_list in fp_list :
-            fid = fid_dict[fault.id]
-            for patid in patid_list :
-                #print('  insert({}, {})'.format(fid, tid_base + patid))
-                mincov.insert_elem(fid, tid_base + patid)
+    for fault, patid in fsim.grade(tv_list) :
+        #print('  insert({}, {})'.format(fid_dict[fault.id], patid))
+        mincov.insert_elem(fid_dict[fault.id], patid)
 
     cost, solution = mincov.heuristic()
     print('# of initial patterns: {}'.format(len(tv_list)))
@@ -71,6 +53,12 @@ def main() :
     mode_group.add_argument('-m', '--mffc',
                             action = 'store_true',
                             help = 'run in MFFC mode')
+    mode_group.add_argument('-i', '--incremental',
+                            action = 'store_true',
+                            help = 'run in incremental FFR mode')
+    mode_group.add_argument('-p', '--parallel',
+                            action = 'store_true',
+                            help = 'run in multi-threaded FFR mode')
 
     type_group = parser.add_mutually_exclusive_group()
     type_group.add_argument('--stuck_at',
@@ -92,6 +80,12 @@ def main() :
                         action = 'store_true',
                         help = 'fault drop mode')
 
+    parser.add_argument('--thread_num',
+                        type = int,
+                        default = 0,
+                        metavar = '<number of threads>',
+                        help = 'specify the number of threads for parallel mode')
+
     parser.add_argument('--compaction',
                         type = str,
                         metavar = '<compaction algorithm>',
@@ -109,6 +103,10 @@ def main() :
         mode = 'ffr'
     elif args.mffc :
         mode = 'mffc'
+    elif args.incremental :
+        mode = 'ffr_inc'
+    elif args.parallel :
+        mode = 'parallel'
     else :
         # デフォルト
         mode = 'ffr'
@@ -164,6 +162,10 @@ def main() :
             ndet, nunt, nabt = dtpg.ffr_mode(drop)
         elif mode == 'mffc' :
             ndet, nunt, nabt = dtpg.mffc_mode(drop)
+        elif mode == 'ffr_inc' :
+            ndet, nunt, nabt = dtpg.ffr_inc_mode(drop)
+        elif mode == 'parallel' :
+            ndet, nunt, nabt = dtpg.parallel_mode(drop, args.thread_num)
 
         lap1 = time.process_time()
         cpu_time = lap1 - start
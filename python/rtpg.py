@@ -4,108 +4,118 @@
 ### @brief RTPG(random test pattern generation)のスクリプト
 ### @author Yusuke Matsunaga (松永 裕介)
 ###
-### Copyright (C) 2017 Yusuke Matsunaga
+### Copyright (C) 2017, 2018 Yusuke Matsunaga
 ### All rights reserved.
 
-import satpg_core
-
-class Rtpg :
-
-    ### @brief 初期化
-    def __init__(self, fmgr, tvmgr, fsim) :
-        self._FaultMgr = fmgr
-        self._TvMgr = tvmgr
-        self._Fsim = fsim
-        self._RandGen = RandGen()
-        self._min_f = 1
-        self._max_undet = 4
-        self._max_pat = 1024
-
-    ### @brief パタン生成を行う．
-    def run(self) :
-        fmgr = self._FaultMgr
-        tvmgr = self._TvMgr
-        fsim = self._Fsim
-        randgen = self._RandGen
-        fnum = 0
-
-        # fsim の故障フラグを初期化する．
-        fsim.set_skip_all()
-        for f in fmgr.fault_list() :
-            if fmgr.status(f) == kFsUndetected :
-                fsim.clear_skip(f)
-                fnum += 1
-
-        # TestVector を用意する．
-        tv_array = [tvmgr.new_sa_vector() for i in range(0, kPvBitLen)]
-
-        fsim.clear_patterns()
-        pat_num = 0
-        wpos = 0
-        while True :
-            if pat_num < max_pat :
-                tv = tv_array[wpos]
-                tv.set_from_random(randgen)
-                pat_num += 1
-                wpos += 1
-                if wpos < kPvBitLen :
-                    continue
-            elif wpos == 0 :
-                break
-
-            det_count = fsim.sa_ppsfp()
-            def_flags = [False for i in range(0, kPvBitLen)]
-
-            num = wpos
-            for i in range(0, det_count) :
-                f = fsim.det_fault(i)
-                fmgr.set_status(f, kFsDetected)
-                fsim.set_skip(f)
-                dpat = fsim.det_fault_pat(i)
-
-                # dpat の最初の1のビットを調べる．
-                first = 0
-                while first < num :
-                    if dpat & (1 << first) :
-                        break
-                    first += 1
-                else :
-                    assert False
-                det_flags[first] = True
-
-            for i in range(0, num) :
-                if det_flags[i] :
-                    # 検出できたパタンは tvlist に移す．
-                    tv = tv_array[i]
-                    tvlist.append(tv)
-                    # tv_array には新しいパタンを補充しておく
-                    tv_array[i] = tvmgr.new_sa_vector()
-                    epat_num += 1
-
-            fsim.clear_patterns()
-            wpos = 0
-
-            total_det_count += det_count
-            if det_count > 0 :
-                undet_count = 0
+import argparse
+import os.path
+import time
+from satpg_core import FaultType
+from satpg_core import TpgNetwork
+from satpg_core import FaultStatusMgr
+from satpg_core import Rtpg
+
+
+def main() :
+
+    parser = argparse.ArgumentParser()
+
+    type_group = parser.add_mutually_exclusive_group()
+    type_group.add_argument('--stuck_at',
+                            action = 'store_true',
+                            help = 'TPG for stuck-at fault [default]')
+    type_group.add_argument('--transition_delay',
+                            action = 'store_true',
+                            help = 'TPG for transition-delay fault')
+
+    fmt_group = parser.add_mutually_exclusive_group()
+    fmt_group.add_argument('--blif',
+                            action = 'store_true',
+                            help = 'read blif file [default]')
+    fmt_group.add_argument('--iscas89',
+                           action = 'store_true',
+                           help = 'read ISCAS89 file')
+
+    parser.add_argument('--min_f',
+                        type = int,
+                        default = 1,
+                        metavar = '<number of faults>',
+                        help = 'minimum number of detected faults per block')
+    parser.add_argument('--max_i',
+                        type = int,
+                        default = 4,
+                        metavar = '<number of blocks>',
+                        help = 'maximum number of ineffective blocks in a row')
+    parser.add_argument('--max_pat',
+                        type = int,
+                        default = 100000,
+                        metavar = '<number of patterns>',
+                        help = 'maximum number of simulated patterns')
+    parser.add_argument('--seed',
+                        type = int,
+                        default = 0,
+                        metavar = '<seed>',
+                        help = 'seed of the random number generator')
+
+    parser.add_argument('file_list', metavar = '<filename>', type = str,
+                        nargs = '+',
+                        help = 'file name')
+
+    args = parser.parse_args()
+    if not args :
+        exit(1)
+
+    if args.transition_delay :
+        fault_type = FaultType.TransitionDelay
+    else :
+        # デフォルト
+        fault_type = FaultType.StuckAt
+
+    if args.blif :
+        file_format = 'blif'
+    elif args.iscas89 :
+        file_format = 'iscas89'
+    else :
+        file_format = None
+
+    for file_name in args.file_list :
+        file_format1 = file_format
+        if not file_format1 :
+            body, ext = os.path.splitext(file_name)
+            if ext == '.bench' :
+                file_format1 = 'iscas89'
             else :
-                undet_count += 1
-
-            if total_det_count == fnum :
-                # すべての故障を検出した．
-                break
-
-            # ループを打ち切る条件をチェックする．
-            if self.break_condition(det_count, undet_count) :
-                break
-
-        # パタンを削除する．
-        for tv in tv_array :
-            tvmgr.delete_vector(tv)
-
-    ## @brief ループの打ち切り条件
-    def break_condition(self, det_count, undet_count) :
-        if det_count < self._min_f :
-            return True
-        if undet_count > self._max_i :
-            return True
+                # デフォルト
+                file_format1 = 'blif'
+
+        if file_format1 == 'blif' :
+            network = TpgNetwork.read_blif(file_name)
+        else :
+            network = TpgNetwork.read_iscas89(file_name)
+
+        if not network :
+            print('Error, could not read {}'.format(file_name))
+            continue
+
+        start = time.process_time()
+
+        fmgr = FaultStatusMgr(network)
+        rtpg = Rtpg(network, fault_type, seed = args.seed)
+        ndet = rtpg.run(fmgr, args.min_f, args.max_i, args.max_pat)
+
+        end = time.process_time()
+        cpu_time = end - start
+
+        tf = 0
+        for i in network.rep_fault_list() :
+            tf += 1
+        print('file name:              {}'.format(file_name))
+        print('# of total faults:      {:8d}'.format(tf))
+        print('# of detected faults:   {:8d}'.format(ndet))
+        print('# of simulated patterns:{:8d}'.format(rtpg.sim_pat_num))
+        print('# of effective patterns:{:8d}'.format(len(rtpg.pattern_list)))
+        print('CPU time:               {:8.2f}'.format(cpu_time))
+
+
+if __name__ == '__main__' :
+    main()